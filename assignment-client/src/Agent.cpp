@@ -134,7 +134,7 @@ void Agent::handleOctreePacket(QSharedPointer<ReceivedMessage> message, SharedNo
             memcpy(buffer.get(), message->getRawMessage() + statsMessageLength, piggyBackedSizeWithHeader);
 
             auto newPacket = NLPacket::fromReceivedPacket(std::move(buffer), piggyBackedSizeWithHeader, message->getSenderSockAddr());
-            message = QSharedPointer<ReceivedMessage>::create(*newPacket);
+            message = QSharedPointer<ReceivedMessage>::create(std::move(newPacket));
         } else {
             return; // bail since no piggyback data
         }
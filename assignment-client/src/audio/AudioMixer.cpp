@@ -86,7 +86,7 @@ AudioMixer::AudioMixer(ReceivedMessage& message) :
             PacketType::RadiusIgnoreRequest,
             PacketType::RequestsDomainListData,
             PacketType::PerAvatarGainSet },
-            this, "queueAudioPacket");
+            this, &AudioMixer::queueAudioPacket);
 
     // packets whose consequences are global should be processed on the main thread
     packetReceiver.registerListener(PacketType::MuteEnvironment, this, "handleMuteEnvironmentPacket");
@@ -117,7 +117,7 @@ void AudioMixer::queueReplicatedAudioPacket(QSharedPointer<ReceivedMessage> mess
     // make sure we have a replicated node for the original sender of the packet
     auto nodeList = DependencyManager::get<NodeList>();
 
-    QUuid nodeID =  QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+    QUuid nodeID =  message->readUuid();
 
     auto replicatedNode = nodeList->addOrUpdateNode(nodeID, NodeType::Agent,
                                                     message->getSenderSockAddr(), message->getSenderSockAddr(),
@@ -125,7 +125,7 @@ void AudioMixer::queueReplicatedAudioPacket(QSharedPointer<ReceivedMessage> mess
     replicatedNode->setLastHeardMicrostamp(usecTimestampNow());
 
     // construct a "fake" audio received message from the byte array and packet list information
-    auto audioData = message->getMessage().mid(NUM_BYTES_RFC4122_UUID);
+    auto audioData = message->read(message->getBytesLeftToRead());
 
     PacketType rewrittenType = PacketTypeEnum::getReplicatedPacketMapping().key(message->getType());
 
@@ -201,7 +201,7 @@ void AudioMixer::handleNodeKilled(SharedNodePointer killedNode) {
 
 void AudioMixer::handleNodeMuteRequestPacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode) {
     auto nodeList = DependencyManager::get<NodeList>();
-    QUuid nodeUUID = QUuid::fromRfc4122(packet->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+    QUuid nodeUUID = packet->readUuid();
     if (sendingNode->getCanKick()) {
         auto node = nodeList->nodeWithUUID(nodeUUID);
         if (node) {
@@ -153,7 +153,7 @@ void AudioMixerClientData::optionallyReplicatePacket(ReceivedMessage& message, c
                         packet->write(node.getUUID().toRfc4122());
                     }
 
-                    packet->write(message.getMessage());
+                    packet->write(message.getRawMessage(), message.getSize());
                 }
                 
                 nodeList->sendUnreliablePacket(*packet, *downstreamNode);
@@ -185,7 +185,7 @@ void AudioMixerClientData::parseRequestsDomainListData(ReceivedMessage& message)
 void AudioMixerClientData::parsePerAvatarGainSet(ReceivedMessage& message, const SharedNodePointer& node) {
     QUuid uuid = node->getUUID();
     // parse the UUID from the packet
-    QUuid avatarUuid = QUuid::fromRfc4122(message.readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+    QUuid avatarUuid = message.readUuid();
     uint8_t packedGain;
     message.readPrimitive(&packedGain);
     float gain = unpackFloatGainFromByte(packedGain);
@@ -300,7 +300,7 @@ int AudioMixerClientData::parseData(ReceivedMessage& message) {
             // grab the stream identifier for this injected audio
             message.seek(sizeof(quint16));
 
-            QUuid streamIdentifier = QUuid::fromRfc4122(message.readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+            QUuid streamIdentifier = message.readUuid();
 
             bool isStereo;
             message.readPrimitive(&isStereo);
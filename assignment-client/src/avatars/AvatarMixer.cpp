@@ -45,7 +45,7 @@ AvatarMixer::AvatarMixer(ReceivedMessage& message) :
     connect(DependencyManager::get<NodeList>().data(), &NodeList::nodeKilled, this, &AvatarMixer::nodeKilled);
 
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
-    packetReceiver.registerListener(PacketType::AvatarData, this, "queueIncomingPacket");
+    packetReceiver.registerListener(PacketType::AvatarData, this, &AvatarMixer::queueIncomingPacket);
     packetReceiver.registerListener(PacketType::AdjustAvatarSorting, this, "handleAdjustAvatarSorting");
     packetReceiver.registerListener(PacketType::ViewFrustum, this, "handleViewFrustumPacket");
     packetReceiver.registerListener(PacketType::AvatarIdentity, this, "handleAvatarIdentityPacket");
@@ -112,7 +112,7 @@ void AvatarMixer::handleReplicatedPacket(QSharedPointer<ReceivedMessage> message
 void AvatarMixer::handleReplicatedBulkAvatarPacket(QSharedPointer<ReceivedMessage> message) {
     while (message->getBytesLeftToRead()) {
         // first, grab the node ID for this replicated avatar
-        auto nodeID = QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+        auto nodeID = message->readUuid();
 
         // make sure we have an upstream replicated node that matches
         auto replicatedNode = addOrUpdateReplicatedNode(nodeID, message->getSenderSockAddr());
@@ -164,7 +164,7 @@ void AvatarMixer::optionallyReplicatePacket(ReceivedMessage& message, const Node
             if (!packet) {
                 // construct an NLPacket to send to the replicant that has the contents of the received packet
                 packet = NLPacket::create(replicatedType, message.getSize());
-                packet->write(message.getMessage());
+                packet->write(message.getRawMessage(), message.getSize());
             }
 
             nodeList->sendUnreliablePacket(*packet, *node);
@@ -260,7 +260,8 @@ void AvatarMixer::start() {
             auto start = usecTimestampNow();
             nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
                 auto start = usecTimestampNow();
-                _slavePool.broadcastAvatarData(cbegin, cend, _lastFrameTimestamp, _maxKbpsPerNode, _throttlingRatio);
+                _slavePool.broadcastAvatarData(cbegin, cend, _lastFrameTimestamp, _maxKbpsPerNode, _throttlingRatio,
+                                               _jointDeltaEncoding);
                 auto end = usecTimestampNow();
                 _broadcastAvatarDataInner += (end - start);
             }, &lockWait, &nodeTransform, &functor);
@@ -523,7 +524,7 @@ void AvatarMixer::handleViewFrustumPacket(QSharedPointer<ReceivedMessage> messag
     if (senderNode->getLinkedData()) {
         AvatarMixerClientData* nodeData = dynamic_cast<AvatarMixerClientData*>(senderNode->getLinkedData());
         if (nodeData != nullptr) {
-            nodeData->readViewFrustumPacket(message->getMessage());
+            nodeData->readViewFrustumPacket(message->readWithoutCopy(message->getBytesLeftToRead()));
         }
     }
 
@@ -585,7 +586,7 @@ void AvatarMixer::handleAvatarIdentityPacket(QSharedPointer<ReceivedMessage> mes
             bool identityChanged = false;
             bool displayNameChanged = false;
             bool skeletonModelUrlChanged = false;
-            avatar.processAvatarIdentity(message->getMessage(), identityChanged, displayNameChanged, skeletonModelUrlChanged);
+            avatar.processAvatarIdentity(message->readWithoutCopy(message->getBytesLeftToRead()), identityChanged, displayNameChanged, skeletonModelUrlChanged);
 
             if (identityChanged) {
                 QMutexLocker nodeDataLocker(&nodeData->getMutex());
@@ -620,7 +621,7 @@ void AvatarMixer::handleNodeIgnoreRequestPacket(QSharedPointer<ReceivedMessage>
     message->readPrimitive(&addToIgnore);
     while (message->getBytesLeftToRead()) {
         // parse out the UUID being ignored from the packet
-        QUuid ignoredUUID = QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+        QUuid ignoredUUID = message->readUuid();
 
         if (nodeList->nodeWithUUID(ignoredUUID)) {
             // Reset the lastBroadcastTime for the ignored avatar to 0
@@ -921,6 +922,10 @@ void AvatarMixer::parseDomainServerSettings(const QJsonObject& domainSettings) {
     _maxKbpsPerNode = nodeBandwidthValue.toDouble(DEFAULT_NODE_SEND_BANDWIDTH) * KILO_PER_MEGA;
     qCDebug(avatars) << "The maximum send bandwidth per node is" << _maxKbpsPerNode << "kbps.";
 
+    const QString JOINT_DELTA_ENCODING_KEY = "joint_delta_encoding";
+    _jointDeltaEncoding = avatarMixerGroupObject[JOINT_DELTA_ENCODING_KEY].toBool(false);
+    qCDebug(avatars) << "Joint data delta encoding is" << (_jointDeltaEncoding ? "enabled" : "disabled");
+
     const QString AUTO_THREADS = "auto_threads";
     bool autoThreads = avatarMixerGroupObject[AUTO_THREADS].toBool();
     if (!autoThreads) {
@@ -57,6 +57,7 @@ public:
     Q_INVOKABLE void cleanupKilledNode(const QUuid& nodeUUID) {
         removeLastBroadcastSequenceNumber(nodeUUID);
         removeLastBroadcastTime(nodeUUID);
+        _lastOtherAvatarJointBaselines.erase(nodeUUID);
     }
 
     uint16_t getLastReceivedSequenceNumber() const { return _lastReceivedSequenceNumber; }
@@ -126,6 +127,8 @@ public:
         return _lastOtherAvatarSentJoints[otherAvatar];
     }
 
+    JointBaseline& getLastOtherAvatarJointBaseline(QUuid otherAvatar) { return _lastOtherAvatarJointBaselines[otherAvatar]; }
+
     void queuePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer node);
     int processPackets(); // returns number of packets processed
 
@@ -145,6 +148,7 @@ private:
     // sending to "this" node
     std::unordered_map<QUuid, quint64> _lastOtherAvatarEncodeTime;
     std::unordered_map<QUuid, QVector<JointData>> _lastOtherAvatarSentJoints;
+    std::unordered_map<QUuid, JointBaseline> _lastOtherAvatarJointBaselines; // last joint keyframe sent, see JointDeltaCoding
 
     uint64_t _identityChangeTimestamp;
     bool _avatarSessionDisplayNameMustChange{ true };
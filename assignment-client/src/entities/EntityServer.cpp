@@ -37,7 +37,7 @@ EntityServer::EntityServer(ReceivedMessage& message) :
 
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
     packetReceiver.registerListenerForTypes({ PacketType::EntityAdd, PacketType::EntityEdit, PacketType::EntityErase, PacketType::EntityPhysics },
-                                            this, "handleEntityPacket");
+                                            this, &EntityServer::handleEntityPacket);
 }
 
 EntityServer::~EntityServer() {
@@ -367,6 +367,39 @@ QString EntityServer::serverSubclassStats() {
     statsString += QString().sprintf("       EntityItem size... %ld bytes\r\n", sizeof(EntityItem));
     statsString += "\r\n\r\n";
 
+    // display how much encoding the send threads shared, averaged over send passes
+    float encodedDataHits = OctreeServer::getAverageEncodedDataHits();
+    float encodedDataLookups = OctreeServer::getAverageEncodedDataLookups();
+    float encodedDataHitRate = encodedDataLookups > 0.0f ? encodedDataHits / encodedDataLookups : 0.0f;
+    statsString += "<b>Entity Server Encoding Statistics</b>\r\n";
+    statsString += QString("  Encodings reused/pass... %1 of %2 (%3%)\r\n")
+        .arg(locale.toString(encodedDataHits, 'f', 1))
+        .arg(locale.toString(encodedDataLookups, 'f', 1))
+        .arg(encodedDataHitRate * 100.0f, 0, 'f', 1);
+    statsString += QString("   Encode time saved/pass... %1 usecs\r\n")
+        .arg(locale.toString(OctreeServer::getAverageEncodedDataUsecsSaved(), 'f', 1));
+    statsString += "\r\n\r\n";
+
+    // display how long moving entities between elements held the tree's write lock
+    EntityTreePointer tree = std::static_pointer_cast<EntityTree>(_tree);
+    statsString += "<b>Entity Server Re-binning Statistics</b>\r\n";
+    statsString += QString("    Batched traversals... %1 moving %2 entities\r\n")
+        .arg(locale.toString(tree->getTotalMoveTraversals()))
+        .arg(locale.toString(tree->getTotalEntitiesMoved()));
+    statsString += QString("     Lock time/traversal... %1 usecs average, %2 usecs max\r\n")
+        .arg(locale.toString(tree->getAverageMoveTime()))
+        .arg(locale.toString(tree->getMaxMoveTime()));
+    statsString += QString("  Element checks saved... %1\r\n")
+        .arg(locale.toString(tree->getMoveChecksSaved()));
+    statsString += "\r\n\r\n";
+
+    statsString += "<b>Entity Server Text Delta Statistics</b>\r\n";
+    statsString += QString("  Deltas resolved... %1\r\n")
+        .arg(locale.toString(tree->getStringDeltasResolved()));
+    statsString += QString("   Deltas dropped... %1\r\n")
+        .arg(locale.toString(tree->getStringDeltasDropped()));
+    statsString += "\r\n\r\n";
+
     statsString += "<b>Entity Server Sending to Viewer Statistics</b>\r\n";
     statsString += "----- Viewer Node ID -----------------    ----- Entity ID ----------------------    "
                    "---------- Last Sent To ----------    ---------- Last Edited -----------\r\n";
@@ -15,6 +15,8 @@
 #include <LogHandler.h>
 #include <MessagesClient.h>
 #include <NodeList.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
 #include <udt/PacketHeaders.h>
 #include "MessagesMixer.h"
 
@@ -30,40 +32,69 @@ MessagesMixer::MessagesMixer(ReceivedMessage& message) : ThreadedAssignment(mess
 }
 
 void MessagesMixer::nodeKilled(SharedNodePointer killedNode) {
-    for (auto& channel : _channelSubscribers) {
-        channel.remove(killedNode->getUUID());
+    auto channels = _subscriberChannels.take(killedNode->getUUID());
+    for (auto& channel : channels) {
+        auto it = _channelSubscribers.find(channel);
+        if (it != _channelSubscribers.end()) {
+            it->remove(killedNode->getUUID());
+            if (it->isEmpty()) {
+                _channelSubscribers.erase(it);
+            }
+        }
     }
 }
 
 void MessagesMixer::handleMessages(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode) {
-    QString channel, message;
-    QByteArray data;
-    QUuid senderID;
-    bool isText;
-    MessagesClient::decodeMessagesPacket(receivedMessage, channel, isText, message, data, senderID);
+    // messages are forwarded as they came in, so the channel is all we need to decode
+    QString channel = MessagesClient::decodeMessagesChannel(receivedMessage);
+    QByteArray payload = receivedMessage->getMessage();
+
+    auto& channelStats = _channelStats[channel];
+    channelStats.messages++;
+    channelStats.bytes += payload.size();
+
+    auto subscribers = _channelSubscribers.find(channel);
+    if (subscribers == _channelSubscribers.end()) {
+        return;
+    }
 
     auto nodeList = DependencyManager::get<NodeList>();
 
-    nodeList->eachMatchingNode(
-        [&](const SharedNodePointer& node)->bool {
-        return node->getActiveSocket() && _channelSubscribers[channel].contains(node->getUUID());
-    },
-        [&](const SharedNodePointer& node) {
-        auto packetList = isText ? MessagesClient::encodeMessagesPacket(channel, message, senderID) :
-                                   MessagesClient::encodeMessagesDataPacket(channel, data, senderID);
-        nodeList->sendPacketList(std::move(packetList), *node);
-    });
+    for (auto& subscriberID : *subscribers) {
+        auto node = nodeList->nodeWithUUID(subscriberID);
+        if (node && node->getActiveSocket()) {
+            // reliable packet lists are sequenced per connection so each subscriber needs its own,
+            // but they are all filled from the same encoded payload
+            auto packetList = NLPacketList::create(PacketType::MessagesData, QByteArray(), true, true);
+            packetList->write(payload);
+            nodeList->sendPacketList(std::move(packetList), *node);
+            channelStats.recipients++;
+        }
+    }
 }
 
 void MessagesMixer::handleMessagesSubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     QString channel = QString::fromUtf8(message->getMessage());
     _channelSubscribers[channel] << senderNode->getUUID();
+    _subscriberChannels[senderNode->getUUID()] << channel;
 }
 
 void MessagesMixer::handleMessagesUnsubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     QString channel = QString::fromUtf8(message->getMessage());
-    if (_channelSubscribers.contains(channel)) {
-        _channelSubscribers[channel].remove(senderNode->getUUID());
+    auto it = _channelSubscribers.find(channel);
+    if (it != _channelSubscribers.end()) {
+        it->remove(senderNode->getUUID());
+        if (it->isEmpty()) {
+            _channelSubscribers.erase(it);
+        }
+    }
+
+    auto channels = _subscriberChannels.find(senderNode->getUUID());
+    if (channels != _subscriberChannels.end()) {
+        channels->remove(channel);
+        if (channels->isEmpty()) {
+            _subscriberChannels.erase(channels);
+        }
     }
 }
 
@@ -80,11 +111,36 @@ void MessagesMixer::sendStatsPacket() {
     });
 
     statsObject["messages"] = messagesMixerObject;
+
+    // add stats for each channel, since the last time stats were sent
+    quint64 now = usecTimestampNow();
+    float secondsSinceLastStats = (float)(now - _lastStatsTime) / USECS_PER_SECOND;
+
+    for (auto it = _channelSubscribers.begin(); it != _channelSubscribers.end(); it++) {
+        _channelStats[it.key()];
+    }
+
+    QJsonObject channelsObject;
+    for (auto it = _channelStats.begin(); it != _channelStats.end(); it++) {
+        const ChannelStats& channelStats = it.value();
+        QJsonObject channelObject;
+        channelObject["subscribers"] = _channelSubscribers.value(it.key()).size();
+        channelObject["messages_per_second"] = channelStats.messages / secondsSinceLastStats;
+        channelObject["fanout_per_second"] = channelStats.recipients / secondsSinceLastStats;
+        channelObject["average_fanout"] = channelStats.messages > 0 ? (float)channelStats.recipients / channelStats.messages : 0.0f;
+        channelObject["inbound_kbps"] = channelStats.bytes / secondsSinceLastStats / BYTES_PER_KILOBIT;
+        channelsObject[it.key()] = channelObject;
+    }
+    statsObject["channels"] = channelsObject;
+
+    _channelStats.clear();
+    _lastStatsTime = now;
     ThreadedAssignment::addPacketStatsAndSendStatsPacket(statsObject);
 }
 
 void MessagesMixer::run() {
     ThreadedAssignment::commonInit(MESSAGES_MIXER_LOGGING_NAME, NodeType::MessagesMixer);
+    _lastStatsTime = usecTimestampNow();
     auto nodeList = DependencyManager::get<NodeList>();
     nodeList->addSetOfNodeTypesToNodeInterestSet({ NodeType::Agent, NodeType::EntityScriptServer });
 }
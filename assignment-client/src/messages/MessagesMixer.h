@@ -34,7 +34,20 @@ private slots:
     void handleMessagesUnsubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
 
 private:
+    struct ChannelStats {
+        int messages { 0 };
+        int recipients { 0 };
+        qint64 bytes { 0 };
+    };
+
     QHash<QString,QSet<QUuid>> _channelSubscribers;
+
+    // the reverse of _channelSubscribers, so that a killed node only touches the channels it was in
+    QHash<QUuid,QSet<QString>> _subscriberChannels;
+
+    // reset every time stats are sent
+    QHash<QString,ChannelStats> _channelStats;
+    quint64 _lastStatsTime { 0 };
 };
 
 #endif // hifi_MessagesMixer_h
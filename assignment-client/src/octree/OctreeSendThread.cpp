@@ -341,7 +341,7 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
     int targetSize = MAX_OCTREE_PACKET_DATA_SIZE;
     targetSize = nodeData->getAvailable() - sizeof(OCTREE_PACKET_INTERNAL_SECTION_SIZE);
 
-    _packetData.changeSettings(true, targetSize); // FIXME - eventually support only compressed packets
+    _packetData.changeSettings(true, targetSize, true); // FIXME - eventually support only compressed packets
 
     // If the current view frustum has changed OR we have nothing to send, then search against
     // the current view frustum for things to send.
@@ -466,6 +466,11 @@ void OctreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, Octre
     int extraPackingAttempts = 0;
     bool completedScene = false;
 
+    // each pass through here reports its own reuse of kept encodings, not a running total
+    int encodedDataHits = 0;
+    int encodedDataMisses = 0;
+    quint64 encodedDataUsecsSaved = 0;
+
     bool somethingToSend = true; // assume we have something
     while (somethingToSend && _packetsSentThisInterval < maxPacketsPerInterval && !nodeData->isShuttingDown()) {
         float lockWaitElapsedUsec = OctreeServer::SKIP_TIME;
@@ -516,6 +521,9 @@ void OctreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, Octre
 
                 // NOTE: this is where the tree "contents" are actaully packed
                 _myServer->getOctree()->encodeTreeBitstream(subTree, &_packetData, nodeData->elementBag, params);
+                encodedDataHits += params.encodedDataHits;
+                encodedDataMisses += params.encodedDataMisses;
+                encodedDataUsecsSaved += params.encodedDataUsecsSaved;
 
                 quint64 encodeEnd = usecTimestampNow();
                 encodeElapsedUsec = (float)(encodeEnd - encodeStart);
@@ -574,7 +582,7 @@ void OctreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, Octre
                 // little bit of padding.
                 targetSize = nodeData->getAvailable() - sizeof(OCTREE_PACKET_INTERNAL_SECTION_SIZE) - COMPRESS_PADDING;
             }
-            _packetData.changeSettings(true, targetSize); // will do reset - NOTE: Always compressed
+            _packetData.changeSettings(true, targetSize, true); // will do reset - NOTE: Always compressed
         }
         OctreeServer::trackTreeWaitTime(lockWaitElapsedUsec);
         OctreeServer::trackEncodeTime(encodeElapsedUsec);
@@ -586,6 +594,8 @@ void OctreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, Octre
         OctreeServer::trackInsideTime((float)elapsedInsideUsecs);
     }
 
+    OctreeServer::trackEncodedData(encodedDataHits, encodedDataMisses, encodedDataUsecsSaved);
+
     if (somethingToSend && _myServer->wantsVerboseDebug()) {
         qCDebug(octree) << "Hit PPS Limit, packetsSentThisInterval =" << _packetsSentThisInterval
                         << "  maxPacketsPerInterval = " << maxPacketsPerInterval
@@ -74,6 +74,10 @@ int OctreeServer::_noCompress = 0;
 SimpleMovingAverage OctreeServer::_averagePacketSendingTime(MOVING_AVERAGE_SAMPLE_COUNTS);
 int OctreeServer::_noSend = 0;
 
+SimpleMovingAverage OctreeServer::_averageEncodedDataHits(MOVING_AVERAGE_SAMPLE_COUNTS);
+SimpleMovingAverage OctreeServer::_averageEncodedDataLookups(MOVING_AVERAGE_SAMPLE_COUNTS);
+SimpleMovingAverage OctreeServer::_averageEncodedDataUsecsSaved(MOVING_AVERAGE_SAMPLE_COUNTS);
+
 SimpleMovingAverage OctreeServer::_averageProcessWaitTime(MOVING_AVERAGE_SAMPLE_COUNTS);
 SimpleMovingAverage OctreeServer::_averageProcessShortWaitTime(MOVING_AVERAGE_SAMPLE_COUNTS);
 SimpleMovingAverage OctreeServer::_averageProcessLongWaitTime(MOVING_AVERAGE_SAMPLE_COUNTS);
@@ -216,6 +220,16 @@ void OctreeServer::trackProcessWaitTime(float time) {
     _averageProcessWaitTime.updateAverage(time);
 }
 
+void OctreeServer::trackEncodedData(int hits, int misses, quint64 usecsSaved) {
+    // passes that had nothing to look up would only dilute the rate
+    if (hits + misses == 0) {
+        return;
+    }
+    _averageEncodedDataHits.updateAverage((float)hits);
+    _averageEncodedDataLookups.updateAverage((float)(hits + misses));
+    _averageEncodedDataUsecsSaved.updateAverage((float)usecsSaved);
+}
+
 OctreeServer::OctreeServer(ReceivedMessage& message) :
     ThreadedAssignment(message),
     _argc(0),
@@ -1088,6 +1102,8 @@ void OctreeServer::readConfiguration() {
     QJsonObject settingsSectionObject = settingsObject[settingsKey].toObject();
     _settings = settingsSectionObject; // keep this for later
 
+    setCongestionControlFromSettings(settingsSectionObject);
+
     if (!readOptionString(QString("statusHost"), settingsSectionObject, _statusHost) || _statusHost.isEmpty()) {
         _statusHost = getGuessedLocalAddress().toString();
     }
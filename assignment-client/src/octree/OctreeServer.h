@@ -108,6 +108,12 @@ public:
     static void trackProcessWaitTime(float time);
     static float getAverageProcessWaitTime() { return _averageProcessWaitTime.getAverage(); }
 
+    // counted afresh by each send pass, see EncodeBitstreamParams::encodedDataHits
+    static void trackEncodedData(int hits, int misses, quint64 usecsSaved);
+    static float getAverageEncodedDataHits() { return _averageEncodedDataHits.getAverage(); }
+    static float getAverageEncodedDataLookups() { return _averageEncodedDataLookups.getAverage(); }
+    static float getAverageEncodedDataUsecsSaved() { return _averageEncodedDataUsecsSaved.getAverage(); }
+
     // these methods allow us to track which threads got to various states
     static void didProcess(OctreeSendThread* thread);
     static void didPacketDistributor(OctreeSendThread* thread);
@@ -242,6 +248,10 @@ protected:
     static SimpleMovingAverage _averagePacketSendingTime;
     static int _noSend;
 
+    static SimpleMovingAverage _averageEncodedDataHits;
+    static SimpleMovingAverage _averageEncodedDataLookups;
+    static SimpleMovingAverage _averageEncodedDataUsecsSaved;
+
     static SimpleMovingAverage _averageProcessWaitTime;
     static SimpleMovingAverage _averageProcessShortWaitTime;
     static SimpleMovingAverage _averageProcessLongWaitTime;
@@ -522,7 +522,7 @@ void EntityScriptServer::handleOctreePacket(QSharedPointer<ReceivedMessage> mess
             memcpy(buffer.get(), message->getRawMessage() + statsMessageLength, piggyBackedSizeWithHeader);
 
             auto newPacket = NLPacket::fromReceivedPacket(std::move(buffer), piggyBackedSizeWithHeader, message->getSenderSockAddr());
-            message = QSharedPointer<ReceivedMessage>::create(*newPacket);
+            message = QSharedPointer<ReceivedMessage>::create(std::move(newPacket));
         } else {
             return; // bail since no piggyback data
         }
@@ -11,6 +11,7 @@
 
 #include "DomainServer.h"
 
+#include <algorithm>
 #include <memory>
 #include <random>
 
@@ -915,7 +916,11 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
     // update the connecting hostname in case it has changed
     nodeData->setPlaceName(nodeRequestData.placeName);
 
-    sendDomainListToNode(sendingNode, message->getSenderSockAddr());
+    // the last domain list this node received in full, so we can send what changed since then
+    quint32 acknowledgedListVersion = 0;
+    packetStream >> acknowledgedListVersion;
+
+    sendDomainListToNode(sendingNode, message->getSenderSockAddr(), acknowledgedListVersion);
 }
 
 bool DomainServer::isInInterestSet(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB) {
@@ -1030,51 +1035,101 @@ void DomainServer::handleConnectedNode(SharedNodePointer newNode) {
     broadcastNewNode(newNode);
 }
 
-void DomainServer::sendDomainListToNode(const SharedNodePointer& node, const HifiSockAddr &senderSockAddr) {
-    const int NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES = NUM_BYTES_RFC4122_UUID + NUM_BYTES_RFC4122_UUID + 2;
+void DomainServer::sendDomainListToNode(const SharedNodePointer& node, const HifiSockAddr &senderSockAddr,
+                                        quint32 acknowledgedListVersion) {
+    auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
+
+    DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+
+    // store the nodeInterestSet on this DomainServerNodeData, in case it has changed
+    auto& nodeInterestSet = nodeData->getNodeInterestSet();
+
+    // gather the nodes this node should know about, with what it should know about them
+    DomainListEntries entries;
+    std::vector<SharedNodePointer> listedNodes;
+
+    if (nodeInterestSet.size() > 0) {
+
+        // DTLSServerSession* dtlsSession = _isUsingDTLS ? _dtlsSessions[senderSockAddr] : NULL;
+        if (nodeData->isAuthenticated()) {
+            // if this authenticated node has any interest types, send back those nodes as well
+            limitedNodeList->eachNode([&](const SharedNodePointer& otherNode) {
+                if (otherNode->getUUID() != node->getUUID() && isInInterestSet(node, otherNode)) {
+                    entries.insert(otherNode->getUUID(), {
+                        otherNode->getType(), otherNode->getPublicSocket(), otherNode->getLocalSocket(),
+                        otherNode->getPermissions().permissions, otherNode->isReplicated(),
+                        connectionSecretForNodes(node, otherNode)
+                    });
+                    listedNodes.push_back(otherNode);
+                }
+            });
+        }
+    }
+
+    // if the node has everything we last sent it, only send what has changed since
+    // otherwise (a new node, or one that missed part of a list) send the full list
+    quint32 baseListVersion = 0;
+    std::vector<QUuid> removedNodes;
+
+    if (acknowledgedListVersion != 0 && acknowledgedListVersion == nodeData->getDomainListVersion()) {
+        baseListVersion = acknowledgedListVersion;
+
+        const DomainListEntries& sentEntries = nodeData->getDomainListEntries();
+        listedNodes.erase(std::remove_if(listedNodes.begin(), listedNodes.end(), [&](const SharedNodePointer& otherNode) {
+            auto sentEntry = sentEntries.find(otherNode->getUUID());
+            return sentEntry != sentEntries.end() && *sentEntry == entries[otherNode->getUUID()];
+        }), listedNodes.end());
+
+        for (auto it = sentEntries.begin(); it != sentEntries.end(); ++it) {
+            if (!entries.contains(it.key())) {
+                removedNodes.push_back(it.key());
+            }
+        }
+    }
+
+    quint32 numEntries = (quint32)(listedNodes.size() + removedNodes.size());
+    quint32 listVersion = nodeData->setDomainListEntries(std::move(entries));
+
+    const int NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES = NUM_BYTES_RFC4122_UUID + NUM_BYTES_RFC4122_UUID + 2
+        + 3 * sizeof(quint32);
 
     // setup the extended header for the domain list packets
     // this data is at the beginning of each of the domain list packets
     QByteArray extendedHeader(NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES, 0);
     QDataStream extendedHeaderStream(&extendedHeader, QIODevice::WriteOnly);
 
-    auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
-
     extendedHeaderStream << limitedNodeList->getSessionUUID();
     extendedHeaderStream << node->getUUID();
     extendedHeaderStream << node->getPermissions();
 
+    // the node knows it has all of this list when it has read numEntries entries with this version
+    extendedHeaderStream << listVersion << baseListVersion << numEntries;
+
     auto domainListPackets = NLPacketList::create(PacketType::DomainList, extendedHeader);
 
     // always send the node their own UUID back
     QDataStream domainListStream(domainListPackets.get());
 
-    DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+    for (auto& otherNode : listedNodes) {
+        // since we're about to add a node to the packet we start a segment
+        domainListPackets->startSegment();
 
-    // store the nodeInterestSet on this DomainServerNodeData, in case it has changed
-    auto& nodeInterestSet = nodeData->getNodeInterestSet();
+        domainListStream << DomainListEntryType::Node;
 
-    if (nodeInterestSet.size() > 0) {
+        // don't send avatar nodes to other avatars, that will come from avatar mixer
+        domainListStream << *otherNode.data();
 
-        // DTLSServerSession* dtlsSession = _isUsingDTLS ? _dtlsSessions[senderSockAddr] : NULL;
-        if (nodeData->isAuthenticated()) {
-            // if this authenticated node has any interest types, send back those nodes as well
-            limitedNodeList->eachNode([&](const SharedNodePointer& otherNode) {
-                if (otherNode->getUUID() != node->getUUID() && isInInterestSet(node, otherNode)) {
-                    // since we're about to add a node to the packet we start a segment
-                    domainListPackets->startSegment();
+        // pack the secret that these two nodes will use to communicate with each other
+        domainListStream << connectionSecretForNodes(node, otherNode);
 
-                    // don't send avatar nodes to other avatars, that will come from avatar mixer
-                    domainListStream << *otherNode.data();
-
-                    // pack the secret that these two nodes will use to communicate with each other
-                    domainListStream << connectionSecretForNodes(node, otherNode);
+        // we've added the node we wanted so end the segment now
+        domainListPackets->endSegment();
+    }
 
-                    // we've added the node we wanted so end the segment now
-                    domainListPackets->endSegment();
-                }
-            });
-        }
+    for (auto& removedNode : removedNodes) {
+        domainListPackets->startSegment();
+        domainListStream << DomainListEntryType::Removed << removedNode;
+        domainListPackets->endSegment();
     }
 
     // send an empty list to the node, in case there were no other nodes
@@ -76,3 +76,13 @@ void DomainServerNodeData::removeOverrideForKey(const QString& key, const QStrin
     // Remove override value
     _overrideHash.remove({key, value});
 }
+
+quint32 DomainServerNodeData::setDomainListEntries(DomainListEntries entries) {
+    _domainListEntries = std::move(entries);
+
+    // version 0 means "no list" to the node, skip it when we wrap
+    if (++_domainListVersion == 0) {
+        ++_domainListVersion;
+    }
+    return _domainListVersion;
+}
@@ -19,8 +19,28 @@
 #include <HifiSockAddr.h>
 #include <NLPacket.h>
 #include <NodeData.h>
+#include <NodePermissions.h>
 #include <NodeType.h>
 
+// what a node was last told about another node in its domain list
+struct DomainListEntry {
+    NodeType_t type;
+    HifiSockAddr publicSocket;
+    HifiSockAddr localSocket;
+    NodePermissions::Permissions permissions;
+    bool isReplicated;
+    QUuid connectionSecret;
+
+    bool operator==(const DomainListEntry& other) const {
+        return type == other.type && publicSocket == other.publicSocket && localSocket == other.localSocket
+            && permissions == other.permissions && isReplicated == other.isReplicated
+            && connectionSecret == other.connectionSecret;
+    }
+    bool operator!=(const DomainListEntry& other) const { return !(*this == other); }
+};
+
+using DomainListEntries = QHash<QUuid, DomainListEntry>;
+
 class DomainServerNodeData : public NodeData {
 public:
     DomainServerNodeData();
@@ -68,6 +88,11 @@ public:
 
     bool wasAssigned() const { return _wasAssigned; };
     void setWasAssigned(bool wasAssigned) { _wasAssigned = wasAssigned; }
+
+    // the last domain list sent to this node, which the next one can be sent as a delta against
+    quint32 getDomainListVersion() const { return _domainListVersion; }
+    const DomainListEntries& getDomainListEntries() const { return _domainListEntries; }
+    quint32 setDomainListEntries(DomainListEntries entries);
     
 private:
     QJsonObject overrideValuesIfNeeded(const QJsonObject& newStats);
@@ -93,6 +118,9 @@ private:
     QString _placeName;
 
     bool _wasAssigned { false };
+
+    quint32 _domainListVersion { 0 };
+    DomainListEntries _domainListEntries;
 };
 
 #endif // hifi_DomainServerNodeData_h
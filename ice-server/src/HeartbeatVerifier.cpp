@@ -0,0 +1,26 @@
+//
+//  HeartbeatVerifier.cpp
+//  ice-server/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "HeartbeatVerifier.h"
+
+#include <QtCore/QCryptographicHash>
+
+void HeartbeatVerifier::run() {
+    auto hashedPlaintext = QCryptographicHash::hash(_heartbeat.plaintext, QCryptographicHash::Sha256);
+    int verificationResult = RSA_verify(NID_sha256,
+                                        reinterpret_cast<const unsigned char*>(hashedPlaintext.constData()),
+                                        hashedPlaintext.size(),
+                                        reinterpret_cast<const unsigned char*>(_heartbeat.signature.constData()),
+                                        _heartbeat.signature.size(),
+                                        _publicKey.get());
+
+    // this is the only success case
+    emit finished(_heartbeat, verificationResult == 1);
+}
@@ -0,0 +1,55 @@
+//
+//  HeartbeatVerifier.h
+//  ice-server/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_HeartbeatVerifier_h
+#define hifi_HeartbeatVerifier_h
+
+#include <memory>
+
+#include <QtCore/QObject>
+#include <QtCore/QRunnable>
+#include <QtCore/QUuid>
+
+#include <openssl/rsa.h>
+
+#include <HifiSockAddr.h>
+
+// the parts of an ICEServerHeartbeat we need once its signature has been checked
+struct Heartbeat {
+    QUuid domainID;
+    HifiSockAddr publicSocket;
+    HifiSockAddr localSocket;
+    HifiSockAddr senderSockAddr;
+
+    // the signed part of the packet and its signature, kept to short-circuit repeats of this heartbeat
+    QByteArray plaintext;
+    QByteArray signature;
+};
+
+Q_DECLARE_METATYPE(Heartbeat)
+
+// Checks the signature of a heartbeat against the domain's public key on a worker thread.
+class HeartbeatVerifier : public QObject, public QRunnable {
+    Q_OBJECT
+public:
+    HeartbeatVerifier(const Heartbeat& heartbeat, std::shared_ptr<RSA> publicKey) :
+        _heartbeat(heartbeat), _publicKey(publicKey) {}
+
+    void run() override;
+
+signals:
+    void finished(Heartbeat heartbeat, bool verified);
+
+private:
+    Heartbeat _heartbeat;
+    std::shared_ptr<RSA> _publicKey;
+};
+
+#endif // hifi_HeartbeatVerifier_h
@@ -14,6 +14,7 @@
 #include <openssl/x509.h>
 
 #include <QtCore/QJsonDocument>
+#include <QtCore/QProcessEnvironment>
 #include <QtCore/QTimer>
 #include <QtNetwork/QNetworkReply>
 #include <QtNetwork/QNetworkRequest>
@@ -27,12 +28,27 @@
 const int CLEAR_INACTIVE_PEERS_INTERVAL_MSECS = 1 * 1000;
 const int PEER_SILENCE_THRESHOLD_MSECS = 5 * 1000;
 
+// lets a load test point the ice-server at a stand-in for the metaverse public key API
+const QString METAVERSE_URL_ENV = "HIFI_ICE_SERVER_METAVERSE_URL";
+
 IceServer::IceServer(int argc, char* argv[]) :
     QCoreApplication(argc, argv),
     _id(QUuid::createUuid()),
     _serverSocket(0, false),
-    _activePeers()
+    _activePeers(),
+    _metaverseURL(NetworkingConstants::METAVERSE_SERVER_URL)
 {
+    qRegisterMetaType<Heartbeat>();
+
+    auto metaverseURLOverride = QProcessEnvironment::systemEnvironment().value(METAVERSE_URL_ENV);
+    if (!metaverseURLOverride.isEmpty()) {
+        _metaverseURL = QUrl(metaverseURLOverride);
+        qDebug() << "Requesting domain public keys from" << _metaverseURL;
+    }
+
+    // signature verification is the bulk of the work for a heartbeat, it runs on a pool of its own
+    qDebug() << "ice-server will verify heartbeats on" << _verificationPool.maxThreadCount() << "threads";
+
     // start the ice-server socket
     qDebug() << "ice-server socket is listening on" << ICE_SERVER_DEFAULT_PORT;
     _serverSocket.bind(QHostAddress::AnyIPv4, ICE_SERVER_DEFAULT_PORT);
@@ -73,20 +89,7 @@ void IceServer::processPacket(std::unique_ptr<udt::Packet> packet) {
     if (nlPacket->getPayloadSize() >= NLPacket::localHeaderSize(PacketType::ICEServerHeartbeat)) {
         
         if (nlPacket->getType() == PacketType::ICEServerHeartbeat) {
-            SharedNetworkPeer peer = addOrUpdateHeartbeatingPeer(*nlPacket);
-            if (peer) {
-                // so that we can send packets to the heartbeating peer when we need, we need to activate a socket now
-                peer->activateMatchingOrNewSymmetricSocket(nlPacket->getSenderSockAddr());
-
-                // we have an active and verified heartbeating peer
-                // send them an ACK packet so they know that they are being heard and ready for ICE
-                static auto ackPacket = NLPacket::create(PacketType::ICEServerHeartbeatACK);
-                _serverSocket.writePacket(*ackPacket, nlPacket->getSenderSockAddr());
-            } else {
-                // we couldn't verify this peer - respond back to them so they know they may need to perform keypair re-generation
-                static auto deniedPacket = NLPacket::create(PacketType::ICEServerHeartbeatDenied);
-                _serverSocket.writePacket(*deniedPacket, nlPacket->getSenderSockAddr());
-            }
+            processHeartbeat(*nlPacket);
         } else if (nlPacket->getType() == PacketType::ICEServerQuery) {
             QDataStream heartbeatStream(nlPacket.get());
             
@@ -123,92 +126,104 @@ void IceServer::processPacket(std::unique_ptr<udt::Packet> packet) {
     }
 }
 
-SharedNetworkPeer IceServer::addOrUpdateHeartbeatingPeer(NLPacket& packet) {
+void IceServer::processHeartbeat(NLPacket& packet) {
+    Heartbeat heartbeat;
+    heartbeat.senderSockAddr = packet.getSenderSockAddr();
 
     // pull the UUID, public and private sock addrs for this peer
-    QUuid senderUUID;
-    HifiSockAddr publicSocket, localSocket;
-    QByteArray signature;
-
     QDataStream heartbeatStream(&packet);
-    heartbeatStream >> senderUUID >> publicSocket >> localSocket;
+    heartbeatStream >> heartbeat.domainID >> heartbeat.publicSocket >> heartbeat.localSocket;
+
+    // copy the signed plaintext, it may be verified on another thread
+    heartbeat.plaintext = QByteArray(packet.getPayload(), heartbeatStream.device()->pos());
+    heartbeatStream >> heartbeat.signature;
+
+    // an exact repeat of the last heartbeat we verified for this domain needs no further checks
+    auto verifiedHeartbeat = _verifiedHeartbeats.find(heartbeat.domainID);
+    if (verifiedHeartbeat != _verifiedHeartbeats.end()
+        && verifiedHeartbeat->second.plaintext == heartbeat.plaintext
+        && verifiedHeartbeat->second.signature == heartbeat.signature) {
+        acceptHeartbeat(heartbeat);
+        return;
+    }
 
-    auto signedPlaintext = QByteArray::fromRawData(packet.getPayload(), heartbeatStream.device()->pos());
-    heartbeatStream >> signature;
+    // make sure we're not already waiting for a public key for this domain-server
+    if (!_pendingPublicKeyRequests.contains(heartbeat.domainID)) {
+        // check if we have a public key for this domain ID - if we do not then fire off the request for it
+        auto it = _domainPublicKeys.find(heartbeat.domainID);
+        if (it != _domainPublicKeys.end()) {
+            // verify the signature for this heartbeat off of the socket thread
+            // we'll ACK or deny it in heartbeatVerificationFinished
+            auto verifier = new HeartbeatVerifier(heartbeat, it->second);
+            connect(verifier, &HeartbeatVerifier::finished, this, &IceServer::heartbeatVerificationFinished);
+            _verificationPool.start(verifier);
+            return;
+        }
 
-    // make sure this is a verified heartbeat before performing any more processing
-    if (isVerifiedHeartbeat(senderUUID, signedPlaintext, signature)) {
-        // make sure we have this sender in our peer hash
-        SharedNetworkPeer matchingPeer = _activePeers.value(senderUUID);
+        // we could not verify this heartbeat since we don't have a public key for the domain
+        // ask the metaverse API for the right public key and deny this heartbeat
+        requestDomainPublicKey(heartbeat.domainID);
+    }
 
-        if (!matchingPeer) {
-            // if we don't have this sender we need to create them now
-            matchingPeer = QSharedPointer<NetworkPeer>::create(senderUUID, publicSocket, localSocket);
-            _activePeers.insert(senderUUID, matchingPeer);
+    denyHeartbeat(heartbeat);
+}
 
-            qDebug() << "Added a new network peer" << *matchingPeer;
-        } else {
-            // we already had the peer so just potentially update their sockets
-            matchingPeer->setPublicSocket(publicSocket);
-            matchingPeer->setLocalSocket(localSocket);
+void IceServer::heartbeatVerificationFinished(Heartbeat heartbeat, bool verified) {
+    if (verified) {
+        _verifiedHeartbeats[heartbeat.domainID] = heartbeat;
+        acceptHeartbeat(heartbeat);
+    } else {
+        _verifiedHeartbeats.erase(heartbeat.domainID);
+
+        // the public key we have may be out of date (or this is a bad actor), so ask for it again
+        if (!_pendingPublicKeyRequests.contains(heartbeat.domainID)) {
+            qDebug() << "Failed to verify heartbeat for" << heartbeat.domainID << "- re-requesting public key from API.";
+            requestDomainPublicKey(heartbeat.domainID);
         }
 
-        // update our last heard microstamp for this network peer to now
-        matchingPeer->setLastHeardMicrostamp(usecTimestampNow());
-        
-        return matchingPeer;
-    } else {
-        // not verified, return the empty peer object
-        return SharedNetworkPeer();
+        denyHeartbeat(heartbeat);
     }
 }
 
-bool IceServer::isVerifiedHeartbeat(const QUuid& domainID, const QByteArray& plaintext, const QByteArray& signature) {
-    // make sure we're not already waiting for a public key for this domain-server
-    if (!_pendingPublicKeyRequests.contains(domainID)) {
-        // check if we have a public key for this domain ID - if we do not then fire off the request for it
-        auto it = _domainPublicKeys.find(domainID);
-        if (it != _domainPublicKeys.end()) {
+void IceServer::acceptHeartbeat(const Heartbeat& heartbeat) {
+    // make sure we have this sender in our peer hash
+    SharedNetworkPeer matchingPeer = _activePeers.value(heartbeat.domainID);
 
-            // attempt to verify the signature for this heartbeat
-            const auto rsaPublicKey = it->second.get();
-
-            if (rsaPublicKey) {
-                auto hashedPlaintext = QCryptographicHash::hash(plaintext, QCryptographicHash::Sha256);
-                int verificationResult = RSA_verify(NID_sha256,
-                                                    reinterpret_cast<const unsigned char*>(hashedPlaintext.constData()),
-                                                    hashedPlaintext.size(),
-                                                    reinterpret_cast<const unsigned char*>(signature.constData()),
-                                                    signature.size(),
-                                                    rsaPublicKey);
-
-                if (verificationResult == 1) {
-                    // this is the only success case - we return true here to indicate that the heartbeat is verified
-                    return true;
-                } else {
-                    qDebug() << "Failed to verify heartbeat for" << domainID << "- re-requesting public key from API.";
-                }
+    if (!matchingPeer) {
+        // if we don't have this sender we need to create them now
+        matchingPeer = QSharedPointer<NetworkPeer>::create(heartbeat.domainID, heartbeat.publicSocket, heartbeat.localSocket);
+        _activePeers.insert(heartbeat.domainID, matchingPeer);
 
-            } else {
-                // we can't let this user in since we couldn't convert their public key to an RSA key we could use
-                qWarning() << "Public key for" << domainID << "is not a usable RSA* public key.";
-                qWarning() << "Re-requesting public key from API";
-            }
-        }
-
-        // we could not verify this heartbeat (missing public key, could not load public key, bad actor)
-        // ask the metaverse API for the right public key and return false to indicate that this is not verified
-        requestDomainPublicKey(domainID);
+        qDebug() << "Added a new network peer" << *matchingPeer;
+    } else {
+        // we already had the peer so just potentially update their sockets
+        matchingPeer->setPublicSocket(heartbeat.publicSocket);
+        matchingPeer->setLocalSocket(heartbeat.localSocket);
     }
 
-    return false;
+    // update our last heard microstamp for this network peer to now
+    matchingPeer->setLastHeardMicrostamp(usecTimestampNow());
+
+    // so that we can send packets to the heartbeating peer when we need, we need to activate a socket now
+    matchingPeer->activateMatchingOrNewSymmetricSocket(heartbeat.senderSockAddr);
+
+    // we have an active and verified heartbeating peer
+    // send them an ACK packet so they know that they are being heard and ready for ICE
+    static auto ackPacket = NLPacket::create(PacketType::ICEServerHeartbeatACK);
+    _serverSocket.writePacket(*ackPacket, heartbeat.senderSockAddr);
+}
+
+void IceServer::denyHeartbeat(const Heartbeat& heartbeat) {
+    // we couldn't verify this peer - respond back to them so they know they may need to perform keypair re-generation
+    static auto deniedPacket = NLPacket::create(PacketType::ICEServerHeartbeatDenied);
+    _serverSocket.writePacket(*deniedPacket, heartbeat.senderSockAddr);
 }
 
 void IceServer::requestDomainPublicKey(const QUuid& domainID) {
     // send a request to the metaverse API for the public key for this domain
     auto& networkAccessManager = NetworkAccessManager::getInstance();
 
-    QUrl publicKeyURL { NetworkingConstants::METAVERSE_SERVER_URL };
+    QUrl publicKeyURL { _metaverseURL };
     QString publicKeyPath = QString("/api/v1/domains/%1/public_key").arg(uuidStringWithoutCurlyBraces(domainID));
     publicKeyURL.setPath(publicKeyPath);
 
@@ -253,7 +268,10 @@ void IceServer::publicKeyReplyFinished(QNetworkReply* reply) {
                 RSA* rsaPublicKey = d2i_RSA_PUBKEY(NULL, &publicKeyData, apiPublicKey.size());
 
                 if (rsaPublicKey) {
-                    _domainPublicKeys[domainID] = { rsaPublicKey, RSA_free };
+                    _domainPublicKeys[domainID] = std::shared_ptr<RSA>(rsaPublicKey, RSA_free);
+
+                    // anything verified with a previous key has to be verified again
+                    _verifiedHeartbeats.erase(domainID);
                 } else {
                     qWarning() << "Could not convert in-memory public key for" << domainID << "to usable RSA public key.";
                     qWarning() << "Public key will be re-requested on next heartbeat.";
@@ -300,6 +318,7 @@ void IceServer::clearInactivePeers() {
 
             // if we had a public key for this domain, remove it now
             _domainPublicKeys.erase(peer->getUUID());
+            _verifiedHeartbeats.erase(peer->getUUID());
 
             // remove the peer object
             peerItem = _activePeers.erase(peerItem);
@@ -14,6 +14,7 @@
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QSharedPointer>
+#include <QtCore/QThreadPool>
 #include <QUdpSocket>
 
 #include <openssl/rsa.h>
@@ -26,6 +27,8 @@
 #include <NLPacket.h>
 #include <udt/Socket.h>
 
+#include "HeartbeatVerifier.h"
+
 class QNetworkReply;
 
 class IceServer : public QCoreApplication {
@@ -35,14 +38,16 @@ public:
 private slots:
     void clearInactivePeers();
     void publicKeyReplyFinished(QNetworkReply* reply);
+    void heartbeatVerificationFinished(Heartbeat heartbeat, bool verified);
 private:
     bool packetVersionMatch(const udt::Packet& packet);
     void processPacket(std::unique_ptr<udt::Packet> packet);
     
-    SharedNetworkPeer addOrUpdateHeartbeatingPeer(NLPacket& incomingPacket);
+    void processHeartbeat(NLPacket& packet);
+    void acceptHeartbeat(const Heartbeat& heartbeat);
+    void denyHeartbeat(const Heartbeat& heartbeat);
     void sendPeerInformationPacket(const NetworkPeer& peer, const HifiSockAddr* destinationSockAddr);
 
-    bool isVerifiedHeartbeat(const QUuid& domainID, const QByteArray& plaintext, const QByteArray& signature);
     void requestDomainPublicKey(const QUuid& domainID);
 
     QUuid _id;
@@ -51,11 +56,18 @@ private:
     using NetworkPeerHash = QHash<QUuid, SharedNetworkPeer>;
     NetworkPeerHash _activePeers;
 
-    using RSAUniquePtr = std::unique_ptr<RSA, std::function<void(RSA*)>>;
-    using DomainPublicKeyHash = std::unordered_map<QUuid, RSAUniquePtr>;
+    // shared with verifications in flight, which may outlive a re-requested key
+    using DomainPublicKeyHash = std::unordered_map<QUuid, std::shared_ptr<RSA>>;
     DomainPublicKeyHash _domainPublicKeys;
 
     QSet<QUuid> _pendingPublicKeyRequests;
+
+    // the last verified heartbeat from each domain - domain-servers re-send the same signed heartbeat
+    // until their sockets change, so an exact repeat doesn't need its signature checked again
+    std::unordered_map<QUuid, Heartbeat> _verifiedHeartbeats;
+
+    QThreadPool _verificationPool;
+    QUrl _metaverseURL;
 };
 
 #endif // hifi_IceServer_h
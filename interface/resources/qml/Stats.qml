@@ -355,6 +355,12 @@ Item {
                             " Internal: " + root.localInternal +
                             " Leaves: " + root.localLeaves;
                     }
+                    StatText {
+                        visible: root.expanded
+                        text: "Entity Renderables Updated: " + root.entityRenderablesUpdated +
+                            " Deferred: " + root.entityRenderablesDeferred +
+                            " Time: " + root.entityRenderableUpdateTime.toFixed(2) + " ms";
+                    }
                     StatText {
                         visible: root.expanded
                         text: "LOD: " + root.lodStatus;
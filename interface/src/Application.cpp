@@ -325,6 +325,14 @@ static const QString DESKTOP_LOCATION = QStandardPaths::writableLocation(QStanda
 
 Setting::Handle<int> maxOctreePacketsPerSecond("maxOctreePPS", DEFAULT_MAX_OCTREE_PPS);
 
+// how long rapid edits to one entity are merged before they are sent, 0 sends every edit as it is made
+Setting::Handle<int> entityEditCoalesceMsecs("entityEditCoalesceMsecs",
+    (int)(EntityEditPacketSender::DEFAULT_EDIT_COALESCE_INTERVAL / USECS_PER_MSEC));
+
+// how long each frame may spend updating changed entity renderables, 0 updates them all in the frame they change
+Setting::Handle<int> entityRenderableUpdateBudgetUsecs("entityRenderableUpdateBudgetUsecs",
+    (int)EntityTreeRenderer::DEFAULT_RENDERABLE_UPDATE_BUDGET);
+
 static const QString MARKETPLACE_CDN_HOSTNAME = "mpassets.highfidelity.com";
 static const int INTERVAL_TO_CHECK_HMD_WORN_STATUS = 500; // milliseconds
 static const QString DESKTOP_DISPLAY_PLUGIN_NAME = "Desktop";
@@ -1003,6 +1011,12 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer, bo
     }
     ResourceCache::setRequestLimit(concurrentDownloads);
 
+    QString concurrentDecodesStr = getCmdOption(argc, constArgv, "--concurrent-decodes");
+    int concurrentDecodes = concurrentDecodesStr.toInt(&success);
+    if (success) {
+        ResourceCache::setDecodeLimit(concurrentDecodes);
+    }
+
     // perhaps override the avatar url.  Since we will test later for validity
     // we don't need to do so here.
     QString avatarURL = getCmdOption(argc, constArgv, "--avatarURL");
@@ -1162,6 +1176,21 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer, bo
     // allow you to move an entity around in your hand
     _entityEditSender.setPacketsPerSecond(3000); // super high!!
 
+    // the command line wins over the setting, for trying out a rate without changing it for good
+    QString editCoalesceMsecsStr = getCmdOption(argc, constArgv, "--entity-edit-coalesce-msecs");
+    int editCoalesceMsecs = editCoalesceMsecsStr.toInt(&success);
+    if (!success || editCoalesceMsecs < 0) {
+        editCoalesceMsecs = std::max(entityEditCoalesceMsecs.get(), 0);
+    }
+    _entityEditSender.setEditCoalesceInterval((quint64)editCoalesceMsecs * USECS_PER_MSEC);
+
+    QString renderableUpdateBudgetStr = getCmdOption(argc, constArgv, "--entity-renderable-update-budget-usecs");
+    int renderableUpdateBudget = renderableUpdateBudgetStr.toInt(&success);
+    if (!success || renderableUpdateBudget < 0) {
+        renderableUpdateBudget = std::max(entityRenderableUpdateBudgetUsecs.get(), 0);
+    }
+    getEntities()->setRenderableUpdateBudget((quint64)renderableUpdateBudget);
+
     _overlays.init(); // do this before scripts load
     // Make sure we don't time out during slow operations at startup
     updateHeartbeat();
@@ -2001,6 +2030,7 @@ void Application::cleanupBeforeQuit() {
 
     // Clear any queued processing (I/O, FBX/OBJ/Texture parsing)
     QThreadPool::globalInstance()->clear();
+    ResourceCache::clearPendingDecodes();
 
     DependencyManager::get<ScriptEngines>()->shutdownScripting(); // stop all currently running global scripts
     DependencyManager::destroy<ScriptEngines>();
@@ -4469,7 +4499,19 @@ void Application::init() {
         }
 
         auto distance = glm::distance(getMyAvatar()->getPosition(), item.getPosition());
-        return atan2(maxSize, distance);
+        float priority = atan2(maxSize, distance);
+
+        // anything outside the keyhole loads after everything that is inside it, but still before low priority
+        // resources like sounds
+        bool inView;
+        {
+            QMutexLocker viewLocker(&_viewMutex);
+            inView = _viewFrustum.sphereIntersectsKeyhole(item.getPosition(), 0.5f * maxSize);
+        }
+        if (!inView) {
+            priority -= PI_OVER_TWO;
+        }
+        return priority;
     });
 
     ObjectMotionState::setShapeManager(&_shapeManager);
@@ -60,7 +60,7 @@ AvatarManager::AvatarManager(QObject* parent) :
 
     auto nodeList = DependencyManager::get<NodeList>();
     auto& packetReceiver = nodeList->getPacketReceiver();
-    packetReceiver.registerListener(PacketType::BulkAvatarData, this, "processAvatarDataPacket");
+    packetReceiver.registerListener(PacketType::BulkAvatarData, this, &AvatarManager::processAvatarDataPacket);
     packetReceiver.registerListener(PacketType::KillAvatar, this, "processKillAvatar");
     packetReceiver.registerListener(PacketType::AvatarIdentity, this, "processAvatarIdentityPacket");
 
@@ -198,6 +198,17 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
         avatar->animateScaleChanges(deltaTime);
 
         const float OUT_OF_VIEW_THRESHOLD = 0.5f * AvatarData::OUT_OF_VIEW_PENALTY;
+
+        // while the avatar model is downloading, order it with the entity models by how large it appears
+        auto skeletonModel = avatar->getSkeletonModel();
+        if (skeletonModel && !skeletonModel->isLoaded()) {
+            float distance = glm::distance(cameraView.getPosition(), avatar->getPosition());
+            float loadingPriority = atan2f(2.0f * avatar->getBoundingRadius(), distance);
+            if (sortData.priority <= OUT_OF_VIEW_THRESHOLD) {
+                loadingPriority -= PI_OVER_TWO;
+            }
+            skeletonModel->setLoadingPriority(loadingPriority);
+        }
         uint64_t now = usecTimestampNow();
         if (now < updateExpiry) {
             // we're within budget
@@ -19,8 +19,10 @@
 OctreePacketProcessor::OctreePacketProcessor() {
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
     
-    packetReceiver.registerDirectListenerForTypes({ PacketType::OctreeStats, PacketType::EntityData, PacketType::EntityErase },
-                                                  this, "handleOctreePacket");
+    PacketReceiver::DispatchOptions options;
+    options.onReceiveThread = true;
+    packetReceiver.registerListenerForTypes({ PacketType::OctreeStats, PacketType::EntityData, PacketType::EntityErase },
+                                            this, &OctreePacketProcessor::handleOctreePacket, options);
 }
 
 void OctreePacketProcessor::handleOctreePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
@@ -56,7 +58,7 @@ void OctreePacketProcessor::processPacket(QSharedPointer<ReceivedMessage> messag
             memcpy(buffer.get(), message->getRawMessage() + statsMessageLength, piggybackBytes);
             
             auto newPacket = NLPacket::fromReceivedPacket(std::move(buffer), piggybackBytes, message->getSenderSockAddr());
-            message = QSharedPointer<ReceivedMessage>::create(*newPacket);
+            message = QSharedPointer<ReceivedMessage>::create(std::move(newPacket));
         } else {
             // Note... stats packets don't have sequence numbers, so we don't want to send those to trackIncomingVoxelPacket()
             return; // bail since no piggyback data
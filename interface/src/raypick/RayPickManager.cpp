@@ -10,6 +10,8 @@
 //
 #include "RayPickManager.h"
 
+#include <QtConcurrent/QtConcurrentRun>
+
 #include "Application.h"
 #include "EntityScriptingInterface.h"
 #include "ui/overlays/Overlays.h"
@@ -44,6 +46,9 @@ void RayPickManager::cacheResult(const bool intersects, const RayPickResult& res
 
 void RayPickManager::update() {
     RayPickCache results;
+
+    // gather this frame's picks, so that entities and overlays can be intersected as one batch each
+    QVector<std::pair<QUuid, PickRay>> picks;
     for (auto& uid : _rayPicks.keys()) {
         std::shared_ptr<RayPick> rayPick = _rayPicks[uid];
         if (!rayPick->isEnabled() || rayPick->getFilter().doesPickNothing() || rayPick->getMaxDistance() < 0.0f) {
@@ -56,45 +61,100 @@ void RayPickManager::update() {
         if (!valid) {
             continue;
         }
+        picks.push_back(std::pair<QUuid, PickRay>(uid, ray));
+    }
 
+    // picks that share a ray and a filter share a query, exactly like the per ray cache used to
+    std::vector<EntityRayQuery> entityQueries;
+    QVector<std::pair<QPair<glm::vec3, glm::vec3>, RayPickFilter::Flags>> entityKeys;
+    QVector<OverlayRayQuery> overlayQueries;
+    QVector<std::pair<QPair<glm::vec3, glm::vec3>, RayPickFilter::Flags>> overlayKeys;
+    for (auto& pick : picks) {
+        std::shared_ptr<RayPick> rayPick = _rayPicks[pick.first];
+        const PickRay& ray = pick.second;
         QPair<glm::vec3, glm::vec3> rayKey = QPair<glm::vec3, glm::vec3>(ray.origin, ray.direction);
-        RayPickResult res;
+        bool invisible = rayPick->getFilter().doesPickInvisible();
+        bool nonCollidable = rayPick->getFilter().doesPickNonCollidable();
 
         if (rayPick->getFilter().doesPickEntities()) {
-            RayToEntityIntersectionResult entityRes;
-            bool fromCache = true;
-            bool invisible = rayPick->getFilter().doesPickInvisible();
-            bool nonCollidable = rayPick->getFilter().doesPickNonCollidable();
             RayPickFilter::Flags entityMask = rayPick->getFilter().getEntityFlags();
-            if (!checkAndCompareCachedResults(rayKey, results, res, entityMask)) {
-                entityRes = DependencyManager::get<EntityScriptingInterface>()->findRayIntersectionVector(ray, !rayPick->getFilter().doesPickCourse(),
-                    rayPick->getIncludeEntites(), rayPick->getIgnoreEntites(), !invisible, !nonCollidable);
-                fromCache = false;
-            }
-
-            if (!fromCache) {
-                cacheResult(entityRes.intersects, RayPickResult(IntersectionType::ENTITY, entityRes.entityID, entityRes.distance, entityRes.intersection, entityRes.surfaceNormal),
-                    entityMask, res, rayKey, results);
+            if (!results.contains(rayKey) || results[rayKey].find(entityMask) == results[rayKey].end()) {
+                results[rayKey][entityMask] = RayPickResult();
+                EntityRayQuery query;
+                query.origin = ray.origin;
+                query.direction = ray.direction;
+                query.entityIdsToInclude = rayPick->getIncludeEntites();
+                query.entityIdsToDiscard = rayPick->getIgnoreEntites();
+                query.visibleOnly = !invisible;
+                query.collidableOnly = !nonCollidable;
+                query.precisionPicking = !rayPick->getFilter().doesPickCourse();
+                entityQueries.push_back(query);
+                entityKeys.push_back({ rayKey, entityMask });
             }
         }
 
         if (rayPick->getFilter().doesPickOverlays()) {
-            RayToOverlayIntersectionResult overlayRes;
-            bool fromCache = true;
-            bool invisible = rayPick->getFilter().doesPickInvisible();
-            bool nonCollidable = rayPick->getFilter().doesPickNonCollidable();
             RayPickFilter::Flags overlayMask = rayPick->getFilter().getOverlayFlags();
-            if (!checkAndCompareCachedResults(rayKey, results, res, overlayMask)) {
-                overlayRes = qApp->getOverlays().findRayIntersectionVector(ray, !rayPick->getFilter().doesPickCourse(),
-                    rayPick->getIncludeOverlays(), rayPick->getIgnoreOverlays(), !invisible, !nonCollidable);
-                fromCache = false;
+            if (!results.contains(rayKey) || results[rayKey].find(overlayMask) == results[rayKey].end()) {
+                results[rayKey][overlayMask] = RayPickResult();
+                overlayQueries.push_back({ ray, rayPick->getIncludeOverlays(), rayPick->getIgnoreOverlays() });
+                overlayKeys.push_back({ rayKey, overlayMask });
             }
+        }
+    }
 
-            if (!fromCache) {
-                cacheResult(overlayRes.intersects, RayPickResult(IntersectionType::OVERLAY, overlayRes.overlayID, overlayRes.distance, overlayRes.intersection, overlayRes.surfaceNormal),
-                    overlayMask, res, rayKey, results);
+    // the entity tree has its own lock, so the entity batch can optionally run while we do the overlays here
+    QVector<RayToEntityIntersectionResult> entityResults;
+    QFuture<void> entityFuture;
+    bool entitiesOnWorker = _useWorkerThread.get() && !entityQueries.empty();
+    if (!entityQueries.empty()) {
+        auto entityScriptingInterface = DependencyManager::get<EntityScriptingInterface>();
+        if (entitiesOnWorker) {
+            entityFuture = QtConcurrent::run([&entityResults, &entityQueries, entityScriptingInterface] {
+                entityResults = entityScriptingInterface->findRayIntersections(entityQueries);
+            });
+        } else {
+            entityResults = entityScriptingInterface->findRayIntersections(entityQueries);
+        }
+    }
+
+    if (!overlayQueries.empty()) {
+        QVector<RayToOverlayIntersectionResult> overlayResults = qApp->getOverlays().findRayIntersections(overlayQueries);
+        for (int i = 0; i < overlayResults.size(); i++) {
+            const RayToOverlayIntersectionResult& overlayRes = overlayResults[i];
+            if (overlayRes.intersects) {
+                results[overlayKeys[i].first][overlayKeys[i].second] = RayPickResult(IntersectionType::OVERLAY, overlayRes.overlayID,
+                    overlayRes.distance, overlayRes.intersection, overlayRes.surfaceNormal);
             }
         }
+    }
+
+    if (entitiesOnWorker) {
+        entityFuture.waitForFinished();
+    }
+    for (int i = 0; i < entityResults.size(); i++) {
+        const RayToEntityIntersectionResult& entityRes = entityResults[i];
+        if (entityRes.intersects) {
+            results[entityKeys[i].first][entityKeys[i].second] = RayPickResult(IntersectionType::ENTITY, entityRes.entityID,
+                entityRes.distance, entityRes.intersection, entityRes.surfaceNormal);
+        }
+    }
+
+    for (auto& pick : picks) {
+        const QUuid& uid = pick.first;
+        std::shared_ptr<RayPick> rayPick = _rayPicks[uid];
+        const PickRay& ray = pick.second;
+
+        QPair<glm::vec3, glm::vec3> rayKey = QPair<glm::vec3, glm::vec3>(ray.origin, ray.direction);
+        RayPickResult res;
+
+        if (rayPick->getFilter().doesPickEntities()) {
+            checkAndCompareCachedResults(rayKey, results, res, rayPick->getFilter().getEntityFlags());
+        }
+
+        if (rayPick->getFilter().doesPickOverlays()) {
+            checkAndCompareCachedResults(rayKey, results, res, rayPick->getFilter().getOverlayFlags());
+        }
 
         if (rayPick->getFilter().doesPickAvatars()) {
             RayPickFilter::Flags avatarMask = rayPick->getFilter().getAvatarFlags();
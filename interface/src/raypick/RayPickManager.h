@@ -18,6 +18,7 @@
 #include <QReadWriteLock>
 
 #include "RegisteredMetaTypes.h"
+#include <SettingHandle.h>
 
 #include <unordered_map>
 #include <queue>
@@ -55,6 +56,9 @@ private:
     std::queue<QUuid> _rayPicksToRemove;
     QReadWriteLock _containsLock;
 
+    // when set, the entity batch is intersected on a worker thread while overlays are picked on this one
+    Setting::Handle<bool> _useWorkerThread { "raypick/useWorkerThread", false };
+
     typedef QHash<QPair<glm::vec3, glm::vec3>, std::unordered_map<RayPickFilter::Flags, RayPickResult>> RayPickCache;
 
     // Returns true if this ray exists in the cache, and if it does, update res if the cached result is closer
@@ -321,6 +321,8 @@ void OctreeStatsDialog::paintEvent(QPaintEvent* event) {
     auto outboundPacketsDepth = entitiesEditPacketSender->packetsToSendCount();
     auto outboundQueuedPPS = entitiesEditPacketSender->getLifetimePPSQueued();
     auto outboundSentPPS = entitiesEditPacketSender->getLifetimePPS();
+    auto outboundEditsMerged = entitiesEditPacketSender->getEditsMerged();
+    auto outboundEditBytesSaved = entitiesEditPacketSender->getEditBytesSaved();
 
     QString outboundQueuedPPSString = locale.toString(outboundQueuedPPS, 'f', FLOATING_POINT_PRECISION);
     QString outboundSentPPSString = locale.toString(outboundSentPPS, 'f', FLOATING_POINT_PRECISION);
@@ -330,7 +332,8 @@ void OctreeStatsDialog::paintEvent(QPaintEvent* event) {
     statsValue <<
         "Queue Size: " << outboundPacketsDepth << " packets / " <<
         "Queued IN: " << qPrintable(outboundQueuedPPSString) << " PPS / " <<
-        "Sent OUT: " << qPrintable(outboundSentPPSString) << " PPS";
+        "Sent OUT: " << qPrintable(outboundSentPPSString) << " PPS / " <<
+        "Merged: " << outboundEditsMerged << " edits, " << outboundEditBytesSaved << " bytes saved";
 
     label->setText(statsValue.str().c_str());
 
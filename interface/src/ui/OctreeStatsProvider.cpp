@@ -203,11 +203,15 @@ void OctreeStatsProvider::updateOctreeStatsData() {
     auto outboundPacketsDepth = entitiesEditPacketSender->packetsToSendCount();
     auto outboundQueuedPPS = entitiesEditPacketSender->getLifetimePPSQueued();
     auto outboundSentPPS = entitiesEditPacketSender->getLifetimePPS();
+    auto outboundEditsMerged = entitiesEditPacketSender->getEditsMerged();
+    auto outboundEditBytesSaved = entitiesEditPacketSender->getEditBytesSaved();
 
-    m_outboundEditPackets = QString("Queue Size: %1 packets / Queued IN: %2 PPS / Sent OUT: %3 PPS")
+    m_outboundEditPackets = QString("Queue Size: %1 packets / Queued IN: %2 PPS / Sent OUT: %3 PPS / Merged: %4 edits, %5 bytes saved")
             .arg(outboundPacketsDepth)
             .arg(outboundQueuedPPS, 5, 'f', FLOATING_POINT_PRECISION)
-            .arg(outboundSentPPS, 5, 'f', FLOATING_POINT_PRECISION);
+            .arg(outboundSentPPS, 5, 'f', FLOATING_POINT_PRECISION)
+            .arg(outboundEditsMerged)
+            .arg(outboundEditBytesSaved);
     emit outboundEditPacketsChanged(m_outboundEditPackets);
     
     // Entity Edits update time
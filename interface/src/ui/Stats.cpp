@@ -399,6 +399,11 @@ void Stats::updateStats(bool force) {
         // Local Voxels
         STAT_UPDATE(localInternal, (int)OctreeElement::getInternalNodeCount());
         STAT_UPDATE(localLeaves, (int)OctreeElement::getLeafNodeCount());
+        // Entity renderables changed this frame, and those left for later frames by the update budget
+        auto entities = qApp->getEntities();
+        STAT_UPDATE(entityRenderableUpdateTime, (float)entities->getLastRenderableUpdateTime() / (float)USECS_PER_MSEC);
+        STAT_UPDATE(entityRenderablesUpdated, entities->getNumRenderablesUpdated());
+        STAT_UPDATE(entityRenderablesDeferred, entities->getNumRenderablesDeferred());
         // LOD Details
         STAT_UPDATE(lodStatus, "You can see " + DependencyManager::get<LODManager>()->getLODFeedbackText());
     }
@@ -113,6 +113,9 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(int, localElements, 0)
     STATS_PROPERTY(int, localInternal, 0)
     STATS_PROPERTY(int, localLeaves, 0)
+    STATS_PROPERTY(float, entityRenderableUpdateTime, 0)
+    STATS_PROPERTY(int, entityRenderablesUpdated, 0)
+    STATS_PROPERTY(int, entityRenderablesDeferred, 0)
     STATS_PROPERTY(int, rectifiedTextureCount, 0)
     STATS_PROPERTY(int, decimatedTextureCount, 0)
     STATS_PROPERTY(int, gpuBuffers, 0)
@@ -553,47 +553,58 @@ RayToOverlayIntersectionResult Overlays::findRayIntersectionVector(const PickRay
                                                                    const QVector<OverlayID>& overlaysToInclude,
                                                                    const QVector<OverlayID>& overlaysToDiscard,
                                                                    bool visibleOnly, bool collidableOnly) {
-    float bestDistance = std::numeric_limits<float>::max();
-    bool bestIsFront = false;
+    QVector<OverlayRayQuery> queries = { { ray, overlaysToInclude, overlaysToDiscard } };
+    return findRayIntersections(queries).front();
+}
+
+QVector<RayToOverlayIntersectionResult> Overlays::findRayIntersections(const QVector<OverlayRayQuery>& queries) {
+    QVector<RayToOverlayIntersectionResult> results(queries.size());
+    QVector<float> bestDistances(queries.size(), std::numeric_limits<float>::max());
+    QVector<bool> bestIsFront(queries.size(), false);
 
     QMutexLocker locker(&_mutex);
-    RayToOverlayIntersectionResult result;
     QMapIterator<OverlayID, Overlay::Pointer> i(_overlaysWorld);
     while (i.hasNext()) {
         i.next();
         OverlayID thisID = i.key();
         auto thisOverlay = std::dynamic_pointer_cast<Base3DOverlay>(i.value());
 
-        if ((overlaysToDiscard.size() > 0 && overlaysToDiscard.contains(thisID)) ||
-            (overlaysToInclude.size() > 0 && !overlaysToInclude.contains(thisID))) {
+        if (!thisOverlay || !thisOverlay->getVisible() || thisOverlay->getIgnoreRayIntersection() || !thisOverlay->isLoaded()) {
             continue;
         }
 
-        if (thisOverlay && thisOverlay->getVisible() && !thisOverlay->getIgnoreRayIntersection() && thisOverlay->isLoaded()) {
+        bool isDrawInFront = thisOverlay->getDrawInFront();
+        for (int q = 0; q < queries.size(); q++) {
+            const OverlayRayQuery& query = queries[q];
+            if ((query.overlaysToDiscard.size() > 0 && query.overlaysToDiscard.contains(thisID)) ||
+                (query.overlaysToInclude.size() > 0 && !query.overlaysToInclude.contains(thisID))) {
+                continue;
+            }
+
             float thisDistance;
             BoxFace thisFace;
             glm::vec3 thisSurfaceNormal;
             QString thisExtraInfo;
-            if (thisOverlay->findRayIntersectionExtraInfo(ray.origin, ray.direction, thisDistance,
+            if (thisOverlay->findRayIntersectionExtraInfo(query.ray.origin, query.ray.direction, thisDistance,
                                                           thisFace, thisSurfaceNormal, thisExtraInfo)) {
-                bool isDrawInFront = thisOverlay->getDrawInFront();
-                if ((bestIsFront && isDrawInFront && thisDistance < bestDistance)
-                    || (!bestIsFront && (isDrawInFront || thisDistance < bestDistance))) {
+                if ((bestIsFront[q] && isDrawInFront && thisDistance < bestDistances[q])
+                    || (!bestIsFront[q] && (isDrawInFront || thisDistance < bestDistances[q]))) {
 
-                    bestIsFront = isDrawInFront;
-                    bestDistance = thisDistance;
+                    bestIsFront[q] = isDrawInFront;
+                    bestDistances[q] = thisDistance;
+                    RayToOverlayIntersectionResult& result = results[q];
                     result.intersects = true;
                     result.distance = thisDistance;
                     result.face = thisFace;
                     result.surfaceNormal = thisSurfaceNormal;
                     result.overlayID = thisID;
-                    result.intersection = ray.origin + (ray.direction * thisDistance);
+                    result.intersection = query.ray.origin + (query.ray.direction * thisDistance);
                     result.extraInfo = thisExtraInfo;
                 }
             }
         }
     }
-    return result;
+    return results;
 }
 
 QScriptValue RayToOverlayIntersectionResultToScriptValue(QScriptEngine* engine, const RayToOverlayIntersectionResult& value) {
@@ -23,14 +23,13 @@
 #include <QScriptValue>
 
 #include <PointerEvent.h>
+#include <RegisteredMetaTypes.h>
 
 #include "Overlay.h"
 
 #include "PanelAttachable.h"
 #include "OverlayPanel.h"
 
-class PickRay;
-
 class OverlayPropertyResult {
 public:
     OverlayPropertyResult();
@@ -69,6 +68,14 @@ Q_DECLARE_METATYPE(RayToOverlayIntersectionResult);
 QScriptValue RayToOverlayIntersectionResultToScriptValue(QScriptEngine* engine, const RayToOverlayIntersectionResult& value);
 void RayToOverlayIntersectionResultFromScriptValue(const QScriptValue& object, RayToOverlayIntersectionResult& value);
 
+// one ray of a batch handed to Overlays::findRayIntersections()
+class OverlayRayQuery {
+public:
+    PickRay ray;
+    QVector<OverlayID> overlaysToInclude;
+    QVector<OverlayID> overlaysToDiscard;
+};
+
 /**jsdoc
  * @typedef {int} Overlays.OverlayID
  */
@@ -112,6 +119,10 @@ public:
 
     void cleanupAllOverlays();
 
+    // Same as findRayIntersectionVector for a batch of rays, visiting each overlay once. Returns one result per query,
+    // in the same order. Not a slot, OverlayRayQuery isn't a script type.
+    QVector<RayToOverlayIntersectionResult> findRayIntersections(const QVector<OverlayRayQuery>& queries);
+
 public slots:
     /**jsdoc
      * Add an overlays to the scene. The properties specified will depend
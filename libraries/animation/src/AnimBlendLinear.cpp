@@ -25,15 +25,20 @@ AnimBlendLinear::~AnimBlendLinear() {
 }
 
 const AnimPoseVec& AnimBlendLinear::evaluate(const AnimVariantMap& animVars, const AnimContext& context, float dt, Triggers& triggersOut) {
+    evaluateSoA(animVars, context, dt, triggersOut).store(_poses);
+    return _poses;
+}
+
+const AnimPoseSoA& AnimBlendLinear::evaluateSoA(const AnimVariantMap& animVars, const AnimContext& context, float dt, Triggers& triggersOut) {
 
     _alpha = animVars.lookup(_alphaVar, _alpha);
 
     if (_children.size() == 0) {
-        for (auto&& pose : _poses) {
-            pose = AnimPose::identity;
+        for (size_t i = 0; i < _soaPoses.size(); i++) {
+            _soaPoses.set(i, AnimPose::identity);
         }
     } else if (_children.size() == 1) {
-        _poses = _children[0]->evaluate(animVars, context, dt, triggersOut);
+        _soaPoses = _children[0]->evaluateSoA(animVars, context, dt, triggersOut);
     } else {
 
         float clampedAlpha = glm::clamp(_alpha, 0.0f, (float)(_children.size() - 1));
@@ -43,11 +48,12 @@ const AnimPoseVec& AnimBlendLinear::evaluate(const AnimVariantMap& animVars, con
 
         evaluateAndBlendChildren(animVars, context, triggersOut, alpha, prevPoseIndex, nextPoseIndex, dt);
     }
-    return _poses;
+    return _soaPoses;
 }
 
 // for AnimDebugDraw rendering
 const AnimPoseVec& AnimBlendLinear::getPosesInternal() const {
+    _soaPoses.store(_poses);
     return _poses;
 }
 
@@ -55,16 +61,14 @@ void AnimBlendLinear::evaluateAndBlendChildren(const AnimVariantMap& animVars, c
                                                size_t prevPoseIndex, size_t nextPoseIndex, float dt) {
     if (prevPoseIndex == nextPoseIndex) {
         // this can happen if alpha is on an integer boundary
-        _poses = _children[prevPoseIndex]->evaluate(animVars, context, dt, triggersOut);
+        _soaPoses = _children[prevPoseIndex]->evaluateSoA(animVars, context, dt, triggersOut);
     } else {
         // need to eval and blend between two children.
-        auto prevPoses = _children[prevPoseIndex]->evaluate(animVars, context, dt, triggersOut);
-        auto nextPoses = _children[nextPoseIndex]->evaluate(animVars, context, dt, triggersOut);
+        const AnimPoseSoA& prevPoses = _children[prevPoseIndex]->evaluateSoA(animVars, context, dt, triggersOut);
+        const AnimPoseSoA& nextPoses = _children[nextPoseIndex]->evaluateSoA(animVars, context, dt, triggersOut);
 
         if (prevPoses.size() > 0 && prevPoses.size() == nextPoses.size()) {
-            _poses.resize(prevPoses.size());
-
-            ::blend(_poses.size(), &prevPoses[0], &nextPoses[0], alpha, &_poses[0]);
+            ::blend(prevPoses, nextPoses, alpha, _soaPoses);
         }
     }
 }
@@ -31,6 +31,11 @@ public:
     virtual ~AnimBlendLinear() override;
 
     virtual const AnimPoseVec& evaluate(const AnimVariantMap& animVars, const AnimContext& context, float dt, Triggers& triggersOut) override;
+    virtual const AnimPoseSoA& evaluateSoA(const AnimVariantMap& animVars, const AnimContext& context, float dt, Triggers& triggersOut) override;
+    virtual const AnimPoseSoA& overlaySoA(const AnimVariantMap& animVars, const AnimContext& context, float dt, Triggers& triggersOut,
+                                          const AnimPoseSoA& underPoses) override {
+        return evaluateSoA(animVars, context, dt, triggersOut);
+    }
 
     void setAlphaVar(const QString& alphaVar) { _alphaVar = alphaVar; }
 
@@ -41,7 +46,7 @@ protected:
     void evaluateAndBlendChildren(const AnimVariantMap& animVars, const AnimContext& context, Triggers& triggersOut, float alpha,
                                   size_t prevPoseIndex, size_t nextPoseIndex, float dt);
 
-    AnimPoseVec _poses;
+    mutable AnimPoseVec _poses;
 
     float _alpha;
 
@@ -32,6 +32,11 @@ AnimClip::~AnimClip() {
 }
 
 const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, const AnimContext& context, float dt, Triggers& triggersOut) {
+    evaluateSoA(animVars, context, dt, triggersOut).store(_poses);
+    return _poses;
+}
+
+const AnimPoseSoA& AnimClip::evaluateSoA(const AnimVariantMap& animVars, const AnimContext& context, float dt, Triggers& triggersOut) {
 
     // lookup parameters from animVars, using current instance variables as defaults.
     _startFrame = animVars.lookup(_startFrameVar, _startFrame);
@@ -71,14 +76,14 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, const Anim
         prevIndex = std::min(std::max(0, prevIndex), frameCount - 1);
         nextIndex = std::min(std::max(0, nextIndex), frameCount - 1);
 
-        const AnimPoseVec& prevFrame = _mirrorFlag ? _mirrorAnim[prevIndex] : _anim[prevIndex];
-        const AnimPoseVec& nextFrame = _mirrorFlag ? _mirrorAnim[nextIndex] : _anim[nextIndex];
+        const AnimPoseSoA& prevFrame = _mirrorFlag ? _mirrorAnim[prevIndex] : _anim[prevIndex];
+        const AnimPoseSoA& nextFrame = _mirrorFlag ? _mirrorAnim[nextIndex] : _anim[nextIndex];
         float alpha = glm::fract(_frame);
 
-        ::blend(_poses.size(), &prevFrame[0], &nextFrame[0], alpha, &_poses[0]);
+        ::blend(prevFrame, nextFrame, alpha, _soaPoses);
     }
 
-    return _poses;
+    return _soaPoses;
 }
 
 void AnimClip::loadURL(const QString& url) {
@@ -123,10 +128,7 @@ void AnimClip::copyFromNetworkAnim() {
 
         // init all joints in animation to default pose
         // this will give us a resonable result for bones in the model skeleton but not in the animation.
-        _anim[frame].reserve(skeletonJointCount);
-        for (int skeletonJoint = 0; skeletonJoint < skeletonJointCount; skeletonJoint++) {
-            _anim[frame].push_back(_skeleton->getRelativeDefaultPose(skeletonJoint));
-        }
+        _anim[frame].load(_skeleton->getRelativeDefaultPoses());
 
         for (int animJoint = 0; animJoint < animJointCount; animJoint++) {
             int skeletonJoint = jointMap[animJoint];
@@ -165,7 +167,7 @@ void AnimClip::copyFromNetworkAnim() {
 
                 AnimPose trans = AnimPose(glm::vec3(1.0f), glm::quat(), relDefaultPose.trans() + boneLengthScale * (fbxAnimTrans - fbxZeroTrans));
 
-                _anim[frame][skeletonJoint] = trans * preRot * rot * postRot;
+                _anim[frame].set(skeletonJoint, trans * preRot * rot * postRot);
             }
         }
     }
@@ -181,12 +183,15 @@ void AnimClip::buildMirrorAnim() {
 
     _mirrorAnim.clear();
     _mirrorAnim.reserve(_anim.size());
-    for (auto& relPoses : _anim) {
-        _mirrorAnim.push_back(relPoses);
-        _skeleton->mirrorRelativePoses(_mirrorAnim.back());
+    AnimPoseVec relPoses;
+    for (auto& soaPoses : _anim) {
+        soaPoses.store(relPoses);
+        _skeleton->mirrorRelativePoses(relPoses);
+        _mirrorAnim.push_back(AnimPoseSoA(relPoses));
     }
 }
 
 const AnimPoseVec& AnimClip::getPosesInternal() const {
+    _soaPoses.store(_poses);
     return _poses;
 }
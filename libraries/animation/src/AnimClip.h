@@ -14,6 +14,7 @@
 #include <string>
 #include "AnimationCache.h"
 #include "AnimNode.h"
+#include "AnimPoseSoA.h"
 
 // Playback a single animation timeline.
 // url determines the location of the fbx file to use within this clip.
@@ -31,6 +32,11 @@ public:
     virtual ~AnimClip() override;
 
     virtual const AnimPoseVec& evaluate(const AnimVariantMap& animVars, const AnimContext& context, float dt, Triggers& triggersOut) override;
+    virtual const AnimPoseSoA& evaluateSoA(const AnimVariantMap& animVars, const AnimContext& context, float dt, Triggers& triggersOut) override;
+    virtual const AnimPoseSoA& overlaySoA(const AnimVariantMap& animVars, const AnimContext& context, float dt, Triggers& triggersOut,
+                                          const AnimPoseSoA& underPoses) override {
+        return evaluateSoA(animVars, context, dt, triggersOut);
+    }
 
     void setStartFrameVar(const QString& startFrameVar) { _startFrameVar = startFrameVar; }
     void setEndFrameVar(const QString& endFrameVar) { _endFrameVar = endFrameVar; }
@@ -65,11 +71,11 @@ protected:
     virtual const AnimPoseVec& getPosesInternal() const override;
 
     AnimationPointer _networkAnim;
-    AnimPoseVec _poses;
+    mutable AnimPoseVec _poses;
 
-    // _anim[frame][joint]
-    std::vector<AnimPoseVec> _anim;
-    std::vector<AnimPoseVec> _mirrorAnim;
+    // _anim[frame], keyframes are stored as SoA so they can be sampled with the vectorized blend.
+    std::vector<AnimPoseSoA> _anim;
+    std::vector<AnimPoseSoA> _mirrorAnim;
 
     QString _url;
     float _startFrame;
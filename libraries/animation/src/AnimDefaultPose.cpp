@@ -29,6 +29,20 @@ const AnimPoseVec& AnimDefaultPose::evaluate(const AnimVariantMap& animVars, con
     return _poses;
 }
 
+const AnimPoseSoA& AnimDefaultPose::evaluateSoA(const AnimVariantMap& animVars, const AnimContext& context, float dt, Triggers& triggersOut) {
+    // _soaPoses is only written by setSkeletonInternal()
+    return _soaPoses;
+}
+
+void AnimDefaultPose::setSkeletonInternal(AnimSkeleton::ConstPointer skeleton) {
+    AnimNode::setSkeletonInternal(skeleton);
+    if (_skeleton) {
+        _soaPoses.load(_skeleton->getRelativeDefaultPoses());
+    } else {
+        _soaPoses.resize(0);
+    }
+}
+
 const AnimPoseVec& AnimDefaultPose::getPosesInternal() const {
     return _poses;
 }
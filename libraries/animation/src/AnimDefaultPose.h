@@ -22,7 +22,14 @@ public:
     virtual ~AnimDefaultPose() override;
 
     virtual const AnimPoseVec& evaluate(const AnimVariantMap& animVars, const AnimContext& context, float dt, Triggers& triggersOut) override;
+    virtual const AnimPoseSoA& evaluateSoA(const AnimVariantMap& animVars, const AnimContext& context, float dt, Triggers& triggersOut) override;
+    virtual const AnimPoseSoA& overlaySoA(const AnimVariantMap& animVars, const AnimContext& context, float dt, Triggers& triggersOut,
+                                          const AnimPoseSoA& underPoses) override {
+        return evaluateSoA(animVars, context, dt, triggersOut);
+    }
 protected:
+    virtual void setSkeletonInternal(AnimSkeleton::ConstPointer skeleton) override;
+
     // for AnimDebugDraw rendering
     virtual const AnimPoseVec& getPosesInternal() const override;
 
@@ -58,3 +58,15 @@ void AnimNode::setCurrentFrame(float frame) {
         child->setCurrentFrameInternal(frame);
     }
 }
+
+const AnimPoseSoA& AnimNode::evaluateSoA(const AnimVariantMap& animVars, const AnimContext& context, float dt, Triggers& triggersOut) {
+    _soaPoses.load(evaluate(animVars, context, dt, triggersOut));
+    return _soaPoses;
+}
+
+const AnimPoseSoA& AnimNode::overlaySoA(const AnimVariantMap& animVars, const AnimContext& context, float dt, Triggers& triggersOut,
+                                        const AnimPoseSoA& underPoses) {
+    underPoses.store(_soaUnderPoses);
+    _soaPoses.load(overlay(animVars, context, dt, triggersOut, _soaUnderPoses));
+    return _soaPoses;
+}
@@ -19,6 +19,7 @@
 #include <glm/gtc/quaternion.hpp>
 
 #include "AnimSkeleton.h"
+#include "AnimPoseSoA.h"
 #include "AnimVariant.h"
 #include "AnimContext.h"
 
@@ -33,6 +34,8 @@ class QJsonObject;
 //   * skeleton accessors, the skeleton is from the model whose bones we are going to manipulate
 //   * evaluate method, perform actual joint manipulations here and return result by reference.
 //     Also, append any triggers that are detected during evaluation.
+//   * evaluateSoA method, same as evaluate but returns an AnimPoseSoA. Blend nodes use it to pass
+//     poses to each other without converting them to and from an AnimPoseVec at every node.
 
 class AnimNode : public std::enable_shared_from_this<AnimNode> {
 public:
@@ -80,6 +83,12 @@ public:
         return evaluate(animVars, context, dt, triggersOut);
     }
 
+    // the default implementations convert the result of evaluate() and overlay().
+    // nodes that work on AnimPoseSoA natively should override both.
+    virtual const AnimPoseSoA& evaluateSoA(const AnimVariantMap& animVars, const AnimContext& context, float dt, Triggers& triggersOut);
+    virtual const AnimPoseSoA& overlaySoA(const AnimVariantMap& animVars, const AnimContext& context, float dt, Triggers& triggersOut,
+                                          const AnimPoseSoA& underPoses);
+
     void setCurrentFrame(float frame);
 
     template <typename F>
@@ -120,6 +129,10 @@ protected:
     AnimSkeleton::ConstPointer _skeleton;
     std::weak_ptr<AnimNode> _parent;
 
+    // result of evaluateSoA(), and scratch space for the underPoses the default overlaySoA() passes to overlay().
+    AnimPoseSoA _soaPoses;
+    AnimPoseVec _soaUnderPoses;
+
     // no copies
     AnimNode(const AnimNode&) = delete;
     AnimNode& operator=(const AnimNode&) = delete;
@@ -39,9 +39,17 @@ void AnimOverlay::buildBoneSet(BoneSet boneSet) {
     default:
     case EmptyBoneSet: buildEmptyBoneSet(); break;
     }
+
+    _boneSetWeights = _boneSetVec;
+    _boneSetWeights.resize(AnimPoseSoA::paddedSize(_boneSetVec.size()), 0.0f);
 }
 
 const AnimPoseVec& AnimOverlay::evaluate(const AnimVariantMap& animVars, const AnimContext& context, float dt, Triggers& triggersOut) {
+    evaluateSoA(animVars, context, dt, triggersOut).store(_poses);
+    return _poses;
+}
+
+const AnimPoseSoA& AnimOverlay::evaluateSoA(const AnimVariantMap& animVars, const AnimContext& context, float dt, Triggers& triggersOut) {
 
     // lookup parameters from animVars, using current instance variables as defaults.
     // NOTE: switching bonesets can be an expensive operation, let's try to avoid it.
@@ -53,20 +61,17 @@ const AnimPoseVec& AnimOverlay::evaluate(const AnimVariantMap& animVars, const A
     _alpha = animVars.lookup(_alphaVar, _alpha);
 
     if (_children.size() >= 2) {
-        auto& underPoses = _children[1]->evaluate(animVars, context, dt, triggersOut);
-        auto& overPoses = _children[0]->overlay(animVars, context, dt, triggersOut, underPoses);
+        auto& underPoses = _children[1]->evaluateSoA(animVars, context, dt, triggersOut);
+        auto& overPoses = _children[0]->overlaySoA(animVars, context, dt, triggersOut, underPoses);
 
         if (underPoses.size() > 0 && underPoses.size() == overPoses.size()) {
-            _poses.resize(underPoses.size());
-            assert(_boneSetVec.size() == _poses.size());
+            assert(_boneSetVec.size() == underPoses.size());
 
-            for (size_t i = 0; i < _poses.size(); i++) {
-                float alpha = _boneSetVec[i] * _alpha;
-                ::blend(1, &underPoses[i], &overPoses[i], alpha, &_poses[i]);
-            }
+            // the alpha for joint i is _boneSetVec[i] * _alpha
+            ::blend(underPoses, overPoses, _boneSetWeights.data(), _alpha, _soaPoses);
         }
     }
-    return _poses;
+    return _soaPoses;
 }
 
 template <typename Func>
@@ -213,6 +218,7 @@ void AnimOverlay::buildBothFeetBoneSet() {
 
 // for AnimDebugDraw rendering
 const AnimPoseVec& AnimOverlay::getPosesInternal() const {
+    _soaPoses.store(_poses);
     return _poses;
 }
 
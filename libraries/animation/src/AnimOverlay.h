@@ -12,6 +12,7 @@
 #define hifi_AnimOverlay_h
 
 #include "AnimNode.h"
+#include "AnimPoseSoA.h"
 
 // Overlay the AnimPoses from one AnimNode on top of another AnimNode.
 // child[0] is overlayed on top of child[1].  The boneset is used
@@ -46,6 +47,11 @@ public:
     virtual ~AnimOverlay() override;
 
     virtual const AnimPoseVec& evaluate(const AnimVariantMap& animVars, const AnimContext& context, float dt, Triggers& triggersOut) override;
+    virtual const AnimPoseSoA& evaluateSoA(const AnimVariantMap& animVars, const AnimContext& context, float dt, Triggers& triggersOut) override;
+    virtual const AnimPoseSoA& overlaySoA(const AnimVariantMap& animVars, const AnimContext& context, float dt, Triggers& triggersOut,
+                                          const AnimPoseSoA& underPoses) override {
+        return evaluateSoA(animVars, context, dt, triggersOut);
+    }
 
     void setBoneSetVar(const QString& boneSetVar) { _boneSetVar = boneSetVar; }
     void setAlphaVar(const QString& alphaVar) { _alphaVar = alphaVar; }
@@ -57,10 +63,11 @@ public:
     virtual const AnimPoseVec& getPosesInternal() const override;
     virtual void setSkeletonInternal(AnimSkeleton::ConstPointer skeleton) override;
 
-    AnimPoseVec _poses;
+    mutable AnimPoseVec _poses;
     BoneSet _boneSet;
     float _alpha;
     std::vector<float> _boneSetVec;
+    std::vector<float> _boneSetWeights;  // _boneSetVec, zero padded to AnimPoseSoA::paddedSize()
 
     QString _boneSetVar;
     QString _alphaVar;
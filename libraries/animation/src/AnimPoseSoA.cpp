@@ -0,0 +1,82 @@
+//
+//  AnimPoseSoA.cpp
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimPoseSoA.h"
+
+#include <algorithm>
+#include <cmath>
+
+static void fillIdentity(float* data, size_t stride, size_t begin, size_t end) {
+    for (int c = 0; c < AnimPoseSoA::NumChannels; c++) {
+        float value = (c <= AnimPoseSoA::ScaleZ || c == AnimPoseSoA::RotW) ? 1.0f : 0.0f;
+        std::fill(data + c * stride + begin, data + c * stride + end, value);
+    }
+}
+
+void AnimPoseSoA::resize(size_t numPoses) {
+    size_t stride = paddedSize(numPoses);
+    if (stride != _stride) {
+        // NOTE: changing the stride does not preserve the previous contents.
+        _stride = stride;
+        _data.resize(NumChannels * _stride);
+        fillIdentity(_data.data(), _stride, 0, _stride);
+    } else if (numPoses < _size) {
+        // keep the padding at identity
+        fillIdentity(_data.data(), _stride, numPoses, _size);
+    }
+    _size = numPoses;
+}
+
+void AnimPoseSoA::load(const AnimPoseVec& poses) {
+    resize(poses.size());
+    for (size_t i = 0; i < _size; i++) {
+        set(i, poses[i]);
+    }
+}
+
+void AnimPoseSoA::store(AnimPoseVec& poses) const {
+    poses.resize(_size);
+    for (size_t i = 0; i < _size; i++) {
+        poses[i] = get(i);
+    }
+}
+
+bool AnimPoseSoA::hasUniformScale() const {
+    const float EPSILON = 0.0001f;
+    const float* x = channel(ScaleX);
+    const float* y = channel(ScaleY);
+    const float* z = channel(ScaleZ);
+    for (size_t i = 0; i < _size; i++) {
+        if (fabsf(x[i] - y[i]) > EPSILON || fabsf(x[i] - z[i]) > EPSILON) {
+            return false;
+        }
+    }
+    return true;
+}
+
+AnimPose AnimPoseSoA::get(size_t index) const {
+    const float* d = _data.data() + index;
+    return AnimPose(glm::vec3(d[ScaleX * _stride], d[ScaleY * _stride], d[ScaleZ * _stride]),
+                    glm::quat(d[RotW * _stride], d[RotX * _stride], d[RotY * _stride], d[RotZ * _stride]),
+                    glm::vec3(d[TransX * _stride], d[TransY * _stride], d[TransZ * _stride]));
+}
+
+void AnimPoseSoA::set(size_t index, const AnimPose& pose) {
+    float* d = _data.data() + index;
+    d[ScaleX * _stride] = pose.scale().x;
+    d[ScaleY * _stride] = pose.scale().y;
+    d[ScaleZ * _stride] = pose.scale().z;
+    d[RotX * _stride] = pose.rot().x;
+    d[RotY * _stride] = pose.rot().y;
+    d[RotZ * _stride] = pose.rot().z;
+    d[RotW * _stride] = pose.rot().w;
+    d[TransX * _stride] = pose.trans().x;
+    d[TransY * _stride] = pose.trans().y;
+    d[TransZ * _stride] = pose.trans().z;
+}
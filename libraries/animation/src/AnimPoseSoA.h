@@ -0,0 +1,63 @@
+//
+//  AnimPoseSoA.h
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimPoseSoA
+#define hifi_AnimPoseSoA
+
+#include <vector>
+#include "AnimPose.h"
+
+// Structure-of-arrays storage for a set of AnimPoses.
+// Each component (scale.x, scale.y, ..., trans.z) is stored in its own contiguous channel,
+// padded out to a multiple of SIMD_WIDTH, so that the blend kernels can process 8 joints at a time.
+// Padding joints are always kept at identity, so they can be blended and normalized safely.
+class AnimPoseSoA {
+public:
+    enum Channel {
+        ScaleX = 0, ScaleY, ScaleZ,
+        RotX, RotY, RotZ, RotW,
+        TransX, TransY, TransZ,
+        NumChannels
+    };
+    static const size_t SIMD_WIDTH = 8;
+
+    AnimPoseSoA() {}
+    explicit AnimPoseSoA(const AnimPoseVec& poses) { load(poses); }
+
+    // number of floats per channel needed to hold numPoses.
+    static size_t paddedSize(size_t numPoses) { return (numPoses + SIMD_WIDTH - 1) & ~(SIMD_WIDTH - 1); }
+
+    void resize(size_t numPoses);
+    size_t size() const { return _size; }
+    size_t stride() const { return _stride; }
+
+    // AoS <-> SoA conversion
+    void load(const AnimPoseVec& poses);
+    void store(AnimPoseVec& poses) const;
+
+    // true if every pose has the same scale on all three axes, see accumulatePoses() in AnimUtil.h
+    bool hasUniformScale() const;
+
+    AnimPose get(size_t index) const;
+    void set(size_t index, const AnimPose& pose);
+
+    float* channel(Channel c) { return _data.data() + c * _stride; }
+    const float* channel(Channel c) const { return _data.data() + c * _stride; }
+
+    // all channels, back to back, each stride() floats long.
+    float* data() { return _data.data(); }
+    const float* data() const { return _data.data(); }
+
+private:
+    size_t _size { 0 };
+    size_t _stride { 0 };
+    std::vector<float> _data;
+};
+
+#endif
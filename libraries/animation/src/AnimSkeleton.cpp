@@ -15,6 +15,7 @@
 #include <GLMHelpers.h>
 
 #include "AnimationLogging.h"
+#include "AnimUtil.h"
 
 AnimSkeleton::AnimSkeleton(const FBXGeometry& fbxGeometry) {
     // convert to std::vector of joints
@@ -109,6 +110,25 @@ void AnimSkeleton::convertRelativePosesToAbsolute(AnimPoseVec& poses) const {
     }
 }
 
+void AnimSkeleton::convertRelativePosesToAbsolute(AnimPoseSoA& poses) const {
+    if ((int)poses.size() != _jointsSize || !poses.hasUniformScale()) {
+        // partial pose sets and non-uniform scale are rare, use the AoS path.
+        AnimPoseVec temp;
+        poses.store(temp);
+        convertRelativePosesToAbsolute(temp);
+        poses.load(temp);
+        return;
+    }
+
+    // poses start off relative and leave in absolute frame
+    // all joints at a given depth only depend on joints at a shallower depth.
+    for (size_t depth = 0; depth + 1 < _depthOffsets.size(); depth++) {
+        int begin = _depthOffsets[depth];
+        int end = _depthOffsets[depth + 1];
+        accumulatePoses(poses, &_jointsByDepth[begin], &_parentsByDepth[begin], end - begin);
+    }
+}
+
 void AnimSkeleton::convertAbsolutePosesToRelative(AnimPoseVec& poses) const {
     // poses start off absolute and leave in relative frame
     int lastIndex = std::min((int)poses.size(), _jointsSize);
@@ -220,6 +240,33 @@ void AnimSkeleton::buildSkeletonFromJoints(const std::vector<FBXJoint>& joints)
         _jointIndicesByName[_joints[i].name] = i;
     }
 
+    // sort non-root joints by chain depth
+    _jointsByDepth.clear();
+    _parentsByDepth.clear();
+    _depthOffsets.clear();
+    std::vector<std::vector<int>> jointsAtDepth;
+    for (int i = 0; i < _jointsSize; i++) {
+        if (_joints[i].parentIndex != -1) {
+            // roots have a chain depth of 1, so their children end up in bucket 0.
+            size_t depth = getChainDepth(i) - 2;
+            if (depth >= jointsAtDepth.size()) {
+                jointsAtDepth.resize(depth + 1);
+            }
+            jointsAtDepth[depth].push_back(i);
+        }
+    }
+    _jointsByDepth.reserve(_jointsSize);
+    _parentsByDepth.reserve(_jointsSize);
+    _depthOffsets.reserve(jointsAtDepth.size() + 1);
+    for (auto& joints : jointsAtDepth) {
+        _depthOffsets.push_back((int)_jointsByDepth.size());
+        for (auto& jointIndex : joints) {
+            _jointsByDepth.push_back(jointIndex);
+            _parentsByDepth.push_back(_joints[jointIndex].parentIndex);
+        }
+    }
+    _depthOffsets.push_back((int)_jointsByDepth.size());
+
     // build mirror map.
     _nonMirroredIndices.clear();
     _mirrorMap.reserve(_jointsSize);
@@ -17,6 +17,7 @@
 
 #include <FBXReader.h>
 #include "AnimPose.h"
+#include "AnimPoseSoA.h"
 
 class AnimSkeleton {
 public:
@@ -56,6 +57,10 @@ public:
     void convertRelativePosesToAbsolute(AnimPoseVec& poses) const;
     void convertAbsolutePosesToRelative(AnimPoseVec& poses) const;
 
+    // vectorized version, joints at the same chain depth are accumulated together.
+    // falls back to the AnimPoseVec version for non-uniform scale, see accumulatePoses() in AnimUtil.h
+    void convertRelativePosesToAbsolute(AnimPoseSoA& poses) const;
+
     void convertAbsoluteRotationsToRelative(std::vector<glm::quat>& rotations) const;
 
     void saveNonMirroredPoses(const AnimPoseVec& poses) const;
@@ -83,6 +88,12 @@ protected:
     std::vector<int> _mirrorMap;
     QHash<QString, int> _jointIndicesByName;
 
+    // non-root joints sorted by chain depth, used by the AnimPoseSoA version of convertRelativePosesToAbsolute.
+    // joints at depth d are in [_depthOffsets[d], _depthOffsets[d + 1])
+    std::vector<int> _jointsByDepth;
+    std::vector<int> _parentsByDepth;
+    std::vector<int> _depthOffsets;
+
     // no copies
     AnimSkeleton(const AnimSkeleton&) = delete;
     AnimSkeleton& operator=(const AnimSkeleton&) = delete;
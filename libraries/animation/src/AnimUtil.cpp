@@ -12,7 +12,7 @@
 #include "GLMHelpers.h"
 
 // TODO: use restrict keyword
-// TODO: excellent candidate for simd vectorization.
+// NOTE: the AnimPoseSoA versions below are the vectorized path.
 
 void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result) {
     for (size_t i = 0; i < numPoses; i++) {
@@ -33,6 +33,124 @@ void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, A
     }
 }
 
+static void blendPoseChannels_ref(const float* a, const float* b, const float* weights, float alpha, float* result, int stride) {
+    const int SX = AnimPoseSoA::ScaleX * stride;
+    const int SY = AnimPoseSoA::ScaleY * stride;
+    const int SZ = AnimPoseSoA::ScaleZ * stride;
+    const int RX = AnimPoseSoA::RotX * stride;
+    const int RY = AnimPoseSoA::RotY * stride;
+    const int RZ = AnimPoseSoA::RotZ * stride;
+    const int RW = AnimPoseSoA::RotW * stride;
+    const int TX = AnimPoseSoA::TransX * stride;
+    const int TY = AnimPoseSoA::TransY * stride;
+    const int TZ = AnimPoseSoA::TransZ * stride;
+
+    for (int i = 0; i < stride; i++) {
+        float t = weights ? weights[i] * alpha : alpha;
+
+        result[SX + i] = a[SX + i] + t * (b[SX + i] - a[SX + i]);
+        result[SY + i] = a[SY + i] + t * (b[SY + i] - a[SY + i]);
+        result[SZ + i] = a[SZ + i] + t * (b[SZ + i] - a[SZ + i]);
+
+        // adjust signs if necessary
+        float dot = a[RX + i] * b[RX + i] + a[RY + i] * b[RY + i] + a[RZ + i] * b[RZ + i] + a[RW + i] * b[RW + i];
+        float sign = dot < 0.0f ? -1.0f : 1.0f;
+        float x = a[RX + i] + t * (sign * b[RX + i] - a[RX + i]);
+        float y = a[RY + i] + t * (sign * b[RY + i] - a[RY + i]);
+        float z = a[RZ + i] + t * (sign * b[RZ + i] - a[RZ + i]);
+        float w = a[RW + i] + t * (sign * b[RW + i] - a[RW + i]);
+        float oneOverLength = 1.0f / sqrtf(x * x + y * y + z * z + w * w);
+        result[RX + i] = x * oneOverLength;
+        result[RY + i] = y * oneOverLength;
+        result[RZ + i] = z * oneOverLength;
+        result[RW + i] = w * oneOverLength;
+
+        result[TX + i] = a[TX + i] + t * (b[TX + i] - a[TX + i]);
+        result[TY + i] = a[TY + i] + t * (b[TY + i] - a[TY + i]);
+        result[TZ + i] = a[TZ + i] + t * (b[TZ + i] - a[TZ + i]);
+    }
+}
+
+static void accumulatePoseChannels_ref(float* poses, int stride, const int* jointIndices, const int* parentIndices, int numJoints) {
+    for (int i = 0; i < numJoints; i++) {
+        float* c = poses + jointIndices[i];
+        const float* p = poses + parentIndices[i];
+
+        const float psx = p[AnimPoseSoA::ScaleX * stride], psy = p[AnimPoseSoA::ScaleY * stride], psz = p[AnimPoseSoA::ScaleZ * stride];
+        const float prx = p[AnimPoseSoA::RotX * stride], pry = p[AnimPoseSoA::RotY * stride];
+        const float prz = p[AnimPoseSoA::RotZ * stride], prw = p[AnimPoseSoA::RotW * stride];
+        const float crx = c[AnimPoseSoA::RotX * stride], cry = c[AnimPoseSoA::RotY * stride];
+        const float crz = c[AnimPoseSoA::RotZ * stride], crw = c[AnimPoseSoA::RotW * stride];
+
+        // v = parent.scale * child.trans
+        float vx = psx * c[AnimPoseSoA::TransX * stride];
+        float vy = psy * c[AnimPoseSoA::TransY * stride];
+        float vz = psz * c[AnimPoseSoA::TransZ * stride];
+
+        // rotate v by parent.rot: t = 2 * cross(q.xyz, v), v' = v + q.w * t + cross(q.xyz, t)
+        float tx = 2.0f * (pry * vz - prz * vy);
+        float ty = 2.0f * (prz * vx - prx * vz);
+        float tz = 2.0f * (prx * vy - pry * vx);
+        c[AnimPoseSoA::TransX * stride] = p[AnimPoseSoA::TransX * stride] + vx + prw * tx + (pry * tz - prz * ty);
+        c[AnimPoseSoA::TransY * stride] = p[AnimPoseSoA::TransY * stride] + vy + prw * ty + (prz * tx - prx * tz);
+        c[AnimPoseSoA::TransZ * stride] = p[AnimPoseSoA::TransZ * stride] + vz + prw * tz + (prx * ty - pry * tx);
+
+        // rot = parent.rot * child.rot
+        c[AnimPoseSoA::RotX * stride] = prw * crx + prx * crw + pry * crz - prz * cry;
+        c[AnimPoseSoA::RotY * stride] = prw * cry + pry * crw + prz * crx - prx * crz;
+        c[AnimPoseSoA::RotZ * stride] = prw * crz + prz * crw + prx * cry - pry * crx;
+        c[AnimPoseSoA::RotW * stride] = prw * crw - prx * crx - pry * cry - prz * crz;
+
+        c[AnimPoseSoA::ScaleX * stride] *= psx;
+        c[AnimPoseSoA::ScaleY * stride] *= psy;
+        c[AnimPoseSoA::ScaleZ * stride] *= psz;
+    }
+}
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+//
+// Runtime CPU dispatch
+//
+
+#include "CPUDetect.h"
+
+void blendPoseChannels_AVX2(const float* a, const float* b, const float* weights, float alpha, float* result, int stride);
+void accumulatePoseChannels_AVX2(float* poses, int stride, const int* jointIndices, const int* parentIndices, int numJoints);
+
+static void blendPoseChannels(const float* a, const float* b, const float* weights, float alpha, float* result, int stride) {
+    static auto f = cpuSupportsAVX2() ? blendPoseChannels_AVX2 : blendPoseChannels_ref;
+    (*f)(a, b, weights, alpha, result, stride);  // dispatch
+}
+
+static void accumulatePoseChannels(float* poses, int stride, const int* jointIndices, const int* parentIndices, int numJoints) {
+    static auto f = cpuSupportsAVX2() ? accumulatePoseChannels_AVX2 : accumulatePoseChannels_ref;
+    (*f)(poses, stride, jointIndices, parentIndices, numJoints);  // dispatch
+}
+
+#else   // portable reference code
+
+static auto& blendPoseChannels = blendPoseChannels_ref;
+static auto& accumulatePoseChannels = accumulatePoseChannels_ref;
+
+#endif
+
+void blend(const AnimPoseSoA& a, const AnimPoseSoA& b, float alpha, AnimPoseSoA& result) {
+    assert(a.size() == b.size());
+    result.resize(a.size());
+    blendPoseChannels(a.data(), b.data(), nullptr, alpha, result.data(), (int)a.stride());
+}
+
+void blend(const AnimPoseSoA& a, const AnimPoseSoA& b, const float* weights, float alpha, AnimPoseSoA& result) {
+    assert(a.size() == b.size());
+    result.resize(a.size());
+    blendPoseChannels(a.data(), b.data(), weights, alpha, result.data(), (int)a.stride());
+}
+
+void accumulatePoses(AnimPoseSoA& poses, const int* jointIndices, const int* parentIndices, int numJoints) {
+    accumulatePoseChannels(poses.data(), (int)poses.stride(), jointIndices, parentIndices, numJoints);
+}
+
 glm::quat averageQuats(size_t numQuats, const glm::quat* quats) {
     if (numQuats == 0) {
         return glm::quat();
@@ -12,10 +12,24 @@
 #define hifi_AnimUtil_h
 
 #include "AnimNode.h"
+#include "AnimPoseSoA.h"
 
 // this is where the magic happens
 void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result);
 
+// SoA versions of blend, these use AVX2 kernels when supported by the cpu.
+// a, b and result must all be the same size.
+void blend(const AnimPoseSoA& a, const AnimPoseSoA& b, float alpha, AnimPoseSoA& result);
+
+// per-joint blend, the alpha for joint i is weights[i] * alpha.
+// weights must contain at least a.stride() elements, the padding should be zero.
+void blend(const AnimPoseSoA& a, const AnimPoseSoA& b, const float* weights, float alpha, AnimPoseSoA& result);
+
+// composes poses[jointIndices[i]] = poses[parentIndices[i]] * poses[jointIndices[i]], in place.
+// No joint in jointIndices may be the parent of another joint in the same call, this allows them to be processed in parallel.
+// NOTE: scale is composed component-wise, which is only exact for uniform scale.
+void accumulatePoses(AnimPoseSoA& poses, const int* jointIndices, const int* parentIndices, int numJoints);
+
 glm::quat averageQuats(size_t numQuats, const glm::quat* quats);
 
 float accumulateTime(float startFrame, float endFrame, float timeScale, float currentFrame, float dt, bool loopFlag,
@@ -1678,17 +1678,17 @@ void Rig::buildAbsoluteRigPoses(const AnimPoseVec& relativePoses, AnimPoseVec& a
 
     ASSERT(_animSkeleton->getNumJoints() == (int)relativePoses.size());
 
-    absolutePosesOut.resize(relativePoses.size());
+    _absolutePosesSoA.load(relativePoses);
     AnimPose geometryToRigTransform(_geometryToRigTransform);
     for (int i = 0; i < (int)relativePoses.size(); i++) {
-        int parentIndex = _animSkeleton->getParentIndex(i);
-        if (parentIndex == -1) {
+        if (_animSkeleton->getParentIndex(i) == -1) {
             // transform all root absolute poses into rig space
-            absolutePosesOut[i] = geometryToRigTransform * relativePoses[i];
-        } else {
-            absolutePosesOut[i] = absolutePosesOut[parentIndex] * relativePoses[i];
+            _absolutePosesSoA.set(i, geometryToRigTransform * relativePoses[i]);
         }
     }
+    // then accumulate the rest of each chain onto its root, a chain depth at a time.
+    _animSkeleton->convertRelativePosesToAbsolute(_absolutePosesSoA);
+    _absolutePosesSoA.store(absolutePosesOut);
 }
 
 glm::mat4 Rig::getJointTransform(int jointIndex) const {
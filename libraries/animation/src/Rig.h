@@ -281,6 +281,7 @@ protected:
     mutable QReadWriteLock _externalPoseSetLock;
 
     AnimPoseVec _absoluteDefaultPoses; // rig space, not relative to parent.
+    AnimPoseSoA _absolutePosesSoA; // scratch space for buildAbsoluteRigPoses()
 
     glm::mat4 _geometryToRigTransform;
     glm::mat4 _rigToGeometryTransform;
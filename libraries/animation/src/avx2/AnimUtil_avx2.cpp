@@ -0,0 +1,230 @@
+//
+//  AnimUtil_avx2.cpp
+//  libraries/animation/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifdef __AVX2__
+
+#include <assert.h>
+#include <immintrin.h>
+
+#include "../AnimPoseSoA.h"
+
+#if defined(_MSC_VER)
+#define ALIGN32 __declspec(align(32))
+#elif defined(__GNUC__)
+#define ALIGN32 __attribute__((aligned(32)))
+#else
+#define ALIGN32
+#endif
+
+static const int SIMD_WIDTH = 8;
+
+//
+// Pose blending, 8 joints at a time.
+// stride is always a multiple of 8, and padding joints are identity.
+//
+void blendPoseChannels_AVX2(const float* a, const float* b, const float* weights, float alpha, float* result, int stride) {
+
+    assert(stride % SIMD_WIDTH == 0);
+
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+    const __m256 alpha8 = _mm256_set1_ps(alpha);
+
+    const float* aRot = a + AnimPoseSoA::RotX * stride;
+    const float* bRot = b + AnimPoseSoA::RotX * stride;
+    float* resultRot = result + AnimPoseSoA::RotX * stride;
+
+    for (int i = 0; i < stride; i += SIMD_WIDTH) {
+
+        __m256 t = weights ? _mm256_mul_ps(_mm256_loadu_ps(&weights[i]), alpha8) : alpha8;
+
+        // lerp scale
+        for (int c = AnimPoseSoA::ScaleX; c <= AnimPoseSoA::ScaleZ; c++) {
+            __m256 x0 = _mm256_loadu_ps(&a[c * stride + i]);
+            __m256 x1 = _mm256_loadu_ps(&b[c * stride + i]);
+            _mm256_storeu_ps(&result[c * stride + i], _mm256_fmadd_ps(t, _mm256_sub_ps(x1, x0), x0));
+        }
+
+        // nlerp rotation
+        __m256 ax = _mm256_loadu_ps(&aRot[0 * stride + i]);
+        __m256 ay = _mm256_loadu_ps(&aRot[1 * stride + i]);
+        __m256 az = _mm256_loadu_ps(&aRot[2 * stride + i]);
+        __m256 aw = _mm256_loadu_ps(&aRot[3 * stride + i]);
+        __m256 bx = _mm256_loadu_ps(&bRot[0 * stride + i]);
+        __m256 by = _mm256_loadu_ps(&bRot[1 * stride + i]);
+        __m256 bz = _mm256_loadu_ps(&bRot[2 * stride + i]);
+        __m256 bw = _mm256_loadu_ps(&bRot[3 * stride + i]);
+
+        // adjust signs if necessary, by copying the sign bit of the dot product into b
+        __m256 dot = _mm256_mul_ps(ax, bx);
+        dot = _mm256_fmadd_ps(ay, by, dot);
+        dot = _mm256_fmadd_ps(az, bz, dot);
+        dot = _mm256_fmadd_ps(aw, bw, dot);
+        __m256 sign = _mm256_and_ps(dot, signMask);
+        bx = _mm256_xor_ps(bx, sign);
+        by = _mm256_xor_ps(by, sign);
+        bz = _mm256_xor_ps(bz, sign);
+        bw = _mm256_xor_ps(bw, sign);
+
+        __m256 x = _mm256_fmadd_ps(t, _mm256_sub_ps(bx, ax), ax);
+        __m256 y = _mm256_fmadd_ps(t, _mm256_sub_ps(by, ay), ay);
+        __m256 z = _mm256_fmadd_ps(t, _mm256_sub_ps(bz, az), az);
+        __m256 w = _mm256_fmadd_ps(t, _mm256_sub_ps(bw, aw), aw);
+
+        __m256 lengthSquared = _mm256_mul_ps(x, x);
+        lengthSquared = _mm256_fmadd_ps(y, y, lengthSquared);
+        lengthSquared = _mm256_fmadd_ps(z, z, lengthSquared);
+        lengthSquared = _mm256_fmadd_ps(w, w, lengthSquared);
+        __m256 oneOverLength = _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(lengthSquared));
+
+        _mm256_storeu_ps(&resultRot[0 * stride + i], _mm256_mul_ps(x, oneOverLength));
+        _mm256_storeu_ps(&resultRot[1 * stride + i], _mm256_mul_ps(y, oneOverLength));
+        _mm256_storeu_ps(&resultRot[2 * stride + i], _mm256_mul_ps(z, oneOverLength));
+        _mm256_storeu_ps(&resultRot[3 * stride + i], _mm256_mul_ps(w, oneOverLength));
+
+        // lerp translation
+        for (int c = AnimPoseSoA::TransX; c <= AnimPoseSoA::TransZ; c++) {
+            __m256 x0 = _mm256_loadu_ps(&a[c * stride + i]);
+            __m256 x1 = _mm256_loadu_ps(&b[c * stride + i]);
+            _mm256_storeu_ps(&result[c * stride + i], _mm256_fmadd_ps(t, _mm256_sub_ps(x1, x0), x0));
+        }
+    }
+
+    _mm256_zeroupper();
+}
+
+//
+// Parent * child pose composition, 8 joints at a time.
+// Joints are gathered by index, the results are scattered back with scalar stores.
+//
+void accumulatePoseChannels_AVX2(float* poses, int stride, const int* jointIndices, const int* parentIndices, int numJoints) {
+
+    ALIGN32 float out[AnimPoseSoA::NumChannels][SIMD_WIDTH];
+
+    int i = 0;
+    for (; i + SIMD_WIDTH <= numJoints; i += SIMD_WIDTH) {
+
+        __m256i ci = _mm256_loadu_si256((const __m256i*)&jointIndices[i]);
+        __m256i pi = _mm256_loadu_si256((const __m256i*)&parentIndices[i]);
+
+        __m256 psx = _mm256_i32gather_ps(poses + AnimPoseSoA::ScaleX * stride, pi, 4);
+        __m256 psy = _mm256_i32gather_ps(poses + AnimPoseSoA::ScaleY * stride, pi, 4);
+        __m256 psz = _mm256_i32gather_ps(poses + AnimPoseSoA::ScaleZ * stride, pi, 4);
+        __m256 prx = _mm256_i32gather_ps(poses + AnimPoseSoA::RotX * stride, pi, 4);
+        __m256 pry = _mm256_i32gather_ps(poses + AnimPoseSoA::RotY * stride, pi, 4);
+        __m256 prz = _mm256_i32gather_ps(poses + AnimPoseSoA::RotZ * stride, pi, 4);
+        __m256 prw = _mm256_i32gather_ps(poses + AnimPoseSoA::RotW * stride, pi, 4);
+        __m256 ptx = _mm256_i32gather_ps(poses + AnimPoseSoA::TransX * stride, pi, 4);
+        __m256 pty = _mm256_i32gather_ps(poses + AnimPoseSoA::TransY * stride, pi, 4);
+        __m256 ptz = _mm256_i32gather_ps(poses + AnimPoseSoA::TransZ * stride, pi, 4);
+
+        __m256 csx = _mm256_i32gather_ps(poses + AnimPoseSoA::ScaleX * stride, ci, 4);
+        __m256 csy = _mm256_i32gather_ps(poses + AnimPoseSoA::ScaleY * stride, ci, 4);
+        __m256 csz = _mm256_i32gather_ps(poses + AnimPoseSoA::ScaleZ * stride, ci, 4);
+        __m256 crx = _mm256_i32gather_ps(poses + AnimPoseSoA::RotX * stride, ci, 4);
+        __m256 cry = _mm256_i32gather_ps(poses + AnimPoseSoA::RotY * stride, ci, 4);
+        __m256 crz = _mm256_i32gather_ps(poses + AnimPoseSoA::RotZ * stride, ci, 4);
+        __m256 crw = _mm256_i32gather_ps(poses + AnimPoseSoA::RotW * stride, ci, 4);
+        __m256 ctx = _mm256_i32gather_ps(poses + AnimPoseSoA::TransX * stride, ci, 4);
+        __m256 cty = _mm256_i32gather_ps(poses + AnimPoseSoA::TransY * stride, ci, 4);
+        __m256 ctz = _mm256_i32gather_ps(poses + AnimPoseSoA::TransZ * stride, ci, 4);
+
+        // v = parent.scale * child.trans
+        __m256 vx = _mm256_mul_ps(psx, ctx);
+        __m256 vy = _mm256_mul_ps(psy, cty);
+        __m256 vz = _mm256_mul_ps(psz, ctz);
+
+        // rotate v by parent.rot: t = 2 * cross(q.xyz, v), v' = v + q.w * t + cross(q.xyz, t)
+        const __m256 two = _mm256_set1_ps(2.0f);
+        __m256 tx = _mm256_mul_ps(two, _mm256_fmsub_ps(pry, vz, _mm256_mul_ps(prz, vy)));
+        __m256 ty = _mm256_mul_ps(two, _mm256_fmsub_ps(prz, vx, _mm256_mul_ps(prx, vz)));
+        __m256 tz = _mm256_mul_ps(two, _mm256_fmsub_ps(prx, vy, _mm256_mul_ps(pry, vx)));
+
+        __m256 rx = _mm256_add_ps(_mm256_fmadd_ps(prw, tx, _mm256_add_ps(ptx, vx)), _mm256_fmsub_ps(pry, tz, _mm256_mul_ps(prz, ty)));
+        __m256 ry = _mm256_add_ps(_mm256_fmadd_ps(prw, ty, _mm256_add_ps(pty, vy)), _mm256_fmsub_ps(prz, tx, _mm256_mul_ps(prx, tz)));
+        __m256 rz = _mm256_add_ps(_mm256_fmadd_ps(prw, tz, _mm256_add_ps(ptz, vz)), _mm256_fmsub_ps(prx, ty, _mm256_mul_ps(pry, tx)));
+        _mm256_store_ps(out[AnimPoseSoA::TransX], rx);
+        _mm256_store_ps(out[AnimPoseSoA::TransY], ry);
+        _mm256_store_ps(out[AnimPoseSoA::TransZ], rz);
+
+        // rot = parent.rot * child.rot
+        __m256 qx = _mm256_mul_ps(prw, crx);
+        qx = _mm256_fmadd_ps(prx, crw, qx);
+        qx = _mm256_fmadd_ps(pry, crz, qx);
+        qx = _mm256_fnmadd_ps(prz, cry, qx);
+
+        __m256 qy = _mm256_mul_ps(prw, cry);
+        qy = _mm256_fmadd_ps(pry, crw, qy);
+        qy = _mm256_fmadd_ps(prz, crx, qy);
+        qy = _mm256_fnmadd_ps(prx, crz, qy);
+
+        __m256 qz = _mm256_mul_ps(prw, crz);
+        qz = _mm256_fmadd_ps(prz, crw, qz);
+        qz = _mm256_fmadd_ps(prx, cry, qz);
+        qz = _mm256_fnmadd_ps(pry, crx, qz);
+
+        __m256 qw = _mm256_mul_ps(prw, crw);
+        qw = _mm256_fnmadd_ps(prx, crx, qw);
+        qw = _mm256_fnmadd_ps(pry, cry, qw);
+        qw = _mm256_fnmadd_ps(prz, crz, qw);
+
+        _mm256_store_ps(out[AnimPoseSoA::RotX], qx);
+        _mm256_store_ps(out[AnimPoseSoA::RotY], qy);
+        _mm256_store_ps(out[AnimPoseSoA::RotZ], qz);
+        _mm256_store_ps(out[AnimPoseSoA::RotW], qw);
+
+        _mm256_store_ps(out[AnimPoseSoA::ScaleX], _mm256_mul_ps(psx, csx));
+        _mm256_store_ps(out[AnimPoseSoA::ScaleY], _mm256_mul_ps(psy, csy));
+        _mm256_store_ps(out[AnimPoseSoA::ScaleZ], _mm256_mul_ps(psz, csz));
+
+        // scatter
+        for (int j = 0; j < SIMD_WIDTH; j++) {
+            float* c = poses + jointIndices[i + j];
+            for (int k = 0; k < AnimPoseSoA::NumChannels; k++) {
+                c[k * stride] = out[k][j];
+            }
+        }
+    }
+
+    // remainder
+    for (; i < numJoints; i++) {
+        float* c = poses + jointIndices[i];
+        const float* p = poses + parentIndices[i];
+
+        float psx = p[AnimPoseSoA::ScaleX * stride], psy = p[AnimPoseSoA::ScaleY * stride], psz = p[AnimPoseSoA::ScaleZ * stride];
+        float prx = p[AnimPoseSoA::RotX * stride], pry = p[AnimPoseSoA::RotY * stride];
+        float prz = p[AnimPoseSoA::RotZ * stride], prw = p[AnimPoseSoA::RotW * stride];
+        float crx = c[AnimPoseSoA::RotX * stride], cry = c[AnimPoseSoA::RotY * stride];
+        float crz = c[AnimPoseSoA::RotZ * stride], crw = c[AnimPoseSoA::RotW * stride];
+
+        float vx = psx * c[AnimPoseSoA::TransX * stride];
+        float vy = psy * c[AnimPoseSoA::TransY * stride];
+        float vz = psz * c[AnimPoseSoA::TransZ * stride];
+
+        float tx = 2.0f * (pry * vz - prz * vy);
+        float ty = 2.0f * (prz * vx - prx * vz);
+        float tz = 2.0f * (prx * vy - pry * vx);
+        c[AnimPoseSoA::TransX * stride] = p[AnimPoseSoA::TransX * stride] + vx + prw * tx + (pry * tz - prz * ty);
+        c[AnimPoseSoA::TransY * stride] = p[AnimPoseSoA::TransY * stride] + vy + prw * ty + (prz * tx - prx * tz);
+        c[AnimPoseSoA::TransZ * stride] = p[AnimPoseSoA::TransZ * stride] + vz + prw * tz + (prx * ty - pry * tx);
+
+        c[AnimPoseSoA::RotX * stride] = prw * crx + prx * crw + pry * crz - prz * cry;
+        c[AnimPoseSoA::RotY * stride] = prw * cry + pry * crw + prz * crx - prx * crz;
+        c[AnimPoseSoA::RotZ * stride] = prw * crz + prz * crw + prx * cry - pry * crx;
+        c[AnimPoseSoA::RotW * stride] = prw * crw - prx * crx - pry * cry - prz * crz;
+
+        c[AnimPoseSoA::ScaleX * stride] *= psx;
+        c[AnimPoseSoA::ScaleY * stride] *= psy;
+        c[AnimPoseSoA::ScaleZ * stride] *= psz;
+    }
+
+    _mm256_zeroupper();
+}
+
+#endif
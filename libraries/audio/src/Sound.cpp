@@ -14,7 +14,6 @@
 #include <glm/glm.hpp>
 
 #include <QRunnable>
-#include <QThreadPool>
 #include <QDataStream>
 #include <QtCore/QDebug>
 #include <QtNetwork/QNetworkRequest>
@@ -58,7 +57,7 @@ void Sound::downloadFinished(const QByteArray& data) {
     SoundProcessor* soundProcessor = new SoundProcessor(_url, data, _isStereo, _isAmbisonic);
     connect(soundProcessor, &SoundProcessor::onSuccess, this, &Sound::soundProcessSuccess);
     connect(soundProcessor, &SoundProcessor::onError, this, &Sound::soundProcessError);
-    QThreadPool::globalInstance()->start(soundProcessor);
+    ResourceCache::startDecode(soundProcessor, getLoadPriority());
 }
 
 void Sound::soundProcessSuccess(QByteArray data, bool stereo, bool ambisonic, float duration) {
@@ -77,6 +77,20 @@ size_t AvatarDataPacket::maxJointDataSize(size_t numJoints) {
     return totalSize;
 }
 
+size_t AvatarDataPacket::maxJointDeltaDataSize(size_t numJoints) {
+    size_t NUM_FAUX_JOINT = 2;
+    return JointDeltaCoding::maxEncodedSize((int)numJoints) +
+        NUM_FAUX_JOINT * (sizeof(SixByteQuat) + sizeof(SixByteTrans)); // faux joints
+}
+
+static unsigned char* packFauxJoint(unsigned char* destinationBuffer, const glm::mat4& matrix) {
+    Transform transform = Transform(matrix);
+    destinationBuffer += packOrientationQuatToSixBytes(destinationBuffer, transform.getRotation());
+    destinationBuffer += packFloatVec3ToSignedTwoByteFixed(destinationBuffer, transform.getTranslation(),
+        TRANSLATION_COMPRESSION_RADIX);
+    return destinationBuffer;
+}
+
 
 AvatarData::AvatarData() :
     SpatiallyNestable(NestableType::Avatar, QUuid()),
@@ -169,7 +183,8 @@ QByteArray AvatarData::toByteArrayStateful(AvatarDataDetail dataDetail, bool dro
 
 QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSentTime, const QVector<JointData>& lastSentJointData,
     AvatarDataPacket::HasFlags& hasFlagsOut, bool dropFaceTracking, bool distanceAdjust,
-    glm::vec3 viewerPosition, QVector<JointData>* sentJointDataOut, AvatarDataRate* outboundDataRateOut) const {
+    glm::vec3 viewerPosition, QVector<JointData>* sentJointDataOut, AvatarDataRate* outboundDataRateOut,
+    JointBaseline* jointBaseline) const {
 
     bool cullSmallChanges = (dataDetail == CullSmallData);
     bool sendAll = (dataDetail == SendAllData);
@@ -181,6 +196,7 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
     // special case, if we were asked for no data, then just include the flags all set to nothing
     if (dataDetail == NoData) {
         AvatarDataPacket::HasFlags packetStateFlags = 0;
+        hasFlagsOut = packetStateFlags;
         QByteArray avatarDataByteArray(reinterpret_cast<char*>(&packetStateFlags), sizeof(packetStateFlags));
         return avatarDataByteArray;
     }
@@ -243,10 +259,15 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
         hasJointData = sendAll || !sendMinimum;
     }
 
+    // if the caller keeps a baseline for the receiver, the joints are delta coded against it instead
+    bool hasJointDeltaData = hasJointData && jointBaseline;
+    hasJointData = hasJointData && !hasJointDeltaData;
+
 
     const size_t byteArraySize = AvatarDataPacket::MAX_CONSTANT_HEADER_SIZE +
         (hasFaceTrackerInfo ? AvatarDataPacket::maxFaceTrackerInfoSize(_headData->getNumSummedBlendshapeCoefficients()) : 0) +
-        (hasJointData ? AvatarDataPacket::maxJointDataSize(_jointData.size()) : 0);
+        (hasJointData ? AvatarDataPacket::maxJointDataSize(_jointData.size()) : 0) +
+        (hasJointDeltaData ? AvatarDataPacket::maxJointDeltaDataSize(_jointData.size()) : 0);
 
     QByteArray avatarDataByteArray((int)byteArraySize, 0);
     unsigned char* destinationBuffer = reinterpret_cast<unsigned char*>(avatarDataByteArray.data());
@@ -265,8 +286,10 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
         | (hasParentInfo ? AvatarDataPacket::PACKET_HAS_PARENT_INFO : 0)
         | (hasAvatarLocalPosition ? AvatarDataPacket::PACKET_HAS_AVATAR_LOCAL_POSITION : 0)
         | (hasFaceTrackerInfo ? AvatarDataPacket::PACKET_HAS_FACE_TRACKER_INFO : 0)
-        | (hasJointData ? AvatarDataPacket::PACKET_HAS_JOINT_DATA : 0);
+        | (hasJointData ? AvatarDataPacket::PACKET_HAS_JOINT_DATA : 0)
+        | (hasJointDeltaData ? AvatarDataPacket::PACKET_HAS_JOINT_DELTA_DATA : 0);
 
+    hasFlagsOut = packetStateFlags;
     memcpy(destinationBuffer, &packetStateFlags, sizeof(packetStateFlags));
     destinationBuffer += sizeof(packetStateFlags);
 
@@ -571,14 +594,8 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
         }
 
         // faux joints
-        Transform controllerLeftHandTransform = Transform(getControllerLeftHandMatrix());
-        destinationBuffer += packOrientationQuatToSixBytes(destinationBuffer, controllerLeftHandTransform.getRotation());
-        destinationBuffer += packFloatVec3ToSignedTwoByteFixed(destinationBuffer, controllerLeftHandTransform.getTranslation(),
-            TRANSLATION_COMPRESSION_RADIX);
-        Transform controllerRightHandTransform = Transform(getControllerRightHandMatrix());
-        destinationBuffer += packOrientationQuatToSixBytes(destinationBuffer, controllerRightHandTransform.getRotation());
-        destinationBuffer += packFloatVec3ToSignedTwoByteFixed(destinationBuffer, controllerRightHandTransform.getTranslation(),
-            TRANSLATION_COMPRESSION_RADIX);
+        destinationBuffer = packFauxJoint(destinationBuffer, getControllerLeftHandMatrix());
+        destinationBuffer = packFauxJoint(destinationBuffer, getControllerRightHandMatrix());
 
 #ifdef WANT_DEBUG
         if (sendAll) {
@@ -599,6 +616,37 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
         }
     }
 
+    if (hasJointDeltaData) {
+        auto startSection = destinationBuffer;
+        QReadLocker readLock(&_jointDataLock);
+
+        quint64 now = usecTimestampNow();
+        bool keyframe = sendAll || JointDeltaCoding::needsKeyframe(*jointBaseline, _jointData.size(), now);
+
+        // without culling, any change from the baseline is sent
+        float minRotationDOT = 1.0f;
+        float minTranslation = 0.0f;
+        if (cullSmallChanges) {
+            minRotationDOT = !distanceAdjust ? AVATAR_MIN_ROTATION_DOT : getDistanceBasedMinRotationDOT(viewerPosition);
+            minTranslation = !distanceAdjust ? AVATAR_MIN_TRANSLATION : getDistanceBasedMinTranslationDistance(viewerPosition);
+        }
+
+        destinationBuffer += JointDeltaCoding::encode(destinationBuffer, _jointData, *jointBaseline, keyframe,
+                                                      minRotationDOT, minTranslation);
+        if (keyframe) {
+            jointBaseline->timestamp = now;
+        }
+
+        // faux joints
+        destinationBuffer = packFauxJoint(destinationBuffer, getControllerLeftHandMatrix());
+        destinationBuffer = packFauxJoint(destinationBuffer, getControllerRightHandMatrix());
+
+        int numBytes = destinationBuffer - startSection;
+        if (outboundDataRateOut) {
+            outboundDataRateOut->jointDataRate.increment(numBytes);
+        }
+    }
+
     int avatarDataSize = destinationBuffer - startPosition;
 
     if (avatarDataSize > (int)byteArraySize) {
@@ -701,6 +749,7 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
     bool hasAvatarLocalPosition  = HAS_FLAG(packetStateFlags, AvatarDataPacket::PACKET_HAS_AVATAR_LOCAL_POSITION);
     bool hasFaceTrackerInfo      = HAS_FLAG(packetStateFlags, AvatarDataPacket::PACKET_HAS_FACE_TRACKER_INFO);
     bool hasJointData            = HAS_FLAG(packetStateFlags, AvatarDataPacket::PACKET_HAS_JOINT_DATA);
+    bool hasJointDeltaData       = HAS_FLAG(packetStateFlags, AvatarDataPacket::PACKET_HAS_JOINT_DELTA_DATA);
 
     quint64 now = usecTimestampNow();
 
@@ -1054,6 +1103,40 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
         _jointDataUpdateRate.increment();
     }
 
+    if (hasJointDeltaData) {
+        auto startSection = sourceBuffer;
+
+        QWriteLocker writeLock(&_jointDataLock);
+        bool baselineMissed = false;
+        int numBytesDecoded = JointDeltaCoding::decode(sourceBuffer, (int)(endPosition - sourceBuffer),
+                                                       _jointData, _jointDeltaBaseline, baselineMissed);
+        if (numBytesDecoded < 0) {
+            if (shouldLogError(now)) {
+                qCWarning(avatars) << "AvatarData packet too small, attempting to read JointDeltaData, only"
+                    << (endPosition - sourceBuffer) << "bytes left," << getSessionUUID();
+            }
+            return buffer.size();
+        }
+        sourceBuffer += numBytesDecoded;
+        if (baselineMissed) {
+            // the joints stay as they are until the next keyframe
+            _jointDeltaMissedUpdateRate.increment();
+        } else {
+            _hasNewJointData = true;
+        }
+        writeLock.unlock();
+
+        const int NUM_FAUX_JOINT = 2;
+        PACKET_READ_CHECK(FauxJoints,
+            NUM_FAUX_JOINT * (sizeof(AvatarDataPacket::SixByteQuat) + sizeof(AvatarDataPacket::SixByteTrans)));
+        sourceBuffer = unpackFauxJoint(sourceBuffer, _controllerLeftHandMatrixCache);
+        sourceBuffer = unpackFauxJoint(sourceBuffer, _controllerRightHandMatrixCache);
+
+        int numBytesRead = sourceBuffer - startSection;
+        _jointDataRate.increment(numBytesRead);
+        _jointDataUpdateRate.increment();
+    }
+
     int numBytesRead = sourceBuffer - startPosition;
     _averageBytesReceived.updateAverage(numBytesRead);
 
@@ -1145,6 +1228,8 @@ float AvatarData::getUpdateRate(const QString& rateName) const {
         return _faceTrackerUpdateRate.rate();
     } else if (rateName == "jointData") {
         return _jointDataUpdateRate.rate();
+    } else if (rateName == "jointDeltaMissed") {
+        return _jointDeltaMissedUpdateRate.rate();
     }
     return 0.0f;
 }
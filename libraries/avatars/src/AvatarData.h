@@ -65,6 +65,7 @@ typedef unsigned long long quint64;
 
 #include "AABox.h"
 #include "HeadData.h"
+#include "JointDeltaCoding.h"
 #include "PathUtils.h"
 
 using AvatarSharedPointer = std::shared_ptr<AvatarData>;
@@ -138,6 +139,7 @@ namespace AvatarDataPacket {
     const HasFlags PACKET_HAS_AVATAR_LOCAL_POSITION  = 1U << 9;
     const HasFlags PACKET_HAS_FACE_TRACKER_INFO      = 1U << 10;
     const HasFlags PACKET_HAS_JOINT_DATA             = 1U << 11;
+    const HasFlags PACKET_HAS_JOINT_DELTA_DATA       = 1U << 12;
     const size_t AVATAR_HAS_FLAGS_SIZE = 2;
 
     using SixByteQuat = uint8_t[6];
@@ -269,6 +271,17 @@ namespace AvatarDataPacket {
     };
     */
     size_t maxJointDataSize(size_t numJoints);
+
+    /*
+    struct JointDeltaData {
+        uint8_t joints[];                                      // encoded by JointDeltaCoding::encode(), see JointDeltaCoding.h
+        SixByteQuat leftHandControllerRotation;                // faux joints, same as after JointData
+        SixByteTrans leftHandControllerTranslation;
+        SixByteQuat rightHandControllerRotation;
+        SixByteTrans rightHandControllerTranslation;
+    };
+    */
+    size_t maxJointDeltaDataSize(size_t numJoints);
 }
 
 static const float MAX_AVATAR_SCALE = 1000.0f;
@@ -422,7 +435,8 @@ public:
 
     virtual QByteArray toByteArray(AvatarDataDetail dataDetail, quint64 lastSentTime, const QVector<JointData>& lastSentJointData,
         AvatarDataPacket::HasFlags& hasFlagsOut, bool dropFaceTracking, bool distanceAdjust, glm::vec3 viewerPosition,
-        QVector<JointData>* sentJointDataOut, AvatarDataRate* outboundDataRateOut = nullptr) const;
+        QVector<JointData>* sentJointDataOut, AvatarDataRate* outboundDataRateOut = nullptr,
+        JointBaseline* jointBaseline = nullptr) const;
 
     virtual void doneEncoding(bool cullSmallChanges);
 
@@ -719,6 +733,7 @@ protected:
 
     QVector<JointData> _jointData; ///< the state of the skeleton joints
     QVector<JointData> _lastSentJointData; ///< the state of the skeleton joints last time we transmitted
+    JointBaseline _jointDeltaBaseline; ///< the last joint keyframe we received, see JointDeltaCoding
     mutable QReadWriteLock _jointDataLock;
 
     // key state
@@ -799,6 +814,7 @@ protected:
     RateCounter<> _parentInfoUpdateRate;
     RateCounter<> _faceTrackerUpdateRate;
     RateCounter<> _jointDataUpdateRate;
+    RateCounter<> _jointDeltaMissedUpdateRate; // deltas dropped because we missed their keyframe
 
     // Some rate data for outgoing data
     AvatarDataRate _outboundDataRate;
@@ -0,0 +1,345 @@
+//
+//  JointDeltaCoding.cpp
+//  libraries/avatars/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "JointDeltaCoding.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include <glm/gtc/quaternion.hpp>
+
+#include <NumericalConstants.h>
+
+// rotation components of a normalized quaternion, other than the largest, are within +/- 1/sqrt(2)
+// this gives the same precision as packOrientationQuatToSixBytes()
+static const float ROTATION_SCALE = 16384.0f * sqrtf(2.0f);
+static const int ROTATION_WIDTHS[] = { 5, 8, 11, 16 };
+
+// same precision as packFloatVec3ToSignedTwoByteFixed() with TRANSLATION_COMPRESSION_RADIX
+static const float TRANSLATION_SCALE = (float)(1 << 12);
+static const int32_t MAX_TRANSLATION_VALUE = (1 << 16) - 1;
+static const int TRANSLATION_WIDTHS[] = { 6, 10, 13, 17 };
+
+static const int SIZE_CLASS_BITS = 2;
+static const int NUM_SIZE_CLASSES = 1 << SIZE_CLASS_BITS;
+
+// worst case bits per joint
+static const int MAX_ROTATION_BITS = 1 + 2 + 3 * (SIZE_CLASS_BITS + 16);
+static const int MAX_TRANSLATION_BITS = 1 + 3 * (SIZE_CLASS_BITS + 17);
+
+namespace {
+
+class BitWriter {
+public:
+    BitWriter(unsigned char* destination) : _destination(destination), _start(destination) {}
+
+    void write(uint32_t value, int numBits) {
+        _bits |= (uint64_t)(value & ((1ULL << numBits) - 1)) << _numBits;
+        _numBits += numBits;
+        while (_numBits >= BITS_IN_BYTE) {
+            *_destination++ = (unsigned char)(_bits & 0xff);
+            _bits >>= BITS_IN_BYTE;
+            _numBits -= BITS_IN_BYTE;
+        }
+    }
+
+    // pads to a byte boundary, returns the number of bytes written
+    int finish() {
+        if (_numBits > 0) {
+            *_destination++ = (unsigned char)(_bits & 0xff);
+            _bits = 0;
+            _numBits = 0;
+        }
+        return (int)(_destination - _start);
+    }
+
+private:
+    unsigned char* _destination;
+    unsigned char* _start;
+    uint64_t _bits { 0 };
+    int _numBits { 0 };
+};
+
+class BitReader {
+public:
+    BitReader(const unsigned char* source, int maxBytes) : _source(source), _start(source), _end(source + maxBytes) {}
+
+    // returns false if we ran off the end of the buffer
+    bool read(uint32_t& value, int numBits) {
+        while (_numBits < numBits) {
+            if (_source >= _end) {
+                return false;
+            }
+            _bits |= (uint64_t)(*_source++) << _numBits;
+            _numBits += BITS_IN_BYTE;
+        }
+        value = (uint32_t)(_bits & ((1ULL << numBits) - 1));
+        _bits >>= numBits;
+        _numBits -= numBits;
+        return true;
+    }
+
+    // any bits left in the current byte are padding
+    int bytesRead() const { return (int)(_source - _start); }
+
+private:
+    const unsigned char* _source;
+    const unsigned char* _start;
+    const unsigned char* _end;
+    uint64_t _bits { 0 };
+    int _numBits { 0 };
+};
+
+uint32_t zigzag(int32_t value) {
+    return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+int32_t unzigzag(uint32_t value) {
+    return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+void writeComponent(BitWriter& writer, int32_t value, const int* widths) {
+    uint32_t encoded = zigzag(value);
+    int sizeClass = 0;
+    while (sizeClass < NUM_SIZE_CLASSES - 1 && encoded >= (1U << widths[sizeClass])) {
+        sizeClass++;
+    }
+    writer.write(sizeClass, SIZE_CLASS_BITS);
+    writer.write(encoded, widths[sizeClass]);
+}
+
+bool readComponent(BitReader& reader, int32_t& value, const int* widths) {
+    uint32_t sizeClass, encoded;
+    if (!reader.read(sizeClass, SIZE_CLASS_BITS) || !reader.read(encoded, widths[sizeClass])) {
+        return false;
+    }
+    value = unzigzag(encoded);
+    return true;
+}
+
+// smallest-three quantization, the largest component is dropped and made positive.
+struct QuantizedRotation {
+    uint32_t largest;
+    int32_t components[3];
+};
+
+QuantizedRotation quantizeRotation(const glm::quat& rotation) {
+    QuantizedRotation result;
+    result.largest = 0;
+    for (int i = 1; i < 4; i++) {
+        if (fabsf(rotation[i]) > fabsf(rotation[result.largest])) {
+            result.largest = i;
+        }
+    }
+    glm::quat q = rotation[result.largest] < 0.0f ? -rotation : rotation;
+    for (int i = 0, j = 0; i < 4; i++) {
+        if (i != (int)result.largest) {
+            result.components[j++] = (int32_t)roundf(q[i] * ROTATION_SCALE);
+        }
+    }
+    return result;
+}
+
+glm::quat dequantizeRotation(const QuantizedRotation& quantized) {
+    glm::quat q;
+    float sumSquares = 0.0f;
+    for (int i = 0, j = 0; i < 4; i++) {
+        if (i != (int)quantized.largest) {
+            q[i] = (float)quantized.components[j++] / ROTATION_SCALE;
+            sumSquares += q[i] * q[i];
+        }
+    }
+    q[quantized.largest] = sqrtf(std::max(0.0f, 1.0f - sumSquares));
+    return glm::normalize(q);
+}
+
+int32_t quantizeTranslation(float value) {
+    int32_t result = (int32_t)roundf(value * TRANSLATION_SCALE);
+    return std::max(-MAX_TRANSLATION_VALUE, std::min(MAX_TRANSLATION_VALUE, result));
+}
+
+}
+
+size_t JointDeltaCoding::maxEncodedSize(int numJoints) {
+    size_t maxBits = (size_t)numJoints * (MAX_ROTATION_BITS + MAX_TRANSLATION_BITS);
+    return HEADER_SIZE + (maxBits + BITS_IN_BYTE - 1) / BITS_IN_BYTE;
+}
+
+bool JointDeltaCoding::needsKeyframe(const JointBaseline& baseline, int numJoints, quint64 now) {
+    return !baseline.isValid() || baseline.joints.size() != numJoints || now - baseline.timestamp > KEYFRAME_INTERVAL_USECS;
+}
+
+int JointDeltaCoding::encode(unsigned char* destination, const QVector<JointData>& joints, JointBaseline& baseline,
+                             bool keyframe, float minRotationDot, float minTranslation) {
+    int numJoints = joints.size();
+    assert(keyframe || (baseline.isValid() && baseline.joints.size() == numJoints));
+
+    if (keyframe) {
+        baseline.valid = true;
+        baseline.sequence++;
+        baseline.joints.fill(JointData(), numJoints);
+    }
+
+    destination[0] = (uint8_t)numJoints;
+    destination[1] = baseline.sequence;
+    destination[2] = keyframe ? FLAG_KEYFRAME : 0;
+
+    BitWriter writer(destination + HEADER_SIZE);
+    for (int i = 0; i < numJoints; i++) {
+        const JointData& data = joints[i];
+        JointData& reference = baseline.joints[i];
+
+        // rotation
+        glm::quat referenceRotation = keyframe ? glm::quat() : reference.rotation;
+        bool sendRotation = data.rotationSet &&
+            (keyframe || !reference.rotationSet || fabsf(glm::dot(data.rotation, referenceRotation)) < minRotationDot);
+        QuantizedRotation quantizedRotation;
+        if (sendRotation) {
+            quantizedRotation = quantizeRotation(glm::inverse(referenceRotation) * data.rotation);
+            // a delta that quantizes to identity is the same as sending nothing
+            sendRotation = keyframe || !reference.rotationSet || quantizedRotation.components[0] != 0 ||
+                quantizedRotation.components[1] != 0 || quantizedRotation.components[2] != 0;
+        }
+        writer.write(sendRotation ? 1 : 0, 1);
+        if (sendRotation) {
+            writer.write(quantizedRotation.largest, 2);
+            for (int j = 0; j < 3; j++) {
+                writeComponent(writer, quantizedRotation.components[j], ROTATION_WIDTHS);
+            }
+            if (keyframe) {
+                // remember what the receiver will decode, not what we have.
+                reference.rotation = dequantizeRotation(quantizedRotation);
+                reference.rotationSet = true;
+            }
+        }
+
+        // translation
+        glm::vec3 referenceTranslation = keyframe ? glm::vec3() : reference.translation;
+        bool sendTranslation = data.translationSet &&
+            (keyframe || !reference.translationSet || glm::distance(data.translation, referenceTranslation) > minTranslation);
+        int32_t quantizedTranslation[3];
+        if (sendTranslation) {
+            glm::vec3 delta = data.translation - referenceTranslation;
+            quantizedTranslation[0] = quantizeTranslation(delta.x);
+            quantizedTranslation[1] = quantizeTranslation(delta.y);
+            quantizedTranslation[2] = quantizeTranslation(delta.z);
+            sendTranslation = keyframe || !reference.translationSet || quantizedTranslation[0] != 0 ||
+                quantizedTranslation[1] != 0 || quantizedTranslation[2] != 0;
+        }
+        writer.write(sendTranslation ? 1 : 0, 1);
+        if (sendTranslation) {
+            for (int j = 0; j < 3; j++) {
+                writeComponent(writer, quantizedTranslation[j], TRANSLATION_WIDTHS);
+            }
+            if (keyframe) {
+                reference.translation =
+                    glm::vec3(quantizedTranslation[0], quantizedTranslation[1], quantizedTranslation[2]) / TRANSLATION_SCALE;
+                reference.translationSet = true;
+            }
+        }
+    }
+    return HEADER_SIZE + writer.finish();
+}
+
+int JointDeltaCoding::decode(const unsigned char* source, int maxBytes, QVector<JointData>& joints, JointBaseline& baseline,
+                             bool& baselineMissed) {
+    if (maxBytes < HEADER_SIZE) {
+        return -1;
+    }
+    int numJoints = source[0];
+    uint8_t sequence = source[1];
+    bool keyframe = (source[2] & FLAG_KEYFRAME) != 0;
+
+    // a delta against a baseline we don't have is parsed, but not applied.
+    baselineMissed = !keyframe &&
+        (!baseline.isValid() || baseline.sequence != sequence || baseline.joints.size() != numJoints);
+    bool apply = !baselineMissed;
+
+    if (keyframe) {
+        baseline.valid = true;
+        baseline.sequence = sequence;
+        baseline.joints.fill(JointData(), numJoints);
+    }
+    if (apply) {
+        joints.resize(numJoints);
+    }
+
+    // don't keep a partially decoded keyframe around
+    auto fail = [&] {
+        if (keyframe) {
+            baseline.invalidate();
+        }
+        return -1;
+    };
+
+    BitReader reader(source + HEADER_SIZE, maxBytes - HEADER_SIZE);
+    for (int i = 0; i < numJoints; i++) {
+        uint32_t present;
+
+        // rotation
+        if (!reader.read(present, 1)) {
+            return fail();
+        }
+        if (present) {
+            QuantizedRotation quantized;
+            if (!reader.read(quantized.largest, 2)) {
+                return fail();
+            }
+            for (int j = 0; j < 3; j++) {
+                if (!readComponent(reader, quantized.components[j], ROTATION_WIDTHS)) {
+                    return fail();
+                }
+            }
+            if (apply) {
+                glm::quat delta = dequantizeRotation(quantized);
+                if (keyframe) {
+                    baseline.joints[i].rotation = delta;
+                    baseline.joints[i].rotationSet = true;
+                    joints[i].rotation = delta;
+                } else {
+                    joints[i].rotation = baseline.joints[i].rotation * delta;
+                }
+                joints[i].rotationSet = true;
+            }
+        } else if (apply && !keyframe && baseline.joints[i].rotationSet) {
+            joints[i].rotation = baseline.joints[i].rotation;
+            joints[i].rotationSet = true;
+        }
+
+        // translation
+        if (!reader.read(present, 1)) {
+            return fail();
+        }
+        if (present) {
+            int32_t quantized[3];
+            for (int j = 0; j < 3; j++) {
+                if (!readComponent(reader, quantized[j], TRANSLATION_WIDTHS)) {
+                    return fail();
+                }
+            }
+            if (apply) {
+                glm::vec3 delta = glm::vec3(quantized[0], quantized[1], quantized[2]) / TRANSLATION_SCALE;
+                if (keyframe) {
+                    baseline.joints[i].translation = delta;
+                    baseline.joints[i].translationSet = true;
+                    joints[i].translation = delta;
+                } else {
+                    joints[i].translation = baseline.joints[i].translation + delta;
+                }
+                joints[i].translationSet = true;
+            }
+        } else if (apply && !keyframe && baseline.joints[i].translationSet) {
+            joints[i].translation = baseline.joints[i].translation;
+            joints[i].translationSet = true;
+        }
+    }
+    return HEADER_SIZE + reader.bytesRead();
+}
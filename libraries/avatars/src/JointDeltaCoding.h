@@ -0,0 +1,80 @@
+//
+//  JointDeltaCoding.h
+//  libraries/avatars/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_JointDeltaCoding_h
+#define hifi_JointDeltaCoding_h
+
+#include <stdint.h>
+
+#include <QVector>
+
+#include <JointData.h>
+#include <NumericalConstants.h>
+
+// Delta coding of avatar joint data.
+//
+// Joints are coded against a baseline, the last keyframe the sender sent to a given receiver.
+// A keyframe is coded against the identity pose and replaces the baseline on both ends.
+// Rotations are sent as the smallest-three components of (baseline^-1 * rotation) and translations
+// as (translation - baseline), each component quantized and written with a 2 bit size class,
+// so that small deltas cost only a few bits.  A joint with no bits set is equal to the baseline.
+//
+// Avatar data is unreliable and there is no acknowledgement channel, so a receiver that missed a
+// keyframe ignores deltas until the next one arrives (see JointBaseline::sequence).
+
+class JointBaseline {
+public:
+    bool isValid() const { return valid; }
+    void invalidate() { valid = false; joints.clear(); }
+
+    bool valid { false };
+    uint8_t sequence { 0 };
+    quint64 timestamp { 0 };
+    QVector<JointData> joints;
+};
+
+namespace JointDeltaCoding {
+    const uint8_t FLAG_KEYFRAME = 1U << 0;
+
+    /*
+    struct JointDeltaData {
+        uint8_t numJoints;
+        uint8_t baselineSequence;
+        uint8_t flags;                // FLAG_KEYFRAME
+        bits    joints[numJoints];    // rotation: 1 bit present, 2 bit largest component, 3 x component
+                                      // translation: 1 bit present, 3 x component
+                                      // component: 2 bit size class, zigzag value in ROTATION/TRANSLATION_WIDTHS[class] bits
+                                      // padded to a byte boundary
+    };
+    */
+    const int HEADER_SIZE = 3;
+
+    // a receiver that missed a keyframe is stale for at most this long
+    const quint64 KEYFRAME_INTERVAL_USECS = 500 * USECS_PER_MSEC;
+
+    size_t maxEncodedSize(int numJoints);
+
+    bool needsKeyframe(const JointBaseline& baseline, int numJoints, quint64 now);
+
+    // Encodes joints against baseline, or against the identity pose when keyframe is true, in which case
+    // baseline is replaced with the (quantized) joints and its sequence advanced.
+    // Rotations within minRotationDot and translations within minTranslation of the baseline are not sent.
+    // Returns the number of bytes written.
+    int encode(unsigned char* destination, const QVector<JointData>& joints, JointBaseline& baseline, bool keyframe,
+               float minRotationDot, float minTranslation);
+
+    // Decodes into joints.  On a keyframe, baseline is replaced.  On a delta against a baseline we don't have,
+    // the data is skipped, joints is left untouched and baselineMissed is set.
+    // Returns the number of bytes read, or -1 if the buffer was too small.
+    int decode(const unsigned char* source, int maxBytes, QVector<JointData>& joints, JointBaseline& baseline,
+               bool& baselineMissed);
+}
+
+#endif // hifi_JointDeltaCoding_h
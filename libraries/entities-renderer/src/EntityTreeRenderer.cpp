@@ -11,11 +11,14 @@
 
 #include "EntityTreeRenderer.h"
 
+#include <algorithm>
+
 #include <glm/gtx/quaternion.hpp>
 
 #include <QEventLoop>
 #include <QScriptSyntaxCheckResult>
 #include <QThreadPool>
+#include <QtConcurrent/QtConcurrentMap>
 
 #include <shared/QtHelpers.h>
 #include <ColorUtils.h>
@@ -30,10 +33,12 @@
 #include <Rig.h>
 #include <EntitySimulation.h>
 #include <AddressManager.h>
+#include <ViewFrustum.h>
 #include <ZoneRenderer.h>
 
 #include "EntitiesRendererLogging.h"
 #include "RenderableEntityItem.h"
+#include "RenderableParticleEffectEntityItem.h"
 
 size_t std::hash<EntityItemID>::operator()(const EntityItemID& id) const { return qHash(id); }
 std::function<bool()> EntityTreeRenderer::_entitiesShouldFadeFunction;
@@ -134,6 +139,8 @@ void EntityTreeRenderer::clear() {
         qCWarning(entitiesrenderer) << "EntitityTreeRenderer::clear(), Unexpected null scene, possibly during application shutdown";
     }
     _entitiesInScene.clear();
+    _renderablesToUpdate.clear();
+    _particleEffectsInScene.clear();
 
     // reset the zone to the default (while we load the next scene)
     _layeredZones.clear();
@@ -197,33 +204,124 @@ void EntityTreeRenderer::update(bool simulate) {
             }
         }
 
-        std::unordered_set<EntityItemID> changedEntities;
-        // FIXME Weird build failure in latest VC update that fails to compile when using std::swap
-        _changedEntitiesGuard.withWriteLock([&] {
-            changedEntities.insert(_changedEntities.begin(), _changedEntities.end());
-            _changedEntities.clear();
-        });
-
-        for (const auto& entityId : changedEntities) {
-            auto renderable = renderableForEntityId(entityId);
-            if (!renderable) {
-                continue;
-            }
+        auto scene = _viewState->getMain3DScene();
+        if (scene) {
+            updateChangedEntities(scene);
+        }
+
+        simulateParticleEffects();
+    }
+}
+
+void EntityTreeRenderer::simulateParticleEffects() {
+    PerformanceTimer perfTimer("simulateParticles");
+    if (_particleEffectsInScene.empty()) {
+        return;
+    }
+
+    // every emitter only touches its own particles, so they can all be stepped at once.
+    // the renderers upload the results the next time they render.
+    _particleEffectsToSimulate.clear();
+    _particleEffectsToSimulate.reserve(_particleEffectsInScene.size());
+    for (const auto& entry : _particleEffectsInScene) {
+        _particleEffectsToSimulate.push_back(entry.second);
+    }
+    const uint64_t now = usecTimestampNow();
+    QtConcurrent::blockingMap(_particleEffectsToSimulate, [now](const ParticleEffectRendererPointer& renderer) {
+        renderer->stepSimulation(now);
+    });
+}
+
+const quint64 EntityTreeRenderer::DEFAULT_RENDERABLE_UPDATE_BUDGET = 2 * USECS_PER_MSEC;
+// size on screen ranks renderables from -1 to 1, so after 20 frames of waiting even one out of view ranks with the
+// biggest one that just changed
+const float AGING_PRIORITY_PER_FRAME = 0.1f;
+
+void EntityTreeRenderer::updateChangedEntities(const render::ScenePointer& scene) {
+    PerformanceTimer perfTimer("updateRenderables");
+    std::unordered_set<EntityItemID> changedEntities;
+    // FIXME Weird build failure in latest VC update that fails to compile when using std::swap
+    _changedEntitiesGuard.withWriteLock([&] {
+        changedEntities.insert(_changedEntities.begin(), _changedEntities.end());
+        _changedEntities.clear();
+    });
 
-            _renderablesToUpdate.insert({ entityId, renderable });
+    for (const auto& entityId : changedEntities) {
+        auto renderable = renderableForEntityId(entityId);
+        if (!renderable) {
+            continue;
         }
 
-        auto scene = _viewState->getMain3DScene();
-        if (scene && !_renderablesToUpdate.empty()) {
-            render::Transaction transaction;
-            for (const auto& entry : _renderablesToUpdate) {
-                const auto& renderable = entry.second;
-                renderable->updateInScene(scene, transaction);
+        // the entity may have a new renderer since it was queued, but it keeps its place in line
+        _renderablesToUpdate[entityId].renderable = renderable;
+    }
+
+    _numRenderablesUpdated = 0;
+    if (_renderablesToUpdate.empty()) {
+        _lastRenderableUpdateTime = 0;
+        return;
+    }
+
+    render::Transaction transaction;
+    quint64 start = usecTimestampNow();
+    float expectedCost = _avgRenderableUpdateCost * _renderablesToUpdate.size();
+    if (_renderableUpdateBudget == 0 || expectedCost < (float)_renderableUpdateBudget) {
+        for (const auto& entry : _renderablesToUpdate) {
+            const auto& renderable = entry.second.renderable;
+            renderable->updateInScene(scene, transaction);
+        }
+        _numRenderablesUpdated = (int)_renderablesToUpdate.size();
+        _renderablesToUpdate.clear();
+    } else {
+        // too many to do in one frame, as on scene load: update the ones that look biggest first, but let the
+        // others catch up as they wait so that they are not starved while the load stays high
+        ViewFrustum view;
+        _viewState->copyCurrentViewFrustum(view);
+        const glm::vec3& viewPosition = view.getPosition();
+
+        using SortedRenderable = std::pair<float, EntityItemID>;
+        std::vector<SortedRenderable> sortedRenderables;
+        sortedRenderables.reserve(_renderablesToUpdate.size());
+        for (const auto& entry : _renderablesToUpdate) {
+            const auto& entity = entry.second.renderable->getEntity();
+            bool success = false;
+            AABox bound = entity ? entity->getAABox(success) : AABox();
+            float priority = 0.0f;
+            if (success) {
+                float radius = 0.5f * glm::length(bound.getScale());
+                float distance = glm::distance(bound.calcCenter(), viewPosition);
+                priority = radius / glm::max(distance, glm::max(radius, 0.001f));
+                if (!view.boxIntersectsKeyhole(bound)) {
+                    // out of view, so only after everything that is in view
+                    priority -= 1.0f;
+                }
+            }
+            priority += AGING_PRIORITY_PER_FRAME * entry.second.framesWaited;
+            sortedRenderables.push_back({ priority, entry.first });
+        }
+        std::sort(sortedRenderables.begin(), sortedRenderables.end(),
+            [](const SortedRenderable& a, const SortedRenderable& b) { return a.first > b.first; });
+
+        // always update at least one, so that a slow renderable can't hold up the rest forever
+        for (const auto& sortedRenderable : sortedRenderables) {
+            auto itr = _renderablesToUpdate.find(sortedRenderable.second);
+            itr->second.renderable->updateInScene(scene, transaction);
+            _renderablesToUpdate.erase(itr);
+            _numRenderablesUpdated++;
+            if (usecTimestampNow() - start > _renderableUpdateBudget) {
+                break;
             }
-            _renderablesToUpdate.clear();
-            scene->enqueueTransaction(transaction);
+        }
+        for (auto& entry : _renderablesToUpdate) {
+            entry.second.framesWaited++;
         }
     }
+    scene->enqueueTransaction(transaction);
+
+    _lastRenderableUpdateTime = usecTimestampNow() - start;
+    float cost = (float)_lastRenderableUpdateTime / (float)_numRenderablesUpdated;
+    const float COST_BLEND = 0.1f;
+    _avgRenderableUpdateCost = (1.0f - COST_BLEND) * _avgRenderableUpdateCost + COST_BLEND * cost;
 }
 
 bool EntityTreeRenderer::findBestZoneAndMaybeContainingEntities(QVector<EntityItemID>* entitiesContainingAvatar) {
@@ -725,6 +823,8 @@ void EntityTreeRenderer::deletingEntity(const EntityItemID& entityID) {
 
     auto renderable = itr->second;
     _entitiesInScene.erase(itr);
+    _renderablesToUpdate.erase(entityID);
+    _particleEffectsInScene.erase(entityID);
 
     if (!renderable) {
         qCWarning(entitiesrenderer) << "EntityTreeRenderer::deletingEntity(), trying to remove non-renderable entity";
@@ -759,6 +859,10 @@ void EntityTreeRenderer::addEntityToScene(const EntityItemPointer& entity) {
     auto renderable = EntityRenderer::addToScene(*this, entity, scene);
     if (renderable) {
         _entitiesInScene[entity->getEntityItemID()] = renderable;
+        if (entity->getType() == EntityTypes::ParticleEffect) {
+            _particleEffectsInScene[entity->getEntityItemID()] =
+                std::static_pointer_cast<render::entities::ParticleEffectEntityRenderer>(renderable);
+        }
     }
 }
 
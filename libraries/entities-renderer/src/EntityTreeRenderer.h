@@ -36,6 +36,7 @@ namespace render { namespace entities {
     class EntityRenderer;
     using EntityRendererPointer = std::shared_ptr<EntityRenderer>;
     using EntityRendererWeakPointer = std::weak_ptr<EntityRenderer>;
+    class ParticleEffectEntityRenderer;
 } }
 
 // Allow the use of std::unordered_map with QUuid keys
@@ -80,6 +81,17 @@ public:
     void shutdown();
     void update(bool simulate);
 
+    // the main thread time each frame may spend updating changed renderables, more than that waits for the next
+    // frame, 0 updates every changed renderable in the frame it changed
+    static const quint64 DEFAULT_RENDERABLE_UPDATE_BUDGET; // usecs
+    void setRenderableUpdateBudget(quint64 usecs) { _renderableUpdateBudget = usecs; }
+    quint64 getRenderableUpdateBudget() const { return _renderableUpdateBudget; }
+
+    // the time the last update spent on changed renderables, how many it updated, and how many it left for later frames
+    quint64 getLastRenderableUpdateTime() const { return _lastRenderableUpdateTime; }
+    int getNumRenderablesUpdated() const { return _numRenderablesUpdated; }
+    int getNumRenderablesDeferred() const { return (int)_renderablesToUpdate.size(); }
+
     EntityTreePointer getTree() { return std::static_pointer_cast<EntityTree>(_tree); }
 
     void processEraseMessage(ReceivedMessage& message, const SharedNodePointer& sourceNode);
@@ -163,6 +175,8 @@ private:
     void resetEntitiesScriptEngine();
 
     void addEntityToScene(const EntityItemPointer& entity);
+    void updateChangedEntities(const render::ScenePointer& scene);
+    void simulateParticleEffects();
     bool findBestZoneAndMaybeContainingEntities(QVector<EntityItemID>* entitiesContainingAvatar = nullptr);
 
     bool applyLayeredZones();
@@ -258,8 +272,20 @@ private:
     ReadWriteLockable _changedEntitiesGuard;
     std::unordered_set<EntityItemID> _changedEntities;
 
-    std::unordered_map<EntityItemID, EntityRendererPointer> _renderablesToUpdate;
+    class RenderableToUpdate {
+    public:
+        EntityRendererPointer renderable;
+        int framesWaited { 0 };
+    };
+    std::unordered_map<EntityItemID, RenderableToUpdate> _renderablesToUpdate;
+    quint64 _renderableUpdateBudget { DEFAULT_RENDERABLE_UPDATE_BUDGET };
+    float _avgRenderableUpdateCost { 10.0f }; // usecs, a guess until the first updates are measured
+    quint64 _lastRenderableUpdateTime { 0 };
+    int _numRenderablesUpdated { 0 };
     std::unordered_map<EntityItemID, EntityRendererPointer> _entitiesInScene;
+    using ParticleEffectRendererPointer = std::shared_ptr<render::entities::ParticleEffectEntityRenderer>;
+    std::unordered_map<EntityItemID, ParticleEffectRendererPointer> _particleEffectsInScene;
+    std::vector<ParticleEffectRendererPointer> _particleEffectsToSimulate;
     // For Scene.shouldRenderEntities
     QList<EntityItemID> _entityIDsLastInScene;
 
@@ -0,0 +1,83 @@
+//
+//  PolyVoxChunkMeshing.cpp
+//  libraries/entities-renderer/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PolyVoxChunkMeshing.h"
+
+#include <QDataStream>
+
+#ifdef _WIN32
+#pragma warning(push)
+#pragma warning( disable : 4267 )
+#endif
+#include <PolyVoxCore/CubicSurfaceExtractorWithNormals.h>
+#include <PolyVoxCore/MarchingCubesSurfaceExtractor.h>
+#include <PolyVoxCore/Material.h>
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+
+void extractSurface(PolyVox::SimpleVolume<uint8_t>* volData, const PolyVox::Region& region,
+                    PolyVoxEntityItem::PolyVoxSurfaceStyle voxelSurfaceStyle, PolyVoxMesh& polyVoxMesh) {
+    switch (voxelSurfaceStyle) {
+        case PolyVoxEntityItem::SURFACE_EDGED_MARCHING_CUBES:
+        case PolyVoxEntityItem::SURFACE_MARCHING_CUBES: {
+            PolyVox::MarchingCubesSurfaceExtractor<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
+                (volData, region, &polyVoxMesh);
+            surfaceExtractor.execute();
+            break;
+        }
+        case PolyVoxEntityItem::SURFACE_EDGED_CUBIC:
+        case PolyVoxEntityItem::SURFACE_CUBIC: {
+            PolyVox::CubicSurfaceExtractorWithNormals<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
+                (volData, region, &polyVoxMesh);
+            surfaceExtractor.execute();
+            break;
+        }
+    }
+}
+
+void extractChunkSurfaces(PolyVox::SimpleVolume<uint8_t>* volData, const VoxelChunkGrid& chunks,
+                          const std::vector<int>& dirtyChunks, PolyVoxEntityItem::PolyVoxSurfaceStyle voxelSurfaceStyle,
+                          std::vector<PolyVoxMesh>& chunkMeshes) {
+    for (int chunk : dirtyChunks) {
+        glm::ivec3 low = chunks.getChunkLow(chunk);
+        glm::ivec3 high = chunks.getChunkHigh(chunk);
+        PolyVox::Region region(PolyVox::Vector3DInt32(low.x, low.y, low.z),
+                               PolyVox::Vector3DInt32(high.x, high.y, high.z));
+        chunkMeshes[chunk].clear();
+        extractSurface(volData, region, voxelSurfaceStyle, chunkMeshes[chunk]);
+    }
+}
+
+void stitchChunkSurfaces(const VoxelChunkGrid& chunks, const std::vector<PolyVoxMesh>& chunkMeshes,
+                         std::vector<PolyVox::PositionMaterialNormal>& vertices, std::vector<uint32_t>& indices) {
+    for (int chunk = 0; chunk < (int)chunkMeshes.size(); chunk++) {
+        const auto& chunkMesh = chunkMeshes[chunk];
+        glm::ivec3 low = chunks.getChunkLow(chunk);
+        PolyVox::Vector3DFloat offset((float)low.x, (float)low.y, (float)low.z);
+        uint32_t baseVertex = (uint32_t)vertices.size();
+        for (auto vertex : chunkMesh.getRawVertexData()) {
+            vertex.setPosition(vertex.getPosition() + offset);
+            vertices.push_back(vertex);
+        }
+        for (uint32_t index : chunkMesh.getIndices()) {
+            indices.push_back(baseVertex + index);
+        }
+    }
+}
+
+QByteArray compressVoxelData(quint16 voxelXSize, quint16 voxelYSize, quint16 voxelZSize,
+                             const QByteArray& uncompressedData) {
+    QByteArray voxelData;
+    QDataStream writer(&voxelData, QIODevice::WriteOnly | QIODevice::Truncate);
+    writer << voxelXSize << voxelYSize << voxelZSize;
+    writer << qCompress(uncompressedData, 9);
+    return voxelData;
+}
@@ -0,0 +1,53 @@
+//
+//  PolyVoxChunkMeshing.h
+//  libraries/entities-renderer/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Extracts the surface of a PolyVox volume one VoxelChunkGrid chunk at a time and stitches the chunk meshes
+//  into the mesh of the whole volume.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PolyVoxChunkMeshing_h
+#define hifi_PolyVoxChunkMeshing_h
+
+#include <vector>
+
+#include <QByteArray>
+
+#ifdef _WIN32
+#pragma warning(push)
+#pragma warning( disable : 4267 )
+#endif
+#include <PolyVoxCore/SimpleVolume.h>
+#include <PolyVoxCore/SurfaceMesh.h>
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+
+#include <PolyVoxEntityItem.h>
+#include <VoxelChunkGrid.h>
+
+using PolyVoxMesh = PolyVox::SurfaceMesh<PolyVox::PositionMaterialNormal>;
+
+// the extractors place vertices relative to the low corner of the region
+void extractSurface(PolyVox::SimpleVolume<uint8_t>* volData, const PolyVox::Region& region,
+                    PolyVoxEntityItem::PolyVoxSurfaceStyle voxelSurfaceStyle, PolyVoxMesh& polyVoxMesh);
+
+// re-extracts the listed chunks, chunkMeshes has a mesh for every chunk of the grid
+void extractChunkSurfaces(PolyVox::SimpleVolume<uint8_t>* volData, const VoxelChunkGrid& chunks,
+                          const std::vector<int>& dirtyChunks, PolyVoxEntityItem::PolyVoxSurfaceStyle voxelSurfaceStyle,
+                          std::vector<PolyVoxMesh>& chunkMeshes);
+
+// appends the chunk meshes to one mesh in the coordinates of the volume
+void stitchChunkSurfaces(const VoxelChunkGrid& chunks, const std::vector<PolyVoxMesh>& chunkMeshes,
+                         std::vector<PolyVox::PositionMaterialNormal>& vertices, std::vector<uint32_t>& indices);
+
+// the voxel data property of a polyvox: its size and its voxels compressed
+QByteArray compressVoxelData(quint16 voxelXSize, quint16 voxelYSize, quint16 voxelZSize,
+                             const QByteArray& uncompressedData);
+
+#endif // hifi_PolyVoxChunkMeshing_h
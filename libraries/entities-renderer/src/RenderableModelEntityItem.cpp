@@ -1122,6 +1122,8 @@ void ModelEntityRenderer::doRenderUpdateSynchronousTyped(const ScenePointer& sce
 
     // Nothing else to do unless the model is loaded
     if (!model->isLoaded()) {
+        // keep the download ordered by how large the entity appears right now
+        model->setLoadingPriority(EntityTreeRenderer::getEntityLoadingPriority(*entity));
         return;
     }
 
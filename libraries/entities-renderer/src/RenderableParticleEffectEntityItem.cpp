@@ -44,14 +44,6 @@ static ShapePipelinePointer shapePipelineFactory(const ShapePlumber& plumber, co
     return std::make_shared<render::ShapePipeline>(texturedPipeline, nullptr, nullptr, nullptr);
 }
 
-struct GpuParticle {
-    GpuParticle(const glm::vec3& xyzIn, const glm::vec2& uvIn) : xyz(xyzIn), uv(uvIn) {}
-    glm::vec3 xyz; // Position
-    glm::vec2 uv; // Lifetime + seed
-};
-
-using GpuParticles = std::vector<GpuParticle>;
-
 ParticleEffectEntityRenderer::ParticleEffectEntityRenderer(const EntityItemPointer& entity) : Parent(entity) {
     ParticleUniforms uniforms;
     _uniformBuffer = std::make_shared<Buffer>(sizeof(ParticleUniforms), (const gpu::Byte*) &uniforms);
@@ -155,9 +147,18 @@ bool ParticleEffectEntityRenderer::emitting() const {
     );
 }
 
-void ParticleEffectEntityRenderer::createParticle(uint64_t now) {
-    CpuParticle particle;
+// the random numbers each emitted particle uses, see emitParticles()
+enum EmitRandom {
+    EMIT_RANDOM_SEED = 0,
+    EMIT_RANDOM_ACCELERATION,
+    EMIT_RANDOM_SPEED,
+    EMIT_RANDOM_ELEVATION,
+    EMIT_RANDOM_AZIMUTH,
+    EMIT_RANDOM_RADIUS,
+    NUM_EMIT_RANDOMS
+};
 
+void ParticleEffectEntityRenderer::emitParticles(uint64_t now, size_t first, size_t count) {
     const auto& accelerationSpread = _particleProperties.emission.acceleration.spread;
     const auto& azimuthStart = _particleProperties.azimuth.start;
     const auto& azimuthFinish = _particleProperties.azimuth.finish;
@@ -170,19 +171,32 @@ void ParticleEffectEntityRenderer::createParticle(uint64_t now) {
     const auto& polarStart = _particleProperties.polar.start;
     const auto& polarFinish = _particleProperties.polar.finish;
 
-    particle.seed = randFloatInRange(-1.0f, 1.0f);
-    particle.expiration = now + (uint64_t)(_particleProperties.lifespan * USECS_PER_SECOND);
+    // draw all the random numbers for the batch at once, each in [0, 1)
+    _emitRandoms.resize(count * NUM_EMIT_RANDOMS);
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+    for (auto& random : _emitRandoms) {
+        random = distribution(_randomGenerator);
+    }
+    const float* random = _emitRandoms.data();
+
+    // everything below that doesn't depend on a random number is the same for the whole batch
+    uint64_t expiration = now + (uint64_t)(_particleProperties.lifespan * USECS_PER_SECOND);
+    glm::vec3 origin(0.0f);
     if (_particleProperties.emission.shouldTrail) {
-        particle.position = _modelTransform.getTranslation();
+        origin = _modelTransform.getTranslation();
         emitOrientation = _modelTransform.getRotation() * emitOrientation;
     }
 
     // Position, velocity, and acceleration
     if (polarStart == 0.0f && polarFinish == 0.0f && emitDimensions.z == 0.0f) {
         // Emit along z-axis from position
+        glm::vec3 velocity = (emitSpeed + 0.2f * speedSpread) * (emitOrientation * Vectors::UNIT_Z);
 
-        particle.velocity = (emitSpeed + 0.2f * speedSpread) * (emitOrientation * Vectors::UNIT_Z);
-        particle.acceleration = emitAcceleration + randFloatInRange(-1.0f, 1.0f) * accelerationSpread;
+        for (size_t i = 0; i < count; i++, random += NUM_EMIT_RANDOMS) {
+            float seed = 2.0f * random[EMIT_RANDOM_SEED] - 1.0f;
+            glm::vec3 acceleration = emitAcceleration + (2.0f * random[EMIT_RANDOM_ACCELERATION] - 1.0f) * accelerationSpread;
+            _cpuParticles.set(first + i, seed, expiration, origin, velocity, acceleration);
+        }
 
     } else {
         // Emit around point or from ellipsoid
@@ -192,102 +206,99 @@ void ParticleEffectEntityRenderer::createParticle(uint64_t now) {
 
         float elevationMinZ = sin(PI_OVER_TWO - polarFinish);
         float elevationMaxZ = sin(PI_OVER_TWO - polarStart);
-        //  float elevation = asin(elevationMinZ + (elevationMaxZ - elevationMinZ) * randFloat());
-        float elevation = asin(elevationMinZ + (elevationMaxZ - elevationMinZ) *randFloat());
-
-        float azimuth;
-        if (azimuthFinish >= azimuthStart) {
-            azimuth = azimuthStart + (azimuthFinish - azimuthStart) *  randFloat();
-        } else {
-            azimuth = azimuthStart + (TWO_PI + azimuthFinish - azimuthStart) * randFloat();
-        }
+        float azimuthRange = (azimuthFinish >= azimuthStart) ? azimuthFinish - azimuthStart : TWO_PI + azimuthFinish - azimuthStart;
+
+        for (size_t i = 0; i < count; i++, random += NUM_EMIT_RANDOMS) {
+            float seed = 2.0f * random[EMIT_RANDOM_SEED] - 1.0f;
+            float elevation = asin(elevationMinZ + (elevationMaxZ - elevationMinZ) * random[EMIT_RANDOM_ELEVATION]);
+            float azimuth = azimuthStart + azimuthRange * random[EMIT_RANDOM_AZIMUTH];
+
+            glm::vec3 position = origin;
+            glm::vec3 emitDirection;
+            if (emitDimensions == Vectors::ZERO) {
+                // Point
+                emitDirection = glm::quat(glm::vec3(PI_OVER_TWO - elevation, 0.0f, azimuth)) * Vectors::UNIT_Z;
+            } else {
+                // Ellipsoid
+                float radiusScale = 1.0f;
+                if (emitRadiusStart < 1.0f) {
+                    float randRadius =
+                        emitRadiusStart + (particle::MAXIMUM_EMIT_RADIUS_START - emitRadiusStart) * random[EMIT_RANDOM_RADIUS];
+                    radiusScale = 1.0f - std::pow(1.0f - randRadius, 3.0f);
+                }
 
-        glm::vec3 emitDirection;
-        if (emitDimensions == Vectors::ZERO) {
-            // Point
-            emitDirection = glm::quat(glm::vec3(PI_OVER_TWO - elevation, 0.0f, azimuth)) * Vectors::UNIT_Z;
-        } else {
-            // Ellipsoid
-            float radiusScale = 1.0f;
-            if (emitRadiusStart < 1.0f) {
-                float randRadius =
-                    emitRadiusStart + randFloatInRange(0.0f, particle::MAXIMUM_EMIT_RADIUS_START - emitRadiusStart);
-                radiusScale = 1.0f - std::pow(1.0f - randRadius, 3.0f);
+                glm::vec3 radii = radiusScale * 0.5f * emitDimensions;
+                float x = radii.x * glm::cos(elevation) * glm::cos(azimuth);
+                float y = radii.y * glm::cos(elevation) * glm::sin(azimuth);
+                float z = radii.z * glm::sin(elevation);
+                glm::vec3 emitPosition = glm::vec3(x, y, z);
+                emitDirection = glm::normalize(glm::vec3(
+                    radii.x > 0.0f ? x / (radii.x * radii.x) : 0.0f,
+                    radii.y > 0.0f ? y / (radii.y * radii.y) : 0.0f,
+                    radii.z > 0.0f ? z / (radii.z * radii.z) : 0.0f
+                ));
+                position += emitOrientation * emitPosition;
             }
 
-            glm::vec3 radii = radiusScale * 0.5f * emitDimensions;
-            float x = radii.x * glm::cos(elevation) * glm::cos(azimuth);
-            float y = radii.y * glm::cos(elevation) * glm::sin(azimuth);
-            float z = radii.z * glm::sin(elevation);
-            glm::vec3 emitPosition = glm::vec3(x, y, z);
-            emitDirection = glm::normalize(glm::vec3(
-                radii.x > 0.0f ? x / (radii.x * radii.x) : 0.0f,
-                radii.y > 0.0f ? y / (radii.y * radii.y) : 0.0f,
-                radii.z > 0.0f ? z / (radii.z * radii.z) : 0.0f
-            ));
-            particle.position += emitOrientation * emitPosition;
+            glm::vec3 velocity = (emitSpeed + (2.0f * random[EMIT_RANDOM_SPEED] - 1.0f) * speedSpread) * (emitOrientation * emitDirection);
+            glm::vec3 acceleration = emitAcceleration + (2.0f * random[EMIT_RANDOM_ACCELERATION] - 1.0f) * accelerationSpread;
+            _cpuParticles.set(first + i, seed, expiration, position, velocity, acceleration);
         }
-
-        particle.velocity = (emitSpeed + randFloatInRange(-1.0f, 1.0f) * speedSpread) * (emitOrientation * emitDirection);
-        particle.acceleration = emitAcceleration + randFloatInRange(-1.0f, 1.0f) * accelerationSpread;
     }
-
-    _cpuParticles.push_back(particle);
 }
 
-void ParticleEffectEntityRenderer::stepSimulation() {
+void ParticleEffectEntityRenderer::stepSimulation(uint64_t now) {
+    if (!_visible) {
+        return;
+    }
+
     if (_lastSimulated == 0) {
-        _lastSimulated = usecTimestampNow();
+        _lastSimulated = now;
         return;
     }
 
-    const auto now = usecTimestampNow();
     const auto interval = std::min<uint64_t>(USECS_PER_SECOND / 60, now - _lastSimulated);
     _lastSimulated = now;
 
     if (emitting()) {
         uint64_t emitInterval = (uint64_t)(USECS_PER_SECOND / _particleProperties.emission.rate);
         if (interval >= _timeUntilNextEmit) {
+            // count the particles due this frame, then emit them all at once
+            size_t numToEmit = 0;
             auto timeRemaining = interval;
             while (timeRemaining > _timeUntilNextEmit) {
-                // emit particle
-                createParticle(now);
+                numToEmit++;
                 _timeUntilNextEmit = emitInterval;
                 if (emitInterval < timeRemaining) {
                     timeRemaining -= emitInterval;
                 }
             }
+            emitParticles(now, _cpuParticles.append(numToEmit), numToEmit);
         } else {
             _timeUntilNextEmit -= interval;
         }
     }
 
     // Kill any particles that have expired or are over the max size
-    while (_cpuParticles.size() > _particleProperties.maxParticles || (!_cpuParticles.empty() && _cpuParticles.front().expiration <= now)) {
-        _cpuParticles.pop_front();
-    }
+    _cpuParticles.expire(now, _particleProperties.maxParticles);
 
     const float deltaTime = (float)interval / (float)USECS_PER_SECOND;
     // update the particles 
-    for (auto& particle : _cpuParticles) {
-        particle.integrate(deltaTime);
-    }
+    _cpuParticles.integrate(deltaTime);
 
-    // Build particle primitives
-    static GpuParticles gpuParticles;
+    // Build particle primitives in the back buffer, doRender() only reads the front one
+    size_t numParticles = _cpuParticles.size();
+    GpuParticles& gpuParticles = _stagingParticles[_stagingBack];
     gpuParticles.clear();
-    gpuParticles.reserve(_cpuParticles.size()); // Reserve space
-    std::transform(_cpuParticles.begin(), _cpuParticles.end(), std::back_inserter(gpuParticles), [](const CpuParticle& particle) {
-        return GpuParticle(particle.position, glm::vec2(particle.lifetime, particle.seed));
-    });
-
-    // Update particle buffer
-    auto& particleBuffer = _particleBuffer;
-    size_t numBytes = sizeof(GpuParticle) * gpuParticles.size();
-    particleBuffer->resize(numBytes);
-    if (numBytes != 0) {
-        particleBuffer->setData(numBytes, (const gpu::Byte*)gpuParticles.data());
+    gpuParticles.reserve(numParticles);
+    for (size_t i = 0; i < numParticles; i++) {
+        gpuParticles.emplace_back(_cpuParticles.getPosition(i),
+            glm::vec2(_cpuParticles.getLifetime(i), _cpuParticles.getSeed(i)));
     }
+
+    std::lock_guard<std::mutex> lock(_stagingMutex);
+    _stagingBack = 1 - _stagingBack;
+    _stagingReady = true;
 }
 
 void ParticleEffectEntityRenderer::doRender(RenderArgs* args) {
@@ -296,8 +307,19 @@ void ParticleEffectEntityRenderer::doRender(RenderArgs* args) {
     }
 
 
-    // FIXME migrate simulation to a compute stage
-    stepSimulation();
+    // Update particle buffer from the most recent simulation step
+    {
+        std::lock_guard<std::mutex> lock(_stagingMutex);
+        if (_stagingReady) {
+            const GpuParticles& gpuParticles = _stagingParticles[1 - _stagingBack];
+            size_t numBytes = sizeof(GpuParticle) * gpuParticles.size();
+            _particleBuffer->resize(numBytes);
+            if (numBytes != 0) {
+                _particleBuffer->setData(numBytes, (const gpu::Byte*)gpuParticles.data());
+            }
+            _stagingReady = false;
+        }
+    }
 
     gpu::Batch& batch = *args->_batch;
     if (_networkTexture && _networkTexture->isLoaded()) {
@@ -14,6 +14,10 @@
 #include "RenderableEntityItem.h"
 #include <ParticleEffectEntityItem.h>
 #include <TextureCache.h>
+#include <ParticleStore.h>
+
+#include <mutex>
+#include <random>
 
 namespace render { namespace entities {
 
@@ -24,6 +28,10 @@ class ParticleEffectEntityRenderer : public TypedEntityRenderer<ParticleEffectEn
 public:
     ParticleEffectEntityRenderer(const EntityItemPointer& entity);
 
+    // Emits, expires and integrates the particles, then stages them for the next upload in doRender().
+    // EntityTreeRenderer calls this for every particle effect once a frame, from a parallel job on the main thread.
+    void stepSimulation(uint64_t now);
+
 protected:
     virtual bool needsRenderUpdateFromTypedEntity(const TypedEntityPointer& entity) const override;
 
@@ -43,38 +51,16 @@ private:
     using Buffer = gpu::Buffer;
     using BufferView = gpu::BufferView;
 
-    // CPU particles
-    // FIXME either switch to GPU compute particles or switch to simd updating of the particles
-#if 1
-    struct CpuParticle {
-        float seed{ 0.0f };
-        uint64_t expiration { 0 };
-        float lifetime { 0.0f };
-        glm::vec3 position;
-        glm::vec3 velocity;
-        glm::vec3 acceleration;
-
-        void integrate(float deltaTime) {
-            glm::vec3 atSquared = (0.5f * deltaTime * deltaTime) * acceleration;
-            position += velocity * deltaTime + atSquared;
-            velocity += acceleration * deltaTime;
-            lifetime += deltaTime;
-        }
-    };
-    using CpuParticles = std::deque<CpuParticle>;
-#else
-    struct CpuParticles {
-        std::vector<float> seeds;
-        std::vector<float> lifetimes;
-        std::vector<vec4> positions;
-        std::vector<vec4> velocities;
-        std::vector<vec4> accelerations;
-
-        size_t size() const;
-        void resize(size_t size);
-        void integrate(float deltaTime);
+    // CPU particles, oldest first
+    using CpuParticles = ParticleStore;
+
+    // The per instance data uploaded for each particle
+    struct GpuParticle {
+        GpuParticle(const glm::vec3& xyzIn, const glm::vec2& uvIn) : xyz(xyzIn), uv(uvIn) {}
+        glm::vec3 xyz; // Position
+        glm::vec2 uv; // Lifetime + seed
     };
-#endif
+    using GpuParticles = std::vector<GpuParticle>;
 
 
     template<typename T>
@@ -93,12 +79,23 @@ private:
     };
 
 
-    void createParticle(uint64_t now);
-    void stepSimulation();
+    void emitParticles(uint64_t now, size_t first, size_t count);
     bool emitting() const;
 
     particle::Properties _particleProperties;
     CpuParticles _cpuParticles;
+
+    // random numbers for a batch of emitted particles, each renderer has its own generator since they are stepped in parallel
+    std::mt19937 _randomGenerator { std::random_device()() };
+    std::vector<float> _emitRandoms;
+
+    // upload staging, double buffered: stepSimulation() fills the back buffer and swaps,
+    // doRender() uploads the front one if it hasn't already
+    GpuParticles _stagingParticles[2];
+    int _stagingBack { 0 };
+    bool _stagingReady { false };
+    std::mutex _stagingMutex;
+
     bool _emitting { false };
     uint64_t _timeUntilNextEmit { 0 };
     BufferPointer _particleBuffer{ std::make_shared<Buffer>() };
@@ -18,6 +18,8 @@
 
 #include <QObject>
 #include <QByteArray>
+#include <QThread>
+#include <QThreadPool>
 #include <QtConcurrent/QtConcurrentRun>
 
 #include <model-networking/SimpleMeshProxy.h>
@@ -27,6 +29,7 @@
 #include <StencilMaskPass.h>
 
 #include "EntityTreeRenderer.h"
+#include "PolyVoxChunkMeshing.h"
 #include "polyvox_vert.h"
 #include "polyvox_frag.h"
 #include "polyvox_fade_vert.h"
@@ -56,8 +59,6 @@
 #pragma warning(push)
 #pragma warning( disable : 4267 )
 #endif
-#include <PolyVoxCore/CubicSurfaceExtractorWithNormals.h>
-#include <PolyVoxCore/MarchingCubesSurfaceExtractor.h>
 #include <PolyVoxCore/SurfaceMesh.h>
 #include <PolyVoxCore/SimpleVolume.h>
 #include <PolyVoxCore/Material.h>
@@ -201,6 +202,7 @@ void RenderablePolyVoxEntityItem::setVoxelSurfaceStyle(PolyVoxSurfaceStyle voxel
         } else {
             _volDataDirty = true;
             _voxelSurfaceStyle = voxelSurfaceStyle;
+            _chunks.markAllDirty();
         }
     });
 
@@ -738,6 +740,7 @@ void RenderablePolyVoxEntityItem::setVoxelVolumeSize(const glm::vec3& voxelVolum
         _volData.reset(new PolyVox::SimpleVolume<uint8_t>(PolyVox::Region(lowCorner, highCorner)));
         // having the "outside of voxel-space" value be 255 has helped me notice some problems.
         _volData->setBorderValue(255);
+        _chunks.resize(ivec3(_volData->getWidth(), _volData->getHeight(), _volData->getDepth()));
     });
 }
 
@@ -796,11 +799,11 @@ bool RenderablePolyVoxEntityItem::setVoxelInternal(const ivec3& v, uint8_t toVal
 
     result = updateOnCount(v, toValue);
 
-    if (isEdged()) {
-        _volData->setVoxelAt(v.x + 1, v.y + 1, v.z + 1, toValue);
-    } else {
-        _volData->setVoxelAt(v.x, v.y, v.z, toValue);
+    ivec3 volDataV = isEdged() ? v + 1 : v;
+    if (_volData->getVoxelAt(volDataV.x, volDataV.y, volDataV.z) != toValue) {
+        _chunks.markVoxelDirty(volDataV);
     }
+    _volData->setVoxelAt(volDataV.x, volDataV.y, volDataV.z, toValue);
 
     if (glm::any(glm::equal(ivec3(0), v))) {
         _neighborsNeedUpdate = true;
@@ -892,8 +895,43 @@ void RenderablePolyVoxEntityItem::setVoxelsFromData(QByteArray uncompressedData,
 
 void RenderablePolyVoxEntityItem::compressVolumeDataAndSendEditPacket() {
     // compress the data in _volData and save the results.  The compressed form is used during
-    // saves to disk and for transmission over the wire to the entity-server
+    // saves to disk and for transmission over the wire to the entity-server.  While a stroke is being
+    // sculpted this is called for every step of it, so only one compression runs at a time and the
+    // changes made meanwhile are all picked up by the next one.
+    bool alreadyCompressing = false;
+    withWriteLock([&] {
+        alreadyCompressing = _compressing;
+        _compressing = true;
+        _compressPending = alreadyCompressing;
+    });
+    if (alreadyCompressing) {
+        return;
+    }
+
+    EntityItemPointer entity = getThisPointer();
+    EntityTreeElementPointer element = getElement();
+    EntityTreePointer tree = element ? element->getTree() : nullptr;
+
+    QtConcurrent::run([entity, tree] {
+        auto polyVoxEntity = std::static_pointer_cast<RenderablePolyVoxEntityItem>(entity);
+        do {
+            polyVoxEntity->sendVoxelData(tree);
+        } while (!polyVoxEntity->finishCompression());
+    });
+}
 
+bool RenderablePolyVoxEntityItem::finishCompression() {
+    // returns false if the voxels changed during the last compression, and it has to run again
+    bool finished = false;
+    withWriteLock([&] {
+        finished = !_compressPending;
+        _compressPending = false;
+        _compressing = !finished;
+    });
+    return finished;
+}
+
+void RenderablePolyVoxEntityItem::sendVoxelData(EntityTreePointer tree) {
     EntityItemPointer entity = getThisPointer();
 
     quint16 voxelXSize;
@@ -905,47 +943,34 @@ void RenderablePolyVoxEntityItem::compressVolumeDataAndSendEditPacket() {
         voxelZSize = _voxelVolumeSize.z;
     });
 
-    EntityTreeElementPointer element = getElement();
-    EntityTreePointer tree = element ? element->getTree() : nullptr;
+    QByteArray uncompressedData = volDataToArray(voxelXSize, voxelYSize, voxelZSize);
+    QByteArray newVoxelData = compressVoxelData(voxelXSize, voxelYSize, voxelZSize, uncompressedData);
 
-    QtConcurrent::run([voxelXSize, voxelYSize, voxelZSize, entity, tree] {
-        auto polyVoxEntity = std::static_pointer_cast<RenderablePolyVoxEntityItem>(entity);
-        QByteArray uncompressedData = polyVoxEntity->volDataToArray(voxelXSize, voxelYSize, voxelZSize);
+    // make sure the compressed data can be sent over the wire-protocol
+    if (newVoxelData.size() > 1150) {
+        // HACK -- until we have a way to allow for properties larger than MTU, don't update.
+        // revert the active voxel-space to the last version that fit.
+        qCDebug(entitiesrenderer) << "compressed voxel data is too large" << entity->getName() << entity->getID();
+        return;
+    }
 
-        QByteArray newVoxelData;
-        QDataStream writer(&newVoxelData, QIODevice::WriteOnly | QIODevice::Truncate);
+    auto now = usecTimestampNow();
+    entity->setLastEdited(now);
+    entity->setLastBroadcast(now);
 
-        writer << voxelXSize << voxelYSize << voxelZSize;
+    setVoxelData(newVoxelData);
 
-        QByteArray compressedData = qCompress(uncompressedData, 9);
-        writer << compressedData;
+    tree->withReadLock([&] {
+        EntityItemProperties properties = entity->getProperties();
+        properties.setVoxelDataDirty();
+        properties.setLastEdited(now);
 
-        // make sure the compressed data can be sent over the wire-protocol
-        if (newVoxelData.size() > 1150) {
-            // HACK -- until we have a way to allow for properties larger than MTU, don't update.
-            // revert the active voxel-space to the last version that fit.
-            qCDebug(entitiesrenderer) << "compressed voxel data is too large" << entity->getName() << entity->getID();
-            return;
+        EntitySimulationPointer simulation = tree ? tree->getSimulation() : nullptr;
+        PhysicalEntitySimulationPointer peSimulation = std::static_pointer_cast<PhysicalEntitySimulation>(simulation);
+        EntityEditPacketSender* packetSender = peSimulation ? peSimulation->getPacketSender() : nullptr;
+        if (packetSender) {
+            packetSender->queueEditEntityMessage(PacketType::EntityEdit, tree, entity->getID(), properties);
         }
-
-        auto now = usecTimestampNow();
-        entity->setLastEdited(now);
-        entity->setLastBroadcast(now);
-
-        std::static_pointer_cast<RenderablePolyVoxEntityItem>(entity)->setVoxelData(newVoxelData);
-
-        tree->withReadLock([&] {
-            EntityItemProperties properties = entity->getProperties();
-            properties.setVoxelDataDirty();
-            properties.setLastEdited(now);
-
-            EntitySimulationPointer simulation = tree ? tree->getSimulation() : nullptr;
-            PhysicalEntitySimulationPointer peSimulation = std::static_pointer_cast<PhysicalEntitySimulation>(simulation);
-            EntityEditPacketSender* packetSender = peSimulation ? peSimulation->getPacketSender() : nullptr;
-            if (packetSender) {
-                packetSender->queueEditEntityMessage(PacketType::EntityEdit, tree, entity->getID(), properties);
-            }
-        });
     });
 }
 
@@ -1009,6 +1034,9 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
                     if ((y == 0 || z == 0) && _volData->getVoxelAt(_volData->getWidth() - 1, y, z) != neighborValue) {
                         bonkNeighbors();
                     }
+                    if (_volData->getVoxelAt(_volData->getWidth() - 1, y, z) != neighborValue) {
+                        _chunks.markVoxelDirty({ _volData->getWidth() - 1, y, z });
+                    }
                     _volData->setVoxelAt(_volData->getWidth() - 1, y, z, neighborValue);
                 }
             }
@@ -1024,6 +1052,9 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
                     if ((x == 0 || z == 0) && _volData->getVoxelAt(x, _volData->getHeight() - 1, z) != neighborValue) {
                         bonkNeighbors();
                     }
+                    if (_volData->getVoxelAt(x, _volData->getHeight() - 1, z) != neighborValue) {
+                        _chunks.markVoxelDirty({ x, _volData->getHeight() - 1, z });
+                    }
                     _volData->setVoxelAt(x, _volData->getHeight() - 1, z, neighborValue);
                 }
             }
@@ -1036,10 +1067,12 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
             for (int x = 0; x < _volData->getWidth(); x++) {
                 for (int y = 0; y < _volData->getHeight(); y++) {
                     uint8_t neighborValue = currentZPNeighbor->getVoxel({ x, y, 0 });
-                    _volData->setVoxelAt(x, y, _volData->getDepth() - 1, neighborValue);
                     if ((x == 0 || y == 0) && _volData->getVoxelAt(x, y, _volData->getDepth() - 1) != neighborValue) {
                         bonkNeighbors();
                     }
+                    if (_volData->getVoxelAt(x, y, _volData->getDepth() - 1) != neighborValue) {
+                        _chunks.markVoxelDirty({ x, y, _volData->getDepth() - 1 });
+                    }
                     _volData->setVoxelAt(x, y, _volData->getDepth() - 1, neighborValue);
                 }
             }
@@ -1047,6 +1080,16 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
     }
 }
 
+static QThreadPool* getMeshingThreadPool() {
+    // a pool of its own, so that sculpting several polyvoxes at once can't take over the global one
+    static QThreadPool meshingThreadPool;
+    static std::once_flag once;
+    std::call_once(once, [] {
+        meshingThreadPool.setMaxThreadCount(std::max(1, QThread::idealThreadCount() / 2));
+    });
+    return &meshingThreadPool;
+}
+
 void RenderablePolyVoxEntityItem::recomputeMesh() {
     // use _volData to make a renderable mesh
     PolyVoxSurfaceStyle voxelSurfaceStyle;
@@ -1057,53 +1100,45 @@ void RenderablePolyVoxEntityItem::recomputeMesh() {
     cacheNeighbors();
     copyUpperEdgesFromNeighbors();
 
-    auto entity = std::static_pointer_cast<RenderablePolyVoxEntityItem>(getThisPointer());
+    VoxelChunkGrid chunks;
+    std::vector<int> dirtyChunks;
+    withWriteLock([&] {
+        chunks = _chunks;
+        dirtyChunks = _chunks.takeDirtyChunks();
+    });
 
-    QtConcurrent::run([entity, voxelSurfaceStyle] {
-        model::MeshPointer mesh(new model::Mesh());
+    auto entity = std::static_pointer_cast<RenderablePolyVoxEntityItem>(getThisPointer());
 
-        // A mesh object to hold the result of surface extraction
-        PolyVox::SurfaceMesh<PolyVox::PositionMaterialNormal> polyVoxMesh;
+    QtConcurrent::run(getMeshingThreadPool(), [entity, voxelSurfaceStyle, chunks, dirtyChunks] {
+        // one worker at a time per entity, so the chunk meshes are stitched together in the order they were taken
+        std::lock_guard<std::mutex> chunkMeshesLock(entity->_chunkMeshesMutex);
+        auto& chunkMeshes = entity->_chunkMeshes;
+        if ((int)chunkMeshes.size() != chunks.getNumChunks()) {
+            // the volume was resized, which marked every chunk dirty
+            chunkMeshes.clear();
+            chunkMeshes.resize(chunks.getNumChunks());
+        }
 
         entity->withReadLock([&] {
             PolyVox::SimpleVolume<uint8_t>* volData = entity->getVolData();
-            switch (voxelSurfaceStyle) {
-                case PolyVoxEntityItem::SURFACE_EDGED_MARCHING_CUBES: {
-                    PolyVox::MarchingCubesSurfaceExtractor<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
-                        (volData, volData->getEnclosingRegion(), &polyVoxMesh);
-                    surfaceExtractor.execute();
-                    break;
-                }
-                case PolyVoxEntityItem::SURFACE_MARCHING_CUBES: {
-                    PolyVox::MarchingCubesSurfaceExtractor<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
-                        (volData, volData->getEnclosingRegion(), &polyVoxMesh);
-                    surfaceExtractor.execute();
-                    break;
-                }
-                case PolyVoxEntityItem::SURFACE_EDGED_CUBIC: {
-                    PolyVox::CubicSurfaceExtractorWithNormals<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
-                        (volData, volData->getEnclosingRegion(), &polyVoxMesh);
-                    surfaceExtractor.execute();
-                    break;
-                }
-                case PolyVoxEntityItem::SURFACE_CUBIC: {
-                    PolyVox::CubicSurfaceExtractorWithNormals<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
-                        (volData, volData->getEnclosingRegion(), &polyVoxMesh);
-                    surfaceExtractor.execute();
-                    break;
-                }
+            if (volData) {
+                extractChunkSurfaces(volData, chunks, dirtyChunks, voxelSurfaceStyle, chunkMeshes);
             }
         });
 
+        std::vector<uint32_t> vecIndices;
+        std::vector<PolyVox::PositionMaterialNormal> vecVertices;
+        stitchChunkSurfaces(chunks, chunkMeshes, vecVertices, vecIndices);
+
+        model::MeshPointer mesh(new model::Mesh());
+
         // convert PolyVox mesh to a Sam mesh
-        const std::vector<uint32_t>& vecIndices = polyVoxMesh.getIndices();
         auto indexBuffer = std::make_shared<gpu::Buffer>(vecIndices.size() * sizeof(uint32_t),
                                                          (gpu::Byte*)vecIndices.data());
         auto indexBufferPtr = gpu::BufferPointer(indexBuffer);
         gpu::BufferView indexBufferView(indexBufferPtr, gpu::Element(gpu::SCALAR, gpu::UINT32, gpu::INDEX));
         mesh->setIndexBuffer(indexBufferView);
 
-        const std::vector<PolyVox::PositionMaterialNormal>& vecVertices = polyVoxMesh.getRawVertexData();
         auto vertexBuffer = std::make_shared<gpu::Buffer>(vecVertices.size() * sizeof(PolyVox::PositionMaterialNormal),
                                                           (gpu::Byte*)vecVertices.data());
         auto vertexBufferPtr = gpu::BufferPointer(vertexBuffer);
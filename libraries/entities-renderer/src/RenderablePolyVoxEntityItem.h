@@ -13,10 +13,12 @@
 #define hifi_RenderablePolyVoxEntityItem_h
 
 #include <atomic>
+#include <mutex>
 
 #include <QSemaphore>
 
 #include <PolyVoxCore/SimpleVolume.h>
+#include <PolyVoxCore/SurfaceMesh.h>
 #include <PolyVoxCore/Raycast.h>
 
 #include <gpu/Forward.h>
@@ -25,6 +27,7 @@
 #include <model/Geometry.h>
 #include <TextureCache.h>
 #include <PolyVoxEntityItem.h>
+#include <VoxelChunkGrid.h>
 
 #include "RenderableEntityItem.h"
 
@@ -128,6 +131,8 @@ private:
     // these are run off the main thread
     void decompressVolumeData();
     void compressVolumeDataAndSendEditPacket();
+    void sendVoxelData(EntityTreePointer tree);
+    bool finishCompression();
     void computeShapeInfoWorker();
 
     // The PolyVoxEntityItem class has _voxelData which contains dimensions and compressed voxel data.  The dimensions
@@ -143,6 +148,14 @@ private:
     bool _volDataDirty { false }; // does recomputeMesh need to be called?
     int _onCount; // how many non-zero voxels are in _volData
 
+    // recomputeMesh only extracts the chunks of _volData that changed, and stitches them to the rest
+    VoxelChunkGrid _chunks;
+    std::mutex _chunkMeshesMutex; // held by the worker that extracts the meshes
+    std::vector<PolyVox::SurfaceMesh<PolyVox::PositionMaterialNormal>> _chunkMeshes;
+
+    bool _compressing { false }; // is compressVolumeDataAndSendEditPacket running?
+    bool _compressPending { false }; // did the voxels change again while it was?
+
     bool _neighborsNeedUpdate { false };
 
     // these are cached lookups of _xNNeighborID, _yNNeighborID, _zNNeighborID, _xPNeighborID, _yPNeighborID, _zPNeighborID
@@ -0,0 +1,251 @@
+//
+//  EntityBoundsIndex.cpp
+//  libraries/entities/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityBoundsIndex.h"
+
+// each cell coordinate gets 21 bits of the key, which covers the whole tree down to cubes of well under a centimeter
+static const int CELL_BITS = 21;
+static const int CELL_OFFSET = 1 << (CELL_BITS - 1);
+static const int CELL_MASK = (1 << CELL_BITS) - 1;
+
+static int cellCoordinate(float position, float scale) {
+    return (int)glm::clamp(glm::floor(position / scale), (float)-CELL_OFFSET, (float)(CELL_OFFSET - 1));
+}
+
+static quint64 cellKey(int x, int y, int z) {
+    return ((quint64)((x + CELL_OFFSET) & CELL_MASK) << (2 * CELL_BITS)) |
+        ((quint64)((y + CELL_OFFSET) & CELL_MASK) << CELL_BITS) | (quint64)((z + CELL_OFFSET) & CELL_MASK);
+}
+
+void EntityBoundsIndex::insert(const EntityItemPointer& entity, const AACube& cube) {
+    glm::vec3 low = cube.getCorner();
+    float scale = cube.getScale();
+    quint64 cell = cellKey(cellCoordinate(low.x, scale), cellCoordinate(low.y, scale), cellCoordinate(low.z, scale));
+    withWriteLock([&] {
+        int levelIndex = 0;
+        while (levelIndex < (int)_levels.size() && _levels[levelIndex].scale != scale) {
+            levelIndex++;
+        }
+
+        auto itr = _slots.find(entity.get());
+        if (itr != _slots.end()) {
+            Slot slot = itr.value();
+            if (slot.level == levelIndex && _levels[levelIndex].cells[slot.bucket] == cell) {
+                return;
+            }
+            removeFromBucket(slot);
+        }
+
+        if (levelIndex == (int)_levels.size()) {
+            _levels.push_back(Level());
+            _levels.back().scale = scale;
+        }
+        Level& level = _levels[levelIndex];
+
+        int bucket;
+        auto bucketItr = level.buckets.find(cell);
+        if (bucketItr != level.buckets.end()) {
+            bucket = bucketItr.value();
+        } else {
+            bucket = (int)level.cells.size();
+            level.buckets.insert(cell, bucket);
+            level.cells.push_back(cell);
+            level.lowX.push_back(low.x);
+            level.lowY.push_back(low.y);
+            level.lowZ.push_back(low.z);
+            level.entities.push_back(std::vector<EntityItemPointer>());
+        }
+
+        Slot slot;
+        slot.level = levelIndex;
+        slot.bucket = bucket;
+        slot.index = (int)level.entities[bucket].size();
+        level.entities[bucket].push_back(entity);
+        _slots[entity.get()] = slot;
+    });
+}
+
+void EntityBoundsIndex::remove(const EntityItem* entity) {
+    withWriteLock([&] {
+        auto itr = _slots.find(entity);
+        if (itr == _slots.end()) {
+            return;
+        }
+        Slot slot = itr.value();
+        _slots.erase(itr);
+        removeFromBucket(slot);
+    });
+}
+
+void EntityBoundsIndex::removeFromBucket(const Slot& slot) {
+    Level& level = _levels[slot.level];
+    std::vector<EntityItemPointer>& entities = level.entities[slot.bucket];
+
+    // move the last entity of the bucket into the hole
+    int last = (int)entities.size() - 1;
+    if (slot.index != last) {
+        entities[slot.index] = entities[last];
+        _slots[entities[slot.index].get()].index = slot.index;
+    }
+    entities.pop_back();
+    if (!entities.empty()) {
+        return;
+    }
+
+    // and the last bucket of the level into an empty one
+    level.buckets.remove(level.cells[slot.bucket]);
+    int lastBucket = (int)level.cells.size() - 1;
+    if (slot.bucket != lastBucket) {
+        level.cells[slot.bucket] = level.cells[lastBucket];
+        level.lowX[slot.bucket] = level.lowX[lastBucket];
+        level.lowY[slot.bucket] = level.lowY[lastBucket];
+        level.lowZ[slot.bucket] = level.lowZ[lastBucket];
+        level.entities[slot.bucket].swap(level.entities[lastBucket]);
+        level.buckets[level.cells[slot.bucket]] = slot.bucket;
+        for (const auto& entity : level.entities[slot.bucket]) {
+            _slots[entity.get()].bucket = slot.bucket;
+        }
+    }
+    level.cells.pop_back();
+    level.lowX.pop_back();
+    level.lowY.pop_back();
+    level.lowZ.pop_back();
+    level.entities.pop_back();
+}
+
+void EntityBoundsIndex::clear() {
+    withWriteLock([&] {
+        _levels.clear();
+        _slots.clear();
+    });
+}
+
+int EntityBoundsIndex::size() const {
+    return resultWithReadLock<int>([&] {
+        return _slots.size();
+    });
+}
+
+void EntityBoundsIndex::findCandidates(const glm::vec3& low, const glm::vec3& high,
+                                       QVector<EntityItemPointer>& candidates) const {
+    withReadLock([&] {
+        for (const auto& level : _levels) {
+            findInLevel(level, low, high, candidates);
+        }
+    });
+}
+
+//
+// on x86 architecture, assume that SSE2 is present
+//
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <emmintrin.h>
+
+static void appendTouchingBuckets(const std::vector<float>& lowX, const std::vector<float>& lowY,
+                                  const std::vector<float>& lowZ, float scale, const glm::vec3& low, const glm::vec3& high,
+                                  const std::vector<std::vector<EntityItemPointer>>& entities,
+                                  QVector<EntityItemPointer>& candidates) {
+    // a cube touches the box unless it is apart along some axis
+    const __m128 cubeLowX = _mm_set1_ps(low.x - scale);
+    const __m128 cubeLowY = _mm_set1_ps(low.y - scale);
+    const __m128 cubeLowZ = _mm_set1_ps(low.z - scale);
+    const __m128 queryHighX = _mm_set1_ps(high.x);
+    const __m128 queryHighY = _mm_set1_ps(high.y);
+    const __m128 queryHighZ = _mm_set1_ps(high.z);
+
+    size_t numBuckets = lowX.size();
+    size_t i = 0;
+    for (; i + 4 <= numBuckets; i += 4) {
+        __m128 x = _mm_loadu_ps(&lowX[i]);
+        __m128 y = _mm_loadu_ps(&lowY[i]);
+        __m128 z = _mm_loadu_ps(&lowZ[i]);
+        __m128 apart = _mm_or_ps(_mm_cmpgt_ps(x, queryHighX), _mm_cmplt_ps(x, cubeLowX));
+        apart = _mm_or_ps(apart, _mm_or_ps(_mm_cmpgt_ps(y, queryHighY), _mm_cmplt_ps(y, cubeLowY)));
+        apart = _mm_or_ps(apart, _mm_or_ps(_mm_cmpgt_ps(z, queryHighZ), _mm_cmplt_ps(z, cubeLowZ)));
+        int touching = ~_mm_movemask_ps(apart) & 0xf;
+        while (touching) {
+            int lane = 0;
+            while (!(touching & (1 << lane))) {
+                lane++;
+            }
+            for (const auto& entity : entities[i + lane]) {
+                candidates.push_back(entity);
+            }
+            touching &= ~(1 << lane);
+        }
+    }
+
+    // the remainder
+    for (; i < numBuckets; i++) {
+        if (lowX[i] <= high.x && lowX[i] + scale >= low.x &&
+            lowY[i] <= high.y && lowY[i] + scale >= low.y &&
+            lowZ[i] <= high.z && lowZ[i] + scale >= low.z) {
+            for (const auto& entity : entities[i]) {
+                candidates.push_back(entity);
+            }
+        }
+    }
+}
+
+#else
+
+static void appendTouchingBuckets(const std::vector<float>& lowX, const std::vector<float>& lowY,
+                                  const std::vector<float>& lowZ, float scale, const glm::vec3& low, const glm::vec3& high,
+                                  const std::vector<std::vector<EntityItemPointer>>& entities,
+                                  QVector<EntityItemPointer>& candidates) {
+    for (size_t i = 0; i < lowX.size(); i++) {
+        if (lowX[i] <= high.x && lowX[i] + scale >= low.x &&
+            lowY[i] <= high.y && lowY[i] + scale >= low.y &&
+            lowZ[i] <= high.z && lowZ[i] + scale >= low.z) {
+            for (const auto& entity : entities[i]) {
+                candidates.push_back(entity);
+            }
+        }
+    }
+}
+
+#endif
+
+void EntityBoundsIndex::findInLevel(const Level& level, const glm::vec3& low, const glm::vec3& high,
+                                    QVector<EntityItemPointer>& candidates) const {
+    if (level.cells.empty()) {
+        return;
+    }
+
+    // the cells whose cubes may touch the box, one more on the low side for a cube that ends right at the box
+    float scale = level.scale;
+    glm::ivec3 lowCell(cellCoordinate(low.x, scale) - 1, cellCoordinate(low.y, scale) - 1, cellCoordinate(low.z, scale) - 1);
+    glm::ivec3 highCell(cellCoordinate(high.x, scale), cellCoordinate(high.y, scale), cellCoordinate(high.z, scale));
+    glm::vec3 numCells = glm::vec3(highCell - lowCell + 1);
+    if (numCells.x * numCells.y * numCells.z > (float)level.cells.size()) {
+        appendTouchingBuckets(level.lowX, level.lowY, level.lowZ, scale, low, high, level.entities, candidates);
+        return;
+    }
+
+    for (int z = lowCell.z; z <= highCell.z; z++) {
+        for (int y = lowCell.y; y <= highCell.y; y++) {
+            for (int x = lowCell.x; x <= highCell.x; x++) {
+                auto itr = level.buckets.find(cellKey(x, y, z));
+                if (itr == level.buckets.end()) {
+                    continue;
+                }
+                int bucket = itr.value();
+                if (level.lowX[bucket] <= high.x && level.lowX[bucket] + scale >= low.x &&
+                    level.lowY[bucket] <= high.y && level.lowY[bucket] + scale >= low.y &&
+                    level.lowZ[bucket] <= high.z && level.lowZ[bucket] + scale >= low.z) {
+                    for (const auto& entity : level.entities[bucket]) {
+                        candidates.push_back(entity);
+                    }
+                }
+            }
+        }
+    }
+}
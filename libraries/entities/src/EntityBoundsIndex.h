@@ -0,0 +1,72 @@
+//
+//  EntityBoundsIndex.h
+//  libraries/entities/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityBoundsIndex_h
+#define hifi_EntityBoundsIndex_h
+
+#include <vector>
+
+#include <QHash>
+#include <QVector>
+
+#include <glm/glm.hpp>
+
+#include <AACube.h>
+#include <shared/ReadWriteLockable.h>
+
+#include "EntityItem.h"
+
+// Every entity in an EntityTree bucketed by the cube of the element that holds it, so that a range query can go
+// straight to the cubes it touches instead of recursing the octree from the root. The tree moves an entity to
+// another element whenever its query cube stops fitting, so an entity's element cube prunes it exactly as the
+// octree walk would.
+//
+// Element cubes of the same size are aligned to a grid of that size: a query looks up the cells in its range by
+// hash, or, when the range has more cells than the grid has buckets, tests the buckets' cubes four at a time.
+class EntityBoundsIndex : public ReadWriteLockable {
+public:
+    void insert(const EntityItemPointer& entity, const AACube& cube);
+    void remove(const EntityItem* entity);
+    void clear();
+
+    int size() const;
+
+    // appends the entities whose cube touches the box from low to high, both inclusive
+    void findCandidates(const glm::vec3& low, const glm::vec3& high, QVector<EntityItemPointer>& candidates) const;
+
+private:
+    // all the buckets whose cubes have one size, the corners of their cubes stored as structure-of-arrays
+    class Level {
+    public:
+        float scale;
+        QHash<quint64, int> buckets; // by cell
+        std::vector<quint64> cells;
+        std::vector<float> lowX;
+        std::vector<float> lowY;
+        std::vector<float> lowZ;
+        std::vector<std::vector<EntityItemPointer>> entities;
+    };
+
+    class Slot {
+    public:
+        int level;
+        int bucket;
+        int index;
+    };
+
+    void removeFromBucket(const Slot& slot);
+    void findInLevel(const Level& level, const glm::vec3& low, const glm::vec3& high,
+                     QVector<EntityItemPointer>& candidates) const;
+
+    std::vector<Level> _levels;
+    QHash<const EntityItem*, Slot> _slots;
+};
+
+#endif // hifi_EntityBoundsIndex_h
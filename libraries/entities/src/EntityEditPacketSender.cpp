@@ -9,19 +9,29 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
 #include <assert.h>
 #include <QJsonDocument>
 #include <PerfStat.h>
 #include <OctalCode.h>
+#include <StringDelta.h>
 #include <udt/PacketHeaders.h>
 #include "EntityEditPacketSender.h"
 #include "EntitiesLogging.h"
 #include "EntityItem.h"
 #include "EntityItemProperties.h"
 
+const quint64 EntityEditPacketSender::DEFAULT_EDIT_COALESCE_INTERVAL = USECS_PER_SECOND / 30;
+
+// how long a run of deltas for an entity has to pause before its values are sent once more whole
+const quint64 STRING_DELTA_CLOSING_DELAY = USECS_PER_SECOND / 4;
+
 EntityEditPacketSender::EntityEditPacketSender() {
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
-    packetReceiver.registerDirectListener(PacketType::EntityEditNack, this, "processEntityEditNackPacket");
+    PacketReceiver::DispatchOptions options;
+    options.onReceiveThread = true;
+    packetReceiver.registerListener(PacketType::EntityEditNack, this, &EntityEditPacketSender::processEntityEditNackPacket,
+                                    options);
 }
 
 void EntityEditPacketSender::processEntityEditNackPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
@@ -90,27 +100,280 @@ void EntityEditPacketSender::queueEditEntityMessage(PacketType type,
         return;
     }
 
+    quint64 now = usecTimestampNow();
+    bool heldBack;
+    {
+        std::lock_guard<std::mutex> lock(_pendingEditsMutex);
+        int numHeldBack = _pendingEdits.size() + _closingEdits.size();
+        queueOrHoldEditMessage(type, entityItemID, properties, now);
+        heldBack = _pendingEdits.size() + _closingEdits.size() > numHeldBack;
+    }
+    if (heldBack) {
+        // a threaded sender with nothing left to send waits for packets, it has to learn when this edit is due
+        wakeToProcess();
+    }
+}
+
+void EntityEditPacketSender::queueOrHoldEditMessage(PacketType type, const EntityItemID& entityItemID,
+                                                    const EntityItemProperties& properties, quint64 now) {
+    if (type != PacketType::EntityEdit) {
+        // adds and physics updates are never held back, but whatever is pending for the entity has to go first
+        if (_pendingEdits.contains(entityItemID)) {
+            queuePendingEdit(entityItemID, now);
+        }
+        encodeAndQueueEditMessage(type, entityItemID, properties);
+        _lastEditSent[entityItemID] = now;
+        return;
+    }
+
+    // a change of simulation ownership has to reach the server right away, other bids depend on it
+    bool changesSimulation = properties.simulationOwnerChanged() || properties.dynamicChanged();
+
+    auto pending = _pendingEdits.find(entityItemID);
+    if (pending != _pendingEdits.end()) {
+        quint64 lastEdited = properties.getLastEdited();
+        pending->properties.merge(properties);
+        pending->properties.setLastEdited(lastEdited);
+        pending->numEdits++;
+        _editsMerged++;
+        if (changesSimulation) {
+            queuePendingEdit(entityItemID, now);
+        }
+        return;
+    }
+
+    auto lastSent = _lastEditSent.find(entityItemID);
+    if (changesSimulation || _editCoalesceInterval == 0 || lastSent == _lastEditSent.end() ||
+            now - lastSent.value() >= _editCoalesceInterval) {
+        encodeAndQueueEditMessage(type, entityItemID, properties);
+        _lastEditSent[entityItemID] = now;
+        return;
+    }
+
+    // sent recently, hold on to this one until the interval has passed
+    PendingEdit& edit = _pendingEdits[entityItemID];
+    edit.properties = properties;
+    edit.numEdits = 1;
+}
+
+int EntityEditPacketSender::makeStringDeltas(PacketType type, const QUuid& entityID,
+                                             const EntityItemProperties& properties, quint64 now,
+                                             QHash<int, QByteArray>& deltas, QHash<int, QByteArray>& newBases) const {
+    int bytesSaved = 0;
+    auto bases = _stringDeltaBases.find(entityID);
+    for (int property : { PROP_SCRIPT, PROP_SERVER_SCRIPTS, PROP_USER_DATA, PROP_TEXTURES }) {
+        EntityPropertyList propertyList = (EntityPropertyList)property;
+        if (!properties.canEncodeAsStringDelta(propertyList) ||
+                !properties.getChangedProperties().getHasProperty(propertyList)) {
+            continue;
+        }
+        QByteArray value = properties.getStringProperty(propertyList).toUtf8();
+        if (value.size() < EntityItemProperties::MIN_STRING_DELTA_SIZE) {
+            continue;
+        }
+
+        // the server only knows the bases we sent recently, and adds always go whole
+        if (type == PacketType::EntityEdit && bases != _stringDeltaBases.end() && bases->contains(property)) {
+            const StringDeltaBase& base = bases->value(property);
+            if (now - base.sent < EntityItemProperties::STRING_DELTA_BASE_LIFETIME) {
+                QByteArray delta = StringDelta::diff(base.value, value);
+                if (delta.size() < value.size() / 2) {
+                    deltas.insert(property, delta);
+                    bytesSaved += value.size() - delta.size();
+                    continue;
+                }
+            }
+        }
+        newBases.insert(property, value);
+    }
+    return bytesSaved;
+}
+
+int EntityEditPacketSender::encodeAndQueueEditMessage(PacketType type, EntityItemID entityItemID,
+                                                      const EntityItemProperties& properties, bool allowStringDeltas) {
     QByteArray bufferOut(NLPacket::maxPayloadSize(type), 0);
+    quint64 now = usecTimestampNow();
+
+    QHash<int, QByteArray> deltas;
+    QHash<int, QByteArray> newBases;
+    int deltaBytesSaved = 0;
+    if (allowStringDeltas && (type == PacketType::EntityAdd || type == PacketType::EntityEdit)) {
+        deltaBytesSaved = makeStringDeltas(type, entityItemID, properties, now, deltas, newBases);
+    }
 
     bool success;
-    if (properties.parentIDChanged() && properties.getParentID() == AVATAR_SELF_ID) {
+    bool reparentToMe = properties.parentIDChanged() && properties.getParentID() == AVATAR_SELF_ID;
+    if (reparentToMe || !deltas.isEmpty()) {
         EntityItemProperties propertiesCopy = properties;
-        auto nodeList = DependencyManager::get<NodeList>();
-        const QUuid myNodeID = nodeList->getSessionUUID();
-        propertiesCopy.setParentID(myNodeID);
+        if (reparentToMe) {
+            auto nodeList = DependencyManager::get<NodeList>();
+            const QUuid myNodeID = nodeList->getSessionUUID();
+            propertiesCopy.setParentID(myNodeID);
+        }
+        for (auto itr = deltas.begin(); itr != deltas.end(); ++itr) {
+            propertiesCopy.setStringDelta((EntityPropertyList)itr.key(), itr.value());
+        }
         success = EntityItemProperties::encodeEntityEditPacket(type, entityItemID, propertiesCopy, bufferOut);
     } else {
         success = EntityItemProperties::encodeEntityEditPacket(type, entityItemID, properties, bufferOut);
     }
 
-    if (success) {
-        #ifdef WANT_DEBUG
-            qCDebug(entities) << "calling queueOctreeEditMessage()...";
-            qCDebug(entities) << "    id:" << entityItemID;
-            qCDebug(entities) << "    properties:" << properties;
-        #endif
-        queueOctreeEditMessage(type, bufferOut);
+    if (!success) {
+        return 0;
     }
+    #ifdef WANT_DEBUG
+        qCDebug(entities) << "calling queueOctreeEditMessage()...";
+        qCDebug(entities) << "    id:" << entityItemID;
+        qCDebug(entities) << "    properties:" << properties;
+    #endif
+    queueOctreeEditMessage(type, bufferOut);
+
+    // only what actually went out whole can be diffed against later
+    for (auto itr = newBases.begin(); itr != newBases.end(); ++itr) {
+        StringDeltaBase& base = _stringDeltaBases[entityItemID][itr.key()];
+        base.value = itr.value();
+        base.sent = now;
+    }
+
+    // the server drops a delta whose base it never got, so whatever went out as a delta is sent whole again once
+    // the deltas stop, and a value that just went out whole no longer needs that
+    auto closing = _closingEdits.find(entityItemID);
+    if (!deltas.isEmpty()) {
+        if (closing == _closingEdits.end()) {
+            closing = _closingEdits.insert(entityItemID, ClosingEdit());
+            closing->properties.setType(properties.getType());
+        }
+        for (auto itr = deltas.begin(); itr != deltas.end(); ++itr) {
+            EntityPropertyList property = (EntityPropertyList)itr.key();
+            closing->properties.setStringProperty(property, properties.getStringProperty(property));
+        }
+        closing->properties.setLastEdited(properties.getLastEdited());
+        closing->lastDeltaSent = now;
+    } else if (closing != _closingEdits.end() && !newBases.isEmpty()) {
+        for (auto itr = newBases.begin(); itr != newBases.end(); ++itr) {
+            closing->properties.setStringPropertyChanged((EntityPropertyList)itr.key(), false);
+        }
+        if (closing->properties.getChangedProperties().isEmpty()) {
+            _closingEdits.erase(closing);
+        }
+    }
+
+    _stringDeltaBytesSaved += deltaBytesSaved;
+    return bufferOut.size();
+}
+
+bool EntityEditPacketSender::queueStringDeltaClosingEdits(quint64 now, bool all) {
+    bool queued = false;
+    auto itr = _closingEdits.begin();
+    while (itr != _closingEdits.end()) {
+        if (!all && now - itr->lastDeltaSent < STRING_DELTA_CLOSING_DELAY) {
+            ++itr;
+            continue;
+        }
+        QUuid entityID = itr.key();
+        EntityItemProperties properties = itr->properties;
+        itr = _closingEdits.erase(itr);
+        encodeAndQueueEditMessage(PacketType::EntityEdit, entityID, properties, false);
+        queued = true;
+    }
+    return queued;
+}
+
+void EntityEditPacketSender::queuePendingEdit(const QUuid& entityID, quint64 now) {
+    PendingEdit edit = _pendingEdits.take(entityID);
+    int size = encodeAndQueueEditMessage(PacketType::EntityEdit, entityID, edit.properties);
+    _lastEditSent[entityID] = now;
+
+    // each of the edits merged into this one would have been a message of about the same size
+    _editBytesSaved += (quint64)size * (edit.numEdits - 1);
+}
+
+bool EntityEditPacketSender::queueDuePendingEdits(quint64 now, bool all) {
+    bool queued = false;
+    auto itr = _lastEditSent.begin();
+    while (itr != _lastEditSent.end()) {
+        bool due = all || now - itr.value() >= _editCoalesceInterval;
+        if (!due) {
+            ++itr;
+        } else if (_pendingEdits.contains(itr.key())) {
+            queuePendingEdit(itr.key(), now);
+            queued = true;
+            ++itr;
+        } else if (!all) {
+            // nothing was sent for the whole interval, the next edit for this entity goes out right away
+            itr = _lastEditSent.erase(itr);
+        } else {
+            ++itr;
+        }
+    }
+    return queued;
+}
+
+void EntityEditPacketSender::setEditCoalesceInterval(quint64 interval) {
+    {
+        std::lock_guard<std::mutex> lock(_pendingEditsMutex);
+        _editCoalesceInterval = interval;
+    }
+    wakeToProcess();
+}
+
+quint64 EntityEditPacketSender::getUsecsUntilProcessDue() {
+    std::lock_guard<std::mutex> lock(_pendingEditsMutex);
+    quint64 due = NO_PROCESS_DUE;
+    for (auto itr = _pendingEdits.begin(); itr != _pendingEdits.end(); ++itr) {
+        due = std::min(due, _lastEditSent.value(itr.key()) + _editCoalesceInterval);
+    }
+    for (auto itr = _closingEdits.begin(); itr != _closingEdits.end(); ++itr) {
+        due = std::min(due, itr->lastDeltaSent + STRING_DELTA_CLOSING_DELAY);
+    }
+    if (due == NO_PROCESS_DUE) {
+        return NO_PROCESS_DUE;
+    }
+    quint64 now = usecTimestampNow();
+    return due > now ? due - now : 0;
+}
+
+void EntityEditPacketSender::flushPendingEdits() {
+    std::lock_guard<std::mutex> lock(_pendingEditsMutex);
+    quint64 now = usecTimestampNow();
+    queueDuePendingEdits(now, true);
+    queueStringDeltaClosingEdits(now, true);
+}
+
+bool EntityEditPacketSender::process() {
+    bool queued = false;
+    {
+        std::lock_guard<std::mutex> lock(_pendingEditsMutex);
+        quint64 now = usecTimestampNow();
+        if (!_lastEditSent.isEmpty()) {
+            queued = queueDuePendingEdits(now, false);
+        }
+        if (!_closingEdits.isEmpty()) {
+            queued = queueStringDeltaClosingEdits(now, false) || queued;
+        }
+
+        // a base too old to diff against is just taking up memory
+        auto itr = _stringDeltaBases.begin();
+        while (itr != _stringDeltaBases.end()) {
+            auto baseItr = itr->begin();
+            while (baseItr != itr->end()) {
+                if (now - baseItr->sent >= EntityItemProperties::STRING_DELTA_BASE_LIFETIME) {
+                    baseItr = itr->erase(baseItr);
+                } else {
+                    ++baseItr;
+                }
+            }
+            if (itr->isEmpty()) {
+                itr = _stringDeltaBases.erase(itr);
+            } else {
+                ++itr;
+            }
+        }
+    }
+    if (queued) {
+        releaseQueuedMessages();
+    }
+    return OctreeEditPacketSender::process();
 }
 
 void EntityEditPacketSender::queueEraseEntityMessage(const EntityItemID& entityItemID) {
@@ -123,6 +386,15 @@ void EntityEditPacketSender::queueEraseEntityMessage(const EntityItemID& entityI
         _myAvatar->clearAvatarEntity(entityItemID);
     }
 
+    {
+        // an edit that is still waiting would only be for an entity that is about to be gone
+        std::lock_guard<std::mutex> lock(_pendingEditsMutex);
+        _pendingEdits.remove(entityItemID);
+        _lastEditSent.remove(entityItemID);
+        _stringDeltaBases.remove(entityItemID);
+        _closingEdits.remove(entityItemID);
+    }
+
     QByteArray bufferOut(NLPacket::maxPayloadSize(PacketType::EntityErase), 0);
 
     if (EntityItemProperties::encodeEraseEntityMessage(entityItemID, bufferOut)) {
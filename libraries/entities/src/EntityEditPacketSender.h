@@ -14,8 +14,11 @@
 
 #include <OctreeEditPacketSender.h>
 
+#include <atomic>
 #include <mutex>
 
+#include <QHash>
+
 #include "EntityItem.h"
 #include "AvatarData.h"
 
@@ -39,19 +42,82 @@ public:
 
     void queueEraseEntityMessage(const EntityItemID& entityItemID);
 
+    /// EntityEdit messages for an entity that was sent an edit less than this many usecs ago are merged and sent
+    /// together once the interval has passed. Zero sends every edit as soon as it is queued.
+    static const quint64 DEFAULT_EDIT_COALESCE_INTERVAL;
+    void setEditCoalesceInterval(quint64 interval);
+    quint64 getEditCoalesceInterval() const { return _editCoalesceInterval; }
+
+    /// Queues the merged edits that are still waiting, without waiting for their interval to pass
+    void flushPendingEdits();
+
+    /// The number of edits that were merged into another one rather than sent, and an estimate of the bytes that saved
+    quint64 getEditsMerged() const { return _editsMerged; }
+    quint64 getEditBytesSaved() const { return _editBytesSaved; }
+
+    /// The bytes saved by sending long text properties as deltas against the value last sent whole
+    quint64 getStringDeltaBytesSaved() const { return _stringDeltaBytesSaved; }
+
+    virtual bool process() override;
+
     // My server type is the model server
     virtual char getMyNodeType() const override { return NodeType::EntityServer; }
     virtual void adjustEditPacketForClockSkew(PacketType type, QByteArray& buffer, qint64 clockSkew) override;
 
+protected:
+    virtual quint64 getUsecsUntilProcessDue() override;
+
 public slots:
     void processEntityEditNackPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode);
 
 private:
     void queueEditAvatarEntityMessage(PacketType type, EntityTreePointer entityTree,
                                       EntityItemID entityItemID, const EntityItemProperties& properties);
+    void queueOrHoldEditMessage(PacketType type, const EntityItemID& entityItemID, const EntityItemProperties& properties,
+                                quint64 now);
+    int encodeAndQueueEditMessage(PacketType type, EntityItemID entityItemID, const EntityItemProperties& properties,
+                                  bool allowStringDeltas = true);
+    void queuePendingEdit(const QUuid& entityID, quint64 now);
+    bool queueDuePendingEdits(quint64 now, bool all);
+    int makeStringDeltas(PacketType type, const QUuid& entityID, const EntityItemProperties& properties, quint64 now,
+                         QHash<int, QByteArray>& deltas, QHash<int, QByteArray>& newBases) const;
+    bool queueStringDeltaClosingEdits(quint64 now, bool all);
+
+    class StringDeltaBase {
+    public:
+        QByteArray value;
+        quint64 sent;
+    };
+
+    // the values last sent as deltas, sent again whole once no delta has gone out for a while in case one was lost
+    class ClosingEdit {
+    public:
+        EntityItemProperties properties;
+        quint64 lastDeltaSent;
+    };
+
+    class PendingEdit {
+    public:
+        EntityItemProperties properties;
+        int numEdits { 0 };
+    };
 
 private:
     std::mutex _mutex;
+
+    // guards the pending edits and the send times, held while an edit is queued so an entity's edits stay in order
+    std::mutex _pendingEditsMutex;
+    QHash<QUuid, PendingEdit> _pendingEdits;
+    QHash<QUuid, quint64> _lastEditSent;
+    quint64 _editCoalesceInterval { DEFAULT_EDIT_COALESCE_INTERVAL };
+    std::atomic<quint64> _editsMerged { 0 };
+    std::atomic<quint64> _editBytesSaved { 0 };
+
+    // the long text properties last sent whole, by entity then property, that later edits are diffed against
+    QHash<QUuid, QHash<int, StringDeltaBase>> _stringDeltaBases;
+    QHash<QUuid, ClosingEdit> _closingEdits;
+    std::atomic<quint64> _stringDeltaBytesSaved { 0 };
+
     AvatarData* _myAvatar { nullptr };
     QScriptEngine _scriptEngine;
 };
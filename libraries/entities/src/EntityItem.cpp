@@ -19,6 +19,7 @@
 #include <BufferParser.h>
 #include <ByteCountCoding.h>
 #include <GLMHelpers.h>
+#include <KinematicBatch.h>
 #include <Octree.h>
 #include <PhysicsHelpers.h>
 #include <RegisteredMetaTypes.h>
@@ -146,15 +147,40 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
 
     // If we are being called for a subsequent pass at appendEntityData() that failed to completely encode this item,
     // then our entityTreeElementExtraEncodeData should include data about which properties we need to append.
+    bool isContinuation = false;
     if (entityTreeElementExtraEncodeData && entityTreeElementExtraEncodeData->entities.contains(getEntityItemID())) {
         requestedProperties = entityTreeElementExtraEncodeData->entities.value(getEntityItemID());
+        isContinuation = true;
     }
 
+    quint64 lastEdited = getLastEdited();
+
+    // Every send thread encodes the same entities for its own viewers, so a complete encoding is kept with the
+    // entity and copied as is until the entity changes. The remainder of a split entity is not worth keeping.
+    EncodedEntityData::Key encodedDataKey { lastEdited, getLastChangedOnServer(), getLastUpdated(), getLastSimulated(),
+                                            requestedProperties };
+    if (!isContinuation) {
+        std::shared_ptr<const EncodedEntityData> encodedData;
+        {
+            std::lock_guard<std::mutex> lock(_encodedDataMutex);
+            encodedData = _encodedData;
+        }
+        if (encodedData && encodedData->key == encodedDataKey) {
+            if (packetData->appendRawData((const unsigned char*)encodedData->bytes.constData(), encodedData->bytes.size())) {
+                params.encodedDataHits++;
+                params.encodedDataUsecsSaved += encodedData->encodeUsecs;
+                params.trackSend(getID(), lastEdited);
+                return OctreeElement::COMPLETED;
+            }
+            // doesn't fit in what is left of this packet, the regular path below will split it
+        }
+    }
+    quint64 encodeStart = usecTimestampNow();
+
     EntityPropertyFlags propertiesDidntFit = requestedProperties;
 
     LevelDetails entityLevel = packetData->startLevel();
-
-    quint64 lastEdited = getLastEdited();
+    int entityDataOffset = packetData->getUncompressedByteOffset();
 
     #ifdef WANT_DEBUG
         float editedAgo = getEditedAgo();
@@ -287,6 +313,18 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
         }
 
         packetData->endLevel(entityLevel);
+
+        if (!isContinuation && appendState == OctreeElement::COMPLETED) {
+            auto encodedData = std::make_shared<EncodedEntityData>();
+            encodedData->key = encodedDataKey;
+            encodedData->bytes = QByteArray((const char*)packetData->getUncompressedData(entityDataOffset),
+                                            packetData->getUncompressedSize() - entityDataOffset);
+            encodedData->encodeUsecs = usecTimestampNow() - encodeStart;
+            params.encodedDataMisses++;
+
+            std::lock_guard<std::mutex> lock(_encodedDataMutex);
+            _encodedData = encodedData;
+        }
     } else {
         packetData->discardLevel(entityLevel);
         appendState = OctreeElement::NONE; // if we got here, then we didn't include the item
@@ -1015,11 +1053,7 @@ bool EntityItem::stepKinematicMotion(float timeElapsed) {
     getLocalTransformAndVelocities(transform, linearVelocity, angularVelocity);
 
     // find out if it is moving
-    bool isSpinning = (glm::length2(angularVelocity) > 0.0f);
-    float linearSpeedSquared = glm::length2(linearVelocity);
-    bool isTranslating = linearSpeedSquared > 0.0f;
-    bool moving = isTranslating || isSpinning;
-    if (!moving) {
+    if (!isKinematicMotion(linearVelocity, angularVelocity)) {
         return false;
     }
 
@@ -1028,91 +1062,118 @@ bool EntityItem::stepKinematicMotion(float timeElapsed) {
         // but return 'true' because it is moving
         return true;
     }
+    timeElapsed = limitKinematicTimeStep(timeElapsed);
+
+    stepKinematicRotation(timeElapsed, transform, angularVelocity);
+
+    glm::vec3 position = transform.getTranslation();
+    KinematicBatch::stepLinearMotion(position, linearVelocity, getLocalKinematicAcceleration(linearVelocity),
+        getKinematicDampingFactor(timeElapsed), timeElapsed);
+    transform.setTranslation(position);
+    setLocalTransformAndVelocities(transform, linearVelocity, angularVelocity);
+
+    return true;
+}
+
+bool EntityItem::beginSimulate(const quint64& now, KinematicBatch& batch) {
+    if (getLastSimulated() == 0) {
+        setLastSimulated(now);
+    }
+    float timeElapsed = (float)(now - getLastSimulated()) / (float)(USECS_PER_SECOND);
+
+    Transform transform;
+    glm::vec3 linearVelocity;
+    glm::vec3 angularVelocity;
+    getLocalTransformAndVelocities(transform, linearVelocity, angularVelocity);
+
+    if (!isKinematicMotion(linearVelocity, angularVelocity)) {
+        // the same transition as in simulate()
+        markDirtyFlags(Simulation::DIRTY_MOTION_TYPE);
+        setAcceleration(Vectors::ZERO);
+        setLastSimulated(now);
+        return false;
+    }
+    if (timeElapsed <= 0.0f) {
+        setLastSimulated(now);
+        return false;
+    }
+    timeElapsed = limitKinematicTimeStep(timeElapsed);
+
+    // rotation is stepped here, only the linear motion is left for the batch
+    stepKinematicRotation(timeElapsed, transform, angularVelocity);
+    batch.add(transform, linearVelocity, angularVelocity, getLocalKinematicAcceleration(linearVelocity),
+        getKinematicDampingFactor(timeElapsed), timeElapsed);
+    return true;
+}
+
+void EntityItem::endSimulate(const quint64& now, const KinematicBatch& batch, size_t index) {
+    setLocalTransformAndVelocities(batch.getTransform(index), batch.getVelocity(index), batch.getAngularVelocity(index));
+    setLastSimulated(now);
+}
+
+bool EntityItem::isKinematicMotion(const glm::vec3& linearVelocity, const glm::vec3& angularVelocity) {
+    return glm::length2(linearVelocity) > 0.0f || glm::length2(angularVelocity) > 0.0f;
+}
 
+float EntityItem::limitKinematicTimeStep(float timeElapsed) {
     const float MAX_TIME_ELAPSED = 1.0f; // seconds
     if (timeElapsed > MAX_TIME_ELAPSED) {
         qCWarning(entities) << "kinematic timestep = " << timeElapsed << " truncated to " << MAX_TIME_ELAPSED;
     }
-    timeElapsed = glm::min(timeElapsed, MAX_TIME_ELAPSED);
+    return glm::min(timeElapsed, MAX_TIME_ELAPSED);
+}
 
-    if (isSpinning) {
-        float angularDamping = getAngularDamping();
-        // angular damping
-        if (angularDamping > 0.0f) {
-            angularVelocity *= powf(1.0f - angularDamping, timeElapsed);
-        }
+void EntityItem::stepKinematicRotation(float timeElapsed, Transform& transform, glm::vec3& angularVelocity) const {
+    bool isSpinning = (glm::length2(angularVelocity) > 0.0f);
+    if (!isSpinning) {
+        return;
+    }
 
-        const float MIN_KINEMATIC_ANGULAR_SPEED_SQUARED =
-            KINEMATIC_ANGULAR_SPEED_THRESHOLD * KINEMATIC_ANGULAR_SPEED_THRESHOLD;
-        if (glm::length2(angularVelocity) < MIN_KINEMATIC_ANGULAR_SPEED_SQUARED) {
-            angularVelocity = Vectors::ZERO;
-        } else {
-            // for improved agreement with the way Bullet integrates rotations we use an approximation
-            // and break the integration into bullet-sized substeps
-            glm::quat rotation = transform.getRotation();
-            float dt = timeElapsed;
-            while (dt > 0.0f) {
-                glm::quat  dQ = computeBulletRotationStep(angularVelocity, glm::min(dt, PHYSICS_ENGINE_FIXED_SUBSTEP));
-                rotation = glm::normalize(dQ * rotation);
-                dt -= PHYSICS_ENGINE_FIXED_SUBSTEP;
-            }
-            transform.setRotation(rotation);
-        }
+    float angularDamping = getAngularDamping();
+    // angular damping
+    if (angularDamping > 0.0f) {
+        angularVelocity *= powf(1.0f - angularDamping, timeElapsed);
     }
 
-    glm::vec3 position = transform.getTranslation();
-    const float MIN_KINEMATIC_LINEAR_SPEED_SQUARED =
-        KINEMATIC_LINEAR_SPEED_THRESHOLD * KINEMATIC_LINEAR_SPEED_THRESHOLD;
-    if (isTranslating) {
-        glm::vec3 deltaVelocity = Vectors::ZERO;
-
-        // linear damping
-        float damping = getDamping();
-        if (damping > 0.0f) {
-            deltaVelocity = (powf(1.0f - damping, timeElapsed) - 1.0f) * linearVelocity;
+    const float MIN_KINEMATIC_ANGULAR_SPEED_SQUARED =
+        KINEMATIC_ANGULAR_SPEED_THRESHOLD * KINEMATIC_ANGULAR_SPEED_THRESHOLD;
+    if (glm::length2(angularVelocity) < MIN_KINEMATIC_ANGULAR_SPEED_SQUARED) {
+        angularVelocity = Vectors::ZERO;
+    } else {
+        // for improved agreement with the way Bullet integrates rotations we use an approximation
+        // and break the integration into bullet-sized substeps
+        glm::quat rotation = transform.getRotation();
+        float dt = timeElapsed;
+        while (dt > 0.0f) {
+            glm::quat  dQ = computeBulletRotationStep(angularVelocity, glm::min(dt, PHYSICS_ENGINE_FIXED_SUBSTEP));
+            rotation = glm::normalize(dQ * rotation);
+            dt -= PHYSICS_ENGINE_FIXED_SUBSTEP;
         }
+        transform.setRotation(rotation);
+    }
+}
 
-        const float MIN_KINEMATIC_LINEAR_ACCELERATION_SQUARED = 1.0e-4f; // 0.01 m/sec^2
-        vec3 acceleration = getAcceleration();
-        if (glm::length2(acceleration) > MIN_KINEMATIC_LINEAR_ACCELERATION_SQUARED) {
-            // yes acceleration
-            // acceleration is in world-frame but we need it in local-frame
-            glm::vec3 linearAcceleration = acceleration;
-            bool success;
-            Transform parentTransform = getParentTransform(success);
-            if (success) {
-                linearAcceleration = glm::inverse(parentTransform.getRotation()) * linearAcceleration;
-            }
-            deltaVelocity += linearAcceleration * timeElapsed;
-
-            if (linearSpeedSquared < MIN_KINEMATIC_LINEAR_SPEED_SQUARED
-                    && glm::length2(deltaVelocity) < MIN_KINEMATIC_LINEAR_SPEED_SQUARED
-                    && glm::length2(linearVelocity + deltaVelocity) < MIN_KINEMATIC_LINEAR_SPEED_SQUARED) {
-                linearVelocity = Vectors::ZERO;
-            } else {
-                // NOTE: we do NOT include the second-order acceleration term (0.5 * a * dt^2)
-                // when computing the displacement because Bullet also ignores that term.  Yes,
-                // this is an approximation and it works best when dt is small.
-                position += timeElapsed * linearVelocity;
-                linearVelocity += deltaVelocity;
-            }
-        } else {
-            // no acceleration
-            if (linearSpeedSquared < MIN_KINEMATIC_LINEAR_SPEED_SQUARED) {
-                linearVelocity = Vectors::ZERO;
-            } else {
-                // NOTE: we don't use second-order acceleration term for linear displacement
-                // because Bullet doesn't use it.
-                position += timeElapsed * linearVelocity;
-                linearVelocity += deltaVelocity;
-            }
+glm::vec3 EntityItem::getLocalKinematicAcceleration(const glm::vec3& linearVelocity) const {
+    if (glm::length2(linearVelocity) <= 0.0f) {
+        // acceleration only matters to something that is already translating
+        return Vectors::ZERO;
+    }
+    vec3 acceleration = getAcceleration();
+    if (glm::length2(acceleration) > MIN_KINEMATIC_LINEAR_ACCELERATION_SQUARED) {
+        // acceleration is in world-frame but we need it in local-frame
+        bool success;
+        Transform parentTransform = getParentTransform(success);
+        if (success) {
+            acceleration = glm::inverse(parentTransform.getRotation()) * acceleration;
         }
     }
+    return acceleration;
+}
 
-    transform.setTranslation(position);
-    setLocalTransformAndVelocities(transform, linearVelocity, angularVelocity);
-
-    return true;
+float EntityItem::getKinematicDampingFactor(float timeElapsed) const {
+    // linear damping
+    float damping = getDamping();
+    return (damping > 0.0f) ? powf(1.0f - damping, timeElapsed) : 1.0f;
 }
 
 bool EntityItem::isMoving() const {
@@ -2392,6 +2453,10 @@ void EntityItem::markAsChangedOnServer() {
     withWriteLock([&] {
         _changedOnServer = usecTimestampNow();
     });
+
+    // the key would no longer match anyway, don't hold on to the bytes
+    std::lock_guard<std::mutex> lock(_encodedDataMutex);
+    _encodedData.reset();
 }
 
 quint64 EntityItem::getLastChangedOnServer() const { 
@@ -13,6 +13,7 @@
 #define hifi_EntityItem_h
 
 #include <memory>
+#include <mutex>
 #include <stdint.h>
 
 #include <glm/glm.hpp>
@@ -42,6 +43,7 @@ class EntityTreeElementExtraEncodeData;
 class EntityDynamicInterface;
 class EntityItemProperties;
 class EntityTree;
+class KinematicBatch;
 class btCollisionShape;
 typedef std::shared_ptr<EntityTree> EntityTreePointer;
 typedef std::shared_ptr<EntityDynamicInterface> EntityDynamicPointer;
@@ -59,6 +61,29 @@ using EntityTreeElementExtraEncodeDataPointer = std::shared_ptr<EntityTreeElemen
 
 class MeshProxyList;
 
+// A complete encoding of an entity as written by appendEntityData(), valid for as long as the key matches.
+class EncodedEntityData {
+public:
+    class Key {
+    public:
+        quint64 lastEdited;
+        quint64 lastChangedOnServer;
+        quint64 lastUpdated;
+        quint64 lastSimulated;
+        EntityPropertyFlags requestedProperties;
+
+        bool operator==(const Key& other) const {
+            return lastEdited == other.lastEdited && lastChangedOnServer == other.lastChangedOnServer &&
+                lastUpdated == other.lastUpdated && lastSimulated == other.lastSimulated &&
+                requestedProperties == other.requestedProperties;
+        }
+    };
+
+    Key key;
+    QByteArray bytes;
+    quint64 encodeUsecs { 0 }; // what encoding it took, saved on every reuse
+};
+
 /// EntityItem class this is the base class for all entity types. It handles the basic properties and functionality available
 /// to all other entity types. In particular: postion, size, rotation, age, lifetime, velocity, gravity. You can not instantiate
 /// one directly, instead you must only construct one of it's derived classes with additional features.
@@ -151,6 +176,12 @@ public:
     void simulate(const quint64& now);
     bool stepKinematicMotion(float timeElapsed); // return 'true' if moving
 
+    // simulate() split in two, so EntitySimulation can step the linear motion of many entities at once.
+    // beginSimulate() returns 'true' if it added the entity to the batch, which then needs an endSimulate()
+    // with the entity's index once the batch has been stepped.
+    bool beginSimulate(const quint64& now, KinematicBatch& batch);
+    void endSimulate(const quint64& now, const KinematicBatch& batch, size_t index);
+
     virtual bool needsToCallUpdate() const { return false; }
 
     virtual void debugDump() const;
@@ -470,6 +501,13 @@ protected:
 
     virtual void dimensionsChanged() override;
 
+    // the pieces of stepKinematicMotion() that beginSimulate() shares
+    static bool isKinematicMotion(const glm::vec3& linearVelocity, const glm::vec3& angularVelocity);
+    static float limitKinematicTimeStep(float timeElapsed);
+    void stepKinematicRotation(float timeElapsed, Transform& transform, glm::vec3& angularVelocity) const;
+    glm::vec3 getLocalKinematicAcceleration(const glm::vec3& linearVelocity) const;
+    float getKinematicDampingFactor(float timeElapsed) const;
+
     EntityTypes::EntityType _type { EntityTypes::Unknown };
     quint64 _lastSimulated { 0 }; // last time this entity called simulate(), this includes velocity, angular velocity,
                             // and physics changes
@@ -564,6 +602,10 @@ protected:
     static int _maxActionsDataSize;
     mutable QByteArray _allActionsDataCache;
 
+    // shared by all send threads, see appendEntityData()
+    mutable std::mutex _encodedDataMutex;
+    mutable std::shared_ptr<const EncodedEntityData> _encodedData;
+
     // when an entity-server starts up, EntityItem::setDynamicData is called before the entity-tree is
     // ready.  This means we can't find our EntityItemPointer or add the action to the simulation.  These
     // are used to keep track of and work around this situation.
@@ -1194,9 +1194,10 @@ bool EntityItemProperties::encodeEntityEditPacket(PacketType command, EntityItem
             APPEND_ENTITY_PROPERTY(PROP_RESTITUTION, properties.getRestitution());
             APPEND_ENTITY_PROPERTY(PROP_FRICTION, properties.getFriction());
             APPEND_ENTITY_PROPERTY(PROP_LIFETIME, properties.getLifetime());
-            APPEND_ENTITY_PROPERTY(PROP_SCRIPT, properties.getScript());
+            APPEND_ENTITY_PROPERTY(PROP_SCRIPT, properties.encodeStringProperty(PROP_SCRIPT, properties.getScript()));
             APPEND_ENTITY_PROPERTY(PROP_SCRIPT_TIMESTAMP, properties.getScriptTimestamp());
-            APPEND_ENTITY_PROPERTY(PROP_SERVER_SCRIPTS, properties.getServerScripts());
+            APPEND_ENTITY_PROPERTY(PROP_SERVER_SCRIPTS,
+                properties.encodeStringProperty(PROP_SERVER_SCRIPTS, properties.getServerScripts()));
             APPEND_ENTITY_PROPERTY(PROP_COLOR, properties.getColor());
             APPEND_ENTITY_PROPERTY(PROP_REGISTRATION_POINT, properties.getRegistrationPoint());
             APPEND_ENTITY_PROPERTY(PROP_ANGULAR_VELOCITY, properties.getAngularVelocity());
@@ -1206,7 +1207,7 @@ bool EntityItemProperties::encodeEntityEditPacket(PacketType command, EntityItem
             APPEND_ENTITY_PROPERTY(PROP_COLLISION_MASK, properties.getCollisionMask());
             APPEND_ENTITY_PROPERTY(PROP_DYNAMIC, properties.getDynamic());
             APPEND_ENTITY_PROPERTY(PROP_LOCKED, properties.getLocked());
-            APPEND_ENTITY_PROPERTY(PROP_USER_DATA, properties.getUserData());
+            APPEND_ENTITY_PROPERTY(PROP_USER_DATA, properties.encodeStringProperty(PROP_USER_DATA, properties.getUserData()));
             APPEND_ENTITY_PROPERTY(PROP_HREF, properties.getHref());
             APPEND_ENTITY_PROPERTY(PROP_DESCRIPTION, properties.getDescription());
             APPEND_ENTITY_PROPERTY(PROP_PARENT_ID, properties.getParentID());
@@ -1229,7 +1230,7 @@ bool EntityItemProperties::encodeEntityEditPacket(PacketType command, EntityItem
             if (properties.getType() == EntityTypes::Model) {
                 APPEND_ENTITY_PROPERTY(PROP_MODEL_URL, properties.getModelURL());
                 APPEND_ENTITY_PROPERTY(PROP_COMPOUND_SHAPE_URL, properties.getCompoundShapeURL());
-                APPEND_ENTITY_PROPERTY(PROP_TEXTURES, properties.getTextures());
+                APPEND_ENTITY_PROPERTY(PROP_TEXTURES, properties.encodeStringProperty(PROP_TEXTURES, properties.getTextures()));
                 APPEND_ENTITY_PROPERTY(PROP_SHAPE_TYPE, (uint32_t)(properties.getShapeType()));
 
                 _staticAnimation.setProperties(properties);
@@ -1496,9 +1497,9 @@ bool EntityItemProperties::decodeEntityEditPacket(const unsigned char* data, int
     READ_ENTITY_PROPERTY_TO_PROPERTIES(PROP_RESTITUTION, float, setRestitution);
     READ_ENTITY_PROPERTY_TO_PROPERTIES(PROP_FRICTION, float, setFriction);
     READ_ENTITY_PROPERTY_TO_PROPERTIES(PROP_LIFETIME, float, setLifetime);
-    READ_ENTITY_PROPERTY_TO_PROPERTIES(PROP_SCRIPT, QString, setScript);
+    READ_ENTITY_STRING_PROPERTY_TO_PROPERTIES(PROP_SCRIPT, setScript);
     READ_ENTITY_PROPERTY_TO_PROPERTIES(PROP_SCRIPT_TIMESTAMP, quint64, setScriptTimestamp);
-    READ_ENTITY_PROPERTY_TO_PROPERTIES(PROP_SERVER_SCRIPTS, QString, setServerScripts);
+    READ_ENTITY_STRING_PROPERTY_TO_PROPERTIES(PROP_SERVER_SCRIPTS, setServerScripts);
     READ_ENTITY_PROPERTY_TO_PROPERTIES(PROP_COLOR, xColor, setColor);
     READ_ENTITY_PROPERTY_TO_PROPERTIES(PROP_REGISTRATION_POINT, glm::vec3, setRegistrationPoint);
     READ_ENTITY_PROPERTY_TO_PROPERTIES(PROP_ANGULAR_VELOCITY, glm::vec3, setAngularVelocity);
@@ -1508,7 +1509,7 @@ bool EntityItemProperties::decodeEntityEditPacket(const unsigned char* data, int
     READ_ENTITY_PROPERTY_TO_PROPERTIES(PROP_COLLISION_MASK, uint8_t, setCollisionMask);
     READ_ENTITY_PROPERTY_TO_PROPERTIES(PROP_DYNAMIC, bool, setDynamic);
     READ_ENTITY_PROPERTY_TO_PROPERTIES(PROP_LOCKED, bool, setLocked);
-    READ_ENTITY_PROPERTY_TO_PROPERTIES(PROP_USER_DATA, QString, setUserData);
+    READ_ENTITY_STRING_PROPERTY_TO_PROPERTIES(PROP_USER_DATA, setUserData);
     READ_ENTITY_PROPERTY_TO_PROPERTIES(PROP_HREF, QString, setHref);
     READ_ENTITY_PROPERTY_TO_PROPERTIES(PROP_DESCRIPTION, QString, setDescription);
     READ_ENTITY_PROPERTY_TO_PROPERTIES(PROP_PARENT_ID, QUuid, setParentID);
@@ -1531,7 +1532,7 @@ bool EntityItemProperties::decodeEntityEditPacket(const unsigned char* data, int
     if (properties.getType() == EntityTypes::Model) {
         READ_ENTITY_PROPERTY_TO_PROPERTIES(PROP_MODEL_URL, QString, setModelURL);
         READ_ENTITY_PROPERTY_TO_PROPERTIES(PROP_COMPOUND_SHAPE_URL, QString, setCompoundShapeURL);
-        READ_ENTITY_PROPERTY_TO_PROPERTIES(PROP_TEXTURES, QString, setTextures);
+        READ_ENTITY_STRING_PROPERTY_TO_PROPERTIES(PROP_TEXTURES, setTextures);
         READ_ENTITY_PROPERTY_TO_PROPERTIES(PROP_SHAPE_TYPE, ShapeType, setShapeType);
 
         properties.getAnimation().decodeFromEditPacket(propertyFlags, dataAt, processedBytes);
@@ -1645,6 +1646,105 @@ bool EntityItemProperties::decodeEntityEditPacket(const unsigned char* data, int
 // NOTE: This version will only encode the portion of the edit message immediately following the
 // header it does not include the send times and sequence number because that is handled by the
 // edit packet sender...
+const int EntityItemProperties::MIN_STRING_DELTA_SIZE;
+const quint64 EntityItemProperties::STRING_DELTA_BASE_LIFETIME;
+
+// the first byte of a string property in an edit packet says whether the rest is the value or a delta
+const char STRING_PROPERTY_WHOLE = 0;
+const char STRING_PROPERTY_DELTA = 1;
+
+bool EntityItemProperties::canEncodeAsStringDelta(EntityPropertyList property) const {
+    switch (property) {
+        case PROP_SCRIPT:
+        case PROP_SERVER_SCRIPTS:
+        case PROP_USER_DATA:
+            return true;
+        case PROP_TEXTURES:
+            // the other types that have textures still send them whole
+            return getType() == EntityTypes::Model;
+        default:
+            return false;
+    }
+}
+
+QString EntityItemProperties::getStringProperty(EntityPropertyList property) const {
+    switch (property) {
+        case PROP_SCRIPT:
+            return getScript();
+        case PROP_SERVER_SCRIPTS:
+            return getServerScripts();
+        case PROP_USER_DATA:
+            return getUserData();
+        case PROP_TEXTURES:
+            return getTextures();
+        default:
+            return QString();
+    }
+}
+
+void EntityItemProperties::setStringProperty(EntityPropertyList property, const QString& value) {
+    switch (property) {
+        case PROP_SCRIPT:
+            setScript(value);
+            break;
+        case PROP_SERVER_SCRIPTS:
+            setServerScripts(value);
+            break;
+        case PROP_USER_DATA:
+            setUserData(value);
+            break;
+        case PROP_TEXTURES:
+            setTextures(value);
+            break;
+        default:
+            break;
+    }
+}
+
+void EntityItemProperties::setStringPropertyChanged(EntityPropertyList property, bool value) {
+    switch (property) {
+        case PROP_SCRIPT:
+            setScriptChanged(value);
+            break;
+        case PROP_SERVER_SCRIPTS:
+            setServerScriptsChanged(value);
+            break;
+        case PROP_USER_DATA:
+            setUserDataChanged(value);
+            break;
+        case PROP_TEXTURES:
+            setTexturesChanged(value);
+            break;
+        default:
+            break;
+    }
+}
+
+QByteArray EntityItemProperties::encodeStringProperty(EntityPropertyList property, const QString& value) const {
+    QByteArray bytes;
+    auto delta = _stringDeltas.find(property);
+    if (delta != _stringDeltas.end()) {
+        bytes.append(STRING_PROPERTY_DELTA);
+        bytes.append(delta.value());
+    } else {
+        bytes.append(STRING_PROPERTY_WHOLE);
+        bytes.append(value.toUtf8());
+    }
+    return bytes;
+}
+
+QString EntityItemProperties::decodeStringProperty(EntityPropertyList property, const QByteArray& bytes) {
+    if (bytes.isEmpty()) {
+        return QString();
+    }
+    if (bytes[0] == STRING_PROPERTY_DELTA) {
+        // the value is filled in when the delta is resolved against the receiver's copy of its base
+        _stringDeltas[property] = bytes.mid(1);
+        return QString();
+    }
+    return QString::fromUtf8(bytes.constData() + 1, bytes.size() - 1);
+}
+
 bool EntityItemProperties::encodeEraseEntityMessage(const EntityItemID& entityItemID, QByteArray& buffer) {
 
     char* copyAt = buffer.data();
@@ -19,6 +19,7 @@
 
 #include <QtScript/QScriptEngine>
 #include <QtCore/QObject>
+#include <QHash>
 #include <QVector>
 #include <QString>
 
@@ -251,6 +252,22 @@ public:
     static bool decodeEntityEditPacket(const unsigned char* data, int bytesToRead, int& processedBytes,
                                        EntityItemID& entityID, EntityItemProperties& properties);
 
+    // Long text properties travel in edit packets either whole or as a StringDelta against an earlier value of the
+    // property. A delta read from a packet is kept here until the receiver resolves it against its base.
+    // values shorter than this are always sent whole
+    static const int MIN_STRING_DELTA_SIZE = 256;
+    // a sender only diffs against a value it sent whole less than this long ago, receivers keep those values longer
+    static const quint64 STRING_DELTA_BASE_LIFETIME = USECS_PER_SECOND;
+    bool canEncodeAsStringDelta(EntityPropertyList property) const;
+    QString getStringProperty(EntityPropertyList property) const;
+    void setStringProperty(EntityPropertyList property, const QString& value);
+    void setStringPropertyChanged(EntityPropertyList property, bool value);
+    void setStringDelta(EntityPropertyList property, const QByteArray& delta) { _stringDeltas[property] = delta; }
+    const QHash<int, QByteArray>& getStringDeltas() const { return _stringDeltas; }
+    void clearStringDeltas() { _stringDeltas.clear(); }
+    QByteArray encodeStringProperty(EntityPropertyList property, const QString& value) const;
+    QString decodeStringProperty(EntityPropertyList property, const QByteArray& bytes);
+
     bool localRenderAlphaChanged() const { return _localRenderAlphaChanged; }
 
     void clearID() { _id = UNKNOWN_ENTITY_ID; _idSet = false; }
@@ -335,6 +352,8 @@ private:
     bool _renderInfoHasTransparent { false };
 
     EntityPropertyFlags _desiredProperties; // if set will narrow scopes of copy/to/from to just these properties
+
+    QHash<int, QByteArray> _stringDeltas; // sent or received in place of the values of these properties
 };
 
 Q_DECLARE_METATYPE(EntityItemProperties);
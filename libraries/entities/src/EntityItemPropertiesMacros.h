@@ -70,6 +70,16 @@
             properties.O(fromBuffer);                                              \
         }
 
+// reads a property written with encodeStringProperty(), which is either the value or a delta to resolve later
+#define READ_ENTITY_STRING_PROPERTY_TO_PROPERTIES(P,O)                             \
+        if (propertyFlags.getHasProperty(P)) {                                     \
+            QByteArray fromBuffer;                                                 \
+            int bytes = OctreePacketData::unpackDataFromBytes(dataAt, fromBuffer); \
+            dataAt += bytes;                                                       \
+            processedBytes += bytes;                                               \
+            properties.O(properties.decodeStringProperty(P, fromBuffer));          \
+        }
+
 #define SET_ENTITY_PROPERTY_FROM_PROPERTIES(P,M)    \
     if (properties._##P##Changed) {    \
         M(properties._##P);                         \
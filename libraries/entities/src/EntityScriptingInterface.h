@@ -234,6 +234,10 @@ public slots:
         const QVector<EntityItemID>& entityIdsToInclude, const QVector<EntityItemID>& entityIdsToDiscard,
         bool visibleOnly, bool collidableOnly);
 
+    /// Batched version of findRayIntersectionVector(), all queries are answered in a single walk of the tree.
+    /// Returns one result per query, in the same order.
+    QVector<RayToEntityIntersectionResult> findRayIntersections(std::vector<EntityRayQuery>& queries);
+
     /// If the scripting context has visible entities, this will determine a ray intersection, and will block in
     /// order to return an accurate result
     Q_INVOKABLE RayToEntityIntersectionResult findRayIntersectionBlocking(const PickRay& ray, bool precisionPicking = false, const QScriptValue& entityIdsToInclude = QScriptValue(), const QScriptValue& entityIdsToDiscard = QScriptValue());
@@ -13,12 +13,10 @@
 
 #include "EntitySimulation.h"
 #include "EntitiesLogging.h"
-#include "MovingEntitiesOperator.h"
 
 void EntitySimulation::setEntityTree(EntityTreePointer tree) {
     if (_entityTree && _entityTree != tree) {
-        _mortalEntities.clear();
-        _nextExpiry = quint64(-1);
+        clearMortalEntities();
         _entitiesToUpdate.clear();
         _entitiesToSort.clear();
         _simpleKinematicEntities.clear();
@@ -91,31 +89,59 @@ void EntitySimulation::changeEntityInternal(EntityItemPointer entity) {
     }
 }
 
+// protected
+void EntitySimulation::addMortalEntity(EntityItemPointer entity) {
+    _mortalEntities.insert(entity);
+    quint64 expiry = entity->getExpiry();
+    _expiryQueue.push({ expiry, entity });
+    if (expiry < _nextExpiry) {
+        _nextExpiry = expiry;
+    }
+
+    // entities whose lifetime keeps changing leave stale entries behind, rebuild before they pile up
+    const size_t MIN_EXPIRY_QUEUE_SIZE_TO_COMPACT = 64;
+    if (_expiryQueue.size() > MIN_EXPIRY_QUEUE_SIZE_TO_COMPACT &&
+            _expiryQueue.size() > 2 * (size_t)_mortalEntities.size()) {
+        std::vector<MortalEntityExpiry> entries;
+        entries.reserve(_mortalEntities.size());
+        for (auto& mortalEntity : _mortalEntities) {
+            entries.push_back({ mortalEntity->getExpiry(), mortalEntity });
+        }
+        _expiryQueue = ExpiryQueue(std::greater<MortalEntityExpiry>(), std::move(entries));
+    }
+}
+
+void EntitySimulation::clearMortalEntities() {
+    _mortalEntities.clear();
+    _expiryQueue = ExpiryQueue();
+    _nextExpiry = quint64(-1);
+}
+
 // protected
 void EntitySimulation::expireMortalEntities(const quint64& now) {
     if (now > _nextExpiry) {
-        // only search for expired entities if we expect to find one
-        _nextExpiry = quint64(-1);
+        PerformanceTimer perfTimer("expireMortalEntities");
         QMutexLocker lock(&_mutex);
-        SetOfEntities::iterator itemItr = _mortalEntities.begin();
-        while (itemItr != _mortalEntities.end()) {
-            EntityItemPointer entity = *itemItr;
+        while (!_expiryQueue.empty() && _expiryQueue.top().expiry < now) {
+            MortalEntityExpiry next = _expiryQueue.top();
+            _expiryQueue.pop();
+
+            EntityItemPointer entity = next.entity.lock();
+            if (!entity || !_mortalEntities.contains(entity)) {
+                // removed from the simulation or made immortal since this entry was queued
+                continue;
+            }
             quint64 expiry = entity->getExpiry();
             if (expiry < now) {
-                itemItr = _mortalEntities.erase(itemItr);
+                _mortalEntities.remove(entity);
                 entity->die();
                 prepareEntityForDelete(entity);
             } else {
-                if (expiry < _nextExpiry) {
-                    // remember the smallest _nextExpiry so we know when to start the next search
-                    _nextExpiry = expiry;
-                }
-                ++itemItr;
+                // the lifetime was extended without a new entry, requeue it with the current expiry
+                _expiryQueue.push({ expiry, next.entity });
             }
         }
-        if (_mortalEntities.size() < 1) {
-            _nextExpiry = -1;
-        }
+        _nextExpiry = _expiryQueue.empty() ? quint64(-1) : _expiryQueue.top().expiry;
     }
 }
 
@@ -141,7 +167,7 @@ void EntitySimulation::callUpdateOnEntitiesThatNeedIt(const quint64& now) {
 void EntitySimulation::sortEntitiesThatMoved() {
     // NOTE: this is only for entities that have been moved by THIS EntitySimulation.
     // External changes to entity position/shape are expected to be sorted outside of the EntitySimulation.
-    MovingEntitiesOperator moveOperator(_entityTree);
+    // The moves are applied by the tree at the end of its update, together with the frame's other moves.
     AACube domainBounds(glm::vec3((float)-HALF_TREE_SCALE), (float)TREE_SCALE);
     SetOfEntities::iterator itemItr = _entitiesToSort.begin();
     while (itemItr != _entitiesToSort.end()) {
@@ -155,14 +181,10 @@ void EntitySimulation::sortEntitiesThatMoved() {
             entity->die();
             prepareEntityForDelete(entity);
         } else {
-            moveOperator.addEntityToMoveList(entity, newCube);
+            _entityTree->queueEntityMove(entity, newCube);
             ++itemItr;
         }
     }
-    if (moveOperator.hasMovingEntities()) {
-        PerformanceTimer perfTimer("recurseTreeWithOperator");
-        _entityTree->recurseTreeWithOperator(&moveOperator);
-    }
 
     _entitiesToSort.clear();
 }
@@ -172,11 +194,7 @@ void EntitySimulation::addEntity(EntityItemPointer entity) {
     assert(entity);
     entity->deserializeActions();
     if (entity->isMortal()) {
-        _mortalEntities.insert(entity);
-        quint64 expiry = entity->getExpiry();
-        if (expiry < _nextExpiry) {
-            _nextExpiry = expiry;
-        }
+        addMortalEntity(entity);
     }
     if (entity->needsToCallUpdate()) {
         _entitiesToUpdate.insert(entity);
@@ -220,11 +238,7 @@ void EntitySimulation::changeEntity(EntityItemPointer entity) {
     if (!wasRemoved) {
         if (dirtyFlags & Simulation::DIRTY_LIFETIME) {
             if (entity->isMortal()) {
-                _mortalEntities.insert(entity);
-                quint64 expiry = entity->getExpiry();
-                if (expiry < _nextExpiry) {
-                    _nextExpiry = expiry;
-                }
+                addMortalEntity(entity);
             } else {
                 _mortalEntities.remove(entity);
             }
@@ -241,8 +255,7 @@ void EntitySimulation::changeEntity(EntityItemPointer entity) {
 
 void EntitySimulation::clearEntities() {
     QMutexLocker lock(&_mutex);
-    _mortalEntities.clear();
-    _nextExpiry = quint64(-1);
+    clearMortalEntities();
     _entitiesToUpdate.clear();
     _entitiesToSort.clear();
     _simpleKinematicEntities.clear();
@@ -258,6 +271,10 @@ void EntitySimulation::clearEntities() {
 }
 
 void EntitySimulation::moveSimpleKinematics(const quint64& now) {
+    _kinematicBatch.clear();
+    _kinematicBatch.reserve(_simpleKinematicEntities.size());
+    _kinematicBatchEntities.clear();
+
     SetOfEntities::iterator itemItr = _simpleKinematicEntities.begin();
     while (itemItr != _simpleKinematicEntities.end()) {
         EntityItemPointer entity = *itemItr;
@@ -269,7 +286,9 @@ void EntitySimulation::moveSimpleKinematics(const quint64& now) {
         bool hasAvatarAncestor = entity->hasAncestorOfType(NestableType::Avatar);
 
         if (entity->isMovingRelativeToParent() && !entity->getPhysicsInfo() && ancestryIsKnown && !hasAvatarAncestor) {
-            entity->simulate(now);
+            if (entity->beginSimulate(now, _kinematicBatch)) {
+                _kinematicBatchEntities.push_back(entity);
+            }
             _entitiesToSort.insert(entity);
             ++itemItr;
         } else {
@@ -277,6 +296,13 @@ void EntitySimulation::moveSimpleKinematics(const quint64& now) {
             itemItr = _simpleKinematicEntities.erase(itemItr);
         }
     }
+
+    // the linear motion of every entity is integrated in one pass, then written back
+    _kinematicBatch.step();
+    for (int i = 0; i < _kinematicBatchEntities.size(); i++) {
+        _kinematicBatchEntities[i]->endSimulate(now, _kinematicBatch, i);
+    }
+    _kinematicBatchEntities.clear();
 }
 
 void EntitySimulation::addDynamic(EntityDynamicPointer dynamic) {
@@ -12,10 +12,13 @@
 #ifndef hifi_EntitySimulation_h
 #define hifi_EntitySimulation_h
 
+#include <queue>
+
 #include <QtCore/QObject>
 #include <QSet>
 #include <QVector>
 
+#include <KinematicBatch.h>
 #include <PerfStat.h>
 
 #include "EntityDynamicInterface.h"
@@ -95,6 +98,7 @@ protected:
     virtual void changeEntityInternal(EntityItemPointer entity);
     virtual void clearEntitiesInternal() = 0;
 
+    void addMortalEntity(EntityItemPointer entity);
     void expireMortalEntities(const quint64& now);
     void callUpdateOnEntitiesThatNeedIt(const quint64& now);
     virtual void sortEntitiesThatMoved();
@@ -112,6 +116,18 @@ protected:
 
 private:
     void moveSimpleKinematics();
+    void clearMortalEntities();
+
+    // an entry in the expiry queue, it goes stale when the entity is removed or its expiry changes
+    class MortalEntityExpiry {
+    public:
+        quint64 expiry;
+        EntityItemWeakPointer entity;
+
+        bool operator>(const MortalEntityExpiry& other) const { return expiry > other.expiry; }
+    };
+    using ExpiryQueue = std::priority_queue<MortalEntityExpiry, std::vector<MortalEntityExpiry>,
+        std::greater<MortalEntityExpiry>>;
 
     // back pointer to EntityTree structure
     EntityTreePointer _entityTree;
@@ -120,8 +136,12 @@ private:
     // An entity may be in more than one list.
     SetOfEntities _allEntities; // tracks all entities added the simulation
     SetOfEntities _mortalEntities; // entities that have an expiry
+    ExpiryQueue _expiryQueue; // soonest expiry first, so only the entities that are due get looked at
     quint64 _nextExpiry;
 
+    KinematicBatch _kinematicBatch;
+    VectorOfEntities _kinematicBatchEntities; // the entity for each entry of _kinematicBatch
+
 
     SetOfEntities _entitiesToUpdate; // entities that need to call EntityItem::update()
 
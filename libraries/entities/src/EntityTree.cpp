@@ -17,6 +17,8 @@
 
 #include <PerfStat.h>
 #include <Extents.h>
+#include <RayBatch.h>
+#include <StringDelta.h>
 
 #include "EntitySimulation.h"
 #include "VariantMapToScriptValue.h"
@@ -101,6 +103,7 @@ void EntityTree::eraseAllOctreeElements(bool createNewRoot) {
         }
     });
     localMap.clear();
+    _boundsIndex.clear();
     Octree::eraseAllOctreeElements(createNewRoot);
 
     resetClientEditStats();
@@ -266,11 +269,14 @@ bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperti
         } else {
             newQueryAACube = entity->getQueryAACube();
         }
+        // the edited entity keeps its own traversal, because besides moving it, UpdateEntityOperator marks the path to its
+        // element as changed, which is what gets the edit sent even when the entity stays in the same element.
         UpdateEntityOperator theOperator(getThisPointer(), containingElement, entity, newQueryAACube);
         recurseTreeWithOperator(&theOperator);
         entity->setProperties(properties);
 
-        // if the entity has children, run UpdateEntityOperator on them.  If the children have children, recurse
+        // if the entity has children, queue moves for them.  If the children have children, recurse
+        bool queuedDescendantMoves = false;
         QQueue<SpatiallyNestablePointer> toProcess;
         foreach (SpatiallyNestablePointer child, entity->getChildren()) {
             if (child && child->getNestableType() == NestableType::Entity) {
@@ -298,8 +304,9 @@ bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperti
                 addToNeedsParentFixupList(childEntity);
             }
 
-            UpdateEntityOperator theChildOperator(getThisPointer(), containingElement, childEntity, queryCube);
-            recurseTreeWithOperator(&theChildOperator);
+            // the descendants all move together in one traversal, rather than each in its own
+            queueEntityMove(childEntity, queryCube);
+            queuedDescendantMoves = true;
             foreach (SpatiallyNestablePointer childChild, childEntity->getChildren()) {
                 if (childChild && childChild->getNestableType() == NestableType::Entity) {
                     toProcess.enqueue(childChild);
@@ -307,6 +314,12 @@ bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperti
             }
         }
 
+        // every caller holds the write lock, apply the moves before it is released so that queries and sends never
+        // see a descendant in an element that no longer fits it.  This also applies any other moves queued this frame.
+        if (queuedDescendantMoves) {
+            applyQueuedEntityMoves();
+        }
+
         _isDirty = true;
 
         uint32_t newFlags = entity->getDirtyFlags() & ~preFlags;
@@ -623,9 +636,110 @@ bool EntityTree::findRayIntersection(const glm::vec3& origin, const glm::vec3& d
 }
 
 
+// walks the tree once for a whole batch of rays, each ray keeps descending only where it would have on its own
+class RayBatchArgs {
+public:
+    RayBatch rays;
+    std::vector<EntityRayQuery>& queries;
+    // one mask of the rays still searching per tree depth, reused by every element at that depth so that the
+    // walk doesn't allocate per element, siblings are visited one after another so they never share a mask
+    std::vector<std::vector<uint8_t>> activeByDepth;
+};
+
+static void findRayIntersectionsInElement(const EntityTreeElementPointer& element, RayBatchArgs& args,
+                                          const uint8_t* active, int recursionCount) {
+    if (recursionCount > DANGEROUSLY_DEEP_RECURSION) {
+        return;
+    }
+
+    if ((int)args.activeByDepth.size() <= recursionCount) {
+        args.activeByDepth.resize(recursionCount + 1, std::vector<uint8_t>(args.queries.size(), 0));
+    }
+    uint8_t* childActive = args.activeByDepth[recursionCount].data();
+
+    // reject whole groups of rays against the element cube before running the exact per ray test
+    const AACube& cube = element->getAACube();
+    if (args.rays.intersectBox(cube.getCorner(), glm::vec3(cube.getScale()), active, childActive) == 0) {
+        return;
+    }
+
+    bool anyKeepSearching = false;
+    for (size_t i = 0; i < args.queries.size(); i++) {
+        if (!childActive[i]) {
+            continue;
+        }
+        EntityRayQuery& query = args.queries[i];
+        bool keepSearching = true;
+        if (element->findRayIntersection(query.origin, query.direction, keepSearching,
+                query.element, query.distance, query.face, query.surfaceNormal, query.entityIdsToInclude,
+                query.entityIdsToDiscard, query.visibleOnly, query.collidableOnly, &query.intersectedObject,
+                query.precisionPicking)) {
+            query.found = true;
+        }
+        childActive[i] = keepSearching ? 1 : 0;
+        anyKeepSearching |= keepSearching;
+    }
+
+    if (anyKeepSearching) {
+        for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
+            EntityTreeElementPointer child = element->getChildAtIndex(i);
+            if (child) {
+                findRayIntersectionsInElement(child, args, childActive, recursionCount + 1);
+            }
+        }
+    }
+}
+
+bool EntityTree::findRayIntersections(std::vector<EntityRayQuery>& queries,
+                                      Octree::lockType lockType, bool* accurateResult) {
+    RayBatchArgs args = { RayBatch(), queries, {} };
+    args.rays.reserve(queries.size());
+    // reserved so that adding a depth never moves the masks the elements above it are still reading
+    args.activeByDepth.reserve(DANGEROUSLY_DEEP_RECURSION + 1);
+    for (auto& query : queries) {
+        query.found = false;
+        query.distance = FLT_MAX;
+        query.intersectedObject = nullptr;
+        args.rays.addRay(query.origin, query.direction);
+    }
+
+    bool requireLock = lockType == Octree::Lock;
+    bool lockResult = withReadLock([&]{
+        EntityTreeElementPointer root = std::static_pointer_cast<EntityTreeElement>(_rootElement);
+        if (root && !queries.empty()) {
+            std::vector<uint8_t> active(queries.size(), 1);
+            findRayIntersectionsInElement(root, args, active.data(), 0);
+        }
+    }, requireLock);
+
+    if (accurateResult) {
+        *accurateResult = lockResult;
+    }
+
+    bool found = false;
+    for (auto& query : queries) {
+        found |= query.found;
+    }
+    return found;
+}
+
+
 EntityItemPointer EntityTree::findClosestEntity(const glm::vec3& position, float targetRadius) {
     FindNearPointArgs args = { position, targetRadius, false, NULL, FLT_MAX };
     withReadLock([&] {
+        if (_useBoundsIndex) {
+            QVector<EntityItemPointer> candidates;
+            _boundsIndex.findCandidates(position - glm::vec3(targetRadius), position + glm::vec3(targetRadius), candidates);
+            foreach(EntityItemPointer entity, candidates) {
+                float distanceFromPointToEntity = glm::distance(entity->getPosition(), position);
+                if (distanceFromPointToEntity <= targetRadius && distanceFromPointToEntity < args.closestEntityDistance) {
+                    args.closestEntity = entity;
+                    args.closestEntityDistance = distanceFromPointToEntity;
+                    args.found = true;
+                }
+            }
+            return;
+        }
         // NOTE: This should use recursion, since this is a spatial operation
         recurseTreeWithOperation(findNearPointOperation, &args);
     });
@@ -658,6 +772,17 @@ bool EntityTree::findInSphereOperation(const OctreeElementPointer& element, void
 
 // NOTE: assumes caller has handled locking
 void EntityTree::findEntities(const glm::vec3& center, float radius, QVector<EntityItemPointer>& foundEntities) {
+    if (_useBoundsIndex) {
+        QVector<EntityItemPointer> candidates;
+        _boundsIndex.findCandidates(center - glm::vec3(radius), center + glm::vec3(radius), candidates);
+        foundEntities.clear();
+        foreach(EntityItemPointer entity, candidates) {
+            if (EntityTreeElement::entityTouchesSphere(entity, center, radius)) {
+                foundEntities.push_back(entity);
+            }
+        }
+        return;
+    }
     FindAllNearPointArgs args = { center, radius, QVector<EntityItemPointer>() };
     // NOTE: This should use recursion, since this is a spatial operation
     recurseTreeWithOperation(findInSphereOperation, &args);
@@ -688,6 +813,17 @@ bool EntityTree::findInCubeOperation(const OctreeElementPointer& element, void*
 
 // NOTE: assumes caller has handled locking
 void EntityTree::findEntities(const AACube& cube, QVector<EntityItemPointer>& foundEntities) {
+    if (_useBoundsIndex) {
+        QVector<EntityItemPointer> candidates;
+        _boundsIndex.findCandidates(cube.getMinimumPoint(), cube.getMaximumPoint(), candidates);
+        foundEntities.clear();
+        foreach(EntityItemPointer entity, candidates) {
+            if (EntityTreeElement::entityTouchesCube(entity, cube)) {
+                foundEntities.push_back(entity);
+            }
+        }
+        return;
+    }
     FindEntitiesInCubeArgs args(cube);
     // NOTE: This should use recursion, since this is a spatial operation
     recurseTreeWithOperation(findInCubeOperation, &args);
@@ -717,6 +853,17 @@ bool EntityTree::findInBoxOperation(const OctreeElementPointer& element, void* e
 
 // NOTE: assumes caller has handled locking
 void EntityTree::findEntities(const AABox& box, QVector<EntityItemPointer>& foundEntities) {
+    if (_useBoundsIndex) {
+        QVector<EntityItemPointer> candidates;
+        _boundsIndex.findCandidates(box.getMinimumPoint(), box.getMaximumPoint(), candidates);
+        foundEntities.clear();
+        foreach(EntityItemPointer entity, candidates) {
+            if (EntityTreeElement::entityTouchesBox(entity, box)) {
+                foundEntities.push_back(entity);
+            }
+        }
+        return;
+    }
     FindEntitiesInBoxArgs args(box);
     // NOTE: This should use recursion, since this is a spatial operation
     recurseTreeWithOperation(findInBoxOperation, &args);
@@ -742,6 +889,29 @@ bool EntityTree::findInFrustumOperation(const OctreeElementPointer& element, voi
 
 // NOTE: assumes caller has handled locking
 void EntityTree::findEntities(const ViewFrustum& frustum, QVector<EntityItemPointer>& foundEntities) {
+    if (_useBoundsIndex) {
+        // bound the frustum and its keyhole sphere
+        glm::vec3 low = frustum.getPosition() - glm::vec3(frustum.getCenterRadius());
+        glm::vec3 high = frustum.getPosition() + glm::vec3(frustum.getCenterRadius());
+        const glm::vec3 corners[] = {
+            frustum.getNearTopLeft(), frustum.getNearTopRight(), frustum.getNearBottomLeft(), frustum.getNearBottomRight(),
+            frustum.getFarTopLeft(), frustum.getFarTopRight(), frustum.getFarBottomLeft(), frustum.getFarBottomRight()
+        };
+        for (const glm::vec3& corner : corners) {
+            low = glm::min(low, corner);
+            high = glm::max(high, corner);
+        }
+
+        QVector<EntityItemPointer> candidates;
+        _boundsIndex.findCandidates(low, high, candidates);
+        foundEntities.clear();
+        foreach(EntityItemPointer entity, candidates) {
+            if (EntityTreeElement::entityTouchesFrustum(entity, frustum)) {
+                foundEntities.push_back(entity);
+            }
+        }
+        return;
+    }
     FindInFrustumArgs args = { frustum, QVector<EntityItemPointer>() };
     // NOTE: This should use recursion, since this is a spatial operation
     recurseTreeWithOperation(findInFrustumOperation, &args);
@@ -1022,6 +1192,10 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
                 }
             }
 
+            if (validEditPacket) {
+                resolveStringDeltas(senderNode->getUUID(), entityItemID, existingEntity, properties);
+            }
+
             if (validEditPacket && !_entityScriptSourceWhitelist.isEmpty()) {
 
                 bool wasDeletedBecauseOfClientScript = false;
@@ -1248,8 +1422,6 @@ void EntityTree::entityChanged(EntityItemPointer entity) {
 
 
 void EntityTree::fixupNeedsParentFixups() {
-    MovingEntitiesOperator moveOperator(getThisPointer());
-
     QWriteLocker locker(&_needsParentFixupLock);
 
     QMutableVectorIterator<EntityItemWeakPointer> iter(_needsParentFixup);
@@ -1307,14 +1479,128 @@ void EntityTree::fixupNeedsParentFixups() {
         }
 
         if (queryAACubeSuccess && doMove) {
-            moveOperator.addEntityToMoveList(entity, newCube);
+            queueEntityMove(entity, newCube);
         }
     }
+}
 
-    if (moveOperator.hasMovingEntities()) {
-        PerformanceTimer perfTimer("recurseTreeWithOperator");
-        recurseTreeWithOperator(&moveOperator);
+// the whole values a sender may diff against are kept a while longer than it will use them
+const quint64 STRING_DELTA_BASE_EXPIRY = 3 * EntityItemProperties::STRING_DELTA_BASE_LIFETIME;
+
+void EntityTree::resolveStringDeltas(const QUuid& senderID, const EntityItemID& entityID,
+                                     const EntityItemPointer& existingEntity, EntityItemProperties& properties) {
+    quint64 now = usecTimestampNow();
+    if (now - _lastStringDeltaBasePrune > STRING_DELTA_BASE_EXPIRY) {
+        _lastStringDeltaBasePrune = now;
+        auto itr = _stringDeltaBases.begin();
+        while (itr != _stringDeltaBases.end()) {
+            auto baseItr = itr->begin();
+            while (baseItr != itr->end()) {
+                if (now - baseItr->received > STRING_DELTA_BASE_EXPIRY) {
+                    baseItr = itr->erase(baseItr);
+                } else {
+                    ++baseItr;
+                }
+            }
+            if (itr->isEmpty()) {
+                itr = _stringDeltaBases.erase(itr);
+            } else {
+                ++itr;
+            }
+        }
     }
+
+    QPair<QUuid, QUuid> key(senderID, entityID);
+    const QHash<int, QByteArray>& deltas = properties.getStringDeltas();
+    if (!deltas.isEmpty()) {
+        EntityItemProperties currentProperties;
+        if (existingEntity) {
+            EntityPropertyFlags desiredProperties;
+            for (auto itr = deltas.begin(); itr != deltas.end(); ++itr) {
+                desiredProperties += (EntityPropertyList)itr.key();
+            }
+            currentProperties = existingEntity->getProperties(desiredProperties);
+        }
+        for (auto itr = deltas.begin(); itr != deltas.end(); ++itr) {
+            EntityPropertyList property = (EntityPropertyList)itr.key();
+
+            // the delta is usually against the value we have, unless another edit came in since this sender's base
+            QByteArray value;
+            bool resolved = existingEntity &&
+                StringDelta::patch(currentProperties.getStringProperty(property).toUtf8(), itr.value(), value);
+            if (!resolved) {
+                auto bases = _stringDeltaBases.find(key);
+                if (bases != _stringDeltaBases.end() && bases->contains(property)) {
+                    resolved = StringDelta::patch(bases->value(property).value, itr.value(), value);
+                }
+            }
+
+            if (resolved) {
+                properties.setStringProperty(property, QString::fromUtf8(value));
+                _stringDeltasResolved++;
+            } else {
+                properties.setStringPropertyChanged(property, false);
+                _stringDeltasDropped++;
+                qCDebug(entities) << "Dropped a delta for property" << property << "of entity" << entityID
+                    << "that does not match a known base";
+            }
+        }
+    }
+
+    // keep the long values that were sent whole, the sender's next deltas may be against them
+    for (int property : { PROP_SCRIPT, PROP_SERVER_SCRIPTS, PROP_USER_DATA, PROP_TEXTURES }) {
+        EntityPropertyList propertyList = (EntityPropertyList)property;
+        if (!deltas.contains(property) && properties.canEncodeAsStringDelta(propertyList) &&
+                properties.getChangedProperties().getHasProperty(propertyList)) {
+            QByteArray value = properties.getStringProperty(propertyList).toUtf8();
+            if (value.size() >= EntityItemProperties::MIN_STRING_DELTA_SIZE) {
+                StringDeltaBase& base = _stringDeltaBases[key][property];
+                base.value = value;
+                base.received = now;
+            }
+        }
+    }
+    properties.clearStringDeltas();
+}
+
+void EntityTree::queueEntityMove(const EntityItemPointer& entity, const AACube& newCube) {
+    QMutexLocker locker(&_queuedMovesMutex);
+    _queuedMoves.insert(entity->getEntityItemID(), QPair<EntityItemPointer, AACube>(entity, newCube));
+}
+
+void EntityTree::applyQueuedEntityMoves() {
+    QHash<EntityItemID, QPair<EntityItemPointer, AACube>> queuedMoves;
+    {
+        QMutexLocker locker(&_queuedMovesMutex);
+        queuedMoves.swap(_queuedMoves);
+    }
+    if (queuedMoves.isEmpty()) {
+        return;
+    }
+
+    withWriteLock([&] {
+        quint64 start = usecTimestampNow();
+        MovingEntitiesOperator moveOperator(getThisPointer());
+        foreach (const auto& move, queuedMoves) {
+            // skip the entities that were deleted after they moved
+            if (move.first->getElement()) {
+                moveOperator.addEntityToMoveList(move.first, move.second);
+            }
+        }
+        if (moveOperator.hasMovingEntities()) {
+            PerformanceTimer perfTimer("recurseTreeWithOperator");
+            recurseTreeWithOperator(&moveOperator);
+
+            quint64 elapsed = usecTimestampNow() - start;
+            _totalMoveTraversals++;
+            _totalEntitiesMoved += moveOperator.getNumMovingEntities();
+            _totalMoveTime += elapsed;
+            if (elapsed > _maxMoveTime) {
+                _maxMoveTime = elapsed;
+            }
+            _moveChecksSaved += moveOperator.getNumChecksSaved();
+        }
+    });
 }
 
 void EntityTree::deleteDescendantsOfAvatar(QUuid avatarID) {
@@ -1334,6 +1620,7 @@ void EntityTree::update(bool simulate) {
     if (simulate && _simulation) {
         withWriteLock([&] {
             _simulation->updateEntities();
+            applyQueuedEntityMoves();
             VectorOfEntities pendingDeletes;
             _simulation->takeEntitiesToDelete(pendingDeletes);
 
@@ -1349,6 +1636,8 @@ void EntityTree::update(bool simulate) {
                 deleteEntities(idsToDelete, true);
             }
         });
+    } else {
+        applyQueuedEntityMoves();
     }
 }
 
@@ -12,6 +12,7 @@
 #ifndef hifi_EntityTree_h
 #define hifi_EntityTree_h
 
+#include <QMutex>
 #include <QSet>
 #include <QVector>
 
@@ -23,6 +24,7 @@ typedef std::shared_ptr<EntityTree> EntityTreePointer;
 
 
 #include "EntityTreeElement.h"
+#include "EntityBoundsIndex.h"
 #include "DeleteEntityOperator.h"
 
 class EntityEditFilters;
@@ -49,6 +51,27 @@ public:
     QHash<EntityItemID, EntityItemID>* map;
 };
 
+// one ray of a batch handed to EntityTree::findRayIntersections()
+class EntityRayQuery {
+public:
+    // Inputs
+    glm::vec3 origin;
+    glm::vec3 direction;
+    QVector<EntityItemID> entityIdsToInclude;
+    QVector<EntityItemID> entityIdsToDiscard;
+    bool visibleOnly { false };
+    bool collidableOnly { false };
+    bool precisionPicking { false };
+
+    // Outputs
+    bool found { false };
+    OctreeElementPointer element;
+    float distance { std::numeric_limits<float>::max() };
+    BoxFace face { UNKNOWN_FACE };
+    glm::vec3 surfaceNormal;
+    void* intersectedObject { nullptr };
+};
+
 
 class EntityTree : public Octree, public SpatialParentTree {
     Q_OBJECT
@@ -98,6 +121,11 @@ public:
         BoxFace& face, glm::vec3& surfaceNormal, void** intersectedObject = NULL,
         Octree::lockType lockType = Octree::TryLock, bool* accurateResult = NULL);
 
+    // Same as findRayIntersection() for a whole batch of rays, in a single walk of the tree under one read lock.
+    // Each query gets exactly the answer findRayIntersection() would give it on its own.
+    bool findRayIntersections(std::vector<EntityRayQuery>& queries,
+        Octree::lockType lockType = Octree::TryLock, bool* accurateResult = NULL);
+
     virtual bool rootElementHasData() const override { return true; }
 
     // the root at least needs to store the number of entities in the packet/buffer
@@ -160,6 +188,13 @@ public:
     /// \param foundEntities[out] vector of EntityItemPointer
     void findEntities(const ViewFrustum& frustum, QVector<EntityItemPointer>& foundEntities);
 
+    /// every entity in the tree with the cube of its containing element, kept up to date by EntityTreeElement
+    EntityBoundsIndex& getBoundsIndex() { return _boundsIndex; }
+
+    /// when set, the range queries above scan the bounds index instead of recursing the octree
+    void setUseBoundsIndex(bool value) { _useBoundsIndex = value; }
+    bool getUseBoundsIndex() const { return _useBoundsIndex; }
+
     void addNewlyCreatedHook(NewlyCreatedEntityHook* hook);
     void removeNewlyCreatedHook(NewlyCreatedEntityHook* hook);
 
@@ -240,6 +275,23 @@ public:
     quint64 getMaxEditDelta() const { return _maxEditDelta; }
     quint64 getTotalTrackedEdits() const { return _totalTrackedEdits; }
 
+    /// Gathers a move of the entity to the element that best fits newCube. The moves gathered during a frame, from
+    /// parent fixups and the simulation, are applied together by one traversal in update(). The descendants of an
+    /// edited entity are applied by updateEntity() before it returns, while the caller still holds the write lock.
+    void queueEntityMove(const EntityItemPointer& entity, const AACube& newCube);
+
+    // these statistics track the traversals that move entities between elements while holding the write lock
+    quint64 getTotalMoveTraversals() const { return _totalMoveTraversals; }
+    quint64 getTotalEntitiesMoved() const { return _totalEntitiesMoved; }
+    quint64 getAverageMoveTime() const
+        { return _totalMoveTraversals == 0 ? 0 : _totalMoveTime / _totalMoveTraversals; }
+    quint64 getMaxMoveTime() const { return _maxMoveTime; }
+    quint64 getMoveChecksSaved() const { return _moveChecksSaved; }
+
+    // the edits whose long text properties arrived as deltas, and those whose delta had no matching base
+    quint64 getStringDeltasResolved() const { return _stringDeltasResolved; }
+    quint64 getStringDeltasDropped() const { return _stringDeltasDropped; }
+
     EntityTreePointer getThisPointer() { return std::static_pointer_cast<EntityTree>(shared_from_this()); }
 
     bool isDeletedEntity(const QUuid& id) {
@@ -333,6 +385,28 @@ protected:
     quint64 _maxEditDelta = 0;
     quint64 _treeResetTime = 0;
 
+    // replaces the string deltas in an edit with the values they encode and keeps the whole values later deltas may use
+    void resolveStringDeltas(const QUuid& senderID, const EntityItemID& entityID, const EntityItemPointer& existingEntity,
+                             EntityItemProperties& properties);
+    class StringDeltaBase {
+    public:
+        QByteArray value;
+        quint64 received;
+    };
+    QHash<QPair<QUuid, QUuid>, QHash<int, StringDeltaBase>> _stringDeltaBases; // by sender and entity, then property
+    quint64 _lastStringDeltaBasePrune { 0 };
+    quint64 _stringDeltasResolved { 0 };
+    quint64 _stringDeltasDropped { 0 };
+
+    void applyQueuedEntityMoves(); // move the entities queued by queueEntityMove() in a single traversal
+    QMutex _queuedMovesMutex;
+    QHash<EntityItemID, QPair<EntityItemPointer, AACube>> _queuedMoves;
+    quint64 _totalMoveTraversals { 0 };
+    quint64 _totalEntitiesMoved { 0 };
+    quint64 _totalMoveTime { 0 };
+    quint64 _maxMoveTime { 0 };
+    quint64 _moveChecksSaved { 0 };
+
     void fixupNeedsParentFixups(); // try to hook members of _needsParentFixup to parent instances
     QVector<EntityItemWeakPointer> _needsParentFixup; // entites with a parentID but no (yet) known parent instance
     mutable QReadWriteLock _needsParentFixupLock;
@@ -346,6 +420,9 @@ protected:
     bool filterProperties(EntityItemPointer& existingEntity, EntityItemProperties& propertiesIn, EntityItemProperties& propertiesOut, bool& wasChanged, FilterType filterType);
     bool _hasEntityEditFilter{ false };
     QStringList _entityScriptSourceWhitelist;
+
+    EntityBoundsIndex _boundsIndex;
+    bool _useBoundsIndex { true };
 };
 
 #endif // hifi_EntityTree_h
@@ -199,6 +199,12 @@ public:
     /// \param entities[out] vector of non-const EntityItemPointer
     void getEntities(const ViewFrustum& frustum, QVector<EntityItemPointer>& foundEntities);
 
+    /// the tests getEntities() applies to each entity, shared with the EntityTree's bounds index
+    static bool entityTouchesSphere(const EntityItemPointer& entity, const glm::vec3& position, float radius);
+    static bool entityTouchesCube(const EntityItemPointer& entity, const AACube& cube);
+    static bool entityTouchesBox(const EntityItemPointer& entity, const AABox& box);
+    static bool entityTouchesFrustum(const EntityItemPointer& entity, const ViewFrustum& frustum);
+
     EntityItemPointer getEntityWithID(uint32_t id) const;
     EntityItemPointer getEntityWithEntityItemID(const EntityItemID& id) const;
     void getEntitiesInside(const AACube& box, QVector<EntityItemPointer>& foundEntities);
@@ -9,6 +9,8 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
+
 #include "EntityItem.h"
 #include "EntityTree.h"
 #include "EntityTreeElement.h"
@@ -50,6 +52,24 @@ MovingEntitiesOperator::~MovingEntitiesOperator() {
 }
 
 
+// spreads the low 21 bits of value out to every third bit
+static quint64 spreadBits(quint64 value) {
+    value &= 0x1fffff;
+    value = (value | (value << 32)) & 0x1f00000000ffffULL;
+    value = (value | (value << 16)) & 0x1f0000ff0000ffULL;
+    value = (value | (value << 8)) & 0x100f00f00f00f00fULL;
+    value = (value | (value << 4)) & 0x10c30c30c30c30c3ULL;
+    value = (value | (value << 2)) & 0x1249249249249249ULL;
+    return value;
+}
+
+static quint64 calculateDestinationKey(const AABox& newCubeClamped) {
+    const float KEY_RESOLUTION = (float)(1 << 21);
+    glm::vec3 unitCenter = (newCubeClamped.calcCenter() + glm::vec3((float)HALF_TREE_SCALE)) / (float)TREE_SCALE;
+    glm::vec3 cell = glm::clamp(unitCenter * KEY_RESOLUTION, glm::vec3(0.0f), glm::vec3(KEY_RESOLUTION - 1.0f));
+    return spreadBits((quint64)cell.x) | (spreadBits((quint64)cell.y) << 1) | (spreadBits((quint64)cell.z) << 2);
+}
+
 void MovingEntitiesOperator::addEntityToMoveList(EntityItemPointer entity, const AACube& newCube) {
     EntityTreeElementPointer oldContainingElement = entity->getElement();
     AABox newCubeClamped = newCube.clamp((float)-HALF_TREE_SCALE, (float)HALF_TREE_SCALE);
@@ -73,6 +93,17 @@ void MovingEntitiesOperator::addEntityToMoveList(EntityItemPointer entity, const
         return; // bail without adding.
     }
 
+    // an entity that moved more than once before we recursed only needs to go to its latest destination
+    auto existing = _entityIndices.find(entity->getEntityItemID());
+    if (existing != _entityIndices.end()) {
+        EntityToMoveDetails& details = _entitiesToMove[existing.value()];
+        details.newCube = newCube;
+        details.newCubeClamped = newCubeClamped;
+        details.destinationKey = calculateDestinationKey(newCubeClamped);
+        _sorted = false;
+        return;
+    }
+
     // If the original containing element is the best fit for the requested newCube locations then
     // we don't actually need to add the entity for moving and we can short circuit all this work
     if (!oldContainingElement->bestFitBounds(newCubeClamped)) {
@@ -85,7 +116,10 @@ void MovingEntitiesOperator::addEntityToMoveList(EntityItemPointer entity, const
         details.newFound = false;
         details.newCube = newCube;
         details.newCubeClamped = newCubeClamped;
-        _entitiesToMove << details;
+        details.destinationKey = calculateDestinationKey(newCubeClamped);
+        _entityIndices.insert(entity->getEntityItemID(), _entitiesToMove.size());
+        _entitiesToMove.push_back(details);
+        _sorted = false;
         _lookingCount++;
 
         if (_wantDebug) {
@@ -108,42 +142,30 @@ void MovingEntitiesOperator::addEntityToMoveList(EntityItemPointer entity, const
     }
 }
 
-// does this entity tree element contain the old entity
-bool MovingEntitiesOperator::shouldRecurseSubTree(const OctreeElementPointer& element) {
-    bool containsEntity = false;
-
-    // If we don't have an old entity, then we don't contain the entity, otherwise
-    // check the bounds
-    if (_entitiesToMove.size() > 0) {
-        const AACube& elementCube = element->getAACube();
-        int detailIndex = 0;
-        foreach(const EntityToMoveDetails& details, _entitiesToMove) {
-
-            if (_wantDebug) {
-                qCDebug(entities) << "MovingEntitiesOperator::shouldRecurseSubTree() details["<< detailIndex <<"]-----------------------------";
-                qCDebug(entities) << "    element:" << element->getAACube();
-                qCDebug(entities) << "    details.entity:" << details.entity->getEntityItemID();
-                qCDebug(entities) << "    details.oldContainingElementCube:" << details.oldContainingElementCube;
-                qCDebug(entities) << "    details.newCube:" << details.newCube;
-                qCDebug(entities) << "    details.newCubeClamped:" << details.newCubeClamped;
-                qCDebug(entities) << "    elementCube.contains(details.newCube)" << elementCube.contains(details.newCube);
-                qCDebug(entities) << "    elementCube.contains(details.newCubeClamped)" << elementCube.contains(details.newCubeClamped);
-                qCDebug(entities) << "--------------------------------------------------------------------------";
-            }
-
-            if (elementCube.contains(details.oldContainingElementCube) || elementCube.contains(details.newCubeClamped)) {
-                containsEntity = true;
-                break; // if it contains at least one, we're good to go
-            }
-            detailIndex++;
-        }
+// Orders the moves by destination, so the entities bound for one branch of the tree are next to each
+// other in every candidate list and the branch's new elements are created while they are visited together.
+void MovingEntitiesOperator::sortEntitiesToMove() {
+    std::sort(_entitiesToMove.begin(), _entitiesToMove.end(),
+        [](const EntityToMoveDetails& a, const EntityToMoveDetails& b) {
+            return a.destinationKey < b.destinationKey;
+        });
+    for (int i = 0; i < _entitiesToMove.size(); i++) {
+        _entityIndices[_entitiesToMove[i].entity->getEntityItemID()] = i;
     }
-    return containsEntity;
+    _sorted = true;
+}
+
+// does this entity tree element contain the old or new location of the entity
+bool MovingEntitiesOperator::elementContains(const AACube& elementCube, const EntityToMoveDetails& details) const {
+    return elementCube.contains(details.oldContainingElementCube) || elementCube.contains(details.newCubeClamped);
 }
 
 bool MovingEntitiesOperator::preRecursion(const OctreeElementPointer& element) {
     EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-    
+    if (!_sorted) {
+        sortEntitiesToMove();
+    }
+
     // In Pre-recursion, we're generally deciding whether or not we want to recurse this
     // path of the tree. For this operation, we want to recurse the branch of the tree if
     // and of the following are true:
@@ -152,71 +174,95 @@ bool MovingEntitiesOperator::preRecursion(const OctreeElementPointer& element) {
     //
     // Note: it's often the case that the branch in question contains both the old entity
     // and the new entity.
-    
+    //
+    // Only the entities inside our parent can be inside this element, so we narrow our parent's
+    // list of candidates rather than checking every entity at every element.
+    if ((int)_candidates.size() <= _depth) {
+        _candidates.resize(_depth + 1);
+    }
+    std::vector<int>& candidates = _candidates[_depth];
+    candidates.clear();
+    const AACube& elementCube = element->getAACube();
+    if (_depth == 0) {
+        for (int i = 0; i < _entitiesToMove.size(); i++) {
+            if (elementContains(elementCube, _entitiesToMove[i])) {
+                candidates.push_back(i);
+            }
+        }
+        _numChecks += _entitiesToMove.size();
+    } else {
+        for (int i : _candidates[_depth - 1]) {
+            if (elementContains(elementCube, _entitiesToMove[i])) {
+                candidates.push_back(i);
+            }
+        }
+        _numChecks += _candidates[_depth - 1].size();
+    }
+    _depth++;
+    _numElementsVisited++;
+
     bool keepSearching = (_foundOldCount < _lookingCount) || (_foundNewCount < _lookingCount);
+    if (!keepSearching || candidates.empty()) {
+        return false;
+    }
 
-    // If we haven't yet found all the entities, and this sub tree contains at least one of our
-    // entities, then we need to keep searching.
-    if (keepSearching && shouldRecurseSubTree(element)) {
+    // check against each of our search entities
+    bool branchHasWork = false;
+    for (int i : candidates) {
+        EntityToMoveDetails& details = _entitiesToMove[i];
+
+        if (_wantDebug) {
+            qCDebug(entities) << "MovingEntitiesOperator::preRecursion() details["<< i <<"]-----------------------------";
+            qCDebug(entities) << "    entityTreeElement:" << entityTreeElement->getAACube();
+            qCDebug(entities) << "    entityTreeElement->bestFitBounds(details.newCube):" << entityTreeElement->bestFitBounds(details.newCube);
+            qCDebug(entities) << "    details.entity:" << details.entity->getEntityItemID();
+            qCDebug(entities) << "    details.oldContainingElementCube:" << details.oldContainingElementCube;
+            qCDebug(entities) << "    entityTreeElement:" << entityTreeElement.get();
+            qCDebug(entities) << "    details.newCube:" << details.newCube;
+            qCDebug(entities) << "    details.newCubeClamped:" << details.newCubeClamped;
+            qCDebug(entities) << "    _lookingCount:" << _lookingCount;
+            qCDebug(entities) << "    _foundOldCount:" << _foundOldCount;
+            qCDebug(entities) << "--------------------------------------------------------------------------";
+        }
 
-        // check against each of our search entities
-        int detailIndex = 0;
-        foreach(const EntityToMoveDetails& details, _entitiesToMove) {
-        
+        // If this is one of the old elements we're looking for, then ask it to remove the old entity
+        if (!details.oldFound && entityTreeElement == details.oldContainingElement) {
+            // DO NOT remove the entity here.  It will be removed when added to the destination element.
+            _foundOldCount++;
+            details.oldFound = true;
             if (_wantDebug) {
-                qCDebug(entities) << "MovingEntitiesOperator::preRecursion() details["<< detailIndex <<"]-----------------------------";
-                qCDebug(entities) << "    entityTreeElement:" << entityTreeElement->getAACube();
-                qCDebug(entities) << "    entityTreeElement->bestFitBounds(details.newCube):" << entityTreeElement->bestFitBounds(details.newCube);
-                qCDebug(entities) << "    details.entity:" << details.entity->getEntityItemID();
-                qCDebug(entities) << "    details.oldContainingElementCube:" << details.oldContainingElementCube;
-                qCDebug(entities) << "    entityTreeElement:" << entityTreeElement.get();
-                qCDebug(entities) << "    details.newCube:" << details.newCube;
-                qCDebug(entities) << "    details.newCubeClamped:" << details.newCubeClamped;
-                qCDebug(entities) << "    _lookingCount:" << _lookingCount;
-                qCDebug(entities) << "    _foundOldCount:" << _foundOldCount;
+                qCDebug(entities) << "MovingEntitiesOperator::preRecursion() -----------------------------";
+                qCDebug(entities) << "    FOUND OLD - REMOVING";
+                qCDebug(entities) << "    entityTreeElement == details.oldContainingElement";
                 qCDebug(entities) << "--------------------------------------------------------------------------";
             }
-        
-
-            // If this is one of the old elements we're looking for, then ask it to remove the old entity
-            if (!details.oldFound && entityTreeElement == details.oldContainingElement) {
-                // DO NOT remove the entity here.  It will be removed when added to the destination element.
-                _foundOldCount++;
-                //details.oldFound = true; // TODO: would be nice to add this optimization
-                if (_wantDebug) {
-                    qCDebug(entities) << "MovingEntitiesOperator::preRecursion() -----------------------------";
-                    qCDebug(entities) << "    FOUND OLD - REMOVING";
-                    qCDebug(entities) << "    entityTreeElement == details.oldContainingElement";
-                    qCDebug(entities) << "--------------------------------------------------------------------------";
-                }
-            }
+        }
 
-            // If this element is the best fit for the new bounds of this entity then add the entity to the element
-            if (!details.newFound && entityTreeElement->bestFitBounds(details.newCube)) {
-                // remove from the old before adding
-                EntityTreeElementPointer oldElement = details.entity->getElement();
-                if (oldElement != entityTreeElement) {
-                    if (oldElement) {
-                        oldElement->removeEntityItem(details.entity);
-                    }
-                    entityTreeElement->addEntityItem(details.entity);
-                }
-                _foundNewCount++;
-                //details.newFound = true; // TODO: would be nice to add this optimization
-                if (_wantDebug) {
-                    qCDebug(entities) << "MovingEntitiesOperator::preRecursion() -----------------------------";
-                    qCDebug(entities) << "    FOUND NEW - ADDING";
-                    qCDebug(entities) << "    entityTreeElement->bestFitBounds(details.newCube)";
-                    qCDebug(entities) << "--------------------------------------------------------------------------";
+        // If this element is the best fit for the new bounds of this entity then add the entity to the element
+        if (!details.newFound && entityTreeElement->bestFitBounds(details.newCube)) {
+            // remove from the old before adding
+            EntityTreeElementPointer oldElement = details.entity->getElement();
+            if (oldElement != entityTreeElement) {
+                if (oldElement) {
+                    oldElement->removeEntityItem(details.entity);
                 }
+                entityTreeElement->addEntityItem(details.entity);
+            }
+            _foundNewCount++;
+            details.newFound = true;
+            if (_wantDebug) {
+                qCDebug(entities) << "MovingEntitiesOperator::preRecursion() -----------------------------";
+                qCDebug(entities) << "    FOUND NEW - ADDING";
+                qCDebug(entities) << "    entityTreeElement->bestFitBounds(details.newCube)";
+                qCDebug(entities) << "--------------------------------------------------------------------------";
             }
-            detailIndex++;
         }
-        // if we haven't found all of our search for entities, then keep looking
-        keepSearching = (_foundOldCount < _lookingCount) || (_foundNewCount < _lookingCount);
+
+        branchHasWork = branchHasWork || !details.oldFound || !details.newFound;
     }
 
-    return keepSearching; // if we haven't yet found it, keep looking
+    // if we haven't found all of our search for entities in this branch, then keep looking
+    return branchHasWork;
 }
 
 bool MovingEntitiesOperator::postRecursion(const OctreeElementPointer& element) {
@@ -225,13 +271,14 @@ bool MovingEntitiesOperator::postRecursion(const OctreeElementPointer& element)
     // We might have two paths, one for the old entity and one for the new entity.
     bool keepSearching = (_foundOldCount < _lookingCount) || (_foundNewCount < _lookingCount);
 
+    _depth--;
+    const std::vector<int>& candidates = _candidates[_depth];
+
     // As we unwind, if we're in either of these two paths, we mark our element
     // as dirty.
-    if ((shouldRecurseSubTree(element))) {
+    if (!candidates.empty()) {
         element->markWithChangedTime();
     }
-    
-
 
     // It's not OK to prune if we have the potential of deleting the original containing element
     // because if we prune the containing element then new might end up reallocating the same memory later 
@@ -240,18 +287,16 @@ bool MovingEntitiesOperator::postRecursion(const OctreeElementPointer& element)
     // it's ok to prune if:
     // 2) this subtree doesn't contain any old elements
     // 3) this subtree contains an old element, but this element isn't a direct parent of any old containing element
-
-    bool elementSubTreeContainsOldElements = false;
+    //
+    // every entity whose old containing element is under this one is among our candidates
     bool elementIsDirectParentOfOldElment = false;
-    foreach(const EntityToMoveDetails& details, _entitiesToMove) {
-        if (element->getAACube().contains(details.oldContainingElementCube)) {
-            elementSubTreeContainsOldElements = true;
-        }
-        if (element->isParentOf(details.oldContainingElement)) {
+    for (int i : candidates) {
+        if (element->isParentOf(_entitiesToMove[i].oldContainingElement)) {
             elementIsDirectParentOfOldElment = true;
+            break;
         }
     }
-    if (!elementSubTreeContainsOldElements || !elementIsDirectParentOfOldElment) {
+    if (!elementIsDirectParentOfOldElment) {
         EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
         entityTreeElement->pruneChildren(); // take this opportunity to prune any empty leaves
     }
@@ -262,15 +307,16 @@ bool MovingEntitiesOperator::postRecursion(const OctreeElementPointer& element)
 OctreeElementPointer MovingEntitiesOperator::possiblyCreateChildAt(const OctreeElementPointer& element, int childIndex) {
     // If we're getting called, it's because there was no child element at this index while recursing.
     // We only care if this happens while still searching for the new entity locations.
-    if (_foundNewCount < _lookingCount) {
+    if (_foundNewCount < _lookingCount && _depth > 0) {
 
         float childElementScale = element->getAACube().getScale() / 2.0f; // all of our children will be half our scale
     
-        // check against each of our entities
-        foreach(const EntityToMoveDetails& details, _entitiesToMove) {
+        // check against each of the entities inside this element
+        for (int i : _candidates[_depth - 1]) {
+            const EntityToMoveDetails& details = _entitiesToMove[i];
 
             // if the scale of our desired cube is smaller than our children, then consider making a child
-            if (details.newCubeClamped.getLargestDimension() <= childElementScale) {
+            if (!details.newFound && details.newCubeClamped.getLargestDimension() <= childElementScale) {
 
                 int indexOfChildContainingNewEntity = element->getMyChildContaining(details.newCubeClamped);
             
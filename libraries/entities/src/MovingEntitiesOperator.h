@@ -12,6 +12,8 @@
 #ifndef hifi_MovingEntitiesOperator_h
 #define hifi_MovingEntitiesOperator_h
 
+#include <vector>
+
 class EntityToMoveDetails {
 public:
     EntityItemPointer entity;
@@ -20,37 +22,48 @@ public:
     AABox newCubeClamped; // meters
     EntityTreeElementPointer oldContainingElement;
     AACube oldContainingElementCube; // meters
+    quint64 destinationKey; // z-order of the new cube's center, so moves into the same branch sort together
     bool oldFound;
     bool newFound;
 };
 
-inline uint qHash(const EntityToMoveDetails& a, uint seed) {
-    return qHash(a.entity->getEntityItemID(), seed);
-}
-
-inline bool operator==(const EntityToMoveDetails& a, const EntityToMoveDetails& b) {
-    return a.entity->getEntityItemID() == b.entity->getEntityItemID();
-}
-
 class MovingEntitiesOperator : public RecurseOctreeOperator {
 public:
     MovingEntitiesOperator(EntityTreePointer tree);
     ~MovingEntitiesOperator();
 
+    // adding an entity that is already in the list replaces its destination
     void addEntityToMoveList(EntityItemPointer entity, const AACube& newCube);
     virtual bool preRecursion(const OctreeElementPointer& element) override;
     virtual bool postRecursion(const OctreeElementPointer& element) override;
     virtual OctreeElementPointer possiblyCreateChildAt(const OctreeElementPointer& element, int childIndex) override;
     bool hasMovingEntities() const { return _entitiesToMove.size() > 0; }
+    int getNumMovingEntities() const { return _entitiesToMove.size(); }
+
+    // how many entity-to-element comparisons the traversal made, and how many it skipped by only
+    // considering the entities inside each branch rather than all of them at every element
+    quint64 getNumChecks() const { return _numChecks; }
+    quint64 getNumChecksSaved() const { return _numElementsVisited * (quint64)_lookingCount - _numChecks; }
+
 private:
     EntityTreePointer _tree;
-    QSet<EntityToMoveDetails> _entitiesToMove;
+    QVector<EntityToMoveDetails> _entitiesToMove;
+    QHash<EntityItemID, int> _entityIndices;
+    bool _sorted { false };
+
+    // the entities whose old or new location is inside each element on the current path, by depth
+    std::vector<std::vector<int>> _candidates;
+    int _depth { 0 };
+
     quint64 _changeTime;
     int _foundOldCount;
     int _foundNewCount;
     int _lookingCount;
-    bool shouldRecurseSubTree(const OctreeElementPointer& element);
-    
+    quint64 _numElementsVisited { 0 };
+    quint64 _numChecks { 0 };
+    void sortEntitiesToMove();
+    bool elementContains(const AACube& elementCube, const EntityToMoveDetails& details) const;
+
     bool _wantDebug;
 };
 
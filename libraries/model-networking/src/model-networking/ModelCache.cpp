@@ -18,6 +18,8 @@
 #include <gpu/Batch.h>
 #include <gpu/Stream.h>
 
+#include <mutex>
+
 #include <QThreadPool>
 
 #include <Gzip.h>
@@ -50,6 +52,9 @@ public:
 
     virtual void downloadFinished(const QByteArray& data) override;
 
+    // the nested model is fetched on behalf of the same owners, so it follows their priorities
+    virtual void setLoadPriority(const QPointer<QObject>& owner, float priority) override;
+
 private slots:
     void onGeometryMappingLoaded(bool success);
 
@@ -98,6 +103,7 @@ void GeometryMappingResource::downloadFinished(const QByteArray& data) {
         _geometryResource = modelCache->getResource(url, QUrl(), &extra).staticCast<GeometryResource>();
         // Avoid caching nested resources - their references will be held by the parent
         _geometryResource->_isCacheable = false;
+        _geometryResource->setLoadPriorities(_loadPriorities);
 
         if (_geometryResource->isLoaded()) {
             onGeometryMappingLoaded(!_geometryResource->getURL().isEmpty());
@@ -112,11 +118,19 @@ void GeometryMappingResource::downloadFinished(const QByteArray& data) {
     }
 }
 
+void GeometryMappingResource::setLoadPriority(const QPointer<QObject>& owner, float priority) {
+    GeometryResource::setLoadPriority(owner, priority);
+    if (_geometryResource) {
+        _geometryResource->setLoadPriority(owner, priority);
+    }
+}
+
 void GeometryMappingResource::onGeometryMappingLoaded(bool success) {
     if (success && _geometryResource) {
         _fbxGeometry = _geometryResource->_fbxGeometry;
         _meshParts = _geometryResource->_meshParts;
         _meshes = _geometryResource->_meshes;
+        _triangleSets = _geometryResource->_triangleSets;
         _materials = _geometryResource->_materials;
 
         // Avoid holding onto extra references
@@ -220,6 +234,115 @@ void GeometryReader::run() {
     }
 }
 
+static std::shared_ptr<Geometry::MeshTriangleSets> buildMeshTriangleSets(const FBXGeometry& geometry) {
+    PROFILE_RANGE(resource_parse_geometry, __FUNCTION__);
+
+    int numberOfMeshes = geometry.meshes.size();
+    auto triangleSets = std::make_shared<Geometry::MeshTriangleSets>(numberOfMeshes);
+
+    for (int i = 0; i < numberOfMeshes; i++) {
+        const FBXMesh& mesh = geometry.meshes.at(i);
+        TriangleSet& triangleSet = (*triangleSets)[i];
+
+        const int INDICES_PER_TRIANGLE = 3;
+        const int INDICES_PER_QUAD = 4;
+        const int TRIANGLES_PER_QUAD = 2;
+
+        // tell our triangleSet how many triangles to expect.
+        int totalTriangles = 0;
+        for (const FBXMeshPart& part : mesh.parts) {
+            totalTriangles += (part.quadIndices.size() / INDICES_PER_QUAD) * TRIANGLES_PER_QUAD;
+            totalTriangles += part.triangleIndices.size() / INDICES_PER_TRIANGLE;
+        }
+        triangleSet.reserve(totalTriangles);
+
+        auto meshTransform = geometry.offset * mesh.modelTransform;
+
+        for (const FBXMeshPart& part : mesh.parts) {
+            int numberOfQuads = part.quadIndices.size() / INDICES_PER_QUAD;
+            int numberOfTris = part.triangleIndices.size() / INDICES_PER_TRIANGLE;
+
+            if (part.quadIndices.size() > 0) {
+                int vIndex = 0;
+                for (int q = 0; q < numberOfQuads; q++) {
+                    int i0 = part.quadIndices[vIndex++];
+                    int i1 = part.quadIndices[vIndex++];
+                    int i2 = part.quadIndices[vIndex++];
+                    int i3 = part.quadIndices[vIndex++];
+
+                    // track the model space version... these points will be transformed by the FST's offset,
+                    // which includes the scaling, rotation, and translation specified by the FST/FBX,
+                    // this can't change at runtime, so we can safely store these in our TriangleSet
+                    glm::vec3 v0 = glm::vec3(meshTransform * glm::vec4(mesh.vertices[i0], 1.0f));
+                    glm::vec3 v1 = glm::vec3(meshTransform * glm::vec4(mesh.vertices[i1], 1.0f));
+                    glm::vec3 v2 = glm::vec3(meshTransform * glm::vec4(mesh.vertices[i2], 1.0f));
+                    glm::vec3 v3 = glm::vec3(meshTransform * glm::vec4(mesh.vertices[i3], 1.0f));
+
+                    Triangle tri1 = { v0, v1, v3 };
+                    Triangle tri2 = { v1, v2, v3 };
+                    triangleSet.insert(tri1);
+                    triangleSet.insert(tri2);
+                }
+            }
+
+            if (part.triangleIndices.size() > 0) {
+                int vIndex = 0;
+                for (int t = 0; t < numberOfTris; t++) {
+                    int i0 = part.triangleIndices[vIndex++];
+                    int i1 = part.triangleIndices[vIndex++];
+                    int i2 = part.triangleIndices[vIndex++];
+
+                    glm::vec3 v0 = glm::vec3(meshTransform * glm::vec4(mesh.vertices[i0], 1.0f));
+                    glm::vec3 v1 = glm::vec3(meshTransform * glm::vec4(mesh.vertices[i1], 1.0f));
+                    glm::vec3 v2 = glm::vec3(meshTransform * glm::vec4(mesh.vertices[i2], 1.0f));
+
+                    Triangle tri = { v0, v1, v2 };
+                    triangleSet.insert(tri);
+                }
+            }
+        }
+
+        // after this the set is never modified, so it can be read from any thread
+        triangleSet.balanceTree();
+    }
+    return triangleSets;
+}
+
+// Builds the picking triangles of one FBXGeometry exactly once, whether the worker or a picking thread gets here first
+class GeometryTriangleSets {
+public:
+    GeometryTriangleSets(std::shared_ptr<const FBXGeometry> fbxGeometry) : _fbxGeometry(fbxGeometry) {}
+
+    std::shared_ptr<const Geometry::MeshTriangleSets> get() {
+        std::call_once(_built, [this] {
+            _triangleSets = buildMeshTriangleSets(*_fbxGeometry);
+            _fbxGeometry.reset();
+        });
+        return _triangleSets;
+    }
+
+private:
+    std::once_flag _built;
+    std::shared_ptr<const FBXGeometry> _fbxGeometry;
+    std::shared_ptr<const Geometry::MeshTriangleSets> _triangleSets;
+};
+
+class GeometryTriangleSetsBuilder : public QRunnable {
+public:
+    GeometryTriangleSetsBuilder(const std::shared_ptr<GeometryTriangleSets>& triangleSets) : _triangleSets(triangleSets) {}
+
+    virtual void run() override {
+        // don't bother if every model using the geometry is already gone
+        auto triangleSets = _triangleSets.lock();
+        if (triangleSets) {
+            triangleSets->get();
+        }
+    }
+
+private:
+    std::weak_ptr<GeometryTriangleSets> _triangleSets;
+};
+
 class GeometryDefinitionResource : public GeometryResource {
     Q_OBJECT
 public:
@@ -239,7 +362,7 @@ private:
 };
 
 void GeometryDefinitionResource::downloadFinished(const QByteArray& data) {
-    QThreadPool::globalInstance()->start(new GeometryReader(_self, _url, _mapping, data, _combineParts));
+    ResourceCache::startDecode(new GeometryReader(_self, _url, _mapping, data, _combineParts), getLoadPriority());
 }
 
 void GeometryDefinitionResource::setGeometryDefinition(FBXGeometry::Pointer fbxGeometry) {
@@ -248,9 +371,12 @@ void GeometryDefinitionResource::setGeometryDefinition(FBXGeometry::Pointer fbxG
 
     // Copy materials
     QHash<QString, size_t> materialIDAtlas;
+    float loadPriority = getLoadPriority();
     for (const FBXMaterial& material : _fbxGeometry->materials) {
         materialIDAtlas[material.materialID] = _materials.size();
-        _materials.push_back(std::make_shared<NetworkMaterial>(material, _textureBaseUrl));
+        auto networkMaterial = std::make_shared<NetworkMaterial>(material, _textureBaseUrl);
+        networkMaterial->setTextureLoadPriority(loadPriority);
+        _materials.push_back(networkMaterial);
     }
 
     std::shared_ptr<GeometryMeshes> meshes = std::make_shared<GeometryMeshes>();
@@ -270,6 +396,10 @@ void GeometryDefinitionResource::setGeometryDefinition(FBXGeometry::Pointer fbxG
     _meshes = meshes;
     _meshParts = parts;
 
+    // start on the picking triangles now, so that the first precise pick doesn't have to build them
+    _triangleSets = std::make_shared<GeometryTriangleSets>(_fbxGeometry);
+    QThreadPool::globalInstance()->start(new GeometryTriangleSetsBuilder(_triangleSets));
+
     finishedLoading(true);
 }
 
@@ -339,6 +469,7 @@ Geometry::Geometry(const Geometry& geometry) {
     _fbxGeometry = geometry._fbxGeometry;
     _meshes = geometry._meshes;
     _meshParts = geometry._meshParts;
+    _triangleSets = geometry._triangleSets;
 
     _materials.reserve(geometry._materials.size());
     for (const auto& material : geometry._materials) {
@@ -348,6 +479,13 @@ Geometry::Geometry(const Geometry& geometry) {
     _animGraphOverrideUrl = geometry._animGraphOverrideUrl;
 }
 
+std::shared_ptr<const Geometry::MeshTriangleSets> Geometry::getMeshTriangleSets() const {
+    if (!_triangleSets) {
+        return std::shared_ptr<const MeshTriangleSets>();
+    }
+    return _triangleSets->get();
+}
+
 void Geometry::setTextures(const QVariantMap& textureMap) {
     if (_meshes->size() > 0) {
         for (auto& material : _materials) {
@@ -463,6 +601,12 @@ void GeometryResourceWatcher::setResource(GeometryResource::Pointer resource) {
     }
 }
 
+void GeometryResourceWatcher::setLoadPriority(const QPointer<QObject>& owner, float priority) {
+    if (_resource && !_resource->isLoaded()) {
+        _resource->setLoadPriority(owner, priority);
+    }
+}
+
 void GeometryResourceWatcher::resourceFinished(bool success) {
     if (success) {
         _geometryRef = std::make_shared<Geometry>(*_resource);
@@ -594,6 +738,14 @@ NetworkMaterial::NetworkMaterial(const FBXMaterial& material, const QUrl& textur
     }
 }
 
+void NetworkMaterial::setTextureLoadPriority(float priority) {
+    for (auto& texture : _textures) {
+        if (texture.texture) {
+            texture.texture->setOwnerLoadPriority(priority);
+        }
+    }
+}
+
 void NetworkMaterial::setTextures(const QVariantMap& textureMap) {
     _isOriginal = false;
 
@@ -14,6 +14,7 @@
 
 #include <DependencyManager.h>
 #include <ResourceCache.h>
+#include <TriangleSet.h>
 
 #include <model/Material.h>
 #include <model/Asset.h>
@@ -28,6 +29,7 @@ class NetworkMaterial;
 class MeshPart;
 
 class GeometryMappingResource;
+class GeometryTriangleSets;
 
 class Geometry {
 public:
@@ -50,6 +52,11 @@ public:
     const GeometryMeshes& getMeshes() const { return *_meshes; }
     const std::shared_ptr<const NetworkMaterial> getShapeMaterial(int shapeID) const;
 
+    // Model space triangles of every mesh, for precise picking. They are built on a worker thread as soon as the
+    // geometry has loaded and are shared by every copy of it, asking before that is done builds them right away.
+    using MeshTriangleSets = std::vector<TriangleSet>;
+    std::shared_ptr<const MeshTriangleSets> getMeshTriangleSets() const;
+
     const QVariantMap getTextures() const;
     void setTextures(const QVariantMap& textureMap);
 
@@ -63,6 +70,7 @@ protected:
     std::shared_ptr<const FBXGeometry> _fbxGeometry;
     std::shared_ptr<const GeometryMeshes> _meshes;
     std::shared_ptr<const GeometryMeshParts> _meshParts;
+    std::shared_ptr<GeometryTriangleSets> _triangleSets;
 
     // Copied to each geometry, mutable throughout lifetime via setTextures
     NetworkMaterials _materials;
@@ -111,6 +119,9 @@ public:
 
     void setResource(GeometryResource::Pointer resource);
 
+    // updates the priority of the watched resource while it is still loading
+    void setLoadPriority(const QPointer<QObject>& owner, float priority);
+
     QUrl getURL() const { return (bool)_resource ? _resource->getURL() : QUrl(); }
     int getResourceDownloadAttempts() { return _resource ? _resource->getDownloadAttempts() : 0; }
     int getResourceDownloadAttemptsRemaining() { return _resource ? _resource->getDownloadAttemptsRemaining() : 0; }
@@ -179,6 +190,9 @@ protected:
 
     void setTextures(const QVariantMap& textureMap);
 
+    // streamed textures keep refining in the order of the models using them
+    void setTextureLoadPriority(float priority);
+
     const bool& isOriginal() const { return _isOriginal; }
 
 private:
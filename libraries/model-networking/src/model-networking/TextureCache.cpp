@@ -58,6 +58,10 @@ static const QUrl HMD_PREVIEW_FRAME_URL("resource://hmdPreviewFrame");
 
 static const float SKYBOX_LOAD_PRIORITY { 10.0f }; // Make sure skybox loads first
 static const float HIGH_MIPS_LOAD_PRIORITY { 9.0f }; // Make sure high mips loads after skybox but before models
+static const float MIP_LOAD_PRIORITY_STEP { 0.1f }; // Between textures of equally important models, the least refined goes first
+
+// Small mips are fetched in one range request rather than paying a round trip for each
+static const size_t MAX_COALESCED_MIP_REQUEST_SIZE { 64 * 1024 };
 
 TextureCache::TextureCache() {
     _ktxCache->initialize();
@@ -411,8 +415,21 @@ void NetworkTexture::makeRequest() {
             // Add a fragment to the base url so we can identify the section of the ktx being requested when debugging
             // The actual requested url is _activeUrl and will not contain the fragment
             uint16_t nextMip = _lowestKnownPopulatedMip - 1;
-            _url.setFragment(QString::number(nextMip));
-            startMipRangeRequest(nextMip, nextMip);
+            uint16_t lowestMip = nextMip;
+            auto& images = _originalKtxDescriptor->images;
+            size_t requestSize = images[nextMip]._imageSize;
+            while (lowestMip > _lowestRequestedMipLevel &&
+                   requestSize + images[lowestMip - 1]._imageSize <= MAX_COALESCED_MIP_REQUEST_SIZE) {
+                --lowestMip;
+                requestSize += images[lowestMip]._imageSize;
+            }
+
+            if (lowestMip == nextMip) {
+                _url.setFragment(QString::number(nextMip));
+            } else {
+                _url.setFragment(QString("%1-%2").arg(lowestMip).arg(nextMip));
+            }
+            startMipRangeRequest(lowestMip, nextMip);
         }
     } else {
         qWarning(networking) << "NetworkTexture::makeRequest() called while not in a valid state: " << _ktxResourceState;
@@ -436,13 +453,29 @@ void NetworkTexture::startRequestForNextMipLevel() {
         _ktxResourceState = PENDING_MIP_REQUEST;
 
         init(false);
-        float priority = -(float)_originalKtxDescriptor->header.numberOfMipmapLevels + (float)_lowestKnownPopulatedMip;
-        setLoadPriority(this, priority);
+        setLoadPriority(this, getMipRequestPriority());
         _url.setFragment(QString::number(_lowestKnownPopulatedMip - 1));
         TextureCache::attemptRequest(self);
     }
 }
 
+float NetworkTexture::getMipRequestPriority() const {
+    float mipOffset = -(float)_originalKtxDescriptor->header.numberOfMipmapLevels + (float)_lowestKnownPopulatedMip;
+    if (_ownerLoadPriority == -FLT_MAX) {
+        return mipOffset;
+    }
+    return _ownerLoadPriority + MIP_LOAD_PRIORITY_STEP * mipOffset;
+}
+
+void NetworkTexture::setOwnerLoadPriority(float priority) {
+    _ownerLoadPriority = std::max(_ownerLoadPriority, priority);
+
+    // a refinement already waiting in the queue is picked by its current priority
+    if (_ktxResourceState == PENDING_MIP_REQUEST && _originalKtxDescriptor) {
+        setLoadPriority(this, getMipRequestPriority());
+    }
+}
+
 // Load mips in the range [low, high] (inclusive)
 void NetworkTexture::startMipRangeRequest(uint16_t low, uint16_t high) {
     if (_ktxMipRequest) {
@@ -564,17 +597,44 @@ void NetworkTexture::ktxMipRequestFinished() {
 
         if (_ktxResourceState == REQUESTING_MIP) {
             Q_ASSERT(_ktxMipLevelRangeInFlight.first != NULL_MIP_LEVEL);
-            Q_ASSERT(_ktxMipLevelRangeInFlight.second - _ktxMipLevelRangeInFlight.first == 0);
+            Q_ASSERT(_ktxMipLevelRangeInFlight.second >= _ktxMipLevelRangeInFlight.first);
 
             _ktxResourceState = WAITING_FOR_MIP_REQUEST;
 
             auto self = _self;
             auto url = _url;
             auto data = _ktxMipRequest->getData();
-            auto mipLevel = _ktxMipLevelRangeInFlight.first;
             auto texture = _textureSource->getGPUTexture();
+
+            // Where each requested mip sits in the received data, from the smallest to the largest, which is the
+            // order they have to be assigned in. A server that ignores the range sends the whole file, which
+            // then holds every remaining mip.
+            auto& images = _originalKtxDescriptor->images;
+            size_t imagesStart = ktx::KTX_HEADER_SIZE + _originalKtxDescriptor->header.bytesOfKeyValueData;
+            uint16_t highMip = _ktxMipLevelRangeInFlight.second;
+            uint16_t lowMip = _ktxMipLevelRangeInFlight.first;
+            size_t dataStart = imagesStart + images[lowMip]._imageOffset + ktx::IMAGE_SIZE_WIDTH;
+            size_t dataEnd = imagesStart + images[highMip + 1]._imageOffset;
+            if ((size_t)data.size() != dataEnd - dataStart) {
+                if ((size_t)data.size() >= dataEnd) {
+                    dataStart = 0;
+                    lowMip = 0;
+                } else {
+                    qCWarning(modelnetworking) << "Unexpected size for mips" << _ktxMipLevelRangeInFlight.first << "to"
+                        << highMip << "of" << _url << ":" << data.size();
+                    // keep the mips we have, but stop refining
+                    _ktxResourceState = FAILED_TO_LOAD;
+                    lowMip = highMip + 1;
+                }
+            }
+            std::vector<std::pair<size_t, size_t>> mipSlices;
+            for (int level = highMip; level >= (int)lowMip; --level) {
+                size_t offset = imagesStart + images[level]._imageOffset + ktx::IMAGE_SIZE_WIDTH - dataStart;
+                mipSlices.emplace_back(offset, images[level]._imageSize);
+            }
+
             DependencyManager::get<StatTracker>()->incrementStat("PendingProcessing");
-            QtConcurrent::run(QThreadPool::globalInstance(), [self, data, mipLevel, url, texture] {
+            QtConcurrent::run(ResourceCache::getDecodeThreadPool(), [self, data, highMip, mipSlices, url, texture] {
                 PROFILE_RANGE_EX(resource_parse_image, "NetworkTexture - Processing Mip Data", 0xffff0000, 0, { { "url", url.toString() } });
                 DependencyManager::get<StatTracker>()->decrementStat("PendingProcessing");
                 CounterStat counter("Processing");
@@ -594,7 +654,11 @@ void NetworkTexture::ktxMipRequestFinished() {
 
                 Q_ASSERT_X(texture, "Async - NetworkTexture::ktxMipRequestFinished", "NetworkTexture should have been assigned a GPU texture by now.");
 
-                texture->assignStoredMip(mipLevel, data.size(), reinterpret_cast<const uint8_t*>(data.data()));
+                auto mipData = reinterpret_cast<const uint8_t*>(data.data());
+                uint16_t mipLevel = highMip;
+                for (const auto& slice : mipSlices) {
+                    texture->assignStoredMip(mipLevel--, slice.second, mipData + slice.first);
+                }
 
                 QMetaObject::invokeMethod(resource.data(), "setImage",
                     Q_ARG(gpu::TexturePointer, texture),
@@ -636,7 +700,7 @@ void NetworkTexture::handleFinishedInitialLoad() {
     auto self = _self;
     auto url = _url;
     DependencyManager::get<StatTracker>()->incrementStat("PendingProcessing");
-    QtConcurrent::run(QThreadPool::globalInstance(), [self, ktxHeaderData, ktxHighMipData, url] {
+    QtConcurrent::run(ResourceCache::getDecodeThreadPool(), [self, ktxHeaderData, ktxHighMipData, url] {
         PROFILE_RANGE_EX(resource_parse_image, "NetworkTexture - Processing Initial Data", 0xffff0000, 0, { { "url", url.toString() } });
         DependencyManager::get<StatTracker>()->decrementStat("PendingProcessing");
         CounterStat counter("Processing");
@@ -797,7 +861,7 @@ void NetworkTexture::loadContent(const QByteArray& content) {
         return;
     }
 
-    QThreadPool::globalInstance()->start(new ImageReader(_self, _url, content, _maxNumPixels));
+    ResourceCache::startDecode(new ImageReader(_self, _url, content, _maxNumPixels), getLoadPriority());
 }
 
 void NetworkTexture::refresh() {
@@ -12,6 +12,8 @@
 #ifndef hifi_TextureCache_h
 #define hifi_TextureCache_h
 
+#include <cfloat>
+
 #include <gpu/Texture.h>
 
 #include <QImage>
@@ -59,6 +61,10 @@ public:
 
     void refresh() override;
 
+    // Refinement requests (mips past the initial low resolution ones) are ordered by the most important model
+    // using the texture, rather than only by how far along the texture is.
+    void setOwnerLoadPriority(float priority);
+
     Q_INVOKABLE void setOriginalDescriptor(ktx::KTXDescriptor* descriptor) { _originalKtxDescriptor.reset(descriptor); }
 
 signals:
@@ -82,6 +88,7 @@ protected:
 
     void startMipRangeRequest(uint16_t low, uint16_t high);
     void handleFinishedInitialLoad();
+    float getMipRequestPriority() const;
 
 private:
     friend class KTXReader;
@@ -113,6 +120,8 @@ private:
     uint16_t _lowestRequestedMipLevel { NULL_MIP_LEVEL };
     uint16_t _lowestKnownPopulatedMip { NULL_MIP_LEVEL };
 
+    float _ownerLoadPriority { -FLT_MAX };
+
     // This is a copy of the original KTX descriptor from the source url.
     // We need this because the KTX that will be cached will likely include extra data
     // in its key/value data, and so will not match up with the original, causing
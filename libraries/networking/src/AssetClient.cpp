@@ -280,7 +280,7 @@ void AssetClient::handleAssetGetInfoReply(QSharedPointer<ReceivedMessage> messag
 
     MessageID messageID;
     message->readPrimitive(&messageID);
-    auto assetHash = message->read(SHA256_HASH_LENGTH);
+    auto assetHash = message->readWithoutCopy(SHA256_HASH_LENGTH);
 
     AssetServerError error;
     message->readPrimitive(&error);
@@ -683,7 +683,7 @@ void AssetClient::handleAssetUploadReply(QSharedPointer<ReceivedMessage> message
     if (error) {
         qCWarning(asset_client) << "Error uploading file to asset server";
     } else {
-        auto hash = message->read(SHA256_HASH_LENGTH);
+        auto hash = message->readWithoutCopy(SHA256_HASH_LENGTH);
         hashString = hash.toHex();
 
         qCDebug(asset_client) << "Successfully uploaded asset to asset-server - SHA256 hash is " << hashString;
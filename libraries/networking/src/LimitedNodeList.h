@@ -79,6 +79,13 @@ namespace PingType {
     const PingType_t Symmetric = 3;
 }
 
+// each entry in a DomainList is either a node to add or update, or the UUID of a node that is gone
+typedef quint8 DomainListEntryType_t;
+namespace DomainListEntryType {
+    const DomainListEntryType_t Node = 0;
+    const DomainListEntryType_t Removed = 1;
+}
+
 class LimitedNodeList : public QObject, public Dependency {
     Q_OBJECT
     SINGLETON_DEPENDENCY
@@ -284,6 +291,10 @@ public:
 
     void setConnectionMaxBandwidth(int maxBandwidth) { _nodeSocket.setConnectionMaxBandwidth(maxBandwidth); }
 
+    // only connections made after this use the new congestion control
+    void setCongestionControlFactory(std::unique_ptr<udt::CongestionControlVirtualFactory> ccFactory)
+        { _nodeSocket.setCongestionControlFactory(std::move(ccFactory)); }
+
     void setPacketFilterOperator(udt::PacketFilterOperator filterOperator) { _nodeSocket.setPacketFilterOperator(filterOperator); }
     bool packetVersionMatch(const udt::Packet& packet);
 
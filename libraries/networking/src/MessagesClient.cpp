@@ -32,12 +32,15 @@ MessagesClient::MessagesClient() {
     connect(nodeList.data(), &LimitedNodeList::nodeActivated, this, &MessagesClient::handleNodeActivated);
 }
 
-void MessagesClient::decodeMessagesPacket(QSharedPointer<ReceivedMessage> receivedMessage, QString& channel, 
-                                                bool& isText, QString& message, QByteArray& data, QUuid& senderID) {
+QString MessagesClient::decodeMessagesChannel(QSharedPointer<ReceivedMessage> receivedMessage) {
     quint16 channelLength;
     receivedMessage->readPrimitive(&channelLength);
-    auto channelData = receivedMessage->read(channelLength);
-    channel = QString::fromUtf8(channelData);
+    return QString::fromUtf8(receivedMessage->read(channelLength));
+}
+
+void MessagesClient::decodeMessagesPacket(QSharedPointer<ReceivedMessage> receivedMessage, QString& channel, 
+                                                bool& isText, QString& message, QByteArray& data, QUuid& senderID) {
+    channel = decodeMessagesChannel(receivedMessage);
 
     receivedMessage->readPrimitive(&isText);
 
@@ -38,6 +38,8 @@ public:
 
     static void decodeMessagesPacket(QSharedPointer<ReceivedMessage> receivedMessage, QString& channel, 
                                            bool& isText, QString& message, QByteArray& data, QUuid& senderID);
+    // reads just the channel, for forwarding a message without decoding the rest of it
+    static QString decodeMessagesChannel(QSharedPointer<ReceivedMessage> receivedMessage);
 
     static std::unique_ptr<NLPacketList> encodeMessagesPacket(QString channel, QString message, QUuid senderID);
     static std::unique_ptr<NLPacketList> encodeMessagesDataPacket(QString channel, QByteArray data, QUuid senderID);
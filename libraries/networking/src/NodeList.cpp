@@ -74,6 +74,15 @@ NodeList::NodeList(char newOwnerType, int socketListenPort, int dtlsListenPort)
     // send a domain server check in immediately if there is a public socket change
     connect(this, &LimitedNodeList::publicSockAddrChanged, this, &NodeList::sendDomainServerCheckIn);
 
+    // the domain-server's deltas never list a node again that we dropped on our own (e.g. for being silent),
+    // so forget our list version and the next check in gets us the whole list
+    connect(this, &LimitedNodeList::nodeKilled, this, [this] {
+        if (!_killingDomainListNode) {
+            _domainListVersion = 0;
+            _pendingDomainListVersion = 0;
+        }
+    }, Qt::DirectConnection);
+
     // clear our NodeList when the domain changes
     connect(&_domainHandler, &DomainHandler::disconnectedFromDomain, this, &NodeList::reset);
 
@@ -241,6 +250,11 @@ void NodeList::reset() {
 
     _numNoReplyDomainCheckIns = 0;
 
+    // the next domain list will need to be a full one
+    _domainListVersion = 0;
+    _pendingDomainListVersion = 0;
+    _numPendingDomainListEntries = 0;
+
     // lock and clear our set of ignored IDs
     _ignoredSetLock.lockForWrite();
     _ignoredNodeIDs.clear();
@@ -404,6 +418,9 @@ void NodeList::sendDomainServerCheckIn() {
                 const QByteArray& usernameSignature = accountManager->getAccountInfo().getUsernameSignature(connectionToken);
                 packetStream << usernameSignature;
             }
+        } else {
+            // let the domain-server know which list we have, so it only has to send us what changed since
+            packetStream << _domainListVersion;
         }
 
         flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::SendDSCheckIn);
@@ -624,9 +641,41 @@ void NodeList::processDomainServerList(QSharedPointer<ReceivedMessage> message)
     packetStream >> newPermissions;
     setPermissions(newPermissions);
 
+    // the list may be spread over several packets, we have all of it once we've read numEntries entries
+    quint32 listVersion, baseListVersion, numEntries;
+    packetStream >> listVersion >> baseListVersion >> numEntries;
+
+    if (baseListVersion != 0 && baseListVersion != _domainListVersion) {
+        // this only has what changed since a list we don't have all of
+        // our next check in will tell the domain-server, and it will send us a full list
+        return;
+    }
+
+    if (listVersion != _pendingDomainListVersion) {
+        _pendingDomainListVersion = listVersion;
+        _numPendingDomainListEntries = 0;
+    }
+
     // pull each node in the packet
     while (packetStream.device()->pos() < message->getSize()) {
-        parseNodeFromPacketStream(packetStream);
+        DomainListEntryType_t entryType;
+        packetStream >> entryType;
+
+        if (entryType == DomainListEntryType::Removed) {
+            QUuid nodeUUID;
+            packetStream >> nodeUUID;
+            _killingDomainListNode = true;
+            killNodeWithUUID(nodeUUID);
+            _killingDomainListNode = false;
+        } else {
+            parseNodeFromPacketStream(packetStream);
+        }
+
+        ++_numPendingDomainListEntries;
+    }
+
+    if (_numPendingDomainListEntries >= numEntries) {
+        _domainListVersion = listVersion;
     }
 }
 
@@ -642,7 +691,9 @@ void NodeList::processDomainServerRemovedNode(QSharedPointer<ReceivedMessage> me
     // read the UUID from the packet, remove it if it exists
     QUuid nodeUUID = QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
     qCDebug(networking) << "Received packet from domain-server to remove node with UUID" << uuidStringWithoutCurlyBraces(nodeUUID);
+    _killingDomainListNode = true;
     killNodeWithUUID(nodeUUID);
+    _killingDomainListNode = false;
 }
 
 void NodeList::parseNodeFromPacketStream(QDataStream& packetStream) {
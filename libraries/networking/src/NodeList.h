@@ -159,6 +159,12 @@ private:
     NodeSet _nodeTypesOfInterest;
     DomainHandler _domainHandler;
     int _numNoReplyDomainCheckIns;
+
+    // the last domain list we have all of, and the one we are part way through receiving
+    quint32 _domainListVersion { 0 };
+    quint32 _pendingDomainListVersion { 0 };
+    quint32 _numPendingDomainListEntries { 0 };
+    bool _killingDomainListNode { false }; // set while a node the domain-server removed is killed
     HifiSockAddr _assignmentServerSocket;
     bool _isShuttingDown { false };
     QTimer _keepAlivePingTimer;
@@ -12,20 +12,73 @@
 
 #include "PacketReceiver.h"
 
+#include <QtCore/QCoreApplication>
+#include <QtCore/QEvent>
+#include <QtCore/QJsonArray>
+#include <QtCore/QMetaEnum>
 #include <QMutexLocker>
 
 #include "DependencyManager.h"
 #include "NetworkLogging.h"
 #include "NodeList.h"
 #include "SharedUtil.h"
+#include "UUID.h"
 
-PacketReceiver::PacketReceiver(QObject* parent) : QObject(parent) {
+// Runs tasks on the thread it lives in, in the order they were posted.
+class PacketDispatchQueue : public QObject {
+public:
+    using Task = std::function<void()>;
+
+    void post(Task task) { QCoreApplication::postEvent(this, new TaskEvent(std::move(task))); }
+
+protected:
+    bool event(QEvent* event) override {
+        if (event->type() == TaskEvent::TYPE) {
+            static_cast<TaskEvent*>(event)->task();
+            return true;
+        }
+        return QObject::event(event);
+    }
+
+private:
+    struct TaskEvent : public QEvent {
+        static const QEvent::Type TYPE;
+        TaskEvent(Task task) : QEvent(TYPE), task(std::move(task)) {}
+        Task task;
+    };
+};
+
+const QEvent::Type PacketDispatchQueue::TaskEvent::TYPE = (QEvent::Type)QEvent::registerEventType();
+
+static QString nameForPacketType(PacketType type) {
+    QMetaObject metaObject = PacketTypeEnum::staticMetaObject;
+    QMetaEnum metaEnum = metaObject.enumerator(metaObject.enumeratorOffset());
+    return metaEnum.valueToKey((int)type);
+}
+
+PacketReceiver::PacketReceiver(QObject* parent) :
+    QObject(parent),
+    _listeners(std::make_shared<ListenerTable>())
+{
     qRegisterMetaType<QSharedPointer<NLPacket>>();
     qRegisterMetaType<QSharedPointer<NLPacketList>>();
     qRegisterMetaType<QSharedPointer<ReceivedMessage>>();
+
+    for (auto& histogram : _dispatchLatency) {
+        for (auto& bucket : histogram.buckets) {
+            bucket = 0;
+        }
+        histogram.totalUsecs = 0;
+    }
+    _warnedNoListener.fill(false);
+}
+
+PacketReceiver::~PacketReceiver() {
+    _threadQueues.clear();
 }
 
-bool PacketReceiver::registerListenerForTypes(PacketTypeList types, QObject* listener, const char* slot) {
+bool PacketReceiver::registerListenerForTypes(PacketTypeList types, QObject* listener, const char* slot,
+                                              const DispatchOptions& options) {
     Q_ASSERT_X(!types.empty(), "PacketReceiver::registerListenerForTypes", "No types to register");
     Q_ASSERT_X(listener, "PacketReceiver::registerListenerForTypes", "No object to register");
     Q_ASSERT_X(slot, "PacketReceiver::registerListenerForTypes", "No slot to register");
@@ -54,46 +107,18 @@ bool PacketReceiver::registerListenerForTypes(PacketTypeList types, QObject* lis
     }
     
     // Register non sourced types
-    std::for_each(std::begin(types), middle, [this, &listener, &nonSourcedMethod](PacketType type) {
-        registerVerifiedListener(type, listener, nonSourcedMethod);
+    std::for_each(std::begin(types), middle, [this, &listener, &nonSourcedMethod, &options](PacketType type) {
+        registerVerifiedListener(type, listener, nonSourcedMethod, options);
     });
     
     // Register sourced types
-    std::for_each(middle, std::end(types), [this, &listener, &sourcedMethod](PacketType type) {
-        registerVerifiedListener(type, listener, sourcedMethod);
+    std::for_each(middle, std::end(types), [this, &listener, &sourcedMethod, &options](PacketType type) {
+        registerVerifiedListener(type, listener, sourcedMethod, options);
     });
     
     return true;
 }
 
-void PacketReceiver::registerDirectListener(PacketType type, QObject* listener, const char* slot) {
-    Q_ASSERT_X(listener, "PacketReceiver::registerDirectListener", "No object to register");
-    Q_ASSERT_X(slot, "PacketReceiver::registerDirectListener", "No slot to register");
-    
-    bool success = registerListener(type, listener, slot);
-    if (success) {
-        QMutexLocker locker(&_directConnectSetMutex);
-        
-        // if we successfully registered, add this object to the set of objects that are directly connected
-        _directlyConnectedObjects.insert(listener);
-    }
-}
-
-void PacketReceiver::registerDirectListenerForTypes(PacketTypeList types,
-                                                    QObject* listener, const char* slot) {
-    Q_ASSERT_X(listener, "PacketReceiver::registerDirectListenerForTypes", "No object to register");
-    Q_ASSERT_X(slot, "PacketReceiver::registerDirectListenerForTypes", "No slot to register");
-    
-    // just call register listener for types to start
-    bool success = registerListenerForTypes(std::move(types), listener, slot);
-    if (success) {
-        QMutexLocker locker(&_directConnectSetMutex);
-        
-        // if we successfully registered, add this object to the set of objects that are directly connected
-        _directlyConnectedObjects.insert(listener);
-    }
-}
-
 bool PacketReceiver::registerListener(PacketType type, QObject* listener, const char* slot,
                                              bool deliverPending) {
     Q_ASSERT_X(listener, "PacketReceiver::registerListener", "No object to register");
@@ -103,7 +128,9 @@ bool PacketReceiver::registerListener(PacketType type, QObject* listener, const
 
     if (matchingMethod.isValid()) {
         qCDebug(networking) << "Registering a packet listener for packet list type" << type;
-        registerVerifiedListener(type, listener, matchingMethod, deliverPending);
+        DispatchOptions options;
+        options.deliverPending = deliverPending;
+        registerVerifiedListener(type, listener, matchingMethod, options);
         return true;
     } else {
         qCWarning(networking) << "FAILED to Register a packet listener for packet list type" << type;
@@ -165,39 +192,96 @@ QMetaMethod PacketReceiver::matchingMethodForListener(PacketType type, QObject*
     }
 }
 
-void PacketReceiver::registerVerifiedListener(PacketType type, QObject* object, const QMetaMethod& slot, bool deliverPending) {
+void PacketReceiver::registerVerifiedListener(PacketType type, QObject* object, const QMetaMethod& slot,
+                                              const DispatchOptions& options) {
     Q_ASSERT_X(object, "PacketReceiver::registerVerifiedListener", "No object to register");
+
+    static const QByteArray QSHAREDPOINTER_NODE_NORMALIZED = QMetaObject::normalizedType("QSharedPointer<Node>");
+    static const QByteArray SHARED_NODE_NORMALIZED = QMetaObject::normalizedType("SharedNodePointer");
+
+    // work out how to call the slot once, here, rather than for every message
+    Handler handler;
+    bool requiresNode = false;
+
+    if (slot.parameterTypes().contains(SHARED_NODE_NORMALIZED)) {
+        requiresNode = true;
+        handler = [object, slot](QSharedPointer<ReceivedMessage> message, SharedNodePointer node) {
+            slot.invoke(object, Qt::DirectConnection, Q_ARG(QSharedPointer<ReceivedMessage>, message),
+                        Q_ARG(SharedNodePointer, node));
+        };
+    } else if (slot.parameterTypes().contains(QSHAREDPOINTER_NODE_NORMALIZED)) {
+        requiresNode = true;
+        handler = [object, slot](QSharedPointer<ReceivedMessage> message, SharedNodePointer node) {
+            slot.invoke(object, Qt::DirectConnection, Q_ARG(QSharedPointer<ReceivedMessage>, message),
+                        Q_ARG(QSharedPointer<Node>, node));
+        };
+    } else {
+        handler = [object, slot](QSharedPointer<ReceivedMessage> message, SharedNodePointer) {
+            slot.invoke(object, Qt::DirectConnection, Q_ARG(QSharedPointer<ReceivedMessage>, message));
+        };
+    }
+
+    registerVerifiedHandler(type, object, std::move(handler), options, requiresNode);
+}
+
+bool PacketReceiver::registerVerifiedHandler(PacketType type, QObject* object, Handler handler,
+                                             const DispatchOptions& options, bool requiresNode) {
+    Q_ASSERT_X(object, "PacketReceiver::registerVerifiedHandler", "No object to register");
+    Q_ASSERT_X(handler, "PacketReceiver::registerVerifiedHandler", "No handler to register");
+
+    if (requiresNode && PacketTypeEnum::getNonSourcedPackets().contains(type)) {
+        qCWarning(networking) << "FAILED to Register a packet listener that takes a node for non-sourced packet type"
+            << type;
+        return false;
+    }
+
     QMutexLocker locker(&_packetListenerLock);
 
-    if (_messageListenerMap.contains(type)) {
+    auto listeners = std::make_shared<ListenerTable>(*_listeners);
+    auto& slot = (*listeners)[(int)type];
+
+    if (slot) {
         qCWarning(networking) << "Registering a packet listener for packet type" << type
             << "that will remove a previously registered listener";
     }
-    
+
     // add the mapping
-    _messageListenerMap[type] = { QPointer<QObject>(object), slot, deliverPending };
+    slot = std::make_shared<const Listener>(Listener {
+        QPointer<QObject>(object), std::move(handler),
+        options.onReceiveThread, options.deliverPending, requiresNode
+    });
+
+    std::atomic_store(&_listeners, std::shared_ptr<const ListenerTable>(listeners));
+    return true;
 }
 
 void PacketReceiver::unregisterListener(QObject* listener) {
     Q_ASSERT_X(listener, "PacketReceiver::unregisterListener", "No listener to unregister");
-    
-    {
-        QMutexLocker packetListenerLocker(&_packetListenerLock);
-        
-        // clear any registrations for this listener in _messageListenerMap
-        auto it = _messageListenerMap.begin();
-        
-        while (it != _messageListenerMap.end()) {
-            if (it.value().object == listener) {
-                it = _messageListenerMap.erase(it);
-            } else {
-                ++it;
-            }
+
+    QMutexLocker packetListenerLocker(&_packetListenerLock);
+
+    // clear any registrations for this listener from the listener table
+    auto listeners = std::make_shared<ListenerTable>(*_listeners);
+    for (auto& slot : *listeners) {
+        if (slot && slot->object == listener) {
+            slot.reset();
         }
     }
-    
-    QMutexLocker directConnectSetLocker(&_directConnectSetMutex);
-    _directlyConnectedObjects.remove(listener);
+
+    std::atomic_store(&_listeners, std::shared_ptr<const ListenerTable>(listeners));
+}
+
+void PacketReceiver::removeDeadListener(PacketType type, const std::shared_ptr<const Listener>& listener) {
+    QMutexLocker packetListenerLocker(&_packetListenerLock);
+
+    // it may have been replaced since we looked it up
+    if ((*_listeners)[(int)type] != listener) {
+        return;
+    }
+
+    auto listeners = std::make_shared<ListenerTable>(*_listeners);
+    (*listeners)[(int)type].reset();
+    std::atomic_store(&_listeners, std::shared_ptr<const ListenerTable>(listeners));
 }
 
 void PacketReceiver::handleVerifiedPacket(std::unique_ptr<udt::Packet> packet) {
@@ -210,11 +294,12 @@ void PacketReceiver::handleVerifiedPacket(std::unique_ptr<udt::Packet> packet) {
     
     // setup an NLPacket from the packet we were passed
     auto nlPacket = NLPacket::fromBase(std::move(packet));
-    auto receivedMessage = QSharedPointer<ReceivedMessage>::create(*nlPacket);
 
     _inPacketCount += 1;
     _inByteCount += nlPacket->size();
 
+    auto receivedMessage = QSharedPointer<ReceivedMessage>::create(std::move(nlPacket));
+
     handleVerifiedMessage(receivedMessage, true);
 }
 
@@ -230,14 +315,14 @@ void PacketReceiver::handleVerifiedMessagePacket(std::unique_ptr<udt::Packet> pa
 
     if (it == _pendingMessages.end()) {
         // Create message
-        message = QSharedPointer<ReceivedMessage>::create(*nlPacket);
+        message = QSharedPointer<ReceivedMessage>::create(std::move(nlPacket));
         if (!message->isComplete()) {
             _pendingMessages[key] = message;
         }
         handleVerifiedMessage(message, true);
     } else {
         message = it->second;
-        message->appendPacket(*nlPacket);
+        message->appendPacket(std::move(nlPacket));
 
         if (message->isComplete()) {
             _pendingMessages.erase(it);
@@ -257,107 +342,132 @@ void PacketReceiver::handleMessageFailure(HifiSockAddr from, udt::Packet::Messag
 }
 
 void PacketReceiver::handleVerifiedMessage(QSharedPointer<ReceivedMessage> receivedMessage, bool justReceived) {
-    auto nodeList = DependencyManager::get<LimitedNodeList>();
-    
+    PacketType packetType = receivedMessage->getType();
+
+    // the listener table is replaced rather than changed, so holding on to it is all the locking we need
+    auto listeners = std::atomic_load(&_listeners);
+    const auto& listener = (*listeners)[(int)packetType];
+
+    if (!listener) {
+        if (!_warnedNoListener[(int)packetType]) {
+            qCWarning(networking) << "No listener found for packet type" << packetType;
+
+            // remember we did so we don't print this again
+            _warnedNoListener[(int)packetType] = true;
+        }
+        return;
+    }
+
+    if ((listener->deliverPending && !justReceived) || (!listener->deliverPending && !receivedMessage->isComplete())) {
+        return;
+    }
+
+    if (!listener->object) {
+        qCDebug(networking).nospace() << "Listener for packet " << packetType
+            << " has been destroyed. Removing from listener table.";
+        removeDeadListener(packetType, listener);
+        return;
+    }
+
     SharedNodePointer matchingNode;
-    
+
     if (!receivedMessage->getSourceID().isNull()) {
-        matchingNode = nodeList->nodeWithUUID(receivedMessage->getSourceID());
+        matchingNode = DependencyManager::get<LimitedNodeList>()->nodeWithUUID(receivedMessage->getSourceID());
     }
-    
-    QMutexLocker packetListenerLocker(&_packetListenerLock);
-    
-    bool listenerIsDead = false;
-    
-    auto it = _messageListenerMap.find(receivedMessage->getType());
-            
-    if (it != _messageListenerMap.end() && it->method.isValid()) {
-         
-        auto listener = it.value();
-
-        if ((listener.deliverPending && !justReceived) || (!listener.deliverPending && !receivedMessage->isComplete())) {
-            return;
+
+    if (matchingNode) {
+        matchingNode->recordBytesReceived(receivedMessage->getSize());
+    } else if (listener->requiresNode) {
+        qCDebug(networking).nospace() << "Not delivering packet " << packetType << " from unknown node "
+            << uuidStringWithoutCurlyBraces(receivedMessage->getSourceID()) << " to a listener that requires one";
+        return;
+    }
+
+    dispatch(listener, receivedMessage, matchingNode);
+}
+
+void PacketReceiver::dispatch(const std::shared_ptr<const Listener>& listener, QSharedPointer<ReceivedMessage> message,
+                              SharedNodePointer node) {
+    PacketType packetType = message->getType();
+    quint64 dispatchTime = usecTimestampNow();
+
+    PacketDispatchQueue* queue = nullptr;
+
+    if (!listener->onReceiveThread) {
+        QThread* listenerThread = listener->object->thread();
+        if (listenerThread != QThread::currentThread()) {
+            queue = queueForThread(listenerThread);
         }
-    
-        if (listener.object) {
-            
-            bool success = false;
-
-            Qt::ConnectionType connectionType;
-            // check if this is a directly connected listener
-            {
-                QMutexLocker directConnectLocker(&_directConnectSetMutex);
- 
-                connectionType = _directlyConnectedObjects.contains(listener.object) ? Qt::DirectConnection : Qt::AutoConnection;
-            }
-            
-            PacketType packetType = receivedMessage->getType();
-            
-            if (matchingNode) {
-                matchingNode->recordBytesReceived(receivedMessage->getSize());
-
-                QMetaMethod metaMethod = listener.method;
-                
-                static const QByteArray QSHAREDPOINTER_NODE_NORMALIZED = QMetaObject::normalizedType("QSharedPointer<Node>");
-                static const QByteArray SHARED_NODE_NORMALIZED = QMetaObject::normalizedType("SharedNodePointer");
-                
-                // one final check on the QPointer before we go to invoke
-                if (listener.object) {
-                    if (metaMethod.parameterTypes().contains(SHARED_NODE_NORMALIZED)) {
-                        success = metaMethod.invoke(listener.object,
-                                                    connectionType,
-                                                    Q_ARG(QSharedPointer<ReceivedMessage>, receivedMessage),
-                                                    Q_ARG(SharedNodePointer, matchingNode));
-                        
-                    } else if (metaMethod.parameterTypes().contains(QSHAREDPOINTER_NODE_NORMALIZED)) {
-                        success = metaMethod.invoke(listener.object,
-                                                    connectionType,
-                                                    Q_ARG(QSharedPointer<ReceivedMessage>, receivedMessage),
-                                                    Q_ARG(QSharedPointer<Node>, matchingNode));
-                        
-                    } else {
-                        success = metaMethod.invoke(listener.object,
-                                                    connectionType,
-                                                    Q_ARG(QSharedPointer<ReceivedMessage>, receivedMessage));
-                    }
-                } else {
-                    listenerIsDead = true;
-                }
-            } else {
-                // one final check on the QPointer before we invoke
-                if (listener.object) {
-                    success = listener.method.invoke(listener.object,
-                                                     Q_ARG(QSharedPointer<ReceivedMessage>, receivedMessage));
-                } else {
-                    listenerIsDead = true;
-                }
-                
-            }
-            
-            if (!success) {
-                qCDebug(networking).nospace() << "Error delivering packet " << packetType << " to listener "
-                    << listener.object << "::" << qPrintable(listener.method.methodSignature());
-            }
-            
-        } else {
-            listenerIsDead = true;
+    }
+
+    if (!queue) {
+        recordDispatchLatency(packetType, dispatchTime);
+        listener->handler(message, node);
+        return;
+    }
+
+    // the listener is captured by value so it stays valid even if it is unregistered before the task runs
+    auto queuedListener = listener;
+    queue->post([this, queuedListener, message, node, packetType, dispatchTime] {
+        // one final check on the QPointer before we call the handler
+        if (queuedListener->object) {
+            recordDispatchLatency(packetType, dispatchTime);
+            queuedListener->handler(message, node);
         }
-        
-        if (listenerIsDead) {
-            qCDebug(networking).nospace() << "Listener for packet " << receivedMessage->getType()
-                << " has been destroyed. Removing from listener map.";
-            it = _messageListenerMap.erase(it);
-            
-            // if it exists, remove the listener from _directlyConnectedObjects
-            {
-                QMutexLocker directConnectLocker(&_directConnectSetMutex);
-                _directlyConnectedObjects.remove(listener.object);
-            }
+    });
+}
+
+PacketDispatchQueue* PacketReceiver::queueForThread(QThread* thread) {
+    auto& threadQueue = _threadQueues[thread];
+
+    // a thread that was destroyed can have its address reused by a new one, so check we still have the same thread
+    if (!threadQueue.queue || !threadQueue.thread) {
+        threadQueue.thread = thread;
+        threadQueue.queue.reset(new PacketDispatchQueue());
+        threadQueue.queue->moveToThread(thread);
+    }
+
+    return threadQueue.queue.get();
+}
+
+void PacketReceiver::recordDispatchLatency(PacketType type, quint64 dispatchTime) {
+    quint64 latency = usecTimestampNow() - dispatchTime;
+
+    int bucket = 0;
+    while (bucket < NUM_LATENCY_BUCKETS - 1 && (latency >> (bucket + 1)) > 0) {
+        ++bucket;
+    }
+
+    auto& histogram = _dispatchLatency[(int)type];
+    histogram.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    histogram.totalUsecs.fetch_add(latency, std::memory_order_relaxed);
+}
+
+QJsonObject PacketReceiver::getAndResetDispatchStats() {
+    QJsonObject statsObject;
+
+    for (int type = 0; type < NUM_PACKET_TYPES; ++type) {
+        auto& histogram = _dispatchLatency[type];
+
+        QJsonArray bucketsArray;
+        quint64 count = 0;
+        for (auto& bucket : histogram.buckets) {
+            quint32 bucketCount = bucket.exchange(0, std::memory_order_relaxed);
+            bucketsArray.append((double)bucketCount);
+            count += bucketCount;
+        }
+        quint64 totalUsecs = histogram.totalUsecs.exchange(0, std::memory_order_relaxed);
+
+        if (count > 0) {
+            QJsonObject typeObject;
+            typeObject["count"] = (double)count;
+            typeObject["avg_usecs"] = (double)totalUsecs / count;
+
+            // bucket i counts the messages that waited from 2^i up to 2^(i+1) usecs, the first also counts no wait
+            typeObject["histogram_log2_usecs"] = bucketsArray;
+            statsObject[nameForPacketType((PacketType)type)] = typeObject;
         }
-    } else if (it == _messageListenerMap.end()) {
-        qCWarning(networking) << "No listener found for packet type" << receivedMessage->getType();
-        
-        // insert a dummy listener so we don't print this again
-        _messageListenerMap.insert(receivedMessage->getType(), { nullptr, QMetaMethod(), false });
     }
+
+    return statsObject;
 }
@@ -13,23 +13,30 @@
 #ifndef hifi_PacketReceiver_h
 #define hifi_PacketReceiver_h
 
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
 #include <vector>
 #include <unordered_map>
 
+#include <QtCore/QJsonObject>
 #include <QtCore/QMap>
 #include <QtCore/QMetaMethod>
 #include <QtCore/QMutex>
 #include <QtCore/QObject>
 #include <QtCore/QPointer>
-#include <QtCore/QSet>
+#include <QtCore/QThread>
 
 #include "NLPacket.h"
 #include "NLPacketList.h"
 #include "ReceivedMessage.h"
 #include "udt/PacketHeaders.h"
 
-class EntityEditPacketSender;
-class OctreePacketProcessor;
+class Node;
+class PacketDispatchQueue;
+
+using SharedNodePointer = QSharedPointer<Node>;
 
 namespace std {
     template <>
@@ -44,9 +51,18 @@ class PacketReceiver : public QObject {
     Q_OBJECT
 public:
     using PacketTypeList = std::vector<PacketType>;
-    
+    using Handler = std::function<void(QSharedPointer<ReceivedMessage>, SharedNodePointer)>;
+
+    // Where and when a handler is called. By default handlers run on the thread their listener lives in, the way a
+    // queued slot would. onReceiveThread runs them right away on the thread that received the packet.
+    struct DispatchOptions {
+        bool deliverPending { false };
+        bool onReceiveThread { false };
+    };
+
     PacketReceiver(QObject* parent = 0);
     PacketReceiver(const PacketReceiver&) = delete;
+    ~PacketReceiver();
 
     PacketReceiver& operator=(const PacketReceiver&) = delete;
     
@@ -61,42 +77,106 @@ public:
     // been received. If deliverPending is true, ReceivedMessage will be delivered as soon as the first packet
     // for the message is received.
     bool registerListener(PacketType type, QObject* listener, const char* slot, bool deliverPending = false);
-    bool registerListenerForTypes(PacketTypeList types, QObject* listener, const char* slot);
+    bool registerListenerForTypes(PacketTypeList types, QObject* listener, const char* slot,
+                                  const DispatchOptions& options = DispatchOptions());
+
+    // typed listeners, called without going through the meta-object system. A handler is passed a null node
+    // when the message isn't from a node we know about, a member function that takes the node is not called then.
+    bool registerHandler(PacketType type, QObject* listener, Handler handler,
+                         const DispatchOptions& options = DispatchOptions()) {
+        return registerVerifiedHandler(type, listener, std::move(handler), options, false);
+    }
+
+    // the slot may be a member of a base class of the listener
+    template <typename T, typename U>
+    bool registerListener(PacketType type, T* listener,
+                          void (U::*slot)(QSharedPointer<ReceivedMessage>, SharedNodePointer),
+                          const DispatchOptions& options = DispatchOptions()) {
+        return registerVerifiedHandler(type, listener, [listener, slot](QSharedPointer<ReceivedMessage> message,
+                                                                        SharedNodePointer node) {
+            (listener->*slot)(message, node);
+        }, options, true);
+    }
+
+    template <typename T, typename U>
+    bool registerListener(PacketType type, T* listener, void (U::*slot)(QSharedPointer<ReceivedMessage>),
+                          const DispatchOptions& options = DispatchOptions()) {
+        return registerHandler(type, listener, [listener, slot](QSharedPointer<ReceivedMessage> message, SharedNodePointer) {
+            (listener->*slot)(message);
+        }, options);
+    }
+
+    template <typename T, typename U>
+    bool registerListenerForTypes(PacketTypeList types, T* listener,
+                                  void (U::*slot)(QSharedPointer<ReceivedMessage>, SharedNodePointer),
+                                  const DispatchOptions& options = DispatchOptions()) {
+        bool registered = true;
+        for (PacketType type : types) {
+            registered = registerListener(type, listener, slot, options) && registered;
+        }
+        return registered;
+    }
+
     void unregisterListener(QObject* listener);
     
     void handleVerifiedPacket(std::unique_ptr<udt::Packet> packet);
     void handleVerifiedMessagePacket(std::unique_ptr<udt::Packet> message);
     void handleMessageFailure(HifiSockAddr from, udt::Packet::MessageNumber messageNumber);
+
+    // how long messages of each type waited between being dispatched and their handler starting, since the last call
+    QJsonObject getAndResetDispatchStats();
     
 private:
     struct Listener {
         QPointer<QObject> object;
-        QMetaMethod method;
+        Handler handler;
+        bool onReceiveThread;
         bool deliverPending;
+        bool requiresNode;
     };
 
-    void handleVerifiedMessage(QSharedPointer<ReceivedMessage> message, bool justReceived);
+    static const int NUM_PACKET_TYPES = (int)PacketType::NUM_PACKET_TYPE;
+    using ListenerTable = std::array<std::shared_ptr<const Listener>, NUM_PACKET_TYPES>;
 
-    // these are brutal hacks for now - ideally GenericThread / ReceivedPacketProcessor
-    // should be changed to have a true event loop and be able to handle our QMetaMethod::invoke
-    void registerDirectListenerForTypes(PacketTypeList types, QObject* listener, const char* slot);
-    void registerDirectListener(PacketType type, QObject* listener, const char* slot);
+    // dispatch latency in power of two buckets, from under 2us up to over 32ms
+    static const int NUM_LATENCY_BUCKETS = 16;
+    struct LatencyHistogram {
+        std::array<std::atomic<quint32>, NUM_LATENCY_BUCKETS> buckets;
+        std::atomic<quint64> totalUsecs;
+    };
+
+    void handleVerifiedMessage(QSharedPointer<ReceivedMessage> message, bool justReceived);
+    void dispatch(const std::shared_ptr<const Listener>& listener, QSharedPointer<ReceivedMessage> message,
+                  SharedNodePointer node);
+    void recordDispatchLatency(PacketType type, quint64 dispatchTime);
+    void removeDeadListener(PacketType type, const std::shared_ptr<const Listener>& listener);
+    PacketDispatchQueue* queueForThread(QThread* thread);
 
     QMetaMethod matchingMethodForListener(PacketType type, QObject* object, const char* slot) const;
-    void registerVerifiedListener(PacketType type, QObject* listener, const QMetaMethod& slot, bool deliverPending = false);
+    void registerVerifiedListener(PacketType type, QObject* listener, const QMetaMethod& slot,
+                                  const DispatchOptions& options = DispatchOptions());
+    bool registerVerifiedHandler(PacketType type, QObject* listener, Handler handler,
+                                 const DispatchOptions& options, bool requiresNode);
 
+    // the listener table is only ever replaced, under _packetListenerLock, so it can be read without locking
     QMutex _packetListenerLock;
-    QHash<PacketType, Listener> _messageListenerMap;
+    std::shared_ptr<const ListenerTable> _listeners;
+
+    std::array<LatencyHistogram, NUM_PACKET_TYPES> _dispatchLatency;
+
+    // only used from the thread that receives packets
+    struct ThreadQueue {
+        QPointer<QThread> thread;
+        std::unique_ptr<PacketDispatchQueue> queue;
+    };
+    std::unordered_map<QThread*, ThreadQueue> _threadQueues;
+    std::array<bool, NUM_PACKET_TYPES> _warnedNoListener;
+
     int _inPacketCount = 0;
     int _inByteCount = 0;
     bool _shouldDropPackets = false;
-    QMutex _directConnectSetMutex;
-    QSet<QObject*> _directlyConnectedObjects;
 
     std::unordered_map<std::pair<HifiSockAddr, udt::Packet::MessageNumber>, QSharedPointer<ReceivedMessage>> _pendingMessages;
-    
-    friend class EntityEditPacketSender;
-    friend class OctreePacketProcessor;
 };
 
 #endif // hifi_PacketReceiver_h
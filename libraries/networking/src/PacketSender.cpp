@@ -10,9 +10,12 @@
 //
 
 #include <algorithm>
+#include <limits>
 #include <math.h>
 #include <stdint.h>
 
+#include <NumericalConstants.h>
+
 #include "NodeList.h"
 #include "PacketSender.h"
 #include "SharedUtil.h"
@@ -25,6 +28,7 @@ const int PacketSender::MAX_SLEEP_INTERVAL = PacketSender::USECS_PER_SECOND;
 const int PacketSender::DEFAULT_PACKETS_PER_SECOND = 30;
 const int PacketSender::MINIMUM_PACKETS_PER_SECOND = 1;
 const int PacketSender::MINIMAL_SLEEP_INTERVAL = (USECS_PER_SECOND / TARGET_FPS) / 2;
+const quint64 PacketSender::NO_PROCESS_DUE = std::numeric_limits<quint64>::max();
 
 const int AVERAGE_CALL_TIME_SAMPLES = 10;
 
@@ -76,6 +80,12 @@ void PacketSender::terminating() {
     _hasPackets.wakeAll();
 }
 
+void PacketSender::wakeToProcess() {
+    // take the lock so the wake can't land between the sender asking when it is due and starting to wait
+    QMutexLocker locker(&_waitingOnPacketsMutex);
+    _hasPackets.wakeAll();
+}
+
 bool PacketSender::threadedProcess() {
     bool hasSlept = false;
 
@@ -118,9 +128,14 @@ bool PacketSender::threadedProcess() {
 
     // if threaded and we haven't slept? We want to wait for our consumer to signal us with new packets
     if (!hasSlept) {
-        // wait till we have packets
+        // wait till we have packets, or till a message that was held back is due
         _waitingOnPacketsMutex.lock();
-        _hasPackets.wait(&_waitingOnPacketsMutex);
+        quint64 usecsUntilDue = getUsecsUntilProcessDue();
+        if (usecsUntilDue == NO_PROCESS_DUE) {
+            _hasPackets.wait(&_waitingOnPacketsMutex);
+        } else if (usecsUntilDue > 0) {
+            _hasPackets.wait(&_waitingOnPacketsMutex, (unsigned long)((usecsUntilDue + USECS_PER_MSEC - 1) / USECS_PER_MSEC));
+        }
         _waitingOnPacketsMutex.unlock();
     }
 
@@ -93,6 +93,14 @@ public:
 signals:
     void packetSent(quint64);
 protected:
+    /// In threaded mode, how long to wait for new packets before calling process() again anyway, for subclasses that
+    /// hold messages back and have to queue them once they are due. The default waits until a packet is queued.
+    virtual quint64 getUsecsUntilProcessDue() { return NO_PROCESS_DUE; }
+    static const quint64 NO_PROCESS_DUE;
+
+    /// Wakes a threaded sender waiting for packets so that it asks getUsecsUntilProcessDue() again
+    void wakeToProcess();
+
     int _packetsPerSecond;
     int _usecsPerProcessCallHint;
     quint64 _lastProcessCallTime;
@@ -12,27 +12,39 @@
 
 #include "ReceivedMessage.h"
 
-#include "QSharedPointer"
+#include <algorithm>
+
+#include <QtCore/QSharedPointer>
+#include <QtCore/QtEndian>
+
+#include <UUID.h>
 
 int receivedMessageMetaTypeId = qRegisterMetaType<ReceivedMessage*>("ReceivedMessage*");
 int sharedPtrReceivedMessageMetaTypeId = qRegisterMetaType<QSharedPointer<ReceivedMessage>>("QSharedPointer<ReceivedMessage>");
 
-static const int HEAD_DATA_SIZE = 512;
+static std::atomic<quint64> bytesCopied { 0 };
+static std::atomic<quint64> bytesReceived { 0 };
 
 ReceivedMessage::ReceivedMessage(const NLPacketList& packetList)
     : _data(packetList.getMessage()),
-      _headData(_data.mid(0, HEAD_DATA_SIZE)),
+      _isFlat(true),
       _numPackets(packetList.getNumPackets()),
       _sourceID(packetList.getSourceID()),
       _packetType(packetList.getType()),
       _packetVersion(packetList.getVersion()),
       _senderSockAddr(packetList.getSenderSockAddr())
 {
+    _size = _data.size();
+    _headData = _data.constData();
+    _headSize = _size;
+
+    bytesCopied += _size;
+    bytesReceived += _size;
 }
 
 ReceivedMessage::ReceivedMessage(NLPacket& packet)
     : _data(packet.readAll()),
-      _headData(_data.mid(0, HEAD_DATA_SIZE)),
+      _isFlat(true),
       _numPackets(1),
       _sourceID(packet.getSourceID()),
       _packetType(packet.getType()),
@@ -40,12 +52,36 @@ ReceivedMessage::ReceivedMessage(NLPacket& packet)
       _senderSockAddr(packet.getSenderSockAddr()),
       _isComplete(packet.getPacketPosition() == NLPacket::ONLY)
 {
+    _size = _data.size();
+    _headData = _data.constData();
+    _headSize = _size;
+
+    bytesCopied += _size;
+    bytesReceived += _size;
+}
+
+ReceivedMessage::ReceivedMessage(std::unique_ptr<NLPacket> packet)
+    : _numPackets(1),
+      _sourceID(packet->getSourceID()),
+      _packetType(packet->getType()),
+      _packetVersion(packet->getVersion()),
+      _senderSockAddr(packet->getSenderSockAddr()),
+      _isComplete(packet->getPacketPosition() == NLPacket::ONLY)
+{
+    // the packet's payload is the message, no copy required
+    _headData = packet->getPayload() + packet->pos();
+    _headSize = packet->bytesLeftToRead();
+    _size = _headSize;
+    _segments.push_back({ std::move(packet), _headData, _headSize, 0 });
+
+    bytesReceived += _size;
 }
 
 ReceivedMessage::ReceivedMessage(QByteArray byteArray, PacketType packetType, PacketVersion packetVersion,
                 const HifiSockAddr& senderSockAddr, QUuid sourceID) :
+    _size(byteArray.size()),
     _data(byteArray),
-    _headData(_data.mid(0, HEAD_DATA_SIZE)),
+    _isFlat(true),
     _numPackets(1),
     _sourceID(sourceID),
     _packetType(packetType),
@@ -53,7 +89,8 @@ ReceivedMessage::ReceivedMessage(QByteArray byteArray, PacketType packetType, Pa
     _senderSockAddr(senderSockAddr),
     _isComplete(true)
 {
-
+    _headData = _data.constData();
+    _headSize = _size;
 }
 
 void ReceivedMessage::setFailed() {
@@ -62,7 +99,7 @@ void ReceivedMessage::setFailed() {
     emit completed();
 }
 
-void ReceivedMessage::appendPacket(NLPacket& packet) {
+void ReceivedMessage::appendPacket(std::unique_ptr<NLPacket> packet) {
     Q_ASSERT_X(!_isComplete, "ReceivedMessage::appendPacket", 
                "We should not be appending to a complete message");
 
@@ -71,47 +108,150 @@ void ReceivedMessage::appendPacket(NLPacket& packet) {
 
     ++_numPackets;
 
-    _data.append(packet.getPayload(), packet.getPayloadSize());
+    bool isLast = packet->getPacketPosition() == NLPacket::PacketPosition::LAST;
+    const char* payload = packet->getPayload();
+    qint64 payloadSize = packet->getPayloadSize();
+
+    if (_isFlat) {
+        // someone already needed this message in one piece, keep it that way
+        std::lock_guard<std::mutex> lock(_flattenMutex);
+        _data.append(payload, payloadSize);
+        bytesCopied += payloadSize;
+    } else {
+        _segments.push_back({ std::move(packet), payload, payloadSize, _size });
+    }
+    _size += payloadSize;
+    bytesReceived += payloadSize;
 
     if (_numPackets % EMIT_PROGRESS_EVERY_X_PACKETS == 0) {
         emit progress(getSize());
     }
 
-    if (packet.getPacketPosition() == NLPacket::PacketPosition::LAST) {
+    if (isLast) {
         _isComplete = true;
         emit completed();
     }
 }
 
+const char* ReceivedMessage::contiguousData(qint64 position, qint64 size) const {
+    if (_isFlat) {
+        return _data.constData() + position;
+    }
+
+    // find the last packet that starts at or before position
+    auto segment = std::upper_bound(_segments.begin(), _segments.end(), position,
+                                    [](qint64 position, const Segment& segment) { return position < segment.offset; });
+    if (segment == _segments.begin()) {
+        return nullptr;
+    }
+    --segment;
+
+    qint64 offset = position - segment->offset;
+    if (offset + size <= segment->size) {
+        return segment->data + offset;
+    }
+    return nullptr;
+}
+
+void ReceivedMessage::copyData(qint64 position, char* data, qint64 size) const {
+    const char* source = contiguousData(position, size);
+    if (source) {
+        memcpy(data, source, size);
+        return;
+    }
+
+    // spans packets, copy a piece from each
+    for (auto& segment : _segments) {
+        if (size <= 0) {
+            break;
+        }
+        qint64 segmentEnd = segment.offset + segment.size;
+        if (position >= segmentEnd) {
+            continue;
+        }
+        qint64 offset = position - segment.offset;
+        qint64 chunkSize = std::min(size, segment.size - offset);
+        memcpy(data, segment.data + offset, chunkSize);
+        data += chunkSize;
+        position += chunkSize;
+        size -= chunkSize;
+    }
+}
+
+void ReceivedMessage::flatten() const {
+    std::lock_guard<std::mutex> lock(_flattenMutex);
+    if (_isFlat) {
+        return;
+    }
+
+    QByteArray data;
+    data.reserve(_size);
+    for (auto& segment : _segments) {
+        data.append(segment.data, segment.size);
+    }
+    bytesCopied += data.size();
+
+    _data = data;
+    _isFlat = true;
+}
+
+QByteArray ReceivedMessage::getMessage() const {
+    if (!_isFlat) {
+        flatten();
+    }
+    return _data;
+}
+
+const char* ReceivedMessage::getRawMessage() const {
+    if (_isFlat) {
+        return _data.constData();
+    }
+    if (_segments.size() == 1) {
+        return _segments.front().data;
+    }
+    flatten();
+    return _data.constData();
+}
+
 qint64 ReceivedMessage::peek(char* data, qint64 size) {
-    memcpy(data, _data.constData() + _position, size);
+    copyData(_position, data, size);
     return size;
 }
 
 qint64 ReceivedMessage::read(char* data, qint64 size) {
-    memcpy(data, _data.constData() + _position, size);
+    copyData(_position, data, size);
     _position += size;
     return size;
 }
 
 qint64 ReceivedMessage::readHead(char* data, qint64 size) {
-    memcpy(data, _headData.constData() + _position, size);
+    memcpy(data, _headData + _position, size);
     _position += size;
     return size;
 }
 
 QByteArray ReceivedMessage::peek(qint64 size) {
-    return _data.mid(_position, size);
+    size = std::max((qint64)0, std::min(size, getBytesLeftToRead()));
+    QByteArray data(size, Qt::Uninitialized);
+    copyData(_position, data.data(), size);
+    bytesCopied += size;
+    return data;
 }
 
 QByteArray ReceivedMessage::read(qint64 size) {
-    auto data = _data.mid(_position, size);
-    _position += size;
+    QByteArray data;
+    if (_isFlat && _position == 0 && size >= _size) {
+        // the whole thing, share it
+        data = _data;
+    } else {
+        data = peek(size);
+    }
+    _position += data.size();
     return data;
 }
 
 QByteArray ReceivedMessage::readHead(qint64 size) {
-    auto data = _headData.mid(_position, size);
+    auto data = QByteArray(_headData + _position, std::max((qint64)0, std::min(size, _headSize - _position)));
     _position += size;
     return data;
 }
@@ -124,15 +264,41 @@ QString ReceivedMessage::readString() {
     uint32_t size;
     readPrimitive(&size);
     //Q_ASSERT(size <= _size - _position);
-    auto string = QString::fromUtf8(_data.constData() + _position, size);
+    QString string;
+    const char* data = contiguousData(_position, size);
+    if (data) {
+        string = QString::fromUtf8(data, size);
+    } else {
+        string = QString::fromUtf8(peek(size));
+    }
     _position += size;
     return string;
 }
 
+QUuid ReceivedMessage::readUuid() {
+    // same as QUuid::fromRfc4122, without a QByteArray
+    unsigned char bytes[NUM_BYTES_RFC4122_UUID];
+    read(reinterpret_cast<char*>(bytes), NUM_BYTES_RFC4122_UUID);
+
+    uint l = qFromBigEndian<quint32>(bytes);
+    ushort w1 = qFromBigEndian<quint16>(bytes + 4);
+    ushort w2 = qFromBigEndian<quint16>(bytes + 6);
+    return QUuid(l, w1, w2, bytes[8], bytes[9], bytes[10], bytes[11], bytes[12], bytes[13], bytes[14], bytes[15]);
+}
+
 QByteArray ReceivedMessage::readWithoutCopy(qint64 size) {
-    QByteArray data { QByteArray::fromRawData(_data.constData() + _position, size) };
+    const char* data = contiguousData(_position, size);
+    if (!data) {
+        flatten();
+        data = _data.constData() + _position;
+    }
     _position += size;
-    return data;
+    return QByteArray::fromRawData(data, size);
+}
+
+void ReceivedMessage::getAndResetCopyStats(quint64& copied, quint64& received) {
+    copied = bytesCopied.exchange(0);
+    received = bytesReceived.exchange(0);
 }
 
 void ReceivedMessage::onComplete() {
@@ -16,26 +16,33 @@
 #include <QObject>
 
 #include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include "NLPacketList.h"
 
+// A message is kept as the chain of packets it arrived in, and read from them in place.
+// It is only copied into one contiguous buffer if something asks for all of it at once
+// (getMessage or getRawMessage) and it spans more than one packet.
 class ReceivedMessage : public QObject {
     Q_OBJECT
 public:
     ReceivedMessage(const NLPacketList& packetList);
     ReceivedMessage(NLPacket& packet);
+    ReceivedMessage(std::unique_ptr<NLPacket> packet);
     ReceivedMessage(QByteArray byteArray, PacketType packetType, PacketVersion packetVersion,
                     const HifiSockAddr& senderSockAddr, QUuid sourceID = QUuid());
 
-    QByteArray getMessage() const { return _data; }
-    const char* getRawMessage() const { return _data.constData(); }
+    QByteArray getMessage() const;
+    const char* getRawMessage() const;
 
     PacketType getType() const { return _packetType; }
     PacketVersion getVersion() const { return _packetVersion; }
 
     void setFailed();
 
-    void appendPacket(NLPacket& packet);
+    void appendPacket(std::unique_ptr<NLPacket> packet);
 
     bool failed() const { return _failed; }
     bool isComplete() const { return _isComplete; }
@@ -48,9 +55,9 @@ public:
     // Get the number of packets that were used to send this message
     qint64 getNumPackets() const { return _numPackets; }
 
-    qint64 getSize() const { return _data.size(); }
+    qint64 getSize() const { return _size; }
 
-    qint64 getBytesLeftToRead() const { return _data.size() -  _position; }
+    qint64 getBytesLeftToRead() const { return _size -  _position; }
 
     void seek(qint64 position) { _position = position; }
 
@@ -66,6 +73,7 @@ public:
     QByteArray readAll();
 
     QString readString();
+    QUuid readUuid();
 
     QByteArray readHead(qint64 size);
 
@@ -74,6 +82,10 @@ public:
     // exceed that of the ReceivedMessage.
     QByteArray readWithoutCopy(qint64 size);
 
+    // Bytes copied out of packets into new buffers by all messages (assembling messages, and reads that return
+    // a QByteArray) and bytes received in all messages, since the last call.
+    static void getAndResetCopyStats(quint64& bytesCopied, quint64& bytesReceived);
+
     template<typename T> qint64 peekPrimitive(T* data);
     template<typename T> qint64 readPrimitive(T* data);
 
@@ -87,8 +99,29 @@ private slots:
     void onComplete();
 
 private:
-    QByteArray _data;
-    QByteArray _headData;
+    struct Segment {
+        std::unique_ptr<NLPacket> packet;
+        const char* data;
+        qint64 size;
+        qint64 offset;
+    };
+
+    // returns a pointer to size contiguous bytes at position, or nullptr if they span packets
+    const char* contiguousData(qint64 position, qint64 size) const;
+    void copyData(qint64 position, char* data, qint64 size) const;
+    void flatten() const;
+
+    std::vector<Segment> _segments;
+    std::atomic<qint64> _size { 0 };
+
+    // for messages that began as one buffer, and for messages that were asked for all at once
+    mutable QByteArray _data;
+    mutable std::atomic<bool> _isFlat { false };
+    mutable std::mutex _flattenMutex;
+
+    // the first packet, which can be read with readHead while more packets are being appended on another thread
+    const char* _headData { nullptr };
+    qint64 _headSize { 0 };
 
     std::atomic<qint64> _position { 0 };
     std::atomic<qint64> _numPackets { 0 };
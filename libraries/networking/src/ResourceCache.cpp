@@ -11,7 +11,9 @@
 
 #include "ResourceCache.h"
 
+#include <algorithm>
 #include <cfloat>
+#include <climits>
 #include <cmath>
 #include <assert.h>
 
@@ -32,6 +34,18 @@
                            (((x) > (max)) ? (max) :\
                                             (x)))
 
+// load priorities are small floats (angular sizes, mip offsets), QThreadPool orders work by int
+static const float DECODE_PRIORITY_SCALE = 1000.0f;
+static const float MAX_DECODE_PRIORITY = (float)(INT_MAX / 2) / DECODE_PRIORITY_SCALE;
+
+// a resource whose owners have all been destroyed is still loaded, but only after everything that is still wanted
+static const float STALE_LOAD_PRIORITY = -FLT_MAX;
+
+ResourceCacheSharedItems::ResourceCacheSharedItems() {
+    const int MIN_DECODE_LIMIT = 2;
+    _decodeThreadPool.setMaxThreadCount(std::max(MIN_DECODE_LIMIT, QThread::idealThreadCount() / 2));
+}
+
 void ResourceCacheSharedItems::appendActiveRequest(QWeakPointer<Resource> resource) {
     Lock lock(_mutex);
     _loadingRequests.append(resource);
@@ -96,7 +110,8 @@ void ResourceCacheSharedItems::removeRequest(QWeakPointer<Resource> resource) {
 }
 
 QSharedPointer<Resource> ResourceCacheSharedItems::getHighestPendingRequest() {
-    // look for the highest priority pending request
+    // look for the highest priority pending request, local files always go first. Priorities are read again on
+    // every pick, so owners that keep their priority up to date (e.g. by distance) reorder the queue as they move
     int highestIndex = -1;
     float highestPriority = -FLT_MAX;
     QSharedPointer<Resource> highestResource;
@@ -115,7 +130,7 @@ QSharedPointer<Resource> ResourceCacheSharedItems::getHighestPendingRequest() {
         // Check load priority
         float priority = resource->getLoadPriority();
         bool isFile = resource->getURL().scheme() == URL_SCHEME_FILE;
-        if (priority >= highestPriority && (isFile || !currentHighestIsFile)) {
+        if ((isFile && !currentHighestIsFile) || (isFile == currentHighestIsFile && priority >= highestPriority)) {
             highestPriority = priority;
             highestIndex = i;
             highestResource = resource;
@@ -495,6 +510,31 @@ bool ResourceCache::attemptRequest(QSharedPointer<Resource> resource) {
     return true;
 }
 
+void ResourceCache::setDecodeLimit(int limit) {
+    getDecodeThreadPool()->setMaxThreadCount(std::max(1, limit));
+}
+
+int ResourceCache::getDecodeLimit() {
+    return getDecodeThreadPool()->maxThreadCount();
+}
+
+QThreadPool* ResourceCache::getDecodeThreadPool() {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    if (!sharedItems) {
+        return QThreadPool::globalInstance();
+    }
+    return sharedItems->getDecodeThreadPool();
+}
+
+void ResourceCache::startDecode(QRunnable* runnable, float loadPriority) {
+    float priority = clamp(loadPriority, -MAX_DECODE_PRIORITY, MAX_DECODE_PRIORITY);
+    getDecodeThreadPool()->start(runnable, (int)(priority * DECODE_PRIORITY_SCALE));
+}
+
+void ResourceCache::clearPendingDecodes() {
+    getDecodeThreadPool()->clear();
+}
+
 void ResourceCache::requestCompleted(QWeakPointer<Resource> resource) {
     auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
 
@@ -541,6 +581,7 @@ void Resource::ensureLoading() {
 void Resource::setLoadPriority(const QPointer<QObject>& owner, float priority) {
     if (!(_failedToLoad)) {
         _loadPriorities.insert(owner, priority);
+        _loadPriorityIsStale = false;
     }
 }
 
@@ -551,6 +592,7 @@ void Resource::setLoadPriorities(const QHash<QPointer<QObject>, float>& prioriti
     for (QHash<QPointer<QObject>, float>::const_iterator it = priorities.constBegin();
             it != priorities.constEnd(); it++) {
         _loadPriorities.insert(it.key(), it.value());
+        _loadPriorityIsStale = false;
     }
 }
 
@@ -562,7 +604,7 @@ void Resource::clearLoadPriority(const QPointer<QObject>& owner) {
 
 float Resource::getLoadPriority() {
     if (_loadPriorities.size() == 0) {
-        return 0;
+        return _loadPriorityIsStale ? STALE_LOAD_PRIORITY : 0.0f;
     }
 
     float highestPriority = -FLT_MAX;
@@ -574,6 +616,11 @@ float Resource::getLoadPriority() {
         highestPriority = qMax(highestPriority, it.value());
         it++;
     }
+    if (_loadPriorities.size() == 0) {
+        // everything that asked for this resource has gone away while it was waiting
+        _loadPriorityIsStale = true;
+        return STALE_LOAD_PRIORITY;
+    }
     return highestPriority;
 }
 
@@ -650,6 +697,7 @@ void Resource::finishedLoading(bool success) {
     if (success) {
         qCDebug(networking).noquote() << "Finished loading:" << _url.toDisplayString();
         _loadPriorities.clear();
+        _loadPriorityIsStale = false;
         _loaded = true;
     } else {
         qCDebug(networking).noquote() << "Failed to load:" << _url.toDisplayString();
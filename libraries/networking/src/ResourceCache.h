@@ -24,6 +24,7 @@
 #include <QtCore/QWeakPointer>
 #include <QtCore/QReadWriteLock>
 #include <QtCore/QQueue>
+#include <QtCore/QThreadPool>
 
 #include <QtNetwork/QNetworkReply>
 #include <QtNetwork/QNetworkRequest>
@@ -75,12 +76,18 @@ public:
     QSharedPointer<Resource> getHighestPendingRequest();
     uint32_t getLoadingRequestsCount() const;
 
+    QThreadPool* getDecodeThreadPool() { return &_decodeThreadPool; }
+
 private:
-    ResourceCacheSharedItems() = default;
+    ResourceCacheSharedItems();
 
     mutable Mutex _mutex;
     QList<QWeakPointer<Resource>> _pendingRequests;
     QList<QWeakPointer<Resource>> _loadingRequests;
+
+    // processing of downloaded data is bounded separately from the number of active downloads, so that a burst of
+    // finished requests can't starve the rest of the application of worker threads
+    QThreadPool _decodeThreadPool;
 };
 
 /// Wrapper to expose resources to JS/QML
@@ -234,6 +241,18 @@ public:
     static int getRequestLimit() { return _requestLimit; }
 
     static int getRequestsActive() { return _requestsActive; }
+
+    /// Sets the number of downloaded resources that may be processed (parsed, decoded) at the same time.
+    static void setDecodeLimit(int limit);
+    static int getDecodeLimit();
+
+    /// Queues the processing of a downloaded resource. Queued work with a higher load priority starts first.
+    /// The pool takes ownership of runnables that have autoDelete() set.
+    static void startDecode(QRunnable* runnable, float loadPriority);
+    static QThreadPool* getDecodeThreadPool();
+
+    /// Drops all processing that has not started yet, used at shutdown.
+    static void clearPendingDecodes();
     
     void setUnusedResourceCacheSize(qint64 unusedResourcesMaxSize);
     qint64 getUnusedResourceCacheSize() const { return _unusedResourcesMaxSize; }
@@ -363,7 +382,8 @@ public:
     /// Clears the load priority for one owner.
     virtual void clearLoadPriority(const QPointer<QObject>& owner);
     
-    /// Returns the highest load priority across all owners.
+    /// Returns the highest load priority across all owners. Once every owner has been destroyed the resource is
+    /// considered stale and gets the lowest possible priority, until someone sets a priority again.
     float getLoadPriority();
 
     /// Checks whether the resource has loaded.
@@ -463,6 +483,7 @@ protected:
     bool _loaded = false;
 
     QHash<QPointer<QObject>, float> _loadPriorities;
+    bool _loadPriorityIsStale { false };
     QWeakPointer<Resource> _self;
     QPointer<ResourceCache> _cache;
 
@@ -20,6 +20,8 @@
 #include "ThreadedAssignment.h"
 
 #include "NetworkLogging.h"
+#include "ReceivedMessage.h"
+#include "udt/BBRCC.h"
 
 ThreadedAssignment::ThreadedAssignment(ReceivedMessage& message) :
     Assignment(message),
@@ -103,11 +105,42 @@ void ThreadedAssignment::addPacketStatsAndSendStatsPacket(QJsonObject statsObjec
     ioStats["outbound_bytes_per_s"] = bytesOutPerSecond;
     ioStats["outbound_packets_per_s"] = packetsOutPerSecond;
 
+    // how much of what we received was copied out of its packets again, since the last stats
+    quint64 messageBytesCopied, messageBytesReceived;
+    ReceivedMessage::getAndResetCopyStats(messageBytesCopied, messageBytesReceived);
+    ioStats["inbound_message_bytes"] = (double)messageBytesReceived;
+    ioStats["inbound_message_bytes_copied"] = (double)messageBytesCopied;
+
+    // how long received messages waited to be handled, by packet type
+    ioStats["dispatch_latency"] = nodeList->getPacketReceiver().getAndResetDispatchStats();
+
     statsObject["io_stats"] = ioStats;
 
     nodeList->sendStatsToDomainServer(statsObject);
 }
 
+void ThreadedAssignment::setCongestionControlFromSettings(const QJsonObject& settingsSectionObject) {
+    static const QString CONGESTION_CONTROL_OPTION = "congestion_control";
+    static const QString BBR_CONGESTION_CONTROL = "bbr";
+    static const QString UDT_CONGESTION_CONTROL = "udt";
+
+    QString congestionControl = settingsSectionObject[CONGESTION_CONTROL_OPTION].toString();
+    auto nodeList = DependencyManager::get<NodeList>();
+
+    if (congestionControl == BBR_CONGESTION_CONTROL) {
+        nodeList->setCongestionControlFactory(std::unique_ptr<udt::CongestionControlVirtualFactory>(
+            new udt::CongestionControlFactory<udt::BBRCC>()));
+    } else if (congestionControl == UDT_CONGESTION_CONTROL) {
+        nodeList->setCongestionControlFactory(std::unique_ptr<udt::CongestionControlVirtualFactory>(
+            new udt::CongestionControlFactory<udt::DefaultCC>()));
+    } else {
+        // TCP Vegas is what the socket uses unless told otherwise
+        return;
+    }
+
+    qCInfo(networking) << "Using" << congestionControl << "congestion control for connections";
+}
+
 void ThreadedAssignment::sendStatsPacket() {
     QJsonObject statsObject;
     addPacketStatsAndSendStatsPacket(statsObject);
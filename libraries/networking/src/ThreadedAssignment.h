@@ -12,6 +12,7 @@
 #ifndef hifi_ThreadedAssignment_h
 #define hifi_ThreadedAssignment_h
 
+#include <QtCore/QJsonObject>
 #include <QtCore/QSharedPointer>
 
 #include "ReceivedMessage.h"
@@ -43,6 +44,10 @@ signals:
 protected:
     void commonInit(const QString& targetName, NodeType_t nodeType);
 
+    // picks the congestion control for this assignment's connections from the congestion_control option
+    // in its settings section - "bbr", "udt" or "vegas", the default
+    void setCongestionControlFromSettings(const QJsonObject& settingsSectionObject);
+
     bool _isFinished;
     QTimer _domainServerTimer;
     QTimer _statsTimer;
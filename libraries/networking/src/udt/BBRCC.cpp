@@ -0,0 +1,328 @@
+//
+//  BBRCC.cpp
+//  libraries/networking/src/udt
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BBRCC.h"
+
+#include <algorithm>
+
+#include <QtCore/QtGlobal>
+
+#include <NumericalConstants.h>
+
+using namespace udt;
+using namespace std::chrono;
+
+// 2 / ln(2), the smallest gain that lets startup double its delivery rate every round
+static const double HIGH_GAIN = 2.885;
+static const double PROBE_BANDWIDTH_CONGESTION_WINDOW_GAIN = 2.0;
+static const int GAIN_CYCLE_LENGTH = 8;
+static const double PACING_GAIN_CYCLE[GAIN_CYCLE_LENGTH] = { 1.25, 0.75, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 };
+
+// startup is done once the bandwidth hasn't grown by a quarter for three rounds
+static const double FULL_BANDWIDTH_GROWTH = 1.25;
+static const int FULL_BANDWIDTH_ROUNDS = 3;
+
+static const int MIN_RTT_WINDOW_USECS = 10 * USECS_PER_SECOND;
+static const int PROBE_RTT_DURATION_USECS = 200 * USECS_PER_MSEC;
+
+static const int MIN_CONGESTION_WINDOW_PACKETS = 4;
+static const int INITIAL_CONGESTION_WINDOW_PACKETS = 10;
+static const int INITIAL_SENT_PACKETS_SIZE = 1024;
+
+BBRCC::BBRCC() :
+    _pacingGain(HIGH_GAIN),
+    _congestionWindowGain(HIGH_GAIN)
+{
+    _mss = udt::MAX_PACKET_SIZE_WITH_UDP_HEADER;
+    _congestionWindowSize = INITIAL_CONGESTION_WINDOW_PACKETS;
+
+    // we take a delivery rate sample from every ACK
+    setAckInterval(1);
+
+    _sentPackets.resize(INITIAL_SENT_PACKETS_SIZE);
+    _sentPacketsMask = INITIAL_SENT_PACKETS_SIZE - 1;
+
+    _roundMaxDeliveryRates.fill(0.0);
+
+    auto now = p_high_resolution_clock::now();
+    _deliveredTime = now;
+    _lastDeliveredSentTime = now;
+    _minRTTStamp = now;
+    _cycleStamp = now;
+
+    updateSendParameters();
+}
+
+void BBRCC::setInitialSendSequenceNumber(SequenceNumber seqNum) {
+    _lastACK = seqNum - 1;
+    _lastSentSequenceNumber = seqNum - 1;
+}
+
+int BBRCC::packetsInFlight() const {
+    return std::max(seqoff(_lastACK, _lastSentSequenceNumber), 0);
+}
+
+void BBRCC::growSentPackets(int numInFlight) {
+    size_t size = _sentPackets.size();
+    while ((int)size <= numInFlight) {
+        size *= 2;
+    }
+
+    // re-insert the packets still in flight at their place in the larger ring
+    std::vector<SentPacket> sentPackets(size);
+    SequenceNumber::UType mask = (SequenceNumber::UType)size - 1;
+
+    for (auto seqNum = _lastACK + 1; seqNum <= _lastSentSequenceNumber; ++seqNum) {
+        auto& sentPacket = sentPacketSlot(seqNum);
+        if (sentPacket.sequenceNumber == seqNum) {
+            sentPackets[(SequenceNumber::UType)seqNum & mask] = sentPacket;
+        }
+    }
+
+    _sentPackets.swap(sentPackets);
+    _sentPacketsMask = mask;
+}
+
+void BBRCC::onPacketSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) {
+    bool isRetransmission = seqNum <= _lastSentSequenceNumber;
+
+    if (!isRetransmission) {
+        int numInFlight = seqoff(_lastACK, seqNum);
+        if (numInFlight >= (int)_sentPackets.size()) {
+            growSentPackets(numInFlight);
+        }
+        _lastSentSequenceNumber = seqNum;
+    } else if (seqNum <= _lastACK) {
+        // it was ACKed in the meantime
+        return;
+    }
+
+    if (packetsInFlight() <= 1) {
+        // nothing was in flight, don't count the idle time against the delivery rate
+        _deliveredTime = timePoint;
+        _lastDeliveredSentTime = timePoint;
+    }
+
+    auto& sentPacket = sentPacketSlot(seqNum);
+    sentPacket.sequenceNumber = seqNum;
+    sentPacket.wireSize = wireSize;
+    sentPacket.retransmitted = isRetransmission;
+    sentPacket.sentTime = timePoint;
+    sentPacket.deliveredTime = _deliveredTime;
+    sentPacket.lastDeliveredSentTime = _lastDeliveredSentTime;
+    sentPacket.delivered = _delivered;
+}
+
+bool BBRCC::onACK(SequenceNumber ack, p_high_resolution_clock::time_point receiveTime) {
+    if (ack <= _lastACK || ack > _lastSentSequenceNumber) {
+        // nothing newly delivered, losses are left to the NAKs
+        return false;
+    }
+
+    if (_priorCongestionWindowSize > 0) {
+        // we're hearing back after a timeout, go back to the window we had
+        _congestionWindowSize = std::max(_congestionWindowSize, _priorCongestionWindowSize);
+        _priorCongestionWindowSize = 0;
+    }
+
+    // everything up to this ACK was delivered
+    for (auto seqNum = _lastACK + 1; seqNum <= ack; ++seqNum) {
+        auto& sentPacket = sentPacketSlot(seqNum);
+        if (sentPacket.sequenceNumber == seqNum) {
+            _delivered += sentPacket.wireSize;
+        }
+    }
+    _lastACK = ack;
+
+    auto& ackedPacket = sentPacketSlot(ack);
+    if (ackedPacket.sequenceNumber != ack) {
+        updateSendParameters();
+        return false;
+    }
+
+    _deliveredTime = receiveTime;
+    _lastDeliveredSentTime = ackedPacket.sentTime;
+
+    // a round trip ends when a packet sent after the round started is delivered
+    bool isNewRound = false;
+    if (ackedPacket.delivered >= _nextRoundDelivered) {
+        _nextRoundDelivered = _delivered;
+        ++_roundCount;
+        isNewRound = true;
+    }
+
+    // we can't tell which send of a retransmitted packet this ACK is for, so don't sample its RTT or rate
+    if (!ackedPacket.retransmitted) {
+        int rtt = std::max((int)duration_cast<microseconds>(receiveTime - ackedPacket.sentTime).count(), 1);
+
+        bool minRTTExpired = duration_cast<microseconds>(receiveTime - _minRTTStamp).count() > MIN_RTT_WINDOW_USECS;
+        if (_minRTT < 0 || rtt < _minRTT || (minRTTExpired && _mode != Mode::ProbeRTT)) {
+            if (minRTTExpired && _minRTT >= 0 && rtt >= _minRTT) {
+                // the path hasn't shown its min RTT in a while, drain the queue to measure it again
+                _mode = Mode::ProbeRTT;
+                _pacingGain = 1.0;
+                _congestionWindowGain = 1.0;
+                _probeRTTDoneStamp = p_high_resolution_clock::time_point();
+                _probeRTTRoundDone = false;
+            }
+            _minRTT = rtt;
+            _minRTTStamp = receiveTime;
+        }
+
+        // the rate is measured over whichever was longer, sending or ACKing the data, so bursts don't inflate it
+        auto sendInterval = duration_cast<microseconds>(ackedPacket.sentTime - ackedPacket.lastDeliveredSentTime).count();
+        auto ackInterval = duration_cast<microseconds>(receiveTime - ackedPacket.deliveredTime).count();
+        auto interval = std::max(sendInterval, ackInterval);
+
+        if (interval >= _minRTT && interval > 0) {
+            double deliveryRate = (double)(_delivered - ackedPacket.delivered) / interval;
+            updateBandwidth(deliveryRate, isNewRound);
+        } else if (isNewRound) {
+            updateBandwidth(0.0, isNewRound);
+        }
+    }
+
+    updateMode(receiveTime, isNewRound);
+    updateSendParameters();
+
+    return false;
+}
+
+void BBRCC::onTimeout() {
+    // nothing is getting through, only keep what is needed to find out when it does again
+    if (_priorCongestionWindowSize == 0) {
+        _priorCongestionWindowSize = _congestionWindowSize;
+    }
+    _congestionWindowSize = MIN_CONGESTION_WINDOW_PACKETS;
+}
+
+void BBRCC::updateBandwidth(double deliveryRate, bool isNewRound) {
+    auto& roundMax = _roundMaxDeliveryRates[_roundCount % BANDWIDTH_FILTER_ROUNDS];
+
+    if (isNewRound) {
+        // this slot last held the rate from BANDWIDTH_FILTER_ROUNDS rounds ago
+        roundMax = 0.0;
+    }
+    roundMax = std::max(roundMax, deliveryRate);
+
+    _bottleneckBandwidth = *std::max_element(_roundMaxDeliveryRates.begin(), _roundMaxDeliveryRates.end());
+}
+
+void BBRCC::enterProbeBandwidth(p_high_resolution_clock::time_point now) {
+    _mode = Mode::ProbeBandwidth;
+    _congestionWindowGain = PROBE_BANDWIDTH_CONGESTION_WINDOW_GAIN;
+
+    // start anywhere in the cycle but the slow down phase, so connections sharing a link don't probe in step
+    _cycleIndex = 2 + (int)(_roundCount % (GAIN_CYCLE_LENGTH - 2));
+    _pacingGain = PACING_GAIN_CYCLE[_cycleIndex];
+    _cycleStamp = now;
+}
+
+void BBRCC::updateMode(p_high_resolution_clock::time_point now, bool isNewRound) {
+    switch (_mode) {
+        case Mode::Startup:
+            if (isNewRound && _bottleneckBandwidth > 0.0) {
+                if (_bottleneckBandwidth >= _fullBandwidth * FULL_BANDWIDTH_GROWTH) {
+                    _fullBandwidth = _bottleneckBandwidth;
+                    _fullBandwidthRounds = 0;
+                } else if (++_fullBandwidthRounds >= FULL_BANDWIDTH_ROUNDS) {
+                    // the pipe is full, drain the queue startup built up
+                    _mode = Mode::Drain;
+                    _pacingGain = 1.0 / HIGH_GAIN;
+                    _congestionWindowGain = HIGH_GAIN;
+                }
+            }
+            break;
+
+        case Mode::Drain:
+            if (packetsInFlight() <= bandwidthDelayProduct(1.0)) {
+                enterProbeBandwidth(now);
+            }
+            break;
+
+        case Mode::ProbeBandwidth: {
+            // each phase lasts a min RTT, probing up lasts until the extra packets are in flight
+            // and slowing down ends as soon as the queue it left behind is drained
+            bool phaseDone = duration_cast<microseconds>(now - _cycleStamp).count() > _minRTT;
+            if (_pacingGain > 1.0) {
+                phaseDone = phaseDone && packetsInFlight() >= bandwidthDelayProduct(_pacingGain);
+            } else if (_pacingGain < 1.0) {
+                phaseDone = phaseDone || packetsInFlight() <= bandwidthDelayProduct(1.0);
+            }
+
+            if (phaseDone) {
+                _cycleIndex = (_cycleIndex + 1) % GAIN_CYCLE_LENGTH;
+                _pacingGain = PACING_GAIN_CYCLE[_cycleIndex];
+                _cycleStamp = now;
+            }
+            break;
+        }
+
+        case Mode::ProbeRTT:
+            if (_probeRTTDoneStamp == p_high_resolution_clock::time_point()) {
+                if (packetsInFlight() <= MIN_CONGESTION_WINDOW_PACKETS) {
+                    _probeRTTDoneStamp = now + microseconds(PROBE_RTT_DURATION_USECS);
+                    _probeRTTRoundDone = false;
+                    _nextRoundDelivered = _delivered;
+                }
+            } else {
+                if (isNewRound) {
+                    _probeRTTRoundDone = true;
+                }
+                if (_probeRTTRoundDone && now >= _probeRTTDoneStamp) {
+                    _minRTTStamp = now;
+                    if (_fullBandwidth > 0.0 && _fullBandwidthRounds >= FULL_BANDWIDTH_ROUNDS) {
+                        enterProbeBandwidth(now);
+                    } else {
+                        _mode = Mode::Startup;
+                        _pacingGain = HIGH_GAIN;
+                        _congestionWindowGain = HIGH_GAIN;
+                    }
+                }
+            }
+            break;
+    }
+}
+
+int BBRCC::bandwidthDelayProduct(double gain) const {
+    if (_bottleneckBandwidth <= 0.0 || _minRTT < 0) {
+        return INITIAL_CONGESTION_WINDOW_PACKETS;
+    }
+    return (int)(gain * _bottleneckBandwidth * _minRTT / _mss);
+}
+
+void BBRCC::updateSendParameters() {
+    int rtt = _minRTT > 0 ? _minRTT : _rtt;
+
+    if (_bottleneckBandwidth > 0.0) {
+        setPacketSendPeriod(_mss / (_pacingGain * _bottleneckBandwidth));
+    } else if (rtt > 0) {
+        // no bandwidth sample yet, pace the initial window out over an RTT
+        setPacketSendPeriod(rtt / (_pacingGain * _congestionWindowSize));
+    } else {
+        setPacketSendPeriod(0.0);
+    }
+
+    if (_mode == Mode::ProbeRTT) {
+        _congestionWindowSize = MIN_CONGESTION_WINDOW_PACKETS;
+    } else if (_priorCongestionWindowSize == 0 && _bottleneckBandwidth > 0.0) {
+        // a few packets over the BDP keeps the pipe full while ACKs are delayed or aggregated
+        static const int ACK_AGGREGATION_PACKETS = 3;
+        int congestionWindow = bandwidthDelayProduct(_congestionWindowGain) + ACK_AGGREGATION_PACKETS;
+
+        if (_mode == Mode::Startup) {
+            // startup only ever grows the window
+            congestionWindow = std::max(congestionWindow, _congestionWindowSize);
+        }
+
+        _congestionWindowSize = std::min(std::max(congestionWindow, MIN_CONGESTION_WINDOW_PACKETS),
+                                         udt::MAX_PACKETS_IN_FLIGHT);
+    }
+}
@@ -0,0 +1,107 @@
+//
+//  BBRCC.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_BBRCC_h
+#define hifi_BBRCC_h
+
+#include <array>
+#include <vector>
+
+#include "CongestionControl.h"
+#include "Constants.h"
+
+namespace udt {
+
+// Model based congestion control, after BBR (https://queue.acm.org/detail.cfm?id=3022184).
+// Rather than reacting to loss or delay, it estimates the bottleneck bandwidth and the minimum RTT of the path
+// from what was delivered, paces packets out at that bandwidth and keeps about one bandwidth-delay product in flight.
+class BBRCC : public CongestionControl {
+public:
+    BBRCC();
+
+    virtual bool onACK(SequenceNumber ackNum, p_high_resolution_clock::time_point receiveTime) override;
+    virtual void onLoss(SequenceNumber rangeStart, SequenceNumber rangeEnd) override {}
+    virtual void onTimeout() override;
+
+    virtual bool shouldACK2() override { return false; }
+    virtual bool shouldProbe() override { return false; }
+
+    virtual void onPacketSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) override;
+
+protected:
+    virtual void setInitialSendSequenceNumber(SequenceNumber seqNum) override;
+
+private:
+    enum class Mode { Startup, Drain, ProbeBandwidth, ProbeRTT };
+
+    // what we knew about delivery when a packet was sent, to take a delivery rate sample when it is ACKed
+    struct SentPacket {
+        SequenceNumber sequenceNumber;
+        int wireSize;
+        bool retransmitted;
+        p_high_resolution_clock::time_point sentTime;
+        p_high_resolution_clock::time_point deliveredTime;
+        p_high_resolution_clock::time_point lastDeliveredSentTime;
+        int64_t delivered;
+    };
+
+    SentPacket& sentPacketSlot(SequenceNumber seqNum) { return _sentPackets[(SequenceNumber::UType)seqNum & _sentPacketsMask]; }
+    void growSentPackets(int numInFlight);
+    int packetsInFlight() const;
+
+    void updateBandwidth(double deliveryRate, bool isNewRound);
+    void updateMode(p_high_resolution_clock::time_point now, bool isNewRound);
+    void enterProbeBandwidth(p_high_resolution_clock::time_point now);
+    void updateSendParameters();
+    int bandwidthDelayProduct(double gain) const; // in packets
+
+    // packets in flight are kept in a ring indexed by sequence number, which grows with the congestion window
+    std::vector<SentPacket> _sentPackets;
+    SequenceNumber::UType _sentPacketsMask { 0 };
+
+    SequenceNumber _lastACK; // Sequence number of last packet that was ACKed
+    SequenceNumber _lastSentSequenceNumber; // Highest sequence number sent so far
+
+    int64_t _delivered { 0 }; // Bytes delivered over the connection
+    p_high_resolution_clock::time_point _deliveredTime; // When _delivered was last updated
+    p_high_resolution_clock::time_point _lastDeliveredSentTime; // When the last delivered packet was sent
+
+    // the bottleneck bandwidth is the max delivery rate over the last few rounds, in bytes per microsecond
+    static const int BANDWIDTH_FILTER_ROUNDS = 10;
+    std::array<double, BANDWIDTH_FILTER_ROUNDS> _roundMaxDeliveryRates;
+    double _bottleneckBandwidth { 0.0 };
+
+    int _minRTT { -1 }; // Lowest RTT in the min RTT window, in microseconds
+    p_high_resolution_clock::time_point _minRTTStamp; // When _minRTT was measured
+
+    int64_t _roundCount { 0 }; // Number of round trips so far
+    int64_t _nextRoundDelivered { 0 }; // _delivered at which the current round trip ends
+
+    Mode _mode { Mode::Startup };
+    double _pacingGain;
+    double _congestionWindowGain;
+
+    double _fullBandwidth { 0.0 }; // Bandwidth when startup last saw it grow
+    int _fullBandwidthRounds { 0 }; // Rounds since startup last saw the bandwidth grow
+
+    int _cycleIndex { 0 }; // Phase of the probe bandwidth gain cycle
+    p_high_resolution_clock::time_point _cycleStamp; // When the current phase started
+
+    p_high_resolution_clock::time_point _probeRTTDoneStamp; // When probe RTT can end, unset until it started draining
+    bool _probeRTTRoundDone { false };
+
+    int _priorCongestionWindowSize { 0 }; // Window to go back to after a timeout
+};
+
+}
+
+#endif // hifi_BBRCC_h
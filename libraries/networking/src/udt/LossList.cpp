@@ -11,13 +11,15 @@
 
 #include "LossList.h"
 
+#include <algorithm>
+
 #include "ControlPacket.h"
 
 using namespace udt;
 using namespace std;
 
 void LossList::append(SequenceNumber seq) {
-    Q_ASSERT_X(_lossList.empty() || (_lossList.back().second < seq), "LossList::append(SequenceNumber)",
+    Q_ASSERT_X(isEmpty() || (_lossList.back().second < seq), "LossList::append(SequenceNumber)",
                "SequenceNumber appended is not greater than the last SequenceNumber in the list");
     
     if (getLength() > 0 && _lossList.back().second + 1 == seq) {
@@ -29,7 +31,7 @@ void LossList::append(SequenceNumber seq) {
 }
 
 void LossList::append(SequenceNumber start, SequenceNumber end) {
-    Q_ASSERT_X(_lossList.empty() || (_lossList.back().second < start),
+    Q_ASSERT_X(isEmpty() || (_lossList.back().second < start),
                "LossList::append(SequenceNumber, SequenceNumber)",
                "SequenceNumber range appended is not greater than the last SequenceNumber in the list");
     Q_ASSERT_X(start <= end,
@@ -43,18 +45,47 @@ void LossList::append(SequenceNumber start, SequenceNumber end) {
     _length += seqlen(start, end);
 }
 
+LossList::Ranges::iterator LossList::findRange(SequenceNumber seq) {
+    return lower_bound(first(), _lossList.end(), seq, [](const Range& range, SequenceNumber value) {
+        return range.second < value;
+    });
+}
+
+LossList::Ranges::iterator LossList::eraseRanges(Ranges::iterator begin, Ranges::iterator end) {
+    if (begin != first()) {
+        return _lossList.erase(begin, end);
+    }
+
+    // taking ranges off the front, skip over them rather than moving everything after them
+    _firstIndex += end - begin;
+
+    if (_firstIndex == _lossList.size()) {
+        _lossList.clear();
+        _firstIndex = 0;
+    } else if (_firstIndex >= _lossList.size() / 2) {
+        _lossList.erase(_lossList.begin(), first());
+        _firstIndex = 0;
+    }
+
+    return first();
+}
+
 void LossList::insert(SequenceNumber start, SequenceNumber end) {
     Q_ASSERT_X(start <= end,
                "LossList::insert(SequenceNumber, SequenceNumber)", "Range start greater than range end");
     
-    auto it = find_if_not(_lossList.begin(), _lossList.end(), [&start](pair<SequenceNumber, SequenceNumber> pair){
-        return pair.second < start;
-    });
+    auto it = findRange(start);
     
     if (it == _lossList.end() || end < it->first) {
         // No overlap, simply insert
         _length += seqlen(start, end);
-        _lossList.insert(it, make_pair(start, end));
+
+        if (it == first() && _firstIndex > 0) {
+            // there is room in front of the first range
+            _lossList[--_firstIndex] = make_pair(start, end);
+        } else {
+            _lossList.insert(it, make_pair(start, end));
+        }
     } else {
         // If it starts before segment, extend segment
         if (start < it->first) {
@@ -68,8 +99,7 @@ void LossList::insert(SequenceNumber start, SequenceNumber end) {
             it->second = end;
         }
         
-        auto it2 = it;
-        ++it2;
+        auto it2 = it + 1;
         // For all ranges touching the current range
         while (it2 != _lossList.end() && it->second >= it2->first - 1) {
             // extend current range if necessary
@@ -80,19 +110,18 @@ void LossList::insert(SequenceNumber start, SequenceNumber end) {
             
             // Remove overlapping range
             _length -= seqlen(it2->first, it2->second);
-            it2 = _lossList.erase(it2);
+            ++it2;
         }
+        _lossList.erase(it + 1, it2);
     }
 }
 
 bool LossList::remove(SequenceNumber seq) {
-    auto it = find_if(_lossList.begin(), _lossList.end(), [&seq](pair<SequenceNumber, SequenceNumber> pair) {
-        return pair.first <= seq && seq <= pair.second;
-    });
+    auto it = findRange(seq);
     
-    if (it != end(_lossList)) {
+    if (it != _lossList.end() && it->first <= seq) {
         if (it->first == it->second) {
-            _lossList.erase(it);
+            eraseRanges(it, it + 1);
         } else if (seq == it->first) {
             ++it->first;
         } else if (seq == it->second) {
@@ -100,7 +129,7 @@ bool LossList::remove(SequenceNumber seq) {
         } else {
             auto temp = it->second;
             it->second = seq - 1;
-            _lossList.insert(++it, make_pair(seq + 1, temp));
+            _lossList.insert(it + 1, make_pair(seq + 1, temp));
         }
         _length -= 1;
         
@@ -116,63 +145,69 @@ void LossList::remove(SequenceNumber start, SequenceNumber end) {
     Q_ASSERT_X(start <= end,
                "LossList::remove(SequenceNumber, SequenceNumber)", "Range start greater than range end");
     // Find the first segment sharing sequence numbers
-    auto it = find_if(_lossList.begin(), _lossList.end(), [&start, &end](pair<SequenceNumber, SequenceNumber> pair) {
-        return (pair.first <= start && start <= pair.second) || (start <= pair.first && pair.first <= end);
-    });
+    auto it = findRange(start);
     
-    // If we found one
-    if (it != _lossList.end()) {
-        
-        // While the end of the current segment is contained, either shorten it (first one only - sometimes)
-        // or remove it altogether since it is fully contained it the range
-        while (it != _lossList.end() && end >= it->second) {
-            if (start <= it->first) {
-                // Segment is contained, update new length and erase it.
-                _length -= seqlen(it->first, it->second);
-                it = _lossList.erase(it);
-            } else {
-                // Beginning of segment not contained, modify end of segment.
-                // Will only occur sometimes one the first loop
-                _length -= seqlen(start, it->second);
-                it->second = start - 1;
-                ++it;
-            }
-        }
-        
-        // There might be more to remove
-        if (it != _lossList.end() && it->first <= end) {
-            if (start <= it->first) {
-                // Truncate beginning of segment
-                _length -= seqlen(it->first, end);
-                it->first = end + 1;
-            } else {
-                // Cut it in half if the range we are removing is contained within one segment
-                _length -= seqlen(start, end);
-                auto temp = it->second;
-                it->second = start - 1;
-                _lossList.insert(++it, make_pair(end + 1, temp));
-            }
+    if (it == _lossList.end() || end < it->first) {
+        return;
+    }
+
+    if (it->first < start) {
+        if (end < it->second) {
+            // Cut it in half if the range we are removing is contained within one segment
+            _length -= seqlen(start, end);
+            auto temp = it->second;
+            it->second = start - 1;
+            _lossList.insert(it + 1, make_pair(end + 1, temp));
+            return;
         }
+
+        // Beginning of segment not contained, modify end of segment.
+        _length -= seqlen(start, it->second);
+        it->second = start - 1;
+        ++it;
     }
+
+    // Remove the segments that are fully contained in the range
+    auto last = it;
+    while (last != _lossList.end() && last->second <= end) {
+        _length -= seqlen(last->first, last->second);
+        ++last;
+    }
+
+    // Truncate the beginning of the segment the range ends in
+    if (last != _lossList.end() && last->first <= end) {
+        _length -= seqlen(last->first, end);
+        last->first = end + 1;
+    }
+
+    eraseRanges(it, last);
 }
 
 SequenceNumber LossList::getFirstSequenceNumber() const {
     Q_ASSERT_X(getLength() > 0, "LossList::getFirstSequenceNumber()", "Trying to get first element of an empty list");
-    return _lossList.front().first;
+    return first()->first;
 }
 
 SequenceNumber LossList::popFirstSequenceNumber() {
     auto front = getFirstSequenceNumber();
-    remove(front);
+
+    auto it = first();
+    if (it->first == it->second) {
+        eraseRanges(it, it + 1);
+    } else {
+        ++it->first;
+    }
+    _length -= 1;
+
     return front;
 }
 
 void LossList::write(ControlPacket& packet, int maxPairs) {
     int writtenPairs = 0;
     
-    for (const auto& pair : _lossList) {
-        packet.writePrimitive(pair.first);
-        packet.writePrimitive(pair.second);
+    for (auto it = first(); it != _lossList.end(); ++it) {
+        packet.writePrimitive(it->first);
+        packet.writePrimitive(it->second);
         
         ++writtenPairs;
         
@@ -12,7 +12,7 @@
 #ifndef hifi_LossList_h
 #define hifi_LossList_h
 
-#include <list>
+#include <vector>
 
 #include "SequenceNumber.h"
 
@@ -24,7 +24,7 @@ class LossList {
 public:
     LossList() {}
     
-    void clear() { _length = 0; _lossList.clear(); }
+    void clear() { _length = 0; _firstIndex = 0; _lossList.clear(); }
     
     // must always add at the end - faster than insert
     void append(SequenceNumber seq);
@@ -44,7 +44,20 @@ public:
     void write(ControlPacket& packet, int maxPairs = -1);
     
 private:
-    std::list<std::pair<SequenceNumber, SequenceNumber>> _lossList;
+    using Range = std::pair<SequenceNumber, SequenceNumber>;
+    using Ranges = std::vector<Range>;
+
+    Ranges::iterator first() { return _lossList.begin() + _firstIndex; }
+    Ranges::const_iterator first() const { return _lossList.begin() + _firstIndex; }
+
+    // first range that doesn't end before seq
+    Ranges::iterator findRange(SequenceNumber seq);
+    Ranges::iterator eraseRanges(Ranges::iterator begin, Ranges::iterator end);
+
+    // The ranges are kept sorted in a vector so they can be binary searched. Ranges taken off the front are
+    // left in place before _firstIndex, and only erased once they are half the vector.
+    Ranges _lossList;
+    size_t _firstIndex { 0 };
     int _length { 0 };
 };
     
@@ -261,6 +261,8 @@ const PacketVersion VERSION_ENTITIES_BULLET_DYNAMICS = 70;
 const PacketVersion VERSION_ENTITIES_HAS_SHOULD_HIGHLIGHT = 71;
 const PacketVersion VERSION_ENTITIES_HAS_HIGHLIGHT_SCRIPTING_INTERFACE = 72;
 const PacketVersion VERSION_ENTITIES_ANIMATION_ALLOW_TRANSLATION_PROPERTIES = 73;
+const PacketVersion VERSION_ENTITIES_DICTIONARY_COMPRESSION = 74;
+const PacketVersion VERSION_ENTITIES_STRING_PROPERTY_DELTAS = 75;
 
 enum class EntityQueryPacketVersion: PacketVersion {
     JSONFilter = 18,
@@ -292,6 +294,7 @@ enum class AvatarMixerPacketVersion : PacketVersion {
     AvatarIdentitySequenceFront,
     IsReplicatedInAvatarIdentity,
     AvatarIdentityLookAtSnapping,
+    JointDeltaEncoding,
 };
 
 enum class DomainConnectRequestVersion : PacketVersion {
@@ -317,7 +320,13 @@ enum class DomainListVersion : PacketVersion {
     PrePermissionsGrid = 18,
     PermissionsGrid,
     GetUsernameFromUUIDSupport,
-    GetMachineFingerprintFromUUIDSupport
+    GetMachineFingerprintFromUUIDSupport,
+    IncrementalLists
+};
+
+enum class DomainListRequestVersion : PacketVersion {
+    PreAcknowledgedListVersion = 17,
+    AcknowledgedListVersion
 };
 
 enum class AudioVersion : PacketVersion {
@@ -11,12 +11,61 @@
 
 #include "PacketQueue.h"
 
+#include <algorithm>
+
 #include "PacketList.h"
 
 using namespace udt;
 
+static const size_t MIN_RING_CAPACITY = 16;
+static const size_t MAX_FREE_CHANNELS = 16;
+
+void PacketQueue::PacketRing::reserve(size_t size) {
+    if (size <= _packets.size()) {
+        return;
+    }
+
+    size_t capacity = std::max(MIN_RING_CAPACITY, _packets.size());
+    while (capacity < size) {
+        capacity *= 2;
+    }
+
+    // move what we have to the front of the new buffer
+    std::vector<PacketPointer> packets(capacity);
+    for (size_t i = 0; i < _size; ++i) {
+        packets[i] = std::move(_packets[(_front + i) & (_packets.size() - 1)]);
+    }
+    _packets.swap(packets);
+    _front = 0;
+}
+
+void PacketQueue::PacketRing::push(PacketPointer packet) {
+    if (_size == _packets.size()) {
+        reserve(_size + 1);
+    }
+    _packets[(_front + _size) & (_packets.size() - 1)] = std::move(packet);
+    ++_size;
+}
+
+PacketQueue::PacketPointer PacketQueue::PacketRing::take() {
+    Q_ASSERT(_size > 0);
+    auto packet = std::move(_packets[_front]);
+    _front = (_front + 1) & (_packets.size() - 1);
+    --_size;
+    return packet;
+}
+
 PacketQueue::PacketQueue() {
-    _channels.emplace_back(new std::list<PacketPointer>());
+    _channels.emplace_back(new PacketRing());
+}
+
+PacketQueue::Channel PacketQueue::takeFreeChannel() {
+    if (_freeChannels.empty()) {
+        return Channel(new PacketRing());
+    }
+    auto channel = std::move(_freeChannels.back());
+    _freeChannels.pop_back();
+    return channel;
 }
 
 MessageNumber PacketQueue::getNextMessageNumber() {
@@ -45,12 +94,14 @@ PacketQueue::PacketPointer PacketQueue::takePacket() {
     Q_ASSERT(!channel->empty());
 
     // Take front packet
-    auto packet = std::move(channel->front());
-    channel->pop_front();
+    auto packet = channel->take();
 
-    // Remove now empty channel (Don't remove the main channel)
+    // Remove now empty channel (Don't remove the main channel), keeping it around for the next packet list
     if (channel->empty() && _currentIndex != 0) {
-        channel->swap(*_channels.back());
+        channel.swap(_channels.back());
+        if (_freeChannels.size() < MAX_FREE_CHANNELS) {
+            _freeChannels.push_back(std::move(_channels.back()));
+        }
         _channels.pop_back();
         --_currentIndex;
     }
@@ -65,7 +116,7 @@ unsigned int PacketQueue::nextIndex() {
 
 void PacketQueue::queuePacket(PacketPointer packet) {
     LockGuard locker(_packetsLock);
-    _channels.front()->push_back(std::move(packet));
+    _channels.front()->push(std::move(packet));
 }
 
 void PacketQueue::queuePacketList(PacketListPointer packetList) {
@@ -74,6 +125,11 @@ void PacketQueue::queuePacketList(PacketListPointer packetList) {
     }
 
     LockGuard locker(_packetsLock);
-    _channels.emplace_back(new std::list<PacketPointer>());
-    _channels.back()->swap(packetList->_packets);
+    auto channel = takeFreeChannel();
+    channel->reserve(packetList->_packets.size());
+    for (auto& packet : packetList->_packets) {
+        channel->push(std::move(packet));
+    }
+    packetList->_packets.clear();
+    _channels.push_back(std::move(channel));
 }
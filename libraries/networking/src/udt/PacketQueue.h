@@ -12,7 +12,6 @@
 #ifndef hifi_PacketQueue_h
 #define hifi_PacketQueue_h
 
-#include <list>
 #include <vector>
 #include <memory>
 #include <mutex>
@@ -30,7 +29,24 @@ class PacketQueue {
     using LockGuard = std::lock_guard<Mutex>;
     using PacketPointer = std::unique_ptr<Packet>;
     using PacketListPointer = std::unique_ptr<PacketList>;
-    using Channel = std::unique_ptr<std::list<PacketPointer>>;
+
+    // FIFO of packets in a ring buffer, that only allocates when it has to grow
+    class PacketRing {
+    public:
+        bool empty() const { return _size == 0; }
+        size_t size() const { return _size; }
+
+        void reserve(size_t size);
+        void push(PacketPointer packet);
+        PacketPointer take();
+
+    private:
+        std::vector<PacketPointer> _packets; // capacity is always a power of two
+        size_t _front { 0 };
+        size_t _size { 0 };
+    };
+
+    using Channel = std::unique_ptr<PacketRing>;
     using Channels = std::vector<Channel>;
     
 public:
@@ -46,11 +62,13 @@ public:
 private:
     MessageNumber getNextMessageNumber();
     unsigned int nextIndex();
+    Channel takeFreeChannel();
     
     MessageNumber _currentMessageNumber { 0 };
     
     mutable Mutex _packetsLock; // Protects the packets to be sent.
     Channels _channels; // One channel per packet list + Main channel
+    Channels _freeChannels; // Emptied packet list channels, kept to reuse their buffers
     unsigned int _currentIndex { 0 };
 };
 
@@ -156,6 +156,12 @@ public:
     }
 
     std::function<void(const QUuid& dataID, quint64 itemLastEdited)> trackSend { [](const QUuid&, quint64){} };
+
+    // how many items this pass copied from an encoding kept by an earlier pass, how many it had to encode and keep,
+    // and the encode time the copies saved
+    int encodedDataHits { 0 };
+    int encodedDataMisses { 0 };
+    quint64 encodedDataUsecsSaved { 0 };
 };
 
 class ReadElementBufferToTreeArgs {
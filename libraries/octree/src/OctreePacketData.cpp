@@ -9,11 +9,16 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <cstring>
+
+#include <zlib.h>
+
 #include <GLMHelpers.h>
 #include <PerfStat.h>
 
 #include "OctreeLogging.h"
 #include "OctreePacketData.h"
+#include "OctreePacketDictionary.h"
 #include "NumericalConstants.h"
 
 bool OctreePacketData::_debug = false;
@@ -29,12 +34,13 @@ struct aaCubeData {
     float scale;
 };
 
-OctreePacketData::OctreePacketData(bool enableCompression, int targetSize) {
-    changeSettings(enableCompression, targetSize); // does reset...
+OctreePacketData::OctreePacketData(bool enableCompression, int targetSize, bool useDictionary) {
+    changeSettings(enableCompression, targetSize, useDictionary); // does reset...
 }
 
-void OctreePacketData::changeSettings(bool enableCompression, unsigned int targetSize) {
+void OctreePacketData::changeSettings(bool enableCompression, unsigned int targetSize, bool useDictionary) {
     _enableCompression = enableCompression;
+    _useDictionary = useDictionary;
     _targetSize = std::min(MAX_OCTREE_UNCOMRESSED_PACKET_SIZE, targetSize);
     reset();
 }
@@ -571,6 +577,10 @@ bool OctreePacketData::compressContent() {
 
     _bytesInUseLastCheck = _bytesInUse;
 
+    if (_useDictionary) {
+        return compressContentWithDictionary();
+    }
+
     bool success = false;
     const int MAX_COMPRESSION = 9;
 
@@ -591,13 +601,121 @@ bool OctreePacketData::compressContent() {
     return success;
 }
 
+// A whole section is at most MAX_OCTREE_PACKET_DATA_SIZE, so a small window still reaches back over the entire
+// dictionary, and keeping one stream per thread around costs little.
+const int DICTIONARY_WINDOW_BITS = 13;
+const int DICTIONARY_MEM_LEVEL = 8;
+
+// The dictionary supplies most of what the deeper search of level 9 would find in a packet this small.
+const int DICTIONARY_COMPRESSION_LEVEL = 6;
+
+class DictionaryDeflater {
+public:
+    DictionaryDeflater() {
+        memset(&stream, 0, sizeof(stream));
+        isValid = (deflateInit2(&stream, DICTIONARY_COMPRESSION_LEVEL, Z_DEFLATED, DICTIONARY_WINDOW_BITS,
+            DICTIONARY_MEM_LEVEL, Z_DEFAULT_STRATEGY) == Z_OK);
+    }
+    ~DictionaryDeflater() {
+        if (isValid) {
+            deflateEnd(&stream);
+        }
+    }
+
+    z_stream stream;
+    bool isValid;
+};
+
+class DictionaryInflater {
+public:
+    DictionaryInflater() {
+        memset(&stream, 0, sizeof(stream));
+        isValid = (inflateInit2(&stream, DICTIONARY_WINDOW_BITS) == Z_OK);
+    }
+    ~DictionaryInflater() {
+        if (isValid) {
+            inflateEnd(&stream);
+        }
+    }
+
+    z_stream stream;
+    bool isValid;
+};
+
+bool OctreePacketData::compressContentWithDictionary() {
+    // deflateReset() keeps the stream's buffers, so each packet only pays for priming the dictionary
+    static thread_local DictionaryDeflater deflater;
+    z_stream& stream = deflater.stream;
+    if (!deflater.isValid || deflateReset(&stream) != Z_OK) {
+        return false;
+    }
+
+    const QByteArray& dictionary = getOctreePacketDictionary();
+    if (deflateSetDictionary(&stream, reinterpret_cast<const Bytef*>(dictionary.constData()), dictionary.size()) != Z_OK) {
+        return false;
+    }
+
+    stream.next_in = &_uncompressed[0];
+    stream.avail_in = _bytesInUse;
+    stream.next_out = &_compressed[0];
+    stream.avail_out = MAX_OCTREE_PACKET_DATA_SIZE - 1; // the same limit as the qCompress() path
+
+    // anything short of the end of the stream means the result did not fit
+    if (deflate(&stream, Z_FINISH) != Z_STREAM_END) {
+        return false;
+    }
+
+    _compressedBytes = (int)stream.total_out;
+    _dirty = false;
+    return true;
+}
+
+bool OctreePacketData::uncompressContentWithDictionary(const unsigned char* data, int length) {
+    static thread_local DictionaryInflater inflater;
+    z_stream& stream = inflater.stream;
+    if (!inflater.isValid || inflateReset(&stream) != Z_OK) {
+        return false;
+    }
+
+    stream.next_in = const_cast<Bytef*>(data);
+    stream.avail_in = length;
+    stream.next_out = &_uncompressed[0];
+    stream.avail_out = _bytesAvailable;
+
+    int status = inflate(&stream, Z_FINISH);
+    if (status == Z_NEED_DICT) {
+        if (stream.adler != getOctreePacketDictionaryID()) {
+            qCDebug(octree) << "OctreePacketData::loadFinalizedContent()... section was compressed with an unknown dictionary";
+            return false;
+        }
+        const QByteArray& dictionary = getOctreePacketDictionary();
+        if (inflateSetDictionary(&stream, reinterpret_cast<const Bytef*>(dictionary.constData()), dictionary.size()) != Z_OK) {
+            return false;
+        }
+        status = inflate(&stream, Z_FINISH);
+    }
+    if (status != Z_STREAM_END) {
+        return false;
+    }
+
+    _bytesInUse = (int)stream.total_out;
+    _bytesAvailable -= _bytesInUse;
+    return true;
+}
 
 void OctreePacketData::loadFinalizedContent(const unsigned char* data, int length) {
     reset();
 
     if (data && length > 0) {
 
-        if (_enableCompression) {
+        if (_enableCompression && _useDictionary) {
+            if (length <= (int)MAX_OCTREE_UNCOMRESSED_PACKET_SIZE) {
+                memcpy(_compressed, data, length);
+                _compressedBytes = length;
+                // on failure the section is left empty, like a section that does not fit after qUncompress()
+                uncompressContentWithDictionary(_compressed, _compressedBytes);
+            }
+        } else if (_enableCompression) {
             QByteArray compressedData;
             for (int i = 0; i < length; i++) {
                 compressedData[i] = data[i];
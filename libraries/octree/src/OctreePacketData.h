@@ -59,6 +59,7 @@ const int REASONABLE_NUMBER_OF_PACKING_ATTEMPTS = 5;
 
 const int PACKET_IS_COLOR_BIT = 0;
 const int PACKET_IS_COMPRESSED_BIT = 1;
+const int PACKET_IS_DICTIONARY_COMPRESSED_BIT = 2; // sections are compressed against getOctreePacketDictionary()
 
 /// An opaque key used when starting, ending, and discarding encoding/packing levels of OctreePacketData
 class LevelDetails {
@@ -83,11 +84,13 @@ private:
 /// Handles packing of the data portion of PacketType_OCTREE_DATA messages. 
 class OctreePacketData {
 public:
-    OctreePacketData(bool enableCompression = false, int maxFinalizedSize = MAX_OCTREE_PACKET_DATA_SIZE);
+    OctreePacketData(bool enableCompression = false, int maxFinalizedSize = MAX_OCTREE_PACKET_DATA_SIZE,
+        bool useDictionary = false);
     ~OctreePacketData();
 
-    /// change compression and target size settings
-    void changeSettings(bool enableCompression = false, unsigned int targetSize = MAX_OCTREE_PACKET_DATA_SIZE);
+    /// change compression and target size settings, useDictionary only matters when compression is enabled
+    void changeSettings(bool enableCompression = false, unsigned int targetSize = MAX_OCTREE_PACKET_DATA_SIZE,
+        bool useDictionary = false);
 
     /// reset completely, all data is discarded
     void reset();
@@ -229,6 +232,9 @@ public:
     
     /// returns whether or not zlib compression enabled on finalization
     bool isCompressed() const { return _enableCompression; }
+
+    /// returns whether or not compression is primed with the shared packet dictionary
+    bool usesDictionary() const { return _enableCompression && _useDictionary; }
     
     /// returns the target uncompressed size
     unsigned int getTargetSize() const { return _targetSize; }
@@ -277,6 +283,7 @@ private:
 
     unsigned int _targetSize;
     bool _enableCompression;
+    bool _useDictionary;
     
     unsigned char _uncompressed[MAX_OCTREE_UNCOMRESSED_PACKET_SIZE];
     int _bytesInUse;
@@ -286,6 +293,8 @@ private:
     int _subTreeBytesReserved; // the number of reserved bytes at start of a subtree
 
     bool compressContent();
+    bool compressContentWithDictionary();
+    bool uncompressContentWithDictionary(const unsigned char* data, int length);
     
     unsigned char _compressed[MAX_OCTREE_UNCOMRESSED_PACKET_SIZE];
     int _compressedBytes;
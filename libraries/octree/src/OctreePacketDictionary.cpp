@@ -0,0 +1,89 @@
+//
+//  OctreePacketDictionary.cpp
+//  libraries/octree/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreePacketDictionary.h"
+
+#include <zlib.h>
+
+// Byte sequences that keep showing up in entity data sections: default property values as the entity server packs
+// them, common urls and user data. Every packet is compressed on its own, so without a dictionary zlib has nothing to
+// refer back to until the second entity in the packet. Deflate encodes nearer matches with fewer bits, so the most
+// common sequences are at the end.
+static const char OCTREE_PACKET_DICTIONARY[] =
+    // user data and script snippets
+    "{\"grabbableKey\":{\"grabbable\":false}}"
+    "{\"grabbableKey\":{\"grabbable\":true,\"ignoreIK\":false}}"
+    "{\"grabbableKey\":{\"wantsTrigger\":true}}"
+    "(function() {\n    this.preload = function(entityID) {\n    };\n});\n"
+    "Script.include("
+
+    // urls
+    "http://hifi-content.s3.amazonaws.com/"
+    "https://hifi-content.s3.amazonaws.com/"
+    "http://mpassets.highfidelity.com/"
+    "https://s3.amazonaws.com/hifi-public/"
+    "file:///"
+    ".js\0"
+    ".wav\0"
+    ".png\0"
+    ".jpg\0"
+    ".obj\0"
+    ".fbx\0"
+    "atp:/"
+
+    // a zone's skybox and keylight, and a light's falloff
+    "\x00\x00\x80\x3F\x00\x00\x80\x3F\x00\x00\x80\x3F"
+    "\x00\x00\x00\x00\x00\x00\x80\xBF\x00\x00\x00\x00"
+    "\xFF\xFF\xFF\x00\x00\x00"
+
+    // a shape, particle effect or text entity's color and alpha
+    "\x00\x00\x80\x3F\xFF\xFF\xFF"
+    "\x00\x00\x00\x01\x00\x00"
+
+    // the properties every entity sends, with their default values: position (varies), rotation, velocity, angular
+    // velocity, acceleration, dimensions (varies), density, gravity, damping, restitution, friction, lifetime, script,
+    // script timestamp, server scripts, registration point, angular damping, visible, collisionless, collision mask,
+    // dynamic, locked, user data, marketplace id, name, collision sound url, href, description, action data,
+    // parent id, parent joint index, query cube (varies), last edited by
+    "\xFF\x7F\xFF\x7F\xFF\x7F\xFF\xFF"
+    "\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00"
+    "\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00"
+    "\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00"
+    "\xCD\xCC\xCC\x3D\xCD\xCC\xCC\x3D\xCD\xCC\xCC\x3D"
+    "\x00\x00\x7A\x44"
+    "\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00"
+    "\xE6\x74\xC9\x3E"
+    "\x00\x00\x00\x3F"
+    "\x00\x00\x00\x3F"
+    "\x00\x00\x80\xBF"
+    "\x01\x00\x00"
+    "\x00\x00\x00\x00\x00\x00\x00\x00"
+    "\x01\x00\x00"
+    "\x00\x00\x00\x3F\x00\x00\x00\x3F\x00\x00\x00\x3F"
+    "\xE6\x74\xC9\x3E"
+    "\x01\x00\x1F\x00\x00"
+    "\x01\x00\x00\x01\x00\x00\x01\x00\x00\x01\x00\x00\x01\x00\x00\x01\x00\x00"
+    "\x00\x00"
+    "\x00\x00\xFF\xFF"
+    "\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00"
+    "\x00\x00";
+
+const QByteArray& getOctreePacketDictionary() {
+    // the literal contains zeros, so its size has to be given explicitly
+    static const QByteArray dictionary = QByteArray::fromRawData(OCTREE_PACKET_DICTIONARY,
+        sizeof(OCTREE_PACKET_DICTIONARY) - 1);
+    return dictionary;
+}
+
+unsigned long getOctreePacketDictionaryID() {
+    static const unsigned long dictionaryID = adler32(adler32(0L, Z_NULL, 0),
+        reinterpret_cast<const Bytef*>(getOctreePacketDictionary().constData()), getOctreePacketDictionary().size());
+    return dictionaryID;
+}
@@ -0,0 +1,23 @@
+//
+//  OctreePacketDictionary.h
+//  libraries/octree/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreePacketDictionary_h
+#define hifi_OctreePacketDictionary_h
+
+#include <QByteArray>
+
+/// The preset dictionary shared by the server and clients for packets sent with PACKET_IS_DICTIONARY_COMPRESSED_BIT.
+/// Both sides must use exactly the same bytes, so any change to it needs a new entity packet version.
+const QByteArray& getOctreePacketDictionary();
+
+/// The zlib checksum of the dictionary, as found in the header of every stream compressed with it
+unsigned long getOctreePacketDictionaryID();
+
+#endif // hifi_OctreePacketDictionary_h
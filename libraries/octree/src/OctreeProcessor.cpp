@@ -70,6 +70,7 @@ void OctreeProcessor::processDatagram(ReceivedMessage& message, SharedNodePointe
 
         bool packetIsColored = oneAtBit(flags, PACKET_IS_COLOR_BIT);
         bool packetIsCompressed = oneAtBit(flags, PACKET_IS_COMPRESSED_BIT);
+        bool packetUsesDictionary = oneAtBit(flags, PACKET_IS_DICTIONARY_COMPRESSED_BIT);
         
         OCTREE_PACKET_SENT_TIME arrivedAt = usecTimestampNow();
         qint64 clockSkew = sourceNode ? sourceNode->getClockSkewUsec() : 0;
@@ -125,7 +126,7 @@ void OctreeProcessor::processDatagram(ReceivedMessage& message, SharedNodePointe
                 _tree->withWriteLock([&] {
                     startUncompress = usecTimestampNow();
 
-                    OctreePacketData packetData(packetIsCompressed);
+                    OctreePacketData packetData(packetIsCompressed, MAX_OCTREE_PACKET_DATA_SIZE, packetUsesDictionary);
                     packetData.loadFinalizedContent(reinterpret_cast<const unsigned char*>(message.getRawMessage() + message.getPosition()),
                         sectionLength);
                     if (extraDebugging) {
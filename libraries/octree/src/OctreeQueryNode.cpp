@@ -107,6 +107,7 @@ void OctreeQueryNode::resetOctreePacket() {
     OCTREE_PACKET_FLAGS flags = 0;
     setAtBit(flags, PACKET_IS_COLOR_BIT); // always color
     setAtBit(flags, PACKET_IS_COMPRESSED_BIT); // always compressed
+    setAtBit(flags, PACKET_IS_DICTIONARY_COMPRESSED_BIT); // always against the shared dictionary
 
     _octreePacket->reset();
 
@@ -234,7 +234,8 @@ public:
     virtual bool updateGeometry();
     void setCollisionMesh(model::MeshPointer mesh);
 
-    void setLoadingPriority(float priority) { _loadingPriority = priority; }
+    // may be called every frame, the geometry download is reordered until it completes
+    void setLoadingPriority(float priority);
 
     size_t getRenderInfoVertexCount() const { return _renderInfoVertexCount; }
     size_t getRenderInfoTextureSize();
@@ -364,7 +365,7 @@ protected:
 
     bool _triangleSetsValid { false };
     void calculateTriangleSets();
-    QVector<TriangleSet> _modelSpaceMeshTriangleSets; // model space triangles for all sub meshes
+    std::shared_ptr<const Geometry::MeshTriangleSets> _modelSpaceMeshTriangleSets; // model space triangles for all sub meshes, shared with the geometry
 
 
     void createRenderItemSet();
@@ -1163,7 +1163,8 @@ void ScriptEngine::run() {
     emit scriptEnding();
 
     if (entityScriptingInterface->getEntityPacketSender()->serversExist()) {
-        // release the queue of edit entity messages.
+        // don't leave merged edits behind, then release the queue of edit entity messages.
+        entityScriptingInterface->getEntityPacketSender()->flushPendingEdits();
         entityScriptingInterface->getEntityPacketSender()->releaseQueuedMessages();
 
         // since we're in non-threaded mode, call process so that the packets are sent
@@ -0,0 +1,206 @@
+//
+//  KinematicBatch.cpp
+//  libraries/shared/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "KinematicBatch.h"
+
+#include <glm/gtx/norm.hpp>
+
+#include "PhysicsHelpers.h"
+
+static const float MIN_KINEMATIC_LINEAR_SPEED_SQUARED =
+    KINEMATIC_LINEAR_SPEED_THRESHOLD * KINEMATIC_LINEAR_SPEED_THRESHOLD;
+
+void KinematicBatch::clear() {
+    _positionX.clear();
+    _positionY.clear();
+    _positionZ.clear();
+    _velocityX.clear();
+    _velocityY.clear();
+    _velocityZ.clear();
+    _accelerationX.clear();
+    _accelerationY.clear();
+    _accelerationZ.clear();
+    _dampingFactors.clear();
+    _timesElapsed.clear();
+    _transforms.clear();
+    _angularVelocities.clear();
+}
+
+void KinematicBatch::reserve(size_t size) {
+    size_t padded = (size + 3) & ~(size_t)3;
+    _positionX.reserve(padded);
+    _positionY.reserve(padded);
+    _positionZ.reserve(padded);
+    _velocityX.reserve(padded);
+    _velocityY.reserve(padded);
+    _velocityZ.reserve(padded);
+    _accelerationX.reserve(padded);
+    _accelerationY.reserve(padded);
+    _accelerationZ.reserve(padded);
+    _dampingFactors.reserve(padded);
+    _timesElapsed.reserve(padded);
+    _transforms.reserve(size);
+    _angularVelocities.reserve(size);
+}
+
+size_t KinematicBatch::add(const Transform& transform, const glm::vec3& velocity, const glm::vec3& angularVelocity,
+        const glm::vec3& acceleration, float dampingFactor, float timeElapsed) {
+    size_t index = _transforms.size();
+    _transforms.push_back(transform);
+    _angularVelocities.push_back(angularVelocity);
+
+    size_t padded = (index + 4) & ~(size_t)3;
+    if (_positionX.size() < padded) {
+        // the unused lanes get an object at rest, which step() leaves alone
+        _positionX.resize(padded, 0.0f);
+        _positionY.resize(padded, 0.0f);
+        _positionZ.resize(padded, 0.0f);
+        _velocityX.resize(padded, 0.0f);
+        _velocityY.resize(padded, 0.0f);
+        _velocityZ.resize(padded, 0.0f);
+        _accelerationX.resize(padded, 0.0f);
+        _accelerationY.resize(padded, 0.0f);
+        _accelerationZ.resize(padded, 0.0f);
+        _dampingFactors.resize(padded, 1.0f);
+        _timesElapsed.resize(padded, 0.0f);
+    }
+    glm::vec3 position = transform.getTranslation();
+    _positionX[index] = position.x;
+    _positionY[index] = position.y;
+    _positionZ[index] = position.z;
+    _velocityX[index] = velocity.x;
+    _velocityY[index] = velocity.y;
+    _velocityZ[index] = velocity.z;
+    _accelerationX[index] = acceleration.x;
+    _accelerationY[index] = acceleration.y;
+    _accelerationZ[index] = acceleration.z;
+    _dampingFactors[index] = dampingFactor;
+    _timesElapsed[index] = timeElapsed;
+    return index;
+}
+
+Transform KinematicBatch::getTransform(size_t index) const {
+    Transform transform = _transforms[index];
+    transform.setTranslation(glm::vec3(_positionX[index], _positionY[index], _positionZ[index]));
+    return transform;
+}
+
+glm::vec3 KinematicBatch::getVelocity(size_t index) const {
+    return glm::vec3(_velocityX[index], _velocityY[index], _velocityZ[index]);
+}
+
+void KinematicBatch::stepLinearMotion(glm::vec3& position, glm::vec3& velocity, const glm::vec3& acceleration,
+        float dampingFactor, float timeElapsed) {
+    float speedSquared = glm::length2(velocity);
+    if (speedSquared <= 0.0f) {
+        // not translating
+        return;
+    }
+
+    glm::vec3 deltaVelocity = (dampingFactor - 1.0f) * velocity;
+    bool stop;
+    if (glm::length2(acceleration) > MIN_KINEMATIC_LINEAR_ACCELERATION_SQUARED) {
+        deltaVelocity += acceleration * timeElapsed;
+        stop = speedSquared < MIN_KINEMATIC_LINEAR_SPEED_SQUARED
+            && glm::length2(deltaVelocity) < MIN_KINEMATIC_LINEAR_SPEED_SQUARED
+            && glm::length2(velocity + deltaVelocity) < MIN_KINEMATIC_LINEAR_SPEED_SQUARED;
+    } else {
+        stop = speedSquared < MIN_KINEMATIC_LINEAR_SPEED_SQUARED;
+    }
+
+    if (stop) {
+        velocity = glm::vec3(0.0f);
+    } else {
+        position += timeElapsed * velocity;
+        velocity += deltaVelocity;
+    }
+}
+
+//
+// on x86 architecture, assume that SSE2 is present
+//
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <emmintrin.h>
+
+static inline __m128 selectLanes(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+static inline __m128 lengthSquared(__m128 x, __m128 y, __m128 z) {
+    return _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+}
+
+void KinematicBatch::step() {
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 minSpeedSquared = _mm_set1_ps(MIN_KINEMATIC_LINEAR_SPEED_SQUARED);
+    const __m128 minAccelerationSquared = _mm_set1_ps(MIN_KINEMATIC_LINEAR_ACCELERATION_SQUARED);
+
+    // the same math as stepLinearMotion(), with masks in place of the branches
+    for (size_t i = 0; i < _positionX.size(); i += 4) {
+        __m128 vx = _mm_loadu_ps(&_velocityX[i]);
+        __m128 vy = _mm_loadu_ps(&_velocityY[i]);
+        __m128 vz = _mm_loadu_ps(&_velocityZ[i]);
+        __m128 speedSquared = lengthSquared(vx, vy, vz);
+        __m128 translating = _mm_cmpgt_ps(speedSquared, zero);
+        if (_mm_movemask_ps(translating) == 0) {
+            continue;
+        }
+
+        __m128 ax = _mm_loadu_ps(&_accelerationX[i]);
+        __m128 ay = _mm_loadu_ps(&_accelerationY[i]);
+        __m128 az = _mm_loadu_ps(&_accelerationZ[i]);
+        __m128 accelerating = _mm_cmpgt_ps(lengthSquared(ax, ay, az), minAccelerationSquared);
+        __m128 dt = _mm_loadu_ps(&_timesElapsed[i]);
+        __m128 damping = _mm_sub_ps(_mm_loadu_ps(&_dampingFactors[i]), one);
+
+        __m128 dvx = _mm_add_ps(_mm_mul_ps(damping, vx), _mm_and_ps(accelerating, _mm_mul_ps(ax, dt)));
+        __m128 dvy = _mm_add_ps(_mm_mul_ps(damping, vy), _mm_and_ps(accelerating, _mm_mul_ps(ay, dt)));
+        __m128 dvz = _mm_add_ps(_mm_mul_ps(damping, vz), _mm_and_ps(accelerating, _mm_mul_ps(az, dt)));
+        __m128 nvx = _mm_add_ps(vx, dvx);
+        __m128 nvy = _mm_add_ps(vy, dvy);
+        __m128 nvz = _mm_add_ps(vz, dvz);
+
+        // an accelerating object only stops when it would stay slow after this step
+        __m128 staysSlow = _mm_and_ps(_mm_cmplt_ps(lengthSquared(dvx, dvy, dvz), minSpeedSquared),
+            _mm_cmplt_ps(lengthSquared(nvx, nvy, nvz), minSpeedSquared));
+        __m128 stop = _mm_and_ps(_mm_cmplt_ps(speedSquared, minSpeedSquared),
+            _mm_or_ps(_mm_andnot_ps(accelerating, translating), staysSlow));
+        stop = _mm_and_ps(stop, translating);
+        __m128 move = _mm_andnot_ps(stop, translating);
+
+        _mm_storeu_ps(&_positionX[i], _mm_add_ps(_mm_loadu_ps(&_positionX[i]), _mm_and_ps(move, _mm_mul_ps(dt, vx))));
+        _mm_storeu_ps(&_positionY[i], _mm_add_ps(_mm_loadu_ps(&_positionY[i]), _mm_and_ps(move, _mm_mul_ps(dt, vy))));
+        _mm_storeu_ps(&_positionZ[i], _mm_add_ps(_mm_loadu_ps(&_positionZ[i]), _mm_and_ps(move, _mm_mul_ps(dt, vz))));
+        _mm_storeu_ps(&_velocityX[i], _mm_andnot_ps(stop, selectLanes(move, nvx, vx)));
+        _mm_storeu_ps(&_velocityY[i], _mm_andnot_ps(stop, selectLanes(move, nvy, vy)));
+        _mm_storeu_ps(&_velocityZ[i], _mm_andnot_ps(stop, selectLanes(move, nvz, vz)));
+    }
+}
+
+#else
+
+void KinematicBatch::step() {
+    for (size_t i = 0; i < _transforms.size(); i++) {
+        glm::vec3 position(_positionX[i], _positionY[i], _positionZ[i]);
+        glm::vec3 velocity(_velocityX[i], _velocityY[i], _velocityZ[i]);
+        glm::vec3 acceleration(_accelerationX[i], _accelerationY[i], _accelerationZ[i]);
+        stepLinearMotion(position, velocity, acceleration, _dampingFactors[i], _timesElapsed[i]);
+        _positionX[i] = position.x;
+        _positionY[i] = position.y;
+        _positionZ[i] = position.z;
+        _velocityX[i] = velocity.x;
+        _velocityY[i] = velocity.y;
+        _velocityZ[i] = velocity.z;
+    }
+}
+
+#endif
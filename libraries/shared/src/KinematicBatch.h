@@ -0,0 +1,71 @@
+//
+//  KinematicBatch.h
+//  libraries/shared/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  The linear motion of many simple kinematic objects stored as structure-of-arrays, so it can be
+//  integrated for all of them in one pass.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_KinematicBatch_h
+#define hifi_KinematicBatch_h
+
+#include <stddef.h>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Transform.h"
+
+// accelerations smaller than this are ignored by kinematic motion
+const float MIN_KINEMATIC_LINEAR_ACCELERATION_SQUARED = 1.0e-4f; // 0.01 m/sec^2
+
+class KinematicBatch {
+public:
+    void clear();
+    void reserve(size_t size);
+
+    // Adds one object whose rotation has already been stepped. The acceleration is in the same frame as the
+    // velocity, and dampingFactor is the fraction of the velocity left after timeElapsed. Returns the index.
+    size_t add(const Transform& transform, const glm::vec3& velocity, const glm::vec3& angularVelocity,
+        const glm::vec3& acceleration, float dampingFactor, float timeElapsed);
+
+    size_t size() const { return _transforms.size(); }
+
+    // integrates the linear motion of every object in the batch
+    void step();
+
+    // the results, with the translation of the transform updated by step()
+    Transform getTransform(size_t index) const;
+    glm::vec3 getVelocity(size_t index) const;
+    const glm::vec3& getAngularVelocity(size_t index) const { return _angularVelocities[index]; }
+
+    // Integrates the linear motion of a single object the same way step() does. Like Bullet, the second order
+    // acceleration term is left out, and a velocity that falls below KINEMATIC_LINEAR_SPEED_THRESHOLD is zeroed.
+    static void stepLinearMotion(glm::vec3& position, glm::vec3& velocity, const glm::vec3& acceleration,
+        float dampingFactor, float timeElapsed);
+
+private:
+    // padded up to a multiple of 4 so the SIMD path never has to handle a remainder
+    std::vector<float> _positionX;
+    std::vector<float> _positionY;
+    std::vector<float> _positionZ;
+    std::vector<float> _velocityX;
+    std::vector<float> _velocityY;
+    std::vector<float> _velocityZ;
+    std::vector<float> _accelerationX;
+    std::vector<float> _accelerationY;
+    std::vector<float> _accelerationZ;
+    std::vector<float> _dampingFactors;
+    std::vector<float> _timesElapsed;
+
+    // carried along unchanged
+    std::vector<Transform> _transforms;
+    std::vector<glm::vec3> _angularVelocities;
+};
+
+#endif // hifi_KinematicBatch_h
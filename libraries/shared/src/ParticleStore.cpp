@@ -0,0 +1,187 @@
+//
+//  ParticleStore.cpp
+//  libraries/shared/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ParticleStore.h"
+
+// expired particles are only dropped from the front of the arrays once there are at least this many
+static const size_t MIN_PARTICLES_TO_COMPACT = 64;
+
+void ParticleStore::clear() {
+    _begin = 0;
+    _positionX.clear();
+    _positionY.clear();
+    _positionZ.clear();
+    _velocityX.clear();
+    _velocityY.clear();
+    _velocityZ.clear();
+    _accelerationX.clear();
+    _accelerationY.clear();
+    _accelerationZ.clear();
+    _lifetimes.clear();
+    _seeds.clear();
+    _expirations.clear();
+}
+
+size_t ParticleStore::append(size_t count) {
+    size_t index = size();
+    size_t newSize = _seeds.size() + count;
+    _positionX.resize(newSize, 0.0f);
+    _positionY.resize(newSize, 0.0f);
+    _positionZ.resize(newSize, 0.0f);
+    _velocityX.resize(newSize, 0.0f);
+    _velocityY.resize(newSize, 0.0f);
+    _velocityZ.resize(newSize, 0.0f);
+    _accelerationX.resize(newSize, 0.0f);
+    _accelerationY.resize(newSize, 0.0f);
+    _accelerationZ.resize(newSize, 0.0f);
+    _lifetimes.resize(newSize, 0.0f);
+    _seeds.resize(newSize, 0.0f);
+    _expirations.resize(newSize, 0);
+    return index;
+}
+
+void ParticleStore::set(size_t index, float seed, uint64_t expiration, const glm::vec3& position,
+        const glm::vec3& velocity, const glm::vec3& acceleration) {
+    index += _begin;
+    _positionX[index] = position.x;
+    _positionY[index] = position.y;
+    _positionZ[index] = position.z;
+    _velocityX[index] = velocity.x;
+    _velocityY[index] = velocity.y;
+    _velocityZ[index] = velocity.z;
+    _accelerationX[index] = acceleration.x;
+    _accelerationY[index] = acceleration.y;
+    _accelerationZ[index] = acceleration.z;
+    _lifetimes[index] = 0.0f;
+    _seeds[index] = seed;
+    _expirations[index] = expiration;
+}
+
+void ParticleStore::expire(uint64_t now, size_t maxParticles) {
+    size_t end = _expirations.size();
+    if (end - _begin > maxParticles) {
+        _begin = end - maxParticles;
+    }
+    while (_begin < end && _expirations[_begin] <= now) {
+        _begin++;
+    }
+
+    if (_begin == end) {
+        clear();
+    } else if (_begin >= MIN_PARTICLES_TO_COMPACT && _begin > end - _begin) {
+        compact();
+    }
+}
+
+template <typename T>
+static void dropFront(std::vector<T>& values, size_t count) {
+    values.erase(values.begin(), values.begin() + count);
+}
+
+void ParticleStore::compact() {
+    dropFront(_positionX, _begin);
+    dropFront(_positionY, _begin);
+    dropFront(_positionZ, _begin);
+    dropFront(_velocityX, _begin);
+    dropFront(_velocityY, _begin);
+    dropFront(_velocityZ, _begin);
+    dropFront(_accelerationX, _begin);
+    dropFront(_accelerationY, _begin);
+    dropFront(_accelerationZ, _begin);
+    dropFront(_lifetimes, _begin);
+    dropFront(_seeds, _begin);
+    dropFront(_expirations, _begin);
+    _begin = 0;
+}
+
+glm::vec3 ParticleStore::getPosition(size_t index) const {
+    index += _begin;
+    return glm::vec3(_positionX[index], _positionY[index], _positionZ[index]);
+}
+
+glm::vec3 ParticleStore::getVelocity(size_t index) const {
+    index += _begin;
+    return glm::vec3(_velocityX[index], _velocityY[index], _velocityZ[index]);
+}
+
+void ParticleStore::integrateParticle(glm::vec3& position, glm::vec3& velocity, const glm::vec3& acceleration,
+        float& lifetime, float deltaTime) {
+    glm::vec3 atSquared = (0.5f * deltaTime * deltaTime) * acceleration;
+    position += velocity * deltaTime + atSquared;
+    velocity += acceleration * deltaTime;
+    lifetime += deltaTime;
+}
+
+//
+// on x86 architecture, assume that SSE2 is present
+//
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <emmintrin.h>
+
+void ParticleStore::integrate(float deltaTime) {
+    const __m128 dt = _mm_set1_ps(deltaTime);
+    const __m128 halfDtSquared = _mm_set1_ps(0.5f * deltaTime * deltaTime);
+
+    size_t i = _begin;
+    size_t end = _seeds.size();
+    for (; i + 4 <= end; i += 4) {
+        __m128 vx = _mm_loadu_ps(&_velocityX[i]);
+        __m128 vy = _mm_loadu_ps(&_velocityY[i]);
+        __m128 vz = _mm_loadu_ps(&_velocityZ[i]);
+        __m128 ax = _mm_loadu_ps(&_accelerationX[i]);
+        __m128 ay = _mm_loadu_ps(&_accelerationY[i]);
+        __m128 az = _mm_loadu_ps(&_accelerationZ[i]);
+
+        __m128 px = _mm_add_ps(_mm_mul_ps(vx, dt), _mm_mul_ps(halfDtSquared, ax));
+        __m128 py = _mm_add_ps(_mm_mul_ps(vy, dt), _mm_mul_ps(halfDtSquared, ay));
+        __m128 pz = _mm_add_ps(_mm_mul_ps(vz, dt), _mm_mul_ps(halfDtSquared, az));
+        _mm_storeu_ps(&_positionX[i], _mm_add_ps(_mm_loadu_ps(&_positionX[i]), px));
+        _mm_storeu_ps(&_positionY[i], _mm_add_ps(_mm_loadu_ps(&_positionY[i]), py));
+        _mm_storeu_ps(&_positionZ[i], _mm_add_ps(_mm_loadu_ps(&_positionZ[i]), pz));
+        _mm_storeu_ps(&_velocityX[i], _mm_add_ps(vx, _mm_mul_ps(ax, dt)));
+        _mm_storeu_ps(&_velocityY[i], _mm_add_ps(vy, _mm_mul_ps(ay, dt)));
+        _mm_storeu_ps(&_velocityZ[i], _mm_add_ps(vz, _mm_mul_ps(az, dt)));
+        _mm_storeu_ps(&_lifetimes[i], _mm_add_ps(_mm_loadu_ps(&_lifetimes[i]), dt));
+    }
+
+    // the remainder
+    for (; i < end; i++) {
+        glm::vec3 position(_positionX[i], _positionY[i], _positionZ[i]);
+        glm::vec3 velocity(_velocityX[i], _velocityY[i], _velocityZ[i]);
+        glm::vec3 acceleration(_accelerationX[i], _accelerationY[i], _accelerationZ[i]);
+        integrateParticle(position, velocity, acceleration, _lifetimes[i], deltaTime);
+        _positionX[i] = position.x;
+        _positionY[i] = position.y;
+        _positionZ[i] = position.z;
+        _velocityX[i] = velocity.x;
+        _velocityY[i] = velocity.y;
+        _velocityZ[i] = velocity.z;
+    }
+}
+
+#else
+
+void ParticleStore::integrate(float deltaTime) {
+    for (size_t i = _begin; i < _seeds.size(); i++) {
+        glm::vec3 position(_positionX[i], _positionY[i], _positionZ[i]);
+        glm::vec3 velocity(_velocityX[i], _velocityY[i], _velocityZ[i]);
+        glm::vec3 acceleration(_accelerationX[i], _accelerationY[i], _accelerationZ[i]);
+        integrateParticle(position, velocity, acceleration, _lifetimes[i], deltaTime);
+        _positionX[i] = position.x;
+        _positionY[i] = position.y;
+        _positionZ[i] = position.z;
+        _velocityX[i] = velocity.x;
+        _velocityY[i] = velocity.y;
+        _velocityZ[i] = velocity.z;
+    }
+}
+
+#endif
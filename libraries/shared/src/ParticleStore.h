@@ -0,0 +1,69 @@
+//
+//  ParticleStore.h
+//  libraries/shared/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  The CPU side particles of one emitter stored as structure-of-arrays, oldest first, so they can be
+//  integrated in one pass and expired from the front without moving the rest.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ParticleStore_h
+#define hifi_ParticleStore_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+class ParticleStore {
+public:
+    size_t size() const { return _seeds.size() - _begin; }
+    bool empty() const { return size() == 0; }
+    void clear();
+
+    // Appends count particles at rest and returns the index of the first one, fill them in with set()
+    size_t append(size_t count);
+    void set(size_t index, float seed, uint64_t expiration, const glm::vec3& position, const glm::vec3& velocity,
+        const glm::vec3& acceleration);
+
+    // removes the oldest particles while they have expired or there are more than maxParticles
+    void expire(uint64_t now, size_t maxParticles);
+
+    // integrates the motion and lifetime of every particle
+    void integrate(float deltaTime);
+
+    glm::vec3 getPosition(size_t index) const;
+    glm::vec3 getVelocity(size_t index) const;
+    float getLifetime(size_t index) const { return _lifetimes[_begin + index]; }
+    float getSeed(size_t index) const { return _seeds[_begin + index]; }
+    uint64_t getExpiration(size_t index) const { return _expirations[_begin + index]; }
+
+    // the same integration integrate() does, for a single particle
+    static void integrateParticle(glm::vec3& position, glm::vec3& velocity, const glm::vec3& acceleration,
+        float& lifetime, float deltaTime);
+
+private:
+    void compact();
+
+    // the particles before _begin have expired, they are dropped once they are the majority
+    size_t _begin { 0 };
+    std::vector<float> _positionX;
+    std::vector<float> _positionY;
+    std::vector<float> _positionZ;
+    std::vector<float> _velocityX;
+    std::vector<float> _velocityY;
+    std::vector<float> _velocityZ;
+    std::vector<float> _accelerationX;
+    std::vector<float> _accelerationY;
+    std::vector<float> _accelerationZ;
+    std::vector<float> _lifetimes;
+    std::vector<float> _seeds;
+    std::vector<uint64_t> _expirations;
+};
+
+#endif // hifi_ParticleStore_h
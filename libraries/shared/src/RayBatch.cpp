@@ -0,0 +1,179 @@
+//
+//  RayBatch.cpp
+//  libraries/shared/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "RayBatch.h"
+
+#include <algorithm>
+#include <cmath>
+
+// direction components smaller than this are nudged away from zero, so the reciprocal stays finite and the
+// slab test never produces 0 * inf = NaN
+static const float MIN_DIRECTION_COMPONENT = 1.0e-20f;
+
+// the exact tests in AABox treat points on the surface as inside, pad the box so we never disagree with them
+static const float BOX_PADDING_RATIO = 1.0e-4f;
+static const float MIN_BOX_PADDING = 1.0e-4f;
+
+static float safeInverse(float value) {
+    if (fabsf(value) < MIN_DIRECTION_COMPONENT) {
+        value = (value < 0.0f) ? -MIN_DIRECTION_COMPONENT : MIN_DIRECTION_COMPONENT;
+    }
+    return 1.0f / value;
+}
+
+void RayBatch::clear() {
+    _originX.clear();
+    _originY.clear();
+    _originZ.clear();
+    _invDirectionX.clear();
+    _invDirectionY.clear();
+    _invDirectionZ.clear();
+    _size = 0;
+}
+
+void RayBatch::reserve(size_t numRays) {
+    size_t padded = (numRays + 3) & ~(size_t)3;
+    _originX.reserve(padded);
+    _originY.reserve(padded);
+    _originZ.reserve(padded);
+    _invDirectionX.reserve(padded);
+    _invDirectionY.reserve(padded);
+    _invDirectionZ.reserve(padded);
+}
+
+size_t RayBatch::addRay(const glm::vec3& origin, const glm::vec3& direction) {
+    size_t index = _size++;
+    size_t padded = (_size + 3) & ~(size_t)3;
+    if (_originX.size() < padded) {
+        // the unused lanes get a harmless ray, their results are never reported
+        _originX.resize(padded, 0.0f);
+        _originY.resize(padded, 0.0f);
+        _originZ.resize(padded, 0.0f);
+        _invDirectionX.resize(padded, 1.0f);
+        _invDirectionY.resize(padded, 1.0f);
+        _invDirectionZ.resize(padded, 1.0f);
+    }
+    _originX[index] = origin.x;
+    _originY[index] = origin.y;
+    _originZ[index] = origin.z;
+    _invDirectionX[index] = safeInverse(direction.x);
+    _invDirectionY[index] = safeInverse(direction.y);
+    _invDirectionZ[index] = safeInverse(direction.z);
+    return index;
+}
+
+glm::vec3 RayBatch::getOrigin(size_t index) const {
+    return glm::vec3(_originX[index], _originY[index], _originZ[index]);
+}
+
+//
+// on x86 architecture, assume that SSE2 is present
+//
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <emmintrin.h>
+
+int RayBatch::intersectBox(const glm::vec3& corner, const glm::vec3& scale, const uint8_t* active, uint8_t* hits) const {
+    glm::vec3 padding = scale * BOX_PADDING_RATIO + glm::vec3(MIN_BOX_PADDING);
+    glm::vec3 minimum = corner - padding;
+    glm::vec3 maximum = corner + scale + padding;
+
+    const __m128 minX = _mm_set1_ps(minimum.x);
+    const __m128 minY = _mm_set1_ps(minimum.y);
+    const __m128 minZ = _mm_set1_ps(minimum.z);
+    const __m128 maxX = _mm_set1_ps(maximum.x);
+    const __m128 maxY = _mm_set1_ps(maximum.y);
+    const __m128 maxZ = _mm_set1_ps(maximum.z);
+    const __m128 zero = _mm_setzero_ps();
+
+    int numHits = 0;
+    for (size_t i = 0; i < _size; i += 4) {
+        size_t lanes = std::min<size_t>(4, _size - i);
+
+        // skip the math entirely when no ray in this group is still searching
+        bool anyActive = false;
+        for (size_t j = 0; j < lanes; j++) {
+            anyActive |= (active[i + j] != 0);
+        }
+        if (!anyActive) {
+            for (size_t j = 0; j < lanes; j++) {
+                hits[i + j] = 0;
+            }
+            continue;
+        }
+
+        __m128 originX = _mm_loadu_ps(&_originX[i]);
+        __m128 inverseX = _mm_loadu_ps(&_invDirectionX[i]);
+        __m128 t0 = _mm_mul_ps(_mm_sub_ps(minX, originX), inverseX);
+        __m128 t1 = _mm_mul_ps(_mm_sub_ps(maxX, originX), inverseX);
+        __m128 tEntry = _mm_min_ps(t0, t1);
+        __m128 tExit = _mm_max_ps(t0, t1);
+
+        __m128 originY = _mm_loadu_ps(&_originY[i]);
+        __m128 inverseY = _mm_loadu_ps(&_invDirectionY[i]);
+        t0 = _mm_mul_ps(_mm_sub_ps(minY, originY), inverseY);
+        t1 = _mm_mul_ps(_mm_sub_ps(maxY, originY), inverseY);
+        tEntry = _mm_max_ps(tEntry, _mm_min_ps(t0, t1));
+        tExit = _mm_min_ps(tExit, _mm_max_ps(t0, t1));
+
+        __m128 originZ = _mm_loadu_ps(&_originZ[i]);
+        __m128 inverseZ = _mm_loadu_ps(&_invDirectionZ[i]);
+        t0 = _mm_mul_ps(_mm_sub_ps(minZ, originZ), inverseZ);
+        t1 = _mm_mul_ps(_mm_sub_ps(maxZ, originZ), inverseZ);
+        tEntry = _mm_max_ps(tEntry, _mm_min_ps(t0, t1));
+        tExit = _mm_min_ps(tExit, _mm_max_ps(t0, t1));
+
+        // the box is hit if the slabs overlap somewhere in front of the origin
+        int mask = _mm_movemask_ps(_mm_cmpge_ps(tExit, _mm_max_ps(tEntry, zero)));
+        for (size_t j = 0; j < lanes; j++) {
+            uint8_t hit = (active[i + j] && (mask & (1 << j))) ? 1 : 0;
+            hits[i + j] = hit;
+            numHits += hit;
+        }
+    }
+    return numHits;
+}
+
+#else
+
+int RayBatch::intersectBox(const glm::vec3& corner, const glm::vec3& scale, const uint8_t* active, uint8_t* hits) const {
+    glm::vec3 padding = scale * BOX_PADDING_RATIO + glm::vec3(MIN_BOX_PADDING);
+    glm::vec3 minimum = corner - padding;
+    glm::vec3 maximum = corner + scale + padding;
+
+    int numHits = 0;
+    for (size_t i = 0; i < _size; i++) {
+        if (!active[i]) {
+            hits[i] = 0;
+            continue;
+        }
+        float t0 = (minimum.x - _originX[i]) * _invDirectionX[i];
+        float t1 = (maximum.x - _originX[i]) * _invDirectionX[i];
+        float tEntry = std::min(t0, t1);
+        float tExit = std::max(t0, t1);
+
+        t0 = (minimum.y - _originY[i]) * _invDirectionY[i];
+        t1 = (maximum.y - _originY[i]) * _invDirectionY[i];
+        tEntry = std::max(tEntry, std::min(t0, t1));
+        tExit = std::min(tExit, std::max(t0, t1));
+
+        t0 = (minimum.z - _originZ[i]) * _invDirectionZ[i];
+        t1 = (maximum.z - _originZ[i]) * _invDirectionZ[i];
+        tEntry = std::max(tEntry, std::min(t0, t1));
+        tExit = std::min(tExit, std::max(t0, t1));
+
+        uint8_t hit = (tExit >= std::max(tEntry, 0.0f)) ? 1 : 0;
+        hits[i] = hit;
+        numHits += hit;
+    }
+    return numHits;
+}
+
+#endif
@@ -0,0 +1,51 @@
+//
+//  RayBatch.h
+//  libraries/shared/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  A set of rays stored as structure-of-arrays so that one bounding box can be tested against
+//  several rays at once.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_RayBatch_h
+#define hifi_RayBatch_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+class RayBatch {
+public:
+    void clear();
+    void reserve(size_t numRays);
+
+    // returns the index of the added ray
+    size_t addRay(const glm::vec3& origin, const glm::vec3& direction);
+
+    size_t size() const { return _size; }
+    glm::vec3 getOrigin(size_t index) const;
+
+    // Conservative ray vs. box test. For every ray whose entry in active is non-zero, hits is set to 1 if
+    // the ray may touch the box and 0 otherwise; inactive rays always get 0. The box is padded slightly,
+    // so callers must still run an exact test on the rays that pass. Both arrays hold size() entries.
+    // Returns the number of rays that passed.
+    int intersectBox(const glm::vec3& corner, const glm::vec3& scale, const uint8_t* active, uint8_t* hits) const;
+
+private:
+    // padded up to a multiple of 4 so the SIMD path never has to handle a remainder
+    std::vector<float> _originX;
+    std::vector<float> _originY;
+    std::vector<float> _originZ;
+    std::vector<float> _invDirectionX;
+    std::vector<float> _invDirectionY;
+    std::vector<float> _invDirectionZ;
+    size_t _size { 0 };
+};
+
+#endif // hifi_RayBatch_h
@@ -20,6 +20,57 @@
 const float defaultAACubeSize = 1.0f;
 const int maxParentingChain = 30;
 
+bool WorldTransformCache::read(uint32_t version, Transform& transform) const {
+    uint32_t sequence = _sequence.load(std::memory_order_acquire);
+    if (sequence & 1) {
+        return false;
+    }
+
+    uint32_t cachedVersion = _version.load(std::memory_order_relaxed);
+    std::array<float, NUM_COMPONENTS> components;
+    for (int i = 0; i < NUM_COMPONENTS; ++i) {
+        components[i] = _components[i].load(std::memory_order_relaxed);
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (_sequence.load(std::memory_order_relaxed) != sequence || cachedVersion != version) {
+        return false;
+    }
+
+    transform = Transform(glm::quat(components[0], components[1], components[2], components[3]),
+                          glm::vec3(components[4], components[5], components[6]),
+                          glm::vec3(components[7], components[8], components[9]));
+    return true;
+}
+
+bool WorldTransformCache::isValid(uint32_t version) const {
+    return _version.load(std::memory_order_acquire) == version;
+}
+
+void WorldTransformCache::write(uint32_t version, const Transform& transform) {
+    uint32_t sequence = _sequence.load(std::memory_order_relaxed);
+    if ((sequence & 1) || !_sequence.compare_exchange_strong(sequence, sequence + 1, std::memory_order_acquire)) {
+        // someone else is filling the cache
+        return;
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+
+    const glm::quat& rotation = transform.getRotation();
+    const glm::vec3& scale = transform.getScale();
+    const glm::vec3& translation = transform.getTranslation();
+    const float components[NUM_COMPONENTS] = {
+        rotation.w, rotation.x, rotation.y, rotation.z,
+        scale.x, scale.y, scale.z,
+        translation.x, translation.y, translation.z
+    };
+    for (int i = 0; i < NUM_COMPONENTS; ++i) {
+        _components[i].store(components[i], std::memory_order_relaxed);
+    }
+    _version.store(version, std::memory_order_relaxed);
+
+    _sequence.store(sequence + 2, std::memory_order_release);
+}
+
 SpatiallyNestable::SpatiallyNestable(NestableType nestableType, QUuid id) :
     _nestableType(nestableType),
     _id(id),
@@ -34,6 +85,7 @@ SpatiallyNestable::SpatiallyNestable(NestableType nestableType, QUuid id) :
 
 SpatiallyNestable::~SpatiallyNestable() {
     forEachChild([&](SpatiallyNestablePointer object) {
+        object->worldTransformChanged();
         object->parentDeleted();
     });
 }
@@ -65,12 +117,17 @@ const QUuid SpatiallyNestable::getParentID() const {
 }
 
 void SpatiallyNestable::setParentID(const QUuid& parentID) {
+    bool changed = false;
     _idLock.withWriteLock([&] {
         if (_parentID != parentID) {
             _parentID = parentID;
             _parentKnowsMe = false;
+            changed = true;
         }
     });
+    if (changed) {
+        worldTransformChanged();
+    }
 
     bool success = false;
     getParentPointer(success);
@@ -114,6 +171,7 @@ SpatiallyNestablePointer SpatiallyNestable::getParentPointer(bool& success) cons
         parent->forgetChild(getThisPointer());
         _parentKnowsMe = false;
         _parent.reset();
+        worldTransformChanged();
     }
 
     // we have a _parentID but no parent pointer, or our parent pointer was to the wrong thing
@@ -131,6 +189,7 @@ SpatiallyNestablePointer SpatiallyNestable::getParentPointer(bool& success) cons
     if (parent) {
         parent->beParentOfChild(getThisPointer());
         _parentKnowsMe = true;
+        worldTransformChanged(); // we're relative to something else now
     }
 
     success = (parent || parentID.isNull());
@@ -150,7 +209,10 @@ void SpatiallyNestable::forgetChild(SpatiallyNestablePointer newChild) const {
 }
 
 void SpatiallyNestable::setParentJointIndex(quint16 parentJointIndex) {
-    _parentJointIndex = parentJointIndex;
+    if (_parentJointIndex != parentJointIndex) {
+        _parentJointIndex = parentJointIndex;
+        worldTransformChanged();
+    }
 }
 
 glm::vec3 SpatiallyNestable::worldToLocal(const glm::vec3& position,
@@ -409,6 +471,9 @@ void SpatiallyNestable::setPosition(const glm::vec3& position, bool& success, bo
             _translationChanged = usecTimestampNow();
         }
     });
+    if (changed) {
+        worldTransformChanged();
+    }
     if (success && changed) {
         locationChanged(tellPhysics);
     }
@@ -462,6 +527,9 @@ void SpatiallyNestable::setOrientation(const glm::quat& orientation, bool& succe
             _rotationChanged = usecTimestampNow();
         }
     });
+    if (changed) {
+        worldTransformChanged();
+    }
     if (success && changed) {
         locationChanged(tellPhysics);
     }
@@ -597,11 +665,35 @@ glm::vec3 SpatiallyNestable::getParentAngularVelocity(bool& success) const {
 
 const Transform SpatiallyNestable::getTransform(bool& success, int depth) const {
     Transform result;
+
+    // read the version first, so a change that lands while we compute leaves our result stale in the cache
+    uint32_t version = _worldTransformVersion.load(std::memory_order_acquire);
+    if (_worldTransformCache.read(version, result)) {
+        success = true;
+        return result;
+    }
+
     // return a world-space transform for this object's location
-    Transform parentTransform = getParentTransform(success, depth);
+    Transform parentTransform;
+    bool cacheable = true;
+    SpatiallyNestablePointer parent = getParentPointer(success);
+    if (success && parent) {
+        parentTransform = parent->getTransform(_parentJointIndex, success, depth + 1);
+        parentTransform.setScale(1.0f); // TODO: scaling
+
+        // joints move without telling their children, so only something that hangs off its parent's origin
+        // (and whose parent is cached in turn) can hold on to its world transform
+        cacheable = _parentJointIndex == INVALID_JOINT_INDEX &&
+            parent->_worldTransformCache.isValid(parent->_worldTransformVersion.load(std::memory_order_acquire));
+    }
+
     _transformLock.withReadLock([&] {
         Transform::mult(result, parentTransform, _transform);
     });
+
+    if (success && cacheable) {
+        _worldTransformCache.write(version, result);
+    }
     return result;
 }
 
@@ -662,6 +754,9 @@ void SpatiallyNestable::setTransform(const Transform& transform, bool& success)
             _rotationChanged = usecTimestampNow();
         }
     });
+    if (changed) {
+        worldTransformChanged();
+    }
     if (success && changed) {
         locationChanged();
     }
@@ -704,6 +799,7 @@ void SpatiallyNestable::setScale(const glm::vec3& scale) {
         }
     });
     if (changed) {
+        worldTransformChanged();
         dimensionsChanged();
     }
 }
@@ -727,6 +823,7 @@ void SpatiallyNestable::setScale(float value) {
     });
 
     if (changed) {
+        worldTransformChanged();
         dimensionsChanged();
     }
 }
@@ -758,6 +855,7 @@ void SpatiallyNestable::setLocalTransform(const Transform& transform) {
     });
 
     if (changed) {
+        worldTransformChanged();
         locationChanged();
     }
 }
@@ -785,6 +883,7 @@ void SpatiallyNestable::setLocalPosition(const glm::vec3& position, bool tellPhy
         }
     });
     if (changed) {
+        worldTransformChanged();
         locationChanged(tellPhysics);
     }
 }
@@ -812,6 +911,7 @@ void SpatiallyNestable::setLocalOrientation(const glm::quat& orientation) {
         }
     });
     if (changed) {
+        worldTransformChanged();
         locationChanged();
     }
 }
@@ -870,6 +970,7 @@ void SpatiallyNestable::setLocalScale(const glm::vec3& scale) {
         }
     });
     if (changed) {
+        worldTransformChanged();
         dimensionsChanged();
     }
 }
@@ -966,6 +1067,17 @@ void SpatiallyNestable::forEachDescendantTest(const ChildLambdaTest& actor) cons
     }
 }
 
+void SpatiallyNestable::worldTransformChanged(int depth) const {
+    _worldTransformVersion.fetch_add(1, std::memory_order_acq_rel);
+
+    // a parenting loop is broken when its transform is next computed, don't chase it around here
+    if (depth < maxParentingChain) {
+        forEachChild([&](const SpatiallyNestablePointer& child) {
+            child->worldTransformChanged(depth + 1);
+        });
+    }
+}
+
 void SpatiallyNestable::locationChanged(bool tellPhysics) {
     forEachChild([&](SpatiallyNestablePointer object) {
         object->locationChanged(tellPhysics);
@@ -1168,6 +1280,7 @@ void SpatiallyNestable::setLocalTransformAndVelocities(
     });
 
     if (changed) {
+        worldTransformChanged();
         locationChanged(false);
     }
 }
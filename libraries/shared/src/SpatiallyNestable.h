@@ -12,6 +12,9 @@
 #ifndef hifi_SpatiallyNestable_h
 #define hifi_SpatiallyNestable_h
 
+#include <array>
+#include <atomic>
+
 #include <QUuid>
 
 #include "Transform.h"
@@ -34,6 +37,23 @@ enum class NestableType {
     Overlay
 };
 
+// A world transform saved along with the version of the nestable it was computed for. It is a seqlock over
+// atomic floats, so readers never block and never see a torn transform, and a writer that finds another
+// write in progress just skips caching.
+class WorldTransformCache {
+public:
+    bool read(uint32_t version, Transform& transform) const;
+    bool isValid(uint32_t version) const;
+    void write(uint32_t version, const Transform& transform);
+
+private:
+    static const int NUM_COMPONENTS = 10; // rotation, scale, translation
+
+    std::atomic<uint32_t> _sequence { 0 }; // odd while a write is in progress
+    std::atomic<uint32_t> _version { 0 };
+    std::array<std::atomic<float>, NUM_COMPONENTS> _components;
+};
+
 class SpatiallyNestable : public std::enable_shared_from_this<SpatiallyNestable> {
 public:
     SpatiallyNestable(NestableType nestableType, QUuid id);
@@ -195,6 +215,9 @@ protected:
     QUuid _id;
     mutable SpatiallyNestableWeakPointer _parent;
 
+    // called whenever this object's world transform may have changed - the new one is computed on the next get
+    void worldTransformChanged(int depth = 0) const;
+
     virtual void beParentOfChild(SpatiallyNestablePointer newChild) const;
     virtual void forgetChild(SpatiallyNestablePointer newChild) const;
 
@@ -222,6 +245,11 @@ private:
     mutable ReadWriteLockable _velocityLock;
     mutable ReadWriteLockable _angularVelocityLock;
     Transform _transform; // this is to be combined with parent's world-transform to produce this' world-transform.
+
+    // bumped by worldTransformChanged, which is pushed down to all descendants, so a cache entry for the
+    // current version is still this' world-transform
+    mutable std::atomic<uint32_t> _worldTransformVersion { 1 };
+    mutable WorldTransformCache _worldTransformCache;
     glm::vec3 _velocity;
     glm::vec3 _angularVelocity;
     mutable bool _parentKnowsMe { false };
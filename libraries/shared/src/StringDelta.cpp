@@ -0,0 +1,195 @@
+//
+//  StringDelta.cpp
+//  libraries/shared/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "StringDelta.h"
+
+#include <string.h>
+
+#include <QHash>
+
+const int StringDelta::BLOCK_SIZE;
+const int StringDelta::MAX_TARGET_SIZE;
+
+// multiplier of the polynomial rolling hash
+static const quint32 HASH_BASE = 257;
+
+static void appendVarint(QByteArray& bytes, quint32 value) {
+    while (value >= 0x80) {
+        bytes.append((char)((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    bytes.append((char)value);
+}
+
+static bool readVarint(const QByteArray& bytes, int& offset, quint32& value) {
+    value = 0;
+    for (int shift = 0; shift < 32; shift += 7) {
+        if (offset >= bytes.size()) {
+            return false;
+        }
+        quint8 byte = (quint8)bytes[offset++];
+        value |= (quint32)(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static quint32 hashBlock(const char* data) {
+    quint32 hash = 0;
+    for (int i = 0; i < StringDelta::BLOCK_SIZE; i++) {
+        hash = hash * HASH_BASE + (quint8)data[i];
+    }
+    return hash;
+}
+
+// each op is a varint of (length << 1 | isCopy), followed by the offset into the base for a copy or the bytes
+// themselves for a literal
+static void appendLiteral(QByteArray& delta, const char* data, int length) {
+    if (length > 0) {
+        appendVarint(delta, (quint32)length << 1);
+        delta.append(data, length);
+    }
+}
+
+static void appendCopy(QByteArray& delta, int offset, int length) {
+    appendVarint(delta, ((quint32)length << 1) | 1);
+    appendVarint(delta, (quint32)offset);
+}
+
+quint32 StringDelta::checksum(const QByteArray& data) {
+    // FNV-1a, which does not depend on the platform or the Qt version
+    quint32 hash = 2166136261u;
+    for (int i = 0; i < data.size(); i++) {
+        hash = (hash ^ (quint8)data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+QByteArray StringDelta::diff(const QByteArray& base, const QByteArray& target) {
+    QByteArray delta;
+    appendVarint(delta, (quint32)base.size());
+    quint32 baseChecksum = checksum(base);
+    delta.append((const char*)&baseChecksum, sizeof(baseChecksum));
+    appendVarint(delta, (quint32)target.size());
+
+    const char* baseData = base.constData();
+    const char* targetData = target.constData();
+    int baseSize = base.size();
+    int targetSize = target.size();
+
+    // index the base by the hash of each of its whole blocks
+    QHash<quint32, int> blocks;
+    blocks.reserve(baseSize / BLOCK_SIZE);
+    for (int offset = 0; offset + BLOCK_SIZE <= baseSize; offset += BLOCK_SIZE) {
+        blocks.insert(hashBlock(baseData + offset), offset);
+    }
+
+    // the weight of the byte that leaves the window as it rolls forward
+    quint32 leavingWeight = 1;
+    for (int i = 1; i < BLOCK_SIZE; i++) {
+        leavingWeight *= HASH_BASE;
+    }
+
+    int literalStart = 0;
+    int position = 0;
+    bool hashValid = false;
+    quint32 hash = 0;
+    while (position + BLOCK_SIZE <= targetSize) {
+        if (!hashValid) {
+            hash = hashBlock(targetData + position);
+            hashValid = true;
+        }
+
+        auto block = blocks.find(hash);
+        if (block != blocks.end() && memcmp(baseData + block.value(), targetData + position, BLOCK_SIZE) == 0) {
+            int baseOffset = block.value();
+            int matchStart = position;
+
+            // grow the match back into the pending literal and forward past the block
+            while (matchStart > literalStart && baseOffset > 0 && baseData[baseOffset - 1] == targetData[matchStart - 1]) {
+                matchStart--;
+                baseOffset--;
+            }
+            int matchEnd = position + BLOCK_SIZE;
+            int baseEnd = block.value() + BLOCK_SIZE;
+            while (matchEnd < targetSize && baseEnd < baseSize && baseData[baseEnd] == targetData[matchEnd]) {
+                matchEnd++;
+                baseEnd++;
+            }
+
+            appendLiteral(delta, targetData + literalStart, matchStart - literalStart);
+            appendCopy(delta, baseOffset, matchEnd - matchStart);
+            literalStart = position = matchEnd;
+            hashValid = false;
+            continue;
+        }
+
+        // roll the window forward by one byte
+        if (position + BLOCK_SIZE < targetSize) {
+            hash = (hash - (quint8)targetData[position] * leavingWeight) * HASH_BASE +
+                (quint8)targetData[position + BLOCK_SIZE];
+        }
+        position++;
+    }
+    appendLiteral(delta, targetData + literalStart, targetSize - literalStart);
+    return delta;
+}
+
+bool StringDelta::patch(const QByteArray& base, const QByteArray& delta, QByteArray& target) {
+    int offset = 0;
+    quint32 baseSize;
+    quint32 baseChecksum;
+    quint32 targetSize;
+    if (!readVarint(delta, offset, baseSize) || baseSize != (quint32)base.size() ||
+            offset + (int)sizeof(baseChecksum) > delta.size()) {
+        return false;
+    }
+    memcpy(&baseChecksum, delta.constData() + offset, sizeof(baseChecksum));
+    offset += sizeof(baseChecksum);
+    if (baseChecksum != checksum(base) || !readVarint(delta, offset, targetSize) ||
+            targetSize > (quint32)MAX_TARGET_SIZE) {
+        return false;
+    }
+
+    // the ops can't add up to more than targetSize, so nothing here grows past MAX_TARGET_SIZE
+
+    QByteArray result;
+    result.reserve(targetSize);
+    while (offset < delta.size()) {
+        quint32 op;
+        if (!readVarint(delta, offset, op)) {
+            return false;
+        }
+        quint32 length = op >> 1;
+        if (result.size() + length > targetSize) {
+            return false;
+        }
+        if (op & 1) {
+            quint32 baseOffset;
+            if (!readVarint(delta, offset, baseOffset) || baseOffset > baseSize || length > baseSize - baseOffset) {
+                return false;
+            }
+            result.append(base.constData() + baseOffset, length);
+        } else {
+            if (length > (quint32)(delta.size() - offset)) {
+                return false;
+            }
+            result.append(delta.constData() + offset, length);
+            offset += length;
+        }
+    }
+    if ((quint32)result.size() != targetSize) {
+        return false;
+    }
+    target = result;
+    return true;
+}
@@ -0,0 +1,39 @@
+//
+//  StringDelta.h
+//  libraries/shared/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Encodes a string as the blocks it shares with an earlier version of it plus the bytes that are new, so that
+//  a small change to a long string can be sent without resending the whole string.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_StringDelta_h
+#define hifi_StringDelta_h
+
+#include <QByteArray>
+
+class StringDelta {
+public:
+    // base blocks shorter than this are not worth matching
+    static const int BLOCK_SIZE = 16;
+
+    // the longest string a delta may rebuild, octree packets write string lengths as a uint16
+    static const int MAX_TARGET_SIZE = 65535;
+
+    // Returns the delta that turns base into target. Like rsync, the base is split into blocks that are
+    // found anywhere in the target with a rolling hash, and the bytes between matches are sent as they are.
+    static QByteArray diff(const QByteArray& base, const QByteArray& target);
+
+    // Rebuilds the target from the base it was diffed against. Returns false if the delta is malformed, was
+    // made against a different base, or would rebuild more than MAX_TARGET_SIZE bytes.
+    static bool patch(const QByteArray& base, const QByteArray& delta, QByteArray& target);
+
+    // a checksum of the base, carried in the delta so that a mismatched base is caught
+    static quint32 checksum(const QByteArray& data);
+};
+
+#endif // hifi_StringDelta_h
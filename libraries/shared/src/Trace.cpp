@@ -8,7 +8,10 @@
 
 #include "Trace.h"
 
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <unordered_map>
 
 #include <QtCore/QDebug>
 #include <QtCore/QCoreApplication>
@@ -39,19 +42,169 @@ bool tracing::enabled() {
     return DependencyManager::get<Tracer>()->isEnabled();
 }
 
+static const size_t EVENTS_PER_CHUNK = 1024;
+// about a million events per thread, past that events are dropped until the next serialize drains the buffer
+static const size_t MAX_CHUNKS_PER_THREAD = 1024;
+
+// Only the owning thread writes to a chunk, and it publishes each event by bumping count. Once a chunk is full the
+// owner links the next one and never touches the full chunk again, so the draining side can delete it.
+struct TraceChunk {
+    std::array<TraceEvent, EVENTS_PER_CHUNK> events;
+    std::atomic<size_t> count { 0 };
+    std::atomic<TraceChunk*> next { nullptr };
+};
+
+struct Tracer::ThreadBuffer {
+    ThreadBuffer() : tail(new TraceChunk()), head(tail) {}
+
+    ~ThreadBuffer() {
+        while (head) {
+            auto next = head->next.load(std::memory_order_relaxed);
+            delete head;
+            head = next;
+        }
+    }
+
+    // only called from the owning thread
+    void append(TraceEvent&& event) {
+        size_t count = tail->count.load(std::memory_order_relaxed);
+        if (count == EVENTS_PER_CHUNK) {
+            if (numChunks.load(std::memory_order_relaxed) >= MAX_CHUNKS_PER_THREAD) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            auto chunk = new TraceChunk();
+            numChunks.fetch_add(1, std::memory_order_relaxed);
+            tail->next.store(chunk, std::memory_order_release);
+            tail = chunk;
+            count = 0;
+        }
+
+        tail->events[count] = std::move(event);
+        tail->count.store(count + 1, std::memory_order_release);
+    }
+
+    // only called with _threadBuffersMutex held
+    void drain(std::vector<TraceEvent>& events) {
+        while (true) {
+            size_t count = head->count.load(std::memory_order_acquire);
+            for (size_t i = headConsumed; i < count; ++i) {
+                events.push_back(std::move(head->events[i]));
+            }
+            headConsumed = count;
+
+            auto next = head->next.load(std::memory_order_acquire);
+            if (count < EVENTS_PER_CHUNK || !next) {
+                break;
+            }
+
+            delete head;
+            numChunks.fetch_sub(1, std::memory_order_relaxed);
+            head = next;
+            headConsumed = 0;
+        }
+    }
+
+    TraceChunk* tail; // owning thread side
+    TraceChunk* head; // draining side
+    size_t headConsumed { 0 };
+
+    std::atomic<size_t> numChunks { 1 };
+    std::atomic<uint64_t> dropped { 0 };
+    std::atomic<bool> orphaned { false }; // set once the owning thread has exited
+};
+
+static std::atomic<uint64_t> nextTracerGeneration { 1 };
+
+Tracer::Tracer() :
+    _generation(nextTracerGeneration++)
+{
+}
+
+Tracer::~Tracer() {
+}
+
+Tracer::ThreadBuffer& Tracer::localBuffer() {
+    struct LocalThreadBuffer {
+        uint64_t generation { 0 };
+        std::shared_ptr<ThreadBuffer> buffer;
+
+        ~LocalThreadBuffer() {
+            if (buffer) {
+                buffer->orphaned.store(true, std::memory_order_release);
+            }
+        }
+    };
+    static thread_local LocalThreadBuffer local;
+
+    if (local.generation != _generation) {
+        // first event from this thread for this tracer
+        if (local.buffer) {
+            local.buffer->orphaned.store(true, std::memory_order_release);
+        }
+        local.buffer = std::make_shared<ThreadBuffer>();
+        local.generation = _generation;
+
+        std::lock_guard<std::mutex> guard(_threadBuffersMutex);
+        _threadBuffers.push_back(local.buffer);
+    }
+
+    return *local.buffer;
+}
+
+std::vector<TraceEvent> Tracer::takeEvents() {
+    std::vector<TraceEvent> events;
+    uint64_t dropped = 0;
+
+    {
+        std::lock_guard<std::mutex> guard(_threadBuffersMutex);
+        auto it = _threadBuffers.begin();
+        while (it != _threadBuffers.end()) {
+            auto& buffer = *it;
+
+            // check before draining so that every event of an exited thread has been seen when we let it go
+            bool orphaned = buffer->orphaned.load(std::memory_order_acquire);
+            buffer->drain(events);
+            dropped += buffer->dropped.exchange(0, std::memory_order_relaxed);
+
+            if (orphaned) {
+                it = _threadBuffers.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    if (dropped > 0) {
+        qWarning() << "Tracer dropped" << dropped << "events from threads that filled their trace buffers";
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(_metadataMutex);
+        events.insert(events.end(), _metadataEvents.begin(), _metadataEvents.end());
+    }
+
+    // each thread's events are already in order, this interleaves them
+    std::stable_sort(events.begin(), events.end(), [](const TraceEvent& a, const TraceEvent& b) {
+        return a.timestamp < b.timestamp;
+    });
+
+    return events;
+}
+
 void Tracer::startTracing() {
-    std::lock_guard<std::mutex> guard(_eventsMutex);
     if (_enabled) {
         qWarning() << "Tried to enable tracer, but already enabled";
         return;
     }
 
-    _events.clear();
+    // throw away anything left over from the last trace that was never serialized
+    takeEvents();
     _enabled = true;
 }
 
 void Tracer::stopTracing() {
-    std::lock_guard<std::mutex> guard(_eventsMutex);
     if (!_enabled) {
         qWarning() << "Cannot stop tracing, already disabled";
         return;
@@ -59,12 +212,14 @@ void Tracer::stopTracing() {
     _enabled = false;
 }
 
-void TraceEvent::writeJson(QTextStream& out) const {
+static void writeJsonEvent(QTextStream& out, const QString& id, const QString& name, const QString& categoryName,
+                           EventType type, qint64 timestamp, qint64 processID, qint64 threadID,
+                           const QVariantMap& args, const QVariantMap& extra) {
 #if 0
     // FIXME QJsonObject serialization is very slow, so we should be using manual JSON serialization
     out << "{";
     out << "\"name\":\"" << name << "\",";
-    out << "\"cat\":\"" << category.categoryName() << "\",";
+    out << "\"cat\":\"" << categoryName << "\",";
     out << "\"ph\":\"" << QString(type) << "\",";
     out << "\"ts\":\"" << timestamp << "\",";
     out << "\"pid\":\"" << processID << "\",";
@@ -82,7 +237,7 @@ void TraceEvent::writeJson(QTextStream& out) const {
 #else
     QJsonObject ev {
         { "name", QJsonValue(name) },
-        { "cat", category.categoryName() },
+        { "cat", categoryName },
         { "ph", QString(type) },
         { "ts", timestamp },
         { "pid", processID },
@@ -104,6 +259,214 @@ void TraceEvent::writeJson(QTextStream& out) const {
 #endif
 }
 
+void TraceEvent::writeJson(QTextStream& out) const {
+    writeJsonEvent(out, id, name, category->categoryName(), type, timestamp, processID, threadID, args, extra);
+}
+
+QByteArray Tracer::toJson(const std::vector<TraceEvent>& events) {
+    QByteArray data;
+    {
+        QTextStream out(&data);
+        out << "[\n";
+        bool first = true;
+        for (const auto& event : events) {
+            if (first) {
+                first = false;
+            } else {
+                out << ",\n";
+            }
+            event.writeJson(out);
+        }
+        out << "\n]";
+    }
+    return data;
+}
+
+// The binary format is the magic and version, a table of every distinct string (names, categories and ids),
+// a table of the process and thread ID pairs, then the events. Events refer to strings and threads by index
+// and store their timestamp as the delta from the previous event, all as variable length integers, so most
+// events that have no args take around a dozen bytes.
+static const quint32 BINARY_TRACE_MAGIC = 0x48465452; // "HFTR"
+static const quint32 BINARY_TRACE_VERSION = 1;
+
+enum BinaryEventFlags : quint8 {
+    HasArgs = 1,
+    HasExtra = 2
+};
+
+static void writeVarint(QDataStream& out, quint64 value) {
+    while (value >= 0x80) {
+        out << (quint8)((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    out << (quint8)value;
+}
+
+static bool readVarint(QDataStream& in, quint64& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        quint8 byte;
+        in >> byte;
+        if (in.status() != QDataStream::Ok) {
+            return false;
+        }
+        value |= (quint64)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+QByteArray Tracer::toBinary(const std::vector<TraceEvent>& events) {
+    QStringList strings { QString() };
+    QHash<QString, quint64> stringIndices { { QString(), 0 } };
+    auto indexOf = [&](const QString& string) {
+        auto it = stringIndices.find(string);
+        if (it == stringIndices.end()) {
+            it = stringIndices.insert(string, strings.size());
+            strings.push_back(string);
+        }
+        return it.value();
+    };
+
+    std::vector<std::pair<qint64, qint64>> threads;
+    std::unordered_map<qint64, quint64> threadIndices;
+
+    QByteArray eventData;
+    {
+        QDataStream out(&eventData, QIODevice::WriteOnly);
+        qint64 lastTimestamp = 0;
+
+        for (const auto& event : events) {
+            auto threadIt = threadIndices.find(event.threadID);
+            if (threadIt == threadIndices.end()) {
+                threadIt = threadIndices.emplace(event.threadID, threads.size()).first;
+                threads.emplace_back(event.processID, event.threadID);
+            }
+
+            quint8 flags = (event.args.empty() ? 0 : HasArgs) | (event.extra.empty() ? 0 : HasExtra);
+
+            out << (quint8)event.type << flags;
+            writeVarint(out, indexOf(event.name));
+            writeVarint(out, indexOf(event.category->categoryName()));
+            writeVarint(out, indexOf(event.id));
+            writeVarint(out, threadIt->second);
+            writeVarint(out, (quint64)(event.timestamp - lastTimestamp));
+            lastTimestamp = event.timestamp;
+
+            if (flags & HasArgs) {
+                out << event.args;
+            }
+            if (flags & HasExtra) {
+                out << event.extra;
+            }
+        }
+    }
+
+    QByteArray data;
+    {
+        QDataStream out(&data, QIODevice::WriteOnly);
+        out << BINARY_TRACE_MAGIC << BINARY_TRACE_VERSION;
+
+        writeVarint(out, strings.size());
+        for (const auto& string : strings) {
+            out << string;
+        }
+
+        writeVarint(out, threads.size());
+        for (const auto& thread : threads) {
+            out << thread.first << thread.second;
+        }
+
+        writeVarint(out, events.size());
+    }
+    data.append(eventData);
+    return data;
+}
+
+bool Tracer::binaryToJson(const QByteArray& binary, QByteArray& json) {
+    QDataStream in(binary);
+
+    quint32 magic, version;
+    in >> magic >> version;
+    if (in.status() != QDataStream::Ok || magic != BINARY_TRACE_MAGIC || version != BINARY_TRACE_VERSION) {
+        qWarning() << "Tracer::binaryToJson was not given a binary trace it can read";
+        return false;
+    }
+
+    quint64 numStrings;
+    if (!readVarint(in, numStrings)) {
+        return false;
+    }
+    QStringList strings;
+    for (quint64 i = 0; i < numStrings; ++i) {
+        QString string;
+        in >> string;
+        strings.push_back(string);
+    }
+
+    quint64 numThreads;
+    if (!readVarint(in, numThreads)) {
+        return false;
+    }
+    std::vector<std::pair<qint64, qint64>> threads;
+    for (quint64 i = 0; i < numThreads; ++i) {
+        qint64 processID, threadID;
+        in >> processID >> threadID;
+        threads.emplace_back(processID, threadID);
+    }
+
+    quint64 numEvents;
+    if (!readVarint(in, numEvents) || in.status() != QDataStream::Ok) {
+        return false;
+    }
+
+    json.clear();
+    QTextStream out(&json);
+    out << "[\n";
+
+    qint64 timestamp = 0;
+    for (quint64 i = 0; i < numEvents; ++i) {
+        quint8 type, flags;
+        quint64 nameIndex, categoryIndex, idIndex, threadIndex, timestampDelta;
+        in >> type >> flags;
+
+        if (!readVarint(in, nameIndex) || !readVarint(in, categoryIndex) || !readVarint(in, idIndex) ||
+            !readVarint(in, threadIndex) || !readVarint(in, timestampDelta)) {
+            return false;
+        }
+
+        if (nameIndex >= numStrings || categoryIndex >= numStrings || idIndex >= numStrings || threadIndex >= numThreads) {
+            qWarning() << "Tracer::binaryToJson found an event with an index out of range";
+            return false;
+        }
+
+        QVariantMap args, extra;
+        if (flags & HasArgs) {
+            in >> args;
+        }
+        if (flags & HasExtra) {
+            in >> extra;
+        }
+
+        if (in.status() != QDataStream::Ok) {
+            return false;
+        }
+
+        timestamp += (qint64)timestampDelta;
+
+        if (i > 0) {
+            out << ",\n";
+        }
+        writeJsonEvent(out, strings[(int)idIndex], strings[(int)nameIndex], strings[(int)categoryIndex], (EventType)type,
+                       timestamp, threads[threadIndex].first, threads[threadIndex].second, args, extra);
+    }
+
+    out << "\n]";
+    return true;
+}
+
 void Tracer::serialize(const QString& originalPath) {
 
     QString path = originalPath;
@@ -126,40 +489,20 @@ void Tracer::serialize(const QString& originalPath) {
         }
     }
 
-
-
-    std::list<TraceEvent> currentEvents;
-    {
-        std::lock_guard<std::mutex> guard(_eventsMutex);
-        currentEvents.swap(_events);
-        for (auto& event : _metadataEvents) {
-            currentEvents.push_back(event);
-        }
-    }
+    std::vector<TraceEvent> currentEvents = takeEvents();
 
     // If the file exists and we can't remove it, fail early
     if (QFileInfo(path).exists() && !QFile::remove(path)) {
         return;
     }
 
-    // If we can't open a temp file for writing, fail early
-    QByteArray data;
-    {
-        QTextStream out(&data);
-        out << "[\n";
-        bool first = true;
-        for (const auto& event : currentEvents) {
-            if (first) {
-                first = false;
-            } else {
-                out << ",\n";
-            }
-            event.writeJson(out);
-        }
-        out << "\n]";
-    }
+    bool compress = path.endsWith(".gz");
+    static const QString BINARY_TRACE_EXTENSION = ".htrace";
+    bool binary = (compress ? path.left(path.length() - 3) : path).endsWith(BINARY_TRACE_EXTENSION);
 
-    if (path.endsWith(".gz")) {
+    QByteArray data = binary ? toBinary(currentEvents) : toJson(currentEvents);
+
+    if (compress) {
         QByteArray compressed;
         gzip(data, compressed);
         data = compressed;
@@ -202,18 +545,14 @@ void Tracer::traceEvent(const QLoggingCategory& category,
     qint64 timestamp, qint64 processID, qint64 threadID,
     const QString& id,
     const QVariantMap& args, const QVariantMap& extra) {
-    std::lock_guard<std::mutex> guard(_eventsMutex);
 
     // We always want to store metadata events even if tracing is not enabled so that when
     // tracing is enabled we will be able to associate that metadata with that trace.
     // Metadata events should be used sparingly - as of 12/30/16 the Chrome Tracing
     // spec only supports thread+process metadata, so we should only expect to see metadata
     // events created when a new thread or process is created.
-    if (!_enabled && type != Metadata) {
-        return;
-    }
-
     if (type == Metadata) {
+        std::lock_guard<std::mutex> guard(_metadataMutex);
         _metadataEvents.push_back({
             id,
             name,
@@ -221,23 +560,28 @@ void Tracer::traceEvent(const QLoggingCategory& category,
             timestamp,
             processID,
             threadID,
-            category,
-            args,
-            extra
-        });
-    } else {
-        _events.push_back({
-            id,
-            name,
-            type,
-            timestamp,
-            processID,
-            threadID,
-            category,
+            &category,
             args,
             extra
         });
+        return;
+    }
+
+    if (!_enabled) {
+        return;
     }
+
+    localBuffer().append({
+        id,
+        name,
+        type,
+        timestamp,
+        processID,
+        threadID,
+        &category,
+        args,
+        extra
+    });
 }
 
 void Tracer::traceEvent(const QLoggingCategory& category, 
@@ -247,8 +591,9 @@ void Tracer::traceEvent(const QLoggingCategory& category,
         return;
     }
 
+    static const qint64 processID = QCoreApplication::applicationPid();
+
     auto timestamp = std::chrono::duration_cast<std::chrono::microseconds>(p_high_resolution_clock::now().time_since_epoch()).count();
-    auto processID = QCoreApplication::applicationPid();
     auto threadID = int64_t(QThread::currentThreadId());
 
     traceEvent(category, name, type, timestamp, processID, threadID, id, args, extra);
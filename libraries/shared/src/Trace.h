@@ -10,8 +10,12 @@
 #ifndef hifi_Trace_h
 #define hifi_Trace_h
 
+#include <atomic>
 #include <cstdint>
+#include <list>
+#include <memory>
 #include <mutex>
+#include <vector>
 
 #include <QtCore/QString>
 #include <QtCore/QVariantMap>
@@ -69,15 +73,24 @@ struct TraceEvent {
     qint64 timestamp;
     qint64 processID;
     qint64 threadID;
-    const QLoggingCategory& category;
+    const QLoggingCategory* category;
     QVariantMap args;
     QVariantMap extra;
 
     void writeJson(QTextStream& out) const;
 };
 
+// Events are appended without taking a lock to a buffer owned by the recording thread, made of preallocated
+// chunks that only that thread writes to. The buffers of all threads are drained and merged by timestamp when
+// the trace is serialized.
+//
+// serialize writes the Chrome tracing JSON format, or a compact binary format when the path ends in .htrace
+// (or .htrace.gz). binaryToJson turns a binary trace into the same JSON for viewing.
 class Tracer : public Dependency {
 public:
+    Tracer();
+    ~Tracer();
+
     void traceEvent(const QLoggingCategory& category, 
         const QString& name, EventType type,
         const QString& id = "", 
@@ -86,19 +99,33 @@ public:
     void startTracing();
     void stopTracing();
     void serialize(const QString& file);
-    bool isEnabled() const { return _enabled; }
+    bool isEnabled() const { return _enabled.load(std::memory_order_relaxed); }
+
+    static bool binaryToJson(const QByteArray& binary, QByteArray& json);
 
 private:
+    struct ThreadBuffer;
+
     void traceEvent(const QLoggingCategory& category, 
         const QString& name, EventType type,
         qint64 timestamp, qint64 processID, qint64 threadID,
         const QString& id = "",
         const QVariantMap& args = QVariantMap(), const QVariantMap& extra = QVariantMap());
 
-    bool _enabled { false };
-    std::list<TraceEvent> _events;
+    ThreadBuffer& localBuffer();
+    std::vector<TraceEvent> takeEvents();
+
+    static QByteArray toJson(const std::vector<TraceEvent>& events);
+    static QByteArray toBinary(const std::vector<TraceEvent>& events);
+
+    const uint64_t _generation; // lets a thread tell this tracer from an earlier one at the same address
+    std::atomic<bool> _enabled { false };
+
+    std::vector<std::shared_ptr<ThreadBuffer>> _threadBuffers;
+    std::mutex _threadBuffersMutex; // held to add a buffer and while draining, never while recording
+
     std::list<TraceEvent> _metadataEvents;
-    std::mutex _eventsMutex;
+    std::mutex _metadataMutex;
 };
 
 inline void traceEvent(const QLoggingCategory& category, const QString& name, EventType type, const QString& id = "", const QVariantMap& args = {}, const QVariantMap& extra = {}) {
@@ -12,6 +12,19 @@
 #include "GLMHelpers.h"
 #include "TriangleSet.h"
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+static const uint32_t MAX_LEAF_TRIANGLES = 4; // one TriangleBlock per leaf
+static const int NUM_SAH_BINS = 12;
+static const int MAX_TREE_DEPTH = 64;
+// past this depth nodes are split at the median instead, which bounds the depth for any input
+static const uint32_t MAX_SAH_DEPTH = 32;
+
+// node bounds are grown by this much so that rays grazing a triangle edge can't miss its leaf
+static const float NODE_PADDING_RATIO = 1.0e-5f;
+static const float MIN_NODE_PADDING = 1.0e-6f;
 
 void TriangleSet::insert(const Triangle& t) {
     _isBalanced = false;
@@ -27,26 +40,57 @@ void TriangleSet::clear() {
     _bounds.clear();
     _isBalanced = false;
 
-    _triangleOctree.clear();
+    _nodes.clear();
+    _blocks.clear();
 }
 
 bool TriangleSet::findRayIntersection(const glm::vec3& origin, const glm::vec3& direction,
-    float& distance, BoxFace& face, glm::vec3& surfaceNormal, bool precision, bool allowBackface) {
+    float& distance, BoxFace& face, glm::vec3& surfaceNormal, bool precision, bool allowBackface) const {
 
     // reset our distance to be the max possible, lower level tests will store best distance here
     distance = std::numeric_limits<float>::max();
 
-    if (!_isBalanced) {
-        balanceOctree();
+    if (_triangles.empty()) {
+        return false;
+    }
+
+    float boxDistance;
+    BoxFace boxFace;
+    glm::vec3 boxNormal;
+    if (!_bounds.findRayIntersection(origin, direction, boxDistance, boxFace, boxNormal)) {
+        return false;
+    }
+
+    if (!precision) {
+        distance = boxDistance;
+        face = boxFace;
+        surfaceNormal = boxNormal;
+        return true;
     }
 
     int trianglesTouched = 0;
-    auto result = _triangleOctree.findRayIntersection(origin, direction, distance, face, surfaceNormal, precision, trianglesTouched, allowBackface);
+    bool result = false;
+    if (_isBalanced) {
+        result = findRayIntersectionInTree(origin, direction, distance, surfaceNormal, allowBackface, trianglesTouched);
+    } else {
+        // nobody balanced us, fall back to testing every triangle rather than modifying a possibly shared set
+        for (const auto& triangle : _triangles) {
+            float thisTriangleDistance;
+            trianglesTouched++;
+            if (findRayTriangleIntersection(origin, direction, triangle, thisTriangleDistance, allowBackface) &&
+                    thisTriangleDistance < distance) {
+                distance = thisTriangleDistance;
+                surfaceNormal = triangle.getNormal();
+                result = true;
+            }
+        }
+    }
+    if (result) {
+        face = boxFace;
+    }
 
     #if WANT_DEBUGGING
-    if (precision) {
-        qDebug() << "trianglesTouched :" << trianglesTouched << "out of:" << _triangleOctree._population << "_triangles.size:" << _triangles.size();
-    }
+    qDebug() << "trianglesTouched :" << trianglesTouched << "out of:" << _triangles.size();
     #endif
     return result;
 }
@@ -72,194 +116,387 @@ void TriangleSet::debugDump() {
     qDebug() << __FUNCTION__;
     qDebug() << "bounds:" << getBounds();
     qDebug() << "triangles:" << size() << "at top level....";
-    qDebug() << "----- _triangleOctree -----";
-    _triangleOctree.debugDump();
+    qDebug() << "nodes:" << _nodes.size() << "blocks:" << _blocks.size() << "balanced:" << _isBalanced;
 }
 
-void TriangleSet::balanceOctree() {
-    _triangleOctree.reset(_bounds, 0);
-
-    // insert all the triangles
-    for (size_t i = 0; i < _triangles.size(); i++) {
-        _triangleOctree.insert(i);
-    }
+static float surfaceArea(const glm::vec3& minimum, const glm::vec3& maximum) {
+    glm::vec3 extent = glm::max(maximum - minimum, glm::vec3(0.0f));
+    return 2.0f * (extent.x * extent.y + extent.y * extent.z + extent.z * extent.x);
+}
 
+// Builds a bounding volume hierarchy with the surface area heuristic over binned triangle centroids. Nodes are
+// stored depth first in one array, and each leaf's triangles are packed into one TriangleBlock.
+void TriangleSet::balanceTree() {
+    _nodes.clear();
+    _blocks.clear();
     _isBalanced = true;
 
-    #if WANT_DEBUGGING
-    debugDump();
-    #endif
-}
+    const uint32_t numTriangles = (uint32_t)_triangles.size();
+    if (numTriangles == 0) {
+        return;
+    }
 
+    std::vector<glm::vec3> triangleMinimums(numTriangles);
+    std::vector<glm::vec3> triangleMaximums(numTriangles);
+    std::vector<glm::vec3> centroids(numTriangles);
+    std::vector<uint32_t> order(numTriangles);
+    for (uint32_t i = 0; i < numTriangles; i++) {
+        const Triangle& triangle = _triangles[i];
+        triangleMinimums[i] = glm::min(triangle.v0, glm::min(triangle.v1, triangle.v2));
+        triangleMaximums[i] = glm::max(triangle.v0, glm::max(triangle.v1, triangle.v2));
+        centroids[i] = (triangleMinimums[i] + triangleMaximums[i]) * 0.5f;
+        order[i] = i;
+    }
 
-// Determine of the given ray (origin/direction) in model space intersects with any triangles
-// in the set. If an intersection occurs, the distance and surface normal will be provided.
-bool TriangleSet::TriangleOctreeCell::findRayIntersectionInternal(const glm::vec3& origin, const glm::vec3& direction,
-            float& distance, BoxFace& face, glm::vec3& surfaceNormal, bool precision, int& trianglesTouched, bool allowBackface) {
+    _nodes.reserve(2 * (numTriangles / MAX_LEAF_TRIANGLES) + 1);
+    _blocks.reserve(numTriangles / MAX_LEAF_TRIANGLES + 1);
+
+    struct BuildTask {
+        uint32_t node;
+        uint32_t begin;
+        uint32_t end;
+        uint32_t depth;
+    };
+    std::vector<BuildTask> tasks;
+    _nodes.emplace_back();
+    tasks.push_back({ 0, 0, numTriangles, 0 });
+
+    while (!tasks.empty()) {
+        BuildTask task = tasks.back();
+        tasks.pop_back();
+
+        glm::vec3 minimum(std::numeric_limits<float>::max());
+        glm::vec3 maximum(-std::numeric_limits<float>::max());
+        glm::vec3 centroidMinimum(std::numeric_limits<float>::max());
+        glm::vec3 centroidMaximum(-std::numeric_limits<float>::max());
+        for (uint32_t i = task.begin; i < task.end; i++) {
+            uint32_t index = order[i];
+            minimum = glm::min(minimum, triangleMinimums[index]);
+            maximum = glm::max(maximum, triangleMaximums[index]);
+            centroidMinimum = glm::min(centroidMinimum, centroids[index]);
+            centroidMaximum = glm::max(centroidMaximum, centroids[index]);
+        }
+        glm::vec3 padding = (maximum - minimum) * NODE_PADDING_RATIO + glm::vec3(MIN_NODE_PADDING);
+        _nodes[task.node].minimum = minimum - padding;
+        _nodes[task.node].maximum = maximum + padding;
+
+        uint32_t count = task.end - task.begin;
+        if (count <= MAX_LEAF_TRIANGLES) {
+            TriangleBlock block;
+            memset(&block, 0, sizeof(TriangleBlock));
+            block.firstTriangle = task.begin;
+            for (uint32_t lane = 0; lane < count; lane++) {
+                const Triangle& triangle = _triangles[order[task.begin + lane]];
+                glm::vec3 firstSide = triangle.v0 - triangle.v1;
+                glm::vec3 secondSide = triangle.v2 - triangle.v1;
+                glm::vec3 normal = glm::cross(secondSide, firstSide);
+                for (int axis = 0; axis < 3; axis++) {
+                    block.v1[axis][lane] = triangle.v1[axis];
+                    block.firstSide[axis][lane] = firstSide[axis];
+                    block.secondSide[axis][lane] = secondSide[axis];
+                    block.normal[axis][lane] = normal[axis];
+                }
+                block.normalDotV1[lane] = glm::dot(normal, triangle.v1);
+            }
+            _nodes[task.node].leftChildOrBlock = (uint32_t)_blocks.size();
+            _nodes[task.node].triangleCount = count;
+            _blocks.push_back(block);
+            continue;
+        }
 
-    bool intersectedSomething = false;
-    float boxDistance = distance;
-    float bestDistance = distance;
+        // bin the centroids along the longest axis and pick the split with the lowest surface area cost
+        glm::vec3 centroidExtent = centroidMaximum - centroidMinimum;
+        int axis = 0;
+        if (centroidExtent.y > centroidExtent[axis]) {
+            axis = 1;
+        }
+        if (centroidExtent.z > centroidExtent[axis]) {
+            axis = 2;
+        }
 
-    if (_bounds.findRayIntersection(origin, direction, boxDistance, face, surfaceNormal)) {
+        uint32_t middle = task.begin + count / 2;
+        if (task.depth >= MAX_SAH_DEPTH) {
+            std::nth_element(order.begin() + task.begin, order.begin() + middle, order.begin() + task.end,
+                [&](uint32_t a, uint32_t b) { return centroids[a][axis] < centroids[b][axis]; });
+        } else if (centroidExtent[axis] > 0.0f) {
+            std::array<uint32_t, NUM_SAH_BINS> binCounts;
+            std::array<glm::vec3, NUM_SAH_BINS> binMinimums;
+            std::array<glm::vec3, NUM_SAH_BINS> binMaximums;
+            binCounts.fill(0);
+            binMinimums.fill(glm::vec3(std::numeric_limits<float>::max()));
+            binMaximums.fill(glm::vec3(-std::numeric_limits<float>::max()));
+
+            float binScale = (float)NUM_SAH_BINS / centroidExtent[axis];
+            auto binOf = [&](uint32_t index) {
+                int bin = (int)((centroids[index][axis] - centroidMinimum[axis]) * binScale);
+                return std::min(std::max(bin, 0), NUM_SAH_BINS - 1);
+            };
+            for (uint32_t i = task.begin; i < task.end; i++) {
+                uint32_t index = order[i];
+                int bin = binOf(index);
+                binCounts[bin]++;
+                binMinimums[bin] = glm::min(binMinimums[bin], triangleMinimums[index]);
+                binMaximums[bin] = glm::max(binMaximums[bin], triangleMaximums[index]);
+            }
 
-        // if our bounding box intersects at a distance greater than the current known
-        // best distance, than we can safely not check any of our triangles
-        if (boxDistance > bestDistance) {
-            return false;
-        }
+            // sweep from the right to know the cost of everything above each split
+            std::array<float, NUM_SAH_BINS> rightCosts;
+            glm::vec3 rightMinimum(std::numeric_limits<float>::max());
+            glm::vec3 rightMaximum(-std::numeric_limits<float>::max());
+            uint32_t rightCount = 0;
+            for (int bin = NUM_SAH_BINS - 1; bin > 0; bin--) {
+                rightCount += binCounts[bin];
+                rightMinimum = glm::min(rightMinimum, binMinimums[bin]);
+                rightMaximum = glm::max(rightMaximum, binMaximums[bin]);
+                rightCosts[bin] = rightCount > 0 ? rightCount * surfaceArea(rightMinimum, rightMaximum) : 0.0f;
+            }
 
-        if (precision) {
-            for (const auto& triangleIndex : _triangleIndices) {
-                const auto& triangle = _allTriangles[triangleIndex];
-                float thisTriangleDistance;
-                trianglesTouched++;
-                if (findRayTriangleIntersection(origin, direction, triangle, thisTriangleDistance, allowBackface)) {
-                    if (thisTriangleDistance < bestDistance) {
-                        bestDistance = thisTriangleDistance;
-                        intersectedSomething = true;
-                        surfaceNormal = triangle.getNormal();
-                        distance = bestDistance;
-                    }
+            glm::vec3 leftMinimum(std::numeric_limits<float>::max());
+            glm::vec3 leftMaximum(-std::numeric_limits<float>::max());
+            uint32_t leftCount = 0;
+            float bestCost = std::numeric_limits<float>::max();
+            int bestSplit = -1;
+            for (int bin = 0; bin < NUM_SAH_BINS - 1; bin++) {
+                leftCount += binCounts[bin];
+                leftMinimum = glm::min(leftMinimum, binMinimums[bin]);
+                leftMaximum = glm::max(leftMaximum, binMaximums[bin]);
+                if (leftCount == 0 || leftCount == count) {
+                    continue;
+                }
+                float cost = leftCount * surfaceArea(leftMinimum, leftMaximum) + rightCosts[bin + 1];
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestSplit = bin;
                 }
             }
-        } else {
-            intersectedSomething = true;
-            distance = boxDistance;
-        }
-    }
 
-    return intersectedSomething;
-}
+            if (bestSplit >= 0) {
+                auto split = std::partition(order.begin() + task.begin, order.begin() + task.end,
+                    [&](uint32_t index) { return binOf(index) <= bestSplit; });
+                middle = (uint32_t)(split - order.begin());
+            }
+        }
+        if (middle == task.begin || middle == task.end) {
+            // the centroids are all in one spot, any even split is as good as another
+            middle = task.begin + count / 2;
+        }
 
-static const int MAX_DEPTH = 4; // for now
-static const int MAX_CHILDREN = 8;
+        uint32_t leftChild = (uint32_t)_nodes.size();
+        _nodes.emplace_back();
+        _nodes.emplace_back();
+        _nodes[task.node].leftChildOrBlock = leftChild;
+        _nodes[task.node].triangleCount = 0;
+        tasks.push_back({ leftChild + 1, middle, task.end, task.depth + 1 });
+        tasks.push_back({ leftChild, task.begin, middle, task.depth + 1 });
+    }
 
-TriangleSet::TriangleOctreeCell::TriangleOctreeCell(std::vector<Triangle>& allTriangles, const AABox& bounds, int depth) :
-    _allTriangles(allTriangles)
-{
-    reset(bounds, depth);
-}
+    // store the triangles in leaf order, so each block's firstTriangle indexes straight into them
+    std::vector<Triangle> sortedTriangles;
+    sortedTriangles.reserve(numTriangles);
+    for (uint32_t index : order) {
+        sortedTriangles.push_back(_triangles[index]);
+    }
+    _triangles.swap(sortedTriangles);
 
-void TriangleSet::TriangleOctreeCell::clear() {
-    _population = 0;
-    _triangleIndices.clear();
-    _bounds.clear();
-    _children.clear();
+    #if WANT_DEBUGGING
+    debugDump();
+    #endif
 }
 
-void TriangleSet::TriangleOctreeCell::reset(const AABox& bounds, int depth) {
-    clear();
-    _bounds = bounds;
-    _depth = depth;
+static bool findRayNodeIntersection(const glm::vec3& origin, const glm::vec3& inverseDirection,
+        const glm::vec3& minimum, const glm::vec3& maximum, float& entryDistance) {
+    glm::vec3 t0 = (minimum - origin) * inverseDirection;
+    glm::vec3 t1 = (maximum - origin) * inverseDirection;
+    glm::vec3 nearest = glm::min(t0, t1);
+    glm::vec3 farthest = glm::max(t0, t1);
+    entryDistance = std::max(std::max(nearest.x, nearest.y), std::max(nearest.z, 0.0f));
+    float exitDistance = std::min(std::min(farthest.x, farthest.y), farthest.z);
+    return exitDistance >= entryDistance;
 }
 
-void TriangleSet::TriangleOctreeCell::debugDump() {
-    qDebug() << __FUNCTION__;
-    qDebug() << "bounds:" << getBounds();
-    qDebug() << "depth:" << _depth;
-    qDebug() << "population:" << _population << "this level or below" 
-             << " ---- triangleIndices:" << _triangleIndices.size() << "in this cell";
-
-    qDebug() << "child cells:" << _children.size();
-    if (_depth < MAX_DEPTH) {
-        int childNum = 0;
-        for (auto& child : _children) {
-            qDebug() << "child:" << childNum;
-            child.second.debugDump();
-            childNum++;
+bool TriangleSet::findRayIntersectionInTree(const glm::vec3& origin, const glm::vec3& direction,
+        float& distance, glm::vec3& surfaceNormal, bool allowBackface, int& trianglesTouched) const {
+    // keep the reciprocal finite, so the slab test never sees 0 * inf
+    const float MIN_DIRECTION_COMPONENT = 1.0e-20f;
+    glm::vec3 inverseDirection;
+    for (int axis = 0; axis < 3; axis++) {
+        float component = direction[axis];
+        if (fabsf(component) < MIN_DIRECTION_COMPONENT) {
+            component = component < 0.0f ? -MIN_DIRECTION_COMPONENT : MIN_DIRECTION_COMPONENT;
         }
+        inverseDirection[axis] = 1.0f / component;
     }
-}
 
-void TriangleSet::TriangleOctreeCell::insert(size_t triangleIndex) {
-    const Triangle& triangle = _allTriangles[triangleIndex];
-    _population++;
-    // if we're not yet at the max depth, then check which child the triangle fits in
-    if (_depth < MAX_DEPTH) {
-
-        for (int child = 0; child < MAX_CHILDREN; child++) {
-            AABox childBounds = getBounds().getOctreeChild((AABox::OctreeChild)child);
-
-
-            // if the child AABox would contain the triangle...
-            if (childBounds.contains(triangle)) {
-                // if the child cell doesn't yet exist, create it...
-                if (_children.find((AABox::OctreeChild)child) == _children.end()) {
-                    _children.insert(
-                        std::pair<AABox::OctreeChild, TriangleOctreeCell>
-                        ((AABox::OctreeChild)child, TriangleOctreeCell(_allTriangles, childBounds, _depth + 1)));
-                }
+    bool intersects = false;
+    uint32_t stack[MAX_TREE_DEPTH];
+    int stackSize = 0;
+    float entryDistance;
+    if (!findRayNodeIntersection(origin, inverseDirection, _nodes[0].minimum, _nodes[0].maximum, entryDistance)) {
+        return false;
+    }
+    stack[stackSize++] = 0;
+
+    while (stackSize > 0) {
+        const Node& node = _nodes[stack[--stackSize]];
+
+        if (node.isLeaf()) {
+            float blockDistance = distance;
+            int lane;
+            trianglesTouched += node.triangleCount;
+            if (findRayIntersectionInBlock(origin, direction, node.leftChildOrBlock, blockDistance, lane, allowBackface)) {
+                distance = blockDistance;
+                surfaceNormal = _triangles[_blocks[node.leftChildOrBlock].firstTriangle + lane].getNormal();
+                intersects = true;
+            }
+            continue;
+        }
 
-                // insert the triangleIndex in the child cell
-                _children.at((AABox::OctreeChild)child).insert(triangleIndex);
-                return;
+        // visit the nearer child first, and skip any child that starts beyond our best hit so far
+        uint32_t left = node.leftChildOrBlock;
+        uint32_t right = left + 1;
+        float leftDistance;
+        float rightDistance;
+        bool hitsLeft = findRayNodeIntersection(origin, inverseDirection, _nodes[left].minimum, _nodes[left].maximum,
+            leftDistance) && leftDistance <= distance;
+        bool hitsRight = findRayNodeIntersection(origin, inverseDirection, _nodes[right].minimum, _nodes[right].maximum,
+            rightDistance) && rightDistance <= distance;
+
+        if (hitsLeft && hitsRight) {
+            if (leftDistance > rightDistance) {
+                std::swap(left, right);
             }
+            if (stackSize + 2 > MAX_TREE_DEPTH) {
+                continue;
+            }
+            stack[stackSize++] = right;
+            stack[stackSize++] = left;
+        } else if ((hitsLeft || hitsRight) && stackSize < MAX_TREE_DEPTH) {
+            stack[stackSize++] = hitsLeft ? left : right;
         }
     }
-    // either we're at max depth, or the triangle doesn't fit in one of our
-    // children and so we want to just record it here
-    _triangleIndices.push_back(triangleIndex);
+    return intersects;
 }
 
-bool TriangleSet::TriangleOctreeCell::findRayIntersection(const glm::vec3& origin, const glm::vec3& direction,
-                float& distance, BoxFace& face, glm::vec3& surfaceNormal, bool precision, int& trianglesTouched, bool allowBackface) {
+//
+// on x86 architecture, assume that SSE2 is present
+//
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
 
-    if (_population < 1) {
-        return false; // no triangles below here, so we can't intersect
-    }
+#include <emmintrin.h>
 
-    float bestLocalDistance = distance;
-    BoxFace bestLocalFace;
-    glm::vec3 bestLocalNormal;
-    bool intersects = false;
+// a, b and the result are 3 component vectors stored as one __m128 per component
+static inline __m128 dotCross(const __m128 n[3], const __m128 a[3], const __m128 b[3]) {
+    __m128 crossX = _mm_sub_ps(_mm_mul_ps(a[1], b[2]), _mm_mul_ps(a[2], b[1]));
+    __m128 crossY = _mm_sub_ps(_mm_mul_ps(a[2], b[0]), _mm_mul_ps(a[0], b[2]));
+    __m128 crossZ = _mm_sub_ps(_mm_mul_ps(a[0], b[1]), _mm_mul_ps(a[1], b[0]));
+    return _mm_add_ps(_mm_add_ps(_mm_mul_ps(n[0], crossX), _mm_mul_ps(n[1], crossY)), _mm_mul_ps(n[2], crossZ));
+}
 
-    // if the ray intersects our bounding box, then continue
-    if (getBounds().findRayIntersection(origin, direction, bestLocalDistance, bestLocalFace, bestLocalNormal)) {
+// Same test as findRayTriangleIntersection(), for the four triangles of a block at once.
+bool TriangleSet::findRayIntersectionInBlock(const glm::vec3& origin, const glm::vec3& direction, uint32_t blockIndex,
+        float& distance, int& lane, bool allowBackface) const {
+    const TriangleBlock& block = _blocks[blockIndex];
+    const __m128 zero = _mm_setzero_ps();
+
+    __m128 normal[3];
+    __m128 v1[3];
+    __m128 firstSide[3];
+    __m128 secondSide[3];
+    for (int axis = 0; axis < 3; axis++) {
+        normal[axis] = _mm_loadu_ps(block.normal[axis]);
+        v1[axis] = _mm_loadu_ps(block.v1[axis]);
+        firstSide[axis] = _mm_loadu_ps(block.firstSide[axis]);
+        secondSide[axis] = _mm_loadu_ps(block.secondSide[axis]);
+    }
+    __m128 originX = _mm_set1_ps(origin.x);
+    __m128 originY = _mm_set1_ps(origin.y);
+    __m128 originZ = _mm_set1_ps(origin.z);
+    __m128 directionX = _mm_set1_ps(direction.x);
+    __m128 directionY = _mm_set1_ps(direction.y);
+    __m128 directionZ = _mm_set1_ps(direction.z);
+
+    __m128 originDotNormal = _mm_add_ps(_mm_add_ps(_mm_mul_ps(originX, normal[0]), _mm_mul_ps(originY, normal[1])),
+        _mm_mul_ps(originZ, normal[2]));
+    __m128 dividend = _mm_sub_ps(_mm_loadu_ps(block.normalDotV1), originDotNormal);
+    __m128 divisor = _mm_add_ps(_mm_add_ps(_mm_mul_ps(normal[0], directionX), _mm_mul_ps(normal[1], directionY)),
+        _mm_mul_ps(normal[2], directionZ));
+
+    // degenerate (unused) lanes have a zero normal and fail here
+    __m128 valid = _mm_cmplt_ps(divisor, zero);
+    if (!allowBackface) {
+        valid = _mm_and_ps(valid, _mm_cmple_ps(dividend, zero));
+    }
+    if (_mm_movemask_ps(valid) == 0) {
+        return false;
+    }
 
-        // if the intersection with our bounding box, is greater than the current best distance (the distance passed in)
-        // then we know that none of our triangles can represent a better intersection and we can return
+    __m128 t = _mm_div_ps(dividend, divisor);
+    valid = _mm_and_ps(valid, _mm_cmplt_ps(t, _mm_set1_ps(distance)));
+
+    __m128 fromV1[3];
+    fromV1[0] = _mm_sub_ps(_mm_add_ps(originX, _mm_mul_ps(directionX, t)), v1[0]);
+    fromV1[1] = _mm_sub_ps(_mm_add_ps(originY, _mm_mul_ps(directionY, t)), v1[1]);
+    fromV1[2] = _mm_sub_ps(_mm_add_ps(originZ, _mm_mul_ps(directionZ, t)), v1[2]);
+    valid = _mm_and_ps(valid, _mm_cmpgt_ps(dotCross(normal, fromV1, firstSide), zero));
+    valid = _mm_and_ps(valid, _mm_cmpgt_ps(dotCross(normal, secondSide, fromV1), zero));
+
+    __m128 fromV0[3];
+    __m128 thirdSide[3];
+    for (int axis = 0; axis < 3; axis++) {
+        fromV0[axis] = _mm_sub_ps(fromV1[axis], firstSide[axis]);
+        thirdSide[axis] = _mm_sub_ps(secondSide[axis], firstSide[axis]);
+    }
+    valid = _mm_and_ps(valid, _mm_cmpgt_ps(dotCross(normal, fromV0, thirdSide), zero));
 
-        if (bestLocalDistance > distance) {
-            return false;
+    int mask = _mm_movemask_ps(valid);
+    if (mask == 0) {
+        return false;
+    }
+    float distances[4];
+    _mm_storeu_ps(distances, t);
+    for (int i = 0; i < 4; i++) {
+        if ((mask & (1 << i)) && distances[i] < distance) {
+            distance = distances[i];
+            lane = i;
         }
+    }
+    return true;
+}
 
-        bestLocalDistance = distance;
-
-        float childDistance = distance;
-        BoxFace childFace;
-        glm::vec3 childNormal;
-
-        // if we're not yet at the max depth, then check which child the triangle fits in
-        if (_depth < MAX_DEPTH) {
-            for (auto& child : _children) {
-                // check each child, if there's an intersection, it will return some distance that we need
-                // to compare against the other results, because there might be multiple intersections and
-                // we will always choose the best (shortest) intersection
-                if (child.second.findRayIntersection(origin, direction, childDistance, childFace, childNormal, precision, trianglesTouched)) {
-                    if (childDistance < bestLocalDistance) {
-                        bestLocalDistance = childDistance;
-                        bestLocalFace = childFace;
-                        bestLocalNormal = childNormal;
-                        intersects = true;
-                    }
-                }
-            }
+#else
+
+bool TriangleSet::findRayIntersectionInBlock(const glm::vec3& origin, const glm::vec3& direction, uint32_t blockIndex,
+        float& distance, int& lane, bool allowBackface) const {
+    const TriangleBlock& block = _blocks[blockIndex];
+    bool intersects = false;
+    for (int i = 0; i < 4; i++) {
+        glm::vec3 normal(block.normal[0][i], block.normal[1][i], block.normal[2][i]);
+        glm::vec3 v1(block.v1[0][i], block.v1[1][i], block.v1[2][i]);
+        glm::vec3 firstSide(block.firstSide[0][i], block.firstSide[1][i], block.firstSide[2][i]);
+        glm::vec3 secondSide(block.secondSide[0][i], block.secondSide[1][i], block.secondSide[2][i]);
+
+        float dividend = block.normalDotV1[i] - glm::dot(origin, normal);
+        if (!allowBackface && dividend > 0.0f) {
+            continue;
         }
-        // also check our local triangle set
-        if (findRayIntersectionInternal(origin, direction, childDistance, childFace, childNormal, precision, trianglesTouched, allowBackface)) {
-            if (childDistance < bestLocalDistance) {
-                bestLocalDistance = childDistance;
-                bestLocalFace = childFace;
-                bestLocalNormal = childNormal;
-                intersects = true;
-            }
+        float divisor = glm::dot(normal, direction);
+        if (divisor >= 0.0f) {
+            continue;
+        }
+        float t = dividend / divisor;
+        if (t >= distance) {
+            continue;
+        }
+        glm::vec3 fromV1 = origin + direction * t - v1;
+        if (glm::dot(normal, glm::cross(fromV1, firstSide)) > 0.0f &&
+                glm::dot(normal, glm::cross(secondSide, fromV1)) > 0.0f &&
+                glm::dot(normal, glm::cross(fromV1 - firstSide, secondSide - firstSide)) > 0.0f) {
+            distance = t;
+            lane = i;
+            intersects = true;
         }
-    }
-    if (intersects) {
-        distance = bestLocalDistance;
-        face = bestLocalFace;
-        surfaceNormal = bestLocalNormal;
     }
     return intersects;
 }
+
+#endif
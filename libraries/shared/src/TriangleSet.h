@@ -9,6 +9,10 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#ifndef hifi_TriangleSet_h
+#define hifi_TriangleSet_h
+
+#include <stdint.h>
 #include <vector>
 
 #include "AABox.h"
@@ -16,74 +20,66 @@
 
 class TriangleSet {
 
-    class TriangleOctreeCell {
+    // A node of the flattened bounding volume hierarchy. Interior nodes keep their two children next to each other,
+    // leaves point at one block of up to four triangles.
+    class Node {
     public:
-        TriangleOctreeCell(std::vector<Triangle>& allTriangles) :
-            _allTriangles(allTriangles)
-        { }
-
-        void insert(size_t triangleIndex);
-        void reset(const AABox& bounds, int depth = 0);
-        void clear();
-
-        bool findRayIntersection(const glm::vec3& origin, const glm::vec3& direction,
-            float& distance, BoxFace& face, glm::vec3& surfaceNormal, bool precision, int& trianglesTouched, bool allowBackface = false);
-
-        const AABox& getBounds() const { return _bounds; }
-
-        void debugDump();
-
-    protected:
-        TriangleOctreeCell(std::vector<Triangle>& allTriangles, const AABox& bounds, int depth);
-
-        // checks our internal list of triangles
-        bool findRayIntersectionInternal(const glm::vec3& origin, const glm::vec3& direction,
-            float& distance, BoxFace& face, glm::vec3& surfaceNormal, bool precision, int& trianglesTouched, bool allowBackface = false);
+        glm::vec3 minimum;
+        uint32_t leftChildOrBlock { 0 };
+        glm::vec3 maximum;
+        uint32_t triangleCount { 0 }; // zero for interior nodes
 
-        std::vector<Triangle>& _allTriangles;
-        std::map<AABox::OctreeChild, TriangleOctreeCell> _children;
-        int _depth{ 0 };
-        int _population{ 0 };
-        AABox _bounds;
-        std::vector<size_t> _triangleIndices;
+        bool isLeaf() const { return triangleCount > 0; }
+    };
 
-        friend class TriangleSet;
+    // Four triangles in structure-of-arrays form, so they can be tested against a ray together. Unused lanes are
+    // degenerate and never intersect.
+    class TriangleBlock {
+    public:
+        float v1[3][4];
+        float firstSide[3][4];
+        float secondSide[3][4];
+        float normal[3][4];
+        float normalDotV1[4];
+        uint32_t firstTriangle;
     };
 
 public:
-    TriangleSet() :
-        _triangleOctree(_triangles)
-    {}
-
     void debugDump();
 
     void insert(const Triangle& t);
 
+    // Determine if the given ray (origin/direction) in model space intersects with any triangles in the set. If an
+    // intersection occurs, the distance and surface normal will be provided. Without precision only the bounds of
+    // the set are tested. Call balanceTree() before sharing the set between threads.
     bool findRayIntersection(const glm::vec3& origin, const glm::vec3& direction,
-        float& distance, BoxFace& face, glm::vec3& surfaceNormal, bool precision, bool allowBackface = false);
+        float& distance, BoxFace& face, glm::vec3& surfaceNormal, bool precision, bool allowBackface = false) const;
 
-    void balanceOctree();
+    // builds the hierarchy used by findRayIntersection(), the triangles may be reordered
+    void balanceTree();
+    bool isBalanced() const { return _isBalanced; }
 
     void reserve(size_t size) { _triangles.reserve(size); } // reserve space in the datastructure for size number of triangles
     size_t size() const { return _triangles.size(); }
     void clear();
 
-    // Determine if the given ray (origin/direction) in model space intersects with any triangles in the set. If an 
-    // intersection occurs, the distance and surface normal will be provided.
-    // note: this might side-effect internal structures
-    bool findRayIntersection(const glm::vec3& origin, const glm::vec3& direction,
-        float& distance, BoxFace& face, glm::vec3& surfaceNormal, bool precision, int& trianglesTouched);
-
     // Determine if a point is "inside" all the triangles of a convex hull. It is the responsibility of the caller to
-    // determine that the triangle set is indeed a convex hull. If the triangles added to this set are not in fact a 
+    // determine that the triangle set is indeed a convex hull. If the triangles added to this set are not in fact a
     // convex hull, the result of this method is meaningless and undetermined.
     bool convexHullContains(const glm::vec3& point) const;
     const AABox& getBounds() const { return _bounds; }
 
 protected:
+    bool findRayIntersectionInTree(const glm::vec3& origin, const glm::vec3& direction,
+        float& distance, glm::vec3& surfaceNormal, bool allowBackface, int& trianglesTouched) const;
+    bool findRayIntersectionInBlock(const glm::vec3& origin, const glm::vec3& direction, uint32_t blockIndex,
+        float& distance, int& lane, bool allowBackface) const;
 
     bool _isBalanced{ false };
-    TriangleOctreeCell _triangleOctree;
     std::vector<Triangle> _triangles;
+    std::vector<Node> _nodes;
+    std::vector<TriangleBlock> _blocks;
     AABox _bounds;
 };
+
+#endif // hifi_TriangleSet_h
@@ -0,0 +1,80 @@
+//
+//  VoxelChunkGrid.cpp
+//  libraries/shared/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "VoxelChunkGrid.h"
+
+const int VoxelChunkGrid::CHUNK_SIZE;
+
+static int numChunksAlong(int volumeSize) {
+    if (volumeSize <= 0) {
+        return 0;
+    }
+    // a volume of n voxels has n - 1 cells, but even a single voxel gets a chunk
+    int numCells = volumeSize - 1;
+    return glm::max(1, (numCells + VoxelChunkGrid::CHUNK_SIZE - 1) / VoxelChunkGrid::CHUNK_SIZE);
+}
+
+void VoxelChunkGrid::resize(const glm::ivec3& volumeSize) {
+    _volumeSize = volumeSize;
+    _numChunks = glm::ivec3(numChunksAlong(volumeSize.x), numChunksAlong(volumeSize.y), numChunksAlong(volumeSize.z));
+    _dirty.assign(_numChunks.x * _numChunks.y * _numChunks.z, true);
+    _numDirty = (int)_dirty.size();
+}
+
+glm::ivec3 VoxelChunkGrid::getChunkLow(int chunk) const {
+    glm::ivec3 chunkCoords(chunk % _numChunks.x, (chunk / _numChunks.x) % _numChunks.y, chunk / (_numChunks.x * _numChunks.y));
+    return chunkCoords * CHUNK_SIZE;
+}
+
+glm::ivec3 VoxelChunkGrid::getChunkHigh(int chunk) const {
+    return glm::max(glm::min(getChunkLow(chunk) + CHUNK_SIZE, _volumeSize - 1), glm::ivec3(0));
+}
+
+void VoxelChunkGrid::markVoxelDirty(const glm::ivec3& voxel) {
+    if (_numDirty == (int)_dirty.size()) {
+        return;
+    }
+
+    // chunk c covers voxels c * CHUNK_SIZE through (c + 1) * CHUNK_SIZE, find the ones that touch voxel +/- 1
+    glm::ivec3 low = glm::max(voxel - 1, glm::ivec3(0));
+    glm::ivec3 lowChunk = glm::max((low + CHUNK_SIZE - 1) / CHUNK_SIZE - 1, glm::ivec3(0));
+    glm::ivec3 highChunk = glm::min((voxel + 1) / CHUNK_SIZE, _numChunks - 1);
+
+    glm::ivec3 chunkCoords;
+    for (chunkCoords.z = lowChunk.z; chunkCoords.z <= highChunk.z; chunkCoords.z++) {
+        for (chunkCoords.y = lowChunk.y; chunkCoords.y <= highChunk.y; chunkCoords.y++) {
+            for (chunkCoords.x = lowChunk.x; chunkCoords.x <= highChunk.x; chunkCoords.x++) {
+                int chunk = chunkCoords.x + _numChunks.x * (chunkCoords.y + _numChunks.y * chunkCoords.z);
+                if (!_dirty[chunk]) {
+                    _dirty[chunk] = true;
+                    _numDirty++;
+                }
+            }
+        }
+    }
+}
+
+void VoxelChunkGrid::markAllDirty() {
+    _dirty.assign(_dirty.size(), true);
+    _numDirty = (int)_dirty.size();
+}
+
+std::vector<int> VoxelChunkGrid::takeDirtyChunks() {
+    std::vector<int> dirtyChunks;
+    dirtyChunks.reserve(_numDirty);
+    for (int chunk = 0; chunk < (int)_dirty.size(); chunk++) {
+        if (_dirty[chunk]) {
+            dirtyChunks.push_back(chunk);
+            _dirty[chunk] = false;
+        }
+    }
+    _numDirty = 0;
+    return dirtyChunks;
+}
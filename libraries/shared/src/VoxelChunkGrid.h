@@ -0,0 +1,55 @@
+//
+//  VoxelChunkGrid.h
+//  libraries/shared/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Splits a volume of voxels into cubic chunks that can be meshed independently, and keeps track of the ones
+//  whose mesh is out of date.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_VoxelChunkGrid_h
+#define hifi_VoxelChunkGrid_h
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+class VoxelChunkGrid {
+public:
+    // the number of cells along each side of a chunk
+    static const int CHUNK_SIZE = 16;
+
+    // Sets the number of voxels along each axis and marks every chunk dirty. Neighboring chunks share the
+    // voxels on the face between them, so the cells of the volume are covered without gaps.
+    void resize(const glm::ivec3& volumeSize);
+    const glm::ivec3& getVolumeSize() const { return _volumeSize; }
+
+    int getNumChunks() const { return (int)_dirty.size(); }
+
+    // the corners of the chunk, both inclusive
+    glm::ivec3 getChunkLow(int chunk) const;
+    glm::ivec3 getChunkHigh(int chunk) const;
+
+    // Marks every chunk whose mesh can depend on the voxel. That includes the chunks within one voxel of it,
+    // since marching cubes samples the neighbors of a voxel for its normals.
+    void markVoxelDirty(const glm::ivec3& voxel);
+    void markAllDirty();
+
+    bool isDirty(int chunk) const { return _dirty[chunk]; }
+    int getNumDirtyChunks() const { return _numDirty; }
+
+    // returns the dirty chunks and marks them clean
+    std::vector<int> takeDirtyChunks();
+
+private:
+    glm::ivec3 _volumeSize { 0 };
+    glm::ivec3 _numChunks { 0 };
+    std::vector<bool> _dirty;
+    int _numDirty { 0 };
+};
+
+#endif // hifi_VoxelChunkGrid_h
@@ -0,0 +1,106 @@
+//
+//  priorityLoadTest.js
+//  scripts/developer/tests/scriptableResource
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Spawns a ring of model entities at increasing distances, half of them behind the avatar, and reports how long
+//  it takes until the closest one is usable and until all of them are. Every run uses fresh urls so nothing comes
+//  out of the http cache.
+//
+//  Serve any model from a local folder to stand in for the asset server, e.g.
+//      cd <folder with model.fbx> && python -m SimpleHTTPServer 8000
+//  and compare runs with different --concurrent-downloads / --concurrent-decodes values.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+var BASE_URL = "http://localhost:8000/";
+var MODEL_FILE = "model.fbx";
+var NUM_MODELS = 100;
+var MIN_DISTANCE = 2; // meters
+var MAX_DISTANCE = 100; // meters
+var MODEL_SIZE = 1; // meters
+
+var entities = [];
+var resources = [];
+var startTime = Date.now();
+var runID = startTime.toString();
+
+function getModelURL(index) {
+    return BASE_URL + MODEL_FILE + "?run=" + runID + "&model=" + index;
+}
+
+function spawn() {
+    var yaw = MyAvatar.bodyYaw * Math.PI / 180;
+    for (var i = 0; i < NUM_MODELS; ++i) {
+        // index 0 is the closest and straight ahead, the others alternate between in front and behind
+        var distance = MIN_DISTANCE + (MAX_DISTANCE - MIN_DISTANCE) * i / NUM_MODELS;
+        var angle = yaw + ((i % 2 === 0) ? 0 : Math.PI) + (Math.random() - 0.5) * Math.PI / 4;
+        var position = Vec3.sum(MyAvatar.position, {
+            x: -distance * Math.sin(angle),
+            y: 0.5,
+            z: -distance * Math.cos(angle)
+        });
+        entities.push(Entities.addEntity({
+            name: "priorityLoadTest model " + i,
+            type: "Model",
+            modelURL: getModelURL(i),
+            position: position,
+            dimensions: { x: MODEL_SIZE, y: MODEL_SIZE, z: MODEL_SIZE }
+        }));
+    }
+}
+
+function watch() {
+    var numLoading = NUM_MODELS;
+    var reportedFirst = false;
+
+    function watchResource(index) {
+        // the entity renderer has already created the resource, this only observes it
+        var resource = ModelCache.prefetch(getModelURL(index));
+        resources.push(resource);
+
+        function onStateChanged(state) {
+            if (state !== Resource.State.FINISHED && state !== Resource.State.FAILED) {
+                return;
+            }
+            resource.stateChanged.disconnect(onStateChanged);
+            var elapsed = Date.now() - startTime;
+            if (index === 0 && !reportedFirst) {
+                reportedFirst = true;
+                print("priorityLoadTest: closest model " + (state === Resource.State.FINISHED ? "usable" : "failed") +
+                      " after " + elapsed + " ms");
+            }
+            if (--numLoading === 0) {
+                print("priorityLoadTest: all " + NUM_MODELS + " models done after " + elapsed + " ms");
+            }
+        }
+
+        if (resource.state === Resource.State.FINISHED || resource.state === Resource.State.FAILED) {
+            onStateChanged(resource.state);
+        } else {
+            resource.stateChanged.connect(onStateChanged);
+        }
+    }
+
+    for (var i = 0; i < NUM_MODELS; ++i) {
+        watchResource(i);
+    }
+}
+
+spawn();
+
+// give the entity renderer a frame to request the models with their own priorities
+var WATCH_DELAY = 100; // ms
+Script.setTimeout(watch, WATCH_DELAY);
+
+Script.scriptEnding.connect(function() {
+    entities.forEach(function(entity) {
+        Entities.deleteEntity(entity);
+    });
+    resources.forEach(function(resource) {
+        resource.release();
+    });
+});
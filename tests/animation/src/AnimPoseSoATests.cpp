@@ -0,0 +1,352 @@
+//
+//  AnimPoseSoATests.cpp
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimPoseSoATests.h"
+
+#include <AnimPoseSoA.h>
+#include <AnimUtil.h>
+#include <AnimSkeleton.h>
+#include <AnimDefaultPose.h>
+#include <AnimBlendLinear.h>
+#include <AnimOverlay.h>
+#include <AnimContext.h>
+#include <AnimVariant.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+#include <functional>
+#include <map>
+
+#include "../QTestExtensions.h"
+
+QTEST_MAIN(AnimPoseSoATests)
+
+const float EPSILON = 0.0001f;
+const float ALPHA = 0.3f;
+
+static glm::quat randomRotation() {
+    glm::vec3 axis = glm::normalize(glm::vec3(randFloatInRange(-1.0f, 1.0f), randFloatInRange(-1.0f, 1.0f), randFloatInRange(-1.0f, 1.0f)));
+    return glm::angleAxis(randFloatInRange(-PI, PI), axis);
+}
+
+static AnimPoseVec makeRandomPoses(size_t numPoses) {
+    AnimPoseVec poses;
+    for (size_t i = 0; i < numPoses; i++) {
+        float scale = randFloatInRange(0.5f, 2.0f);
+        glm::vec3 trans(randFloatInRange(-1.0f, 1.0f), randFloatInRange(-1.0f, 1.0f), randFloatInRange(-1.0f, 1.0f));
+        poses.push_back(AnimPose(glm::vec3(scale), randomRotation(), trans));
+    }
+    return poses;
+}
+
+static void addJoint(std::vector<FBXJoint>& joints, const QString& name, int parentIndex) {
+    FBXJoint joint;
+    joint.isFree = false;
+    joint.parentIndex = parentIndex;
+    joint.distanceToParent = 0.1f;
+    joint.translation = glm::vec3(0.0f, 0.1f, 0.0f);
+    joint.preTransform = glm::mat4();
+    joint.preRotation = glm::quat();
+    joint.rotation = randomRotation();
+    joint.postRotation = glm::quat();
+    joint.postTransform = glm::mat4();
+    joint.transform = glm::mat4();
+    joint.rotationMin = glm::vec3(-PI);
+    joint.rotationMax = glm::vec3(PI);
+    joint.inverseDefaultRotation = glm::quat();
+    joint.inverseBindRotation = glm::quat();
+    joint.bindTransform = glm::mat4();
+    joint.name = name;
+    joint.isSkeletonJoint = true;
+    joint.bindTransformFoundInCluster = false;
+    joint.hasGeometricOffset = false;
+    joints.push_back(joint);
+}
+
+static void addChain(std::vector<FBXJoint>& joints, const QStringList& names, int parentIndex) {
+    for (auto& name : names) {
+        addJoint(joints, name, parentIndex);
+        parentIndex = (int)joints.size() - 1;
+    }
+}
+
+// a leaf node that only implements the AnimPoseVec evaluate(), so its parents go through the default evaluateSoA().
+class FixedPoseNode : public AnimNode {
+public:
+    FixedPoseNode(const QString& id, const AnimPoseVec& poses) : AnimNode(AnimNode::Type::Clip, id), _poses(poses) {}
+    virtual const AnimPoseVec& evaluate(const AnimVariantMap& animVars, const AnimContext& context, float dt, Triggers& triggersOut) override {
+        return _poses;
+    }
+protected:
+    virtual const AnimPoseVec& getPosesInternal() const override { return _poses; }
+    AnimPoseVec _poses;
+};
+
+// roughly the joint hierarchy of a typical avatar, 56 joints.
+static AnimSkeleton::Pointer makeAvatarSkeleton() {
+    std::vector<FBXJoint> joints;
+    addJoint(joints, "Hips", -1);
+    addChain(joints, { "Spine", "Spine1", "Spine2", "Neck", "Head" }, 0);
+    int head = (int)joints.size() - 1;
+    addJoint(joints, "LeftEye", head);
+    addJoint(joints, "RightEye", head);
+    int spine2 = 3;
+    for (auto side : { QString("Left"), QString("Right") }) {
+        addChain(joints, { side + "Shoulder", side + "Arm", side + "ForeArm", side + "Hand" }, spine2);
+        int hand = (int)joints.size() - 1;
+        for (auto finger : { "Thumb", "Index", "Middle", "Ring" }) {
+            QString prefix = side + "Hand" + finger;
+            addChain(joints, { prefix + "1", prefix + "2", prefix + "3", prefix + "4" }, hand);
+        }
+        addChain(joints, { side + "UpLeg", side + "Leg", side + "Foot", side + "ToeBase" }, 0);
+    }
+    return std::make_shared<AnimSkeleton>(joints);
+}
+
+void AnimPoseSoATests::testLoadStore() {
+    for (size_t numPoses : { 0, 1, 7, 8, 9, 56 }) {
+        AnimPoseVec poses = makeRandomPoses(numPoses);
+        AnimPoseSoA soaPoses(poses);
+        QCOMPARE(soaPoses.size(), numPoses);
+        QVERIFY(soaPoses.stride() % AnimPoseSoA::SIMD_WIDTH == 0);
+        QVERIFY(soaPoses.stride() >= numPoses);
+
+        AnimPoseVec result;
+        soaPoses.store(result);
+        QCOMPARE(result.size(), numPoses);
+        for (size_t i = 0; i < numPoses; i++) {
+            QCOMPARE_WITH_ABS_ERROR(result[i].scale(), poses[i].scale(), EPSILON);
+            QCOMPARE_WITH_ABS_ERROR(result[i].rot(), poses[i].rot(), EPSILON);
+            QCOMPARE_WITH_ABS_ERROR(result[i].trans(), poses[i].trans(), EPSILON);
+        }
+    }
+}
+
+void AnimPoseSoATests::testBlend() {
+    const size_t NUM_POSES = 61;
+    AnimPoseVec a = makeRandomPoses(NUM_POSES);
+    AnimPoseVec b = makeRandomPoses(NUM_POSES);
+
+    AnimPoseVec expected(NUM_POSES);
+    ::blend(NUM_POSES, &a[0], &b[0], ALPHA, &expected[0]);
+
+    AnimPoseSoA soaResult;
+    ::blend(AnimPoseSoA(a), AnimPoseSoA(b), ALPHA, soaResult);
+    AnimPoseVec result;
+    soaResult.store(result);
+
+    QCOMPARE(result.size(), NUM_POSES);
+    for (size_t i = 0; i < NUM_POSES; i++) {
+        QCOMPARE_WITH_ABS_ERROR(result[i].scale(), expected[i].scale(), EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(result[i].rot(), expected[i].rot(), EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(result[i].trans(), expected[i].trans(), EPSILON);
+    }
+}
+
+void AnimPoseSoATests::testWeightedBlend() {
+    const size_t NUM_POSES = 61;
+    AnimPoseVec a = makeRandomPoses(NUM_POSES);
+    AnimPoseVec b = makeRandomPoses(NUM_POSES);
+
+    std::vector<float> weights(AnimPoseSoA::paddedSize(NUM_POSES), 0.0f);
+    for (size_t i = 0; i < NUM_POSES; i++) {
+        weights[i] = (i % 3 == 0) ? 0.0f : randFloatInRange(0.0f, 1.0f);
+    }
+
+    AnimPoseSoA soaResult;
+    ::blend(AnimPoseSoA(a), AnimPoseSoA(b), weights.data(), ALPHA, soaResult);
+    AnimPoseVec result;
+    soaResult.store(result);
+
+    QCOMPARE(result.size(), NUM_POSES);
+    for (size_t i = 0; i < NUM_POSES; i++) {
+        AnimPose expected;
+        ::blend(1, &a[i], &b[i], weights[i] * ALPHA, &expected);
+        QCOMPARE_WITH_ABS_ERROR(result[i].scale(), expected.scale(), EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(result[i].rot(), expected.rot(), EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(result[i].trans(), expected.trans(), EPSILON);
+    }
+}
+
+void AnimPoseSoATests::testRelativeToAbsolute() {
+    auto skeleton = makeAvatarSkeleton();
+    const size_t numJoints = skeleton->getNumJoints();
+
+    // uniform scale only, see accumulatePoses()
+    // keep scale near one, so errors don't blow up down long chains.
+    AnimPoseVec expected = makeRandomPoses(numJoints);
+    for (auto& pose : expected) {
+        pose.scale() = glm::vec3(randFloatInRange(0.9f, 1.1f));
+    }
+    AnimPoseSoA soaPoses(expected);
+    skeleton->convertRelativePosesToAbsolute(expected);
+    skeleton->convertRelativePosesToAbsolute(soaPoses);
+
+    AnimPoseVec result;
+    soaPoses.store(result);
+    QCOMPARE(result.size(), numJoints);
+    const float ACCUMULATED_EPSILON = 0.001f;
+    for (size_t i = 0; i < numJoints; i++) {
+        // the AoS path goes through a matrix, so it may produce the negated quaternion.
+        glm::quat rot = result[i].rot();
+        if (glm::dot(rot, expected[i].rot()) < 0.0f) {
+            rot = -rot;
+        }
+        QCOMPARE_WITH_ABS_ERROR(result[i].scale(), expected[i].scale(), ACCUMULATED_EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(rot, expected[i].rot(), ACCUMULATED_EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(result[i].trans(), expected[i].trans(), ACCUMULATED_EPSILON);
+    }
+}
+
+// a graph shaped like the upper/lower body split in avatar.json:
+// an overlay on top of a locomotion blend tree.
+static AnimNode::Pointer makeAvatarGraph(AnimOverlay::BoneSet boneSet, std::function<AnimNode::Pointer(const QString&)> makeLeaf) {
+    auto makeBlend = [&](const QString& id, float alpha) {
+        auto blend = std::make_shared<AnimBlendLinear>(id, alpha);
+        blend->addChild(makeLeaf(id + "A"));
+        blend->addChild(makeLeaf(id + "B"));
+        return blend;
+    };
+
+    auto locomotion = std::make_shared<AnimBlendLinear>("locomotion", 0.5f);
+    locomotion->addChild(makeBlend("walk", 0.25f));
+    locomotion->addChild(makeBlend("run", 0.75f));
+
+    auto root = std::make_shared<AnimOverlay>("overlay", boneSet, 0.6f);
+    root->addChild(makeBlend("gesture", 0.4f));
+    root->addChild(locomotion);
+    return root;
+}
+
+void AnimPoseSoATests::testAvatarGraph() {
+    auto skeleton = makeAvatarSkeleton();
+    const size_t numJoints = skeleton->getNumJoints();
+
+    std::map<QString, AnimPoseVec> leafPoses;
+    auto root = makeAvatarGraph(AnimOverlay::FullBodyBoneSet, [&](const QString& id) {
+        leafPoses[id] = makeRandomPoses(numJoints);
+        return std::make_shared<FixedPoseNode>(id, leafPoses[id]);
+    });
+    root->setSkeleton(skeleton);
+
+    // the same graph, blended an AnimPoseVec at a time.
+    auto blendPoses = [&](const AnimPoseVec& a, const AnimPoseVec& b, float alpha) {
+        AnimPoseVec result(numJoints);
+        ::blend(numJoints, &a[0], &b[0], alpha, &result[0]);
+        return result;
+    };
+    AnimPoseVec walk = blendPoses(leafPoses["walkA"], leafPoses["walkB"], 0.25f);
+    AnimPoseVec run = blendPoses(leafPoses["runA"], leafPoses["runB"], 0.75f);
+    AnimPoseVec gesture = blendPoses(leafPoses["gestureA"], leafPoses["gestureB"], 0.4f);
+    AnimPoseVec expected = blendPoses(blendPoses(walk, run, 0.5f), gesture, 0.6f);
+
+    AnimVariantMap vars;
+    AnimContext context(false, false, false, glm::mat4(), glm::mat4());
+    AnimNode::Triggers triggers;
+    AnimPoseVec soaResult;
+    root->evaluateSoA(vars, context, 0.0f, triggers).store(soaResult);
+    const AnimPoseVec& result = root->evaluate(vars, context, 0.0f, triggers);
+
+    QCOMPARE(soaResult.size(), numJoints);
+    QCOMPARE(result.size(), numJoints);
+    for (size_t i = 0; i < numJoints; i++) {
+        QCOMPARE_WITH_ABS_ERROR(soaResult[i].scale(), expected[i].scale(), EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(soaResult[i].rot(), expected[i].rot(), EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(soaResult[i].trans(), expected[i].trans(), EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(result[i].scale(), expected[i].scale(), EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(result[i].rot(), expected[i].rot(), EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(result[i].trans(), expected[i].trans(), EPSILON);
+    }
+}
+
+void AnimPoseSoATests::benchmarkAvatarGraph() {
+    auto skeleton = makeAvatarSkeleton();
+    auto root = makeAvatarGraph(AnimOverlay::UpperBodyBoneSet, [](const QString& id) {
+        return std::make_shared<AnimDefaultPose>(id);
+    });
+    root->setSkeleton(skeleton);
+
+    AnimVariantMap vars;
+    AnimContext context(false, false, false, glm::mat4(), glm::mat4());
+    AnimNode::Triggers triggers;
+
+    const int NUM_ITERATIONS = 10000;
+    const float DT = 1.0f / 90.0f;
+
+    // poses stay in SoA from the leaves through the skeleton accumulation.
+    AnimPoseSoA soaPoses;
+    auto start = usecTimestampNow();
+    for (int i = 0; i < NUM_ITERATIONS; i++) {
+        triggers.clear();
+        soaPoses = root->evaluateSoA(vars, context, DT, triggers);
+        skeleton->convertRelativePosesToAbsolute(soaPoses);
+    }
+    auto soaDuration = usecTimestampNow() - start;
+
+    // the AnimPoseVec entry point, as used by Rig, followed by the AnimPoseVec accumulation.
+    AnimPoseVec poses;
+    start = usecTimestampNow();
+    for (int i = 0; i < NUM_ITERATIONS; i++) {
+        triggers.clear();
+        poses = root->evaluate(vars, context, DT, triggers);
+        skeleton->convertRelativePosesToAbsolute(poses);
+    }
+    auto aosDuration = usecTimestampNow() - start;
+
+    qDebug() << "Evaluated avatar graph" << NUM_ITERATIONS << "times: SoA" << (float)soaDuration / NUM_ITERATIONS
+        << "usecs, AnimPoseVec at the root" << (float)aosDuration / NUM_ITERATIONS << "usecs per evaluation";
+
+    QCOMPARE(soaPoses.size(), (size_t)skeleton->getNumJoints());
+    QCOMPARE(poses.size(), (size_t)skeleton->getNumJoints());
+}
+
+void AnimPoseSoATests::benchmarkClipSampling() {
+    // AnimClip::evaluate blends two keyframes of a typical avatar's 56 joints every frame. Compare the AoS blend
+    // it used to do against sampling SoA keyframes and storing the result back to the AnimPoseVec it returns.
+    const size_t NUM_JOINTS = 56;
+    const size_t NUM_FRAMES = 30;
+    std::vector<AnimPoseVec> frames;
+    std::vector<AnimPoseSoA> soaFrames;
+    for (size_t i = 0; i < NUM_FRAMES; i++) {
+        frames.push_back(makeRandomPoses(NUM_JOINTS));
+        soaFrames.push_back(AnimPoseSoA(frames.back()));
+    }
+
+    const int NUM_ITERATIONS = 100000;
+    AnimPoseVec aosPoses(NUM_JOINTS);
+    auto start = usecTimestampNow();
+    for (int i = 0; i < NUM_ITERATIONS; i++) {
+        size_t frame = i % (NUM_FRAMES - 1);
+        float alpha = (float)(i % 90) / 90.0f;
+        ::blend(NUM_JOINTS, &frames[frame][0], &frames[frame + 1][0], alpha, &aosPoses[0]);
+    }
+    auto aosDuration = usecTimestampNow() - start;
+
+    AnimPoseSoA soaResult;
+    AnimPoseVec soaPoses;
+    start = usecTimestampNow();
+    for (int i = 0; i < NUM_ITERATIONS; i++) {
+        size_t frame = i % (NUM_FRAMES - 1);
+        float alpha = (float)(i % 90) / 90.0f;
+        ::blend(soaFrames[frame], soaFrames[frame + 1], alpha, soaResult);
+        soaResult.store(soaPoses);
+    }
+    auto soaDuration = usecTimestampNow() - start;
+
+    qDebug() << "Sampled a" << NUM_JOINTS << "joint clip" << NUM_ITERATIONS << "times: AoS"
+        << (float)aosDuration / NUM_ITERATIONS << "usecs, SoA with store" << (float)soaDuration / NUM_ITERATIONS << "usecs";
+
+    // both end up with the same last sample
+    QCOMPARE(soaPoses.size(), NUM_JOINTS);
+    for (size_t i = 0; i < NUM_JOINTS; i++) {
+        QCOMPARE_WITH_ABS_ERROR(soaPoses[i].scale(), aosPoses[i].scale(), EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(soaPoses[i].rot(), aosPoses[i].rot(), EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(soaPoses[i].trans(), aosPoses[i].trans(), EPSILON);
+    }
+}
@@ -0,0 +1,27 @@
+//
+//  AnimPoseSoATests.h
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimPoseSoATests_h
+#define hifi_AnimPoseSoATests_h
+
+#include <QtTest/QtTest>
+
+class AnimPoseSoATests : public QObject {
+    Q_OBJECT
+private slots:
+    void testLoadStore();
+    void testBlend();
+    void testWeightedBlend();
+    void testRelativeToAbsolute();
+    void testAvatarGraph();
+    void benchmarkAvatarGraph();
+    void benchmarkClipSampling();
+};
+
+#endif // hifi_AnimPoseSoATests_h
@@ -0,0 +1,151 @@
+//
+//  JointDeltaCodingTests.cpp
+//  tests/avatars/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "JointDeltaCodingTests.h"
+
+#include <JointDeltaCoding.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+#include <../GLMTestUtils.h>
+#include <../QTestExtensions.h>
+
+QTEST_MAIN(JointDeltaCodingTests)
+
+const int NUM_JOINTS = 63;
+const float ROTATION_EPSILON = 0.0001f; // in units of getErrorDifference(quat)
+const float TRANSLATION_EPSILON = 0.001f;
+
+static glm::quat randomRotation() {
+    glm::vec3 axis = glm::normalize(glm::vec3(randFloatInRange(-1.0f, 1.0f), randFloatInRange(-1.0f, 1.0f), randFloatInRange(-1.0f, 1.0f)));
+    return glm::angleAxis(randFloatInRange(-PI, PI), axis);
+}
+
+static QVector<JointData> makeRandomJoints() {
+    QVector<JointData> joints(NUM_JOINTS);
+    for (int i = 0; i < NUM_JOINTS; i++) {
+        // leave a few unset, like joints the client doesn't drive
+        joints[i].rotationSet = (i % 7 != 0);
+        joints[i].rotation = randomRotation();
+        joints[i].translationSet = (i % 5 != 0);
+        joints[i].translation = glm::vec3(randFloatInRange(-1.0f, 1.0f), randFloatInRange(-1.0f, 1.0f), randFloatInRange(-1.0f, 1.0f));
+    }
+    return joints;
+}
+
+static void compareJoints(const QVector<JointData>& result, const QVector<JointData>& expected) {
+    QCOMPARE(result.size(), expected.size());
+    for (int i = 0; i < expected.size(); i++) {
+        QCOMPARE(result[i].rotationSet, expected[i].rotationSet);
+        if (expected[i].rotationSet) {
+            QCOMPARE_WITH_ABS_ERROR(result[i].rotation, expected[i].rotation, ROTATION_EPSILON);
+        }
+        QCOMPARE(result[i].translationSet, expected[i].translationSet);
+        if (expected[i].translationSet) {
+            QCOMPARE_WITH_ABS_ERROR(result[i].translation, expected[i].translation, TRANSLATION_EPSILON);
+        }
+    }
+}
+
+void JointDeltaCodingTests::testKeyframe() {
+    QVector<JointData> joints = makeRandomJoints();
+    QByteArray buffer((int)JointDeltaCoding::maxEncodedSize(NUM_JOINTS), 0);
+    auto data = reinterpret_cast<unsigned char*>(buffer.data());
+
+    JointBaseline senderBaseline;
+    int bytesWritten = JointDeltaCoding::encode(data, joints, senderBaseline, true, 1.0f, 0.0f);
+    QVERIFY(bytesWritten <= buffer.size());
+    QVERIFY(senderBaseline.isValid());
+
+    JointBaseline receiverBaseline;
+    QVector<JointData> result;
+    bool baselineMissed = true;
+    int bytesRead = JointDeltaCoding::decode(data, bytesWritten, result, receiverBaseline, baselineMissed);
+    QCOMPARE(bytesRead, bytesWritten);
+    QVERIFY(!baselineMissed);
+    compareJoints(result, joints);
+
+    // both ends must agree exactly on the baseline
+    QVERIFY(receiverBaseline.isValid());
+    QCOMPARE(receiverBaseline.sequence, senderBaseline.sequence);
+    QCOMPARE(receiverBaseline.joints.size(), senderBaseline.joints.size());
+    for (int i = 0; i < NUM_JOINTS; i++) {
+        QCOMPARE(receiverBaseline.joints[i].rotationSet, senderBaseline.joints[i].rotationSet);
+        QVERIFY(receiverBaseline.joints[i].rotation == senderBaseline.joints[i].rotation);
+        QCOMPARE(receiverBaseline.joints[i].translationSet, senderBaseline.joints[i].translationSet);
+        QVERIFY(receiverBaseline.joints[i].translation == senderBaseline.joints[i].translation);
+    }
+}
+
+void JointDeltaCodingTests::testDelta() {
+    QVector<JointData> joints = makeRandomJoints();
+    QByteArray buffer((int)JointDeltaCoding::maxEncodedSize(NUM_JOINTS), 0);
+    auto data = reinterpret_cast<unsigned char*>(buffer.data());
+
+    JointBaseline senderBaseline;
+    JointBaseline receiverBaseline;
+    QVector<JointData> result;
+    bool baselineMissed;
+    int keyframeSize = JointDeltaCoding::encode(data, joints, senderBaseline, true, 1.0f, 0.0f);
+    JointDeltaCoding::decode(data, keyframeSize, result, receiverBaseline, baselineMissed);
+
+    // a few frames of small motion, and one joint left alone
+    for (int frame = 0; frame < 10; frame++) {
+        for (int i = 1; i < NUM_JOINTS; i++) {
+            glm::quat twist = glm::angleAxis(0.001f * frame, glm::vec3(0.0f, 1.0f, 0.0f));
+            joints[i].rotation = glm::normalize(twist * joints[i].rotation);
+            joints[i].translation += glm::vec3(0.001f, -0.002f, 0.0005f);
+        }
+        int deltaSize = JointDeltaCoding::encode(data, joints, senderBaseline, false, 1.0f, 0.0f);
+        QVERIFY(deltaSize < keyframeSize);
+
+        int bytesRead = JointDeltaCoding::decode(data, deltaSize, result, receiverBaseline, baselineMissed);
+        QCOMPARE(bytesRead, deltaSize);
+        QVERIFY(!baselineMissed);
+        compareJoints(result, joints);
+    }
+}
+
+void JointDeltaCodingTests::testMissedKeyframe() {
+    QVector<JointData> joints = makeRandomJoints();
+    QByteArray buffer((int)JointDeltaCoding::maxEncodedSize(NUM_JOINTS), 0);
+    auto data = reinterpret_cast<unsigned char*>(buffer.data());
+
+    JointBaseline senderBaseline;
+    JointDeltaCoding::encode(data, joints, senderBaseline, true, 1.0f, 0.0f);
+    joints[1].rotation = randomRotation();
+    int deltaSize = JointDeltaCoding::encode(data, joints, senderBaseline, false, 1.0f, 0.0f);
+
+    // the receiver never saw the keyframe, the delta is skipped but fully consumed
+    JointBaseline receiverBaseline;
+    QVector<JointData> result;
+    bool baselineMissed = false;
+    int bytesRead = JointDeltaCoding::decode(data, deltaSize, result, receiverBaseline, baselineMissed);
+    QCOMPARE(bytesRead, deltaSize);
+    QVERIFY(baselineMissed);
+    QVERIFY(result.isEmpty());
+    QVERIFY(!receiverBaseline.isValid());
+}
+
+void JointDeltaCodingTests::testTruncated() {
+    QVector<JointData> joints = makeRandomJoints();
+    QByteArray buffer((int)JointDeltaCoding::maxEncodedSize(NUM_JOINTS), 0);
+    auto data = reinterpret_cast<unsigned char*>(buffer.data());
+
+    JointBaseline senderBaseline;
+    int bytesWritten = JointDeltaCoding::encode(data, joints, senderBaseline, true, 1.0f, 0.0f);
+
+    JointBaseline receiverBaseline;
+    QVector<JointData> result;
+    bool baselineMissed;
+    QCOMPARE(JointDeltaCoding::decode(data, bytesWritten / 2, result, receiverBaseline, baselineMissed), -1);
+    QVERIFY(!receiverBaseline.isValid());
+    QCOMPARE(JointDeltaCoding::decode(data, 2, result, receiverBaseline, baselineMissed), -1);
+}
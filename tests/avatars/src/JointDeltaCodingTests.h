@@ -0,0 +1,25 @@
+//
+//  JointDeltaCodingTests.h
+//  tests/avatars/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_JointDeltaCodingTests_h
+#define hifi_JointDeltaCodingTests_h
+
+#include <QtTest/QtTest>
+
+class JointDeltaCodingTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testKeyframe();
+    void testDelta();
+    void testMissedKeyframe();
+    void testTruncated();
+};
+
+#endif // hifi_JointDeltaCodingTests_h
@@ -0,0 +1,190 @@
+//
+//  PolyVoxChunkMeshingTests.cpp
+//  tests/entities-renderer/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PolyVoxChunkMeshingTests.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+
+#include <NumericalConstants.h>
+#include <PolyVoxChunkMeshing.h>
+#include <SharedUtil.h>
+
+QTEST_MAIN(PolyVoxChunkMeshingTests)
+
+Q_DECLARE_METATYPE(PolyVoxEntityItem::PolyVoxSurfaceStyle)
+
+using Volume = PolyVox::SimpleVolume<uint8_t>;
+
+// the positions and normals of a triangle's corners, on a grid fine enough to hide rounding differences between
+// a vertex placed relative to its chunk and the same vertex placed relative to the volume
+using Triangle = std::array<int, 18>;
+
+static std::vector<Triangle> getTriangles(const std::vector<PolyVox::PositionMaterialNormal>& vertices,
+                                          const std::vector<uint32_t>& indices) {
+    const float GRID = 1024.0f;
+    std::vector<Triangle> triangles;
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        std::array<std::array<int, 6>, 3> corners;
+        for (int corner = 0; corner < 3; corner++) {
+            const auto& vertex = vertices[indices[i + corner]];
+            PolyVox::Vector3DFloat position = vertex.getPosition();
+            PolyVox::Vector3DFloat normal = vertex.getNormal();
+            corners[corner] = {{
+                (int)roundf(position.getX() * GRID), (int)roundf(position.getY() * GRID),
+                (int)roundf(position.getZ() * GRID), (int)roundf(normal.getX() * GRID),
+                (int)roundf(normal.getY() * GRID), (int)roundf(normal.getZ() * GRID)
+            }};
+        }
+
+        // start from the smallest corner, keeping the winding
+        int first = (int)(std::min_element(corners.begin(), corners.end()) - corners.begin());
+        Triangle triangle;
+        for (int corner = 0; corner < 3; corner++) {
+            const auto& values = corners[(first + corner) % 3];
+            std::copy(values.begin(), values.end(), triangle.begin() + 6 * corner);
+        }
+        triangles.push_back(triangle);
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+static void fillSphere(Volume& volume, const glm::ivec3& center, int radius, uint8_t value, VoxelChunkGrid* grid) {
+    glm::ivec3 v;
+    for (v.z = -radius; v.z <= radius; v.z++) {
+        for (v.y = -radius; v.y <= radius; v.y++) {
+            for (v.x = -radius; v.x <= radius; v.x++) {
+                glm::ivec3 voxel = center + v;
+                if (glm::dot(glm::vec3(v), glm::vec3(v)) > radius * radius ||
+                        glm::any(glm::lessThan(voxel, glm::ivec3(0))) ||
+                        voxel.x >= volume.getWidth() || voxel.y >= volume.getHeight() || voxel.z >= volume.getDepth()) {
+                    continue;
+                }
+                if (volume.getVoxelAt(voxel.x, voxel.y, voxel.z) != value) {
+                    volume.setVoxelAt(voxel.x, voxel.y, voxel.z, value);
+                    if (grid) {
+                        grid->markVoxelDirty(voxel);
+                    }
+                }
+            }
+        }
+    }
+}
+
+static QByteArray getVoxelBytes(Volume& volume) {
+    QByteArray bytes(volume.getWidth() * volume.getHeight() * volume.getDepth(), '\0');
+    int index = 0;
+    for (int z = 0; z < volume.getDepth(); z++) {
+        for (int y = 0; y < volume.getHeight(); y++) {
+            for (int x = 0; x < volume.getWidth(); x++) {
+                bytes[index++] = volume.getVoxelAt(x, y, z);
+            }
+        }
+    }
+    return bytes;
+}
+
+void PolyVoxChunkMeshingTests::testStitchedMatchesWhole_data() {
+    QTest::addColumn<PolyVoxEntityItem::PolyVoxSurfaceStyle>("surfaceStyle");
+    QTest::newRow("marching cubes") << PolyVoxEntityItem::SURFACE_MARCHING_CUBES;
+    QTest::newRow("cubic") << PolyVoxEntityItem::SURFACE_CUBIC;
+    QTest::newRow("edged cubic") << PolyVoxEntityItem::SURFACE_EDGED_CUBIC;
+    QTest::newRow("edged marching cubes") << PolyVoxEntityItem::SURFACE_EDGED_MARCHING_CUBES;
+}
+
+void PolyVoxChunkMeshingTests::testStitchedMatchesWhole() {
+    QFETCH(PolyVoxEntityItem::PolyVoxSurfaceStyle, surfaceStyle);
+
+    // not a whole number of chunks, so the last ones are short, with blobs across the faces and corners of chunks
+    const glm::ivec3 VOLUME_SIZE(40, 35, 50);
+    Volume volume(PolyVox::Region(PolyVox::Vector3DInt32(0, 0, 0),
+                                  PolyVox::Vector3DInt32(VOLUME_SIZE.x - 1, VOLUME_SIZE.y - 1, VOLUME_SIZE.z - 1)));
+    volume.setBorderValue(255);
+    std::mt19937 generator(1234);
+    std::uniform_int_distribution<int> coordinate(0, 49);
+    std::uniform_int_distribution<int> radius(1, 8);
+    std::uniform_int_distribution<int> value(0, 255);
+    for (int i = 0; i < 40; i++) {
+        glm::ivec3 center(coordinate(generator), coordinate(generator), coordinate(generator));
+        fillSphere(volume, center, radius(generator), (uint8_t)value(generator), nullptr);
+    }
+
+    VoxelChunkGrid chunks;
+    chunks.resize(VOLUME_SIZE);
+    std::vector<PolyVoxMesh> chunkMeshes(chunks.getNumChunks());
+    extractChunkSurfaces(&volume, chunks, chunks.takeDirtyChunks(), surfaceStyle, chunkMeshes);
+    std::vector<PolyVox::PositionMaterialNormal> stitchedVertices;
+    std::vector<uint32_t> stitchedIndices;
+    stitchChunkSurfaces(chunks, chunkMeshes, stitchedVertices, stitchedIndices);
+
+    PolyVoxMesh wholeMesh;
+    extractSurface(&volume, volume.getEnclosingRegion(), surfaceStyle, wholeMesh);
+
+    std::vector<Triangle> stitched = getTriangles(stitchedVertices, stitchedIndices);
+    std::vector<Triangle> whole = getTriangles(wholeMesh.getRawVertexData(), wholeMesh.getIndices());
+    QVERIFY(!whole.empty());
+    QCOMPARE(stitched.size(), whole.size());
+    QVERIFY(stitched == whole);
+}
+
+void PolyVoxChunkMeshingTests::strokeBenchmark() {
+    // spheres sculpted into the largest volume a polyvox can have, the way the steps of a brush stroke are
+    const int VOLUME_SIZE = 128;
+    const int NUM_STROKES = 20;
+    const int RADIUS = 4;
+    const auto SURFACE_STYLE = PolyVoxEntityItem::SURFACE_MARCHING_CUBES;
+    std::mt19937 generator(1234);
+    std::uniform_int_distribution<int> center(RADIUS, VOLUME_SIZE - 1 - RADIUS);
+
+    Volume volume(PolyVox::Region(PolyVox::Vector3DInt32(0, 0, 0),
+                                  PolyVox::Vector3DInt32(VOLUME_SIZE - 1, VOLUME_SIZE - 1, VOLUME_SIZE - 1)));
+    volume.setBorderValue(255);
+    VoxelChunkGrid chunks;
+    chunks.resize(glm::ivec3(VOLUME_SIZE));
+    std::vector<PolyVoxMesh> chunkMeshes(chunks.getNumChunks());
+    extractChunkSurfaces(&volume, chunks, chunks.takeDirtyChunks(), SURFACE_STYLE, chunkMeshes);
+
+    quint64 chunkUsecs = 0;
+    quint64 wholeUsecs = 0;
+    quint64 bytesSent = 0;
+    int chunksExtracted = 0;
+    for (int i = 0; i < NUM_STROKES; i++) {
+        glm::ivec3 strokeCenter(center(generator), center(generator), center(generator));
+        fillSphere(volume, strokeCenter, RADIUS, 255, &chunks);
+
+        // what the entity does for a stroke: extract the changed chunks and stitch the mesh together
+        auto start = usecTimestampNow();
+        std::vector<int> dirtyChunks = chunks.takeDirtyChunks();
+        extractChunkSurfaces(&volume, chunks, dirtyChunks, SURFACE_STYLE, chunkMeshes);
+        std::vector<PolyVox::PositionMaterialNormal> vertices;
+        std::vector<uint32_t> indices;
+        stitchChunkSurfaces(chunks, chunkMeshes, vertices, indices);
+        chunkUsecs += usecTimestampNow() - start;
+        chunksExtracted += (int)dirtyChunks.size();
+
+        // what it did before, extract everything
+        start = usecTimestampNow();
+        PolyVoxMesh wholeMesh;
+        extractSurface(&volume, volume.getEnclosingRegion(), SURFACE_STYLE, wholeMesh);
+        wholeUsecs += usecTimestampNow() - start;
+
+        // the edit for the stroke carries the whole volume, compressed
+        bytesSent += compressVoxelData(VOLUME_SIZE, VOLUME_SIZE, VOLUME_SIZE, getVoxelBytes(volume)).size();
+    }
+
+    qDebug() << "Per stroke:" << (float)chunksExtracted / NUM_STROKES << "of" << chunks.getNumChunks() << "chunks in"
+        << (float)chunkUsecs / NUM_STROKES / USECS_PER_MSEC << "ms instead of"
+        << (float)wholeUsecs / NUM_STROKES / USECS_PER_MSEC << "ms for the whole volume,"
+        << bytesSent / NUM_STROKES << "bytes of compressed voxels sent";
+    QVERIFY(chunkUsecs < wholeUsecs);
+}
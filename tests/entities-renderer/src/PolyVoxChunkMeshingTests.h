@@ -0,0 +1,27 @@
+//
+//  PolyVoxChunkMeshingTests.h
+//  tests/entities-renderer/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PolyVoxChunkMeshingTests_h
+#define hifi_PolyVoxChunkMeshingTests_h
+
+#include <QtTest/QtTest>
+
+class PolyVoxChunkMeshingTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that the stitched chunk meshes have the same triangles as the whole volume extracted at once
+    void testStitchedMatchesWhole_data();
+    void testStitchedMatchesWhole();
+
+    // Time the extraction and measure the voxel data sent for brush strokes, by chunk and for the whole volume
+    void strokeBenchmark();
+};
+
+#endif // hifi_PolyVoxChunkMeshingTests_h
@@ -19,6 +19,7 @@
 #include <ShapeEntityItem.h>
 #include <EntityItemProperties.h>
 #include <Octree.h>
+#include <EntityTree.h>
 #include <PathUtils.h>
 
 const QString& getTestResourceDir() {
@@ -135,6 +136,72 @@ void testPropertyFlags() {
     testPropertyFlags(0xFFFF);
 }
 
+// compares the range queries of an EntityTree with and without its bounds index, then times moving its entities
+bool benchmarkBoundsIndex() {
+    const int NUM_ENTITIES = 100000;
+    const int NUM_QUERIES = 1000;
+    const float WORLD_SIZE = 2000.0f;
+
+    EntityTreePointer tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+    tree->withWriteLock([&] {
+        for (int i = 0; i < NUM_ENTITIES; ++i) {
+            EntityItemProperties properties;
+            properties.setType(EntityTypes::Box);
+            properties.setPosition(glm::vec3(randFloat(), randFloat(), randFloat()) * WORLD_SIZE);
+            properties.setDimensions(glm::vec3(0.1f + randFloat() * 2.0f));
+            tree->addEntity(EntityItemID(QUuid::createUuid()), properties);
+        }
+    });
+    qDebug() << "bounds index holds" << tree->getBoundsIndex().size() << "entities";
+
+    QVector<glm::vec3> centers;
+    for (int i = 0; i < NUM_QUERIES; ++i) {
+        centers.push_back(glm::vec3(randFloat(), randFloat(), randFloat()) * WORLD_SIZE);
+    }
+
+    // from a pick sized query up to one that covers a good part of the domain
+    for (float queryRadius : { 0.5f, 5.0f, 50.0f, 500.0f }) {
+        int numFound[2] = { 0, 0 };
+        quint64 durations[2] = { 0, 0 };
+        tree->withReadLock([&] {
+            for (int useIndex = 0; useIndex < 2; ++useIndex) {
+                tree->setUseBoundsIndex(useIndex != 0);
+                QVector<EntityItemPointer> foundEntities;
+                auto start = usecTimestampNow();
+                for (const glm::vec3& center : centers) {
+                    foundEntities.clear();
+                    tree->findEntities(center, queryRadius, foundEntities);
+                    numFound[useIndex] += foundEntities.size();
+                }
+                durations[useIndex] = usecTimestampNow() - start;
+            }
+        });
+        tree->setUseBoundsIndex(true);
+        qDebug() << "sphere queries of radius" << queryRadius << ": octree" << durations[0] << "usecs, bounds index"
+            << durations[1] << "usecs," << numFound[1] << "entities found";
+        if (numFound[0] != numFound[1]) {
+            qWarning() << "bounds index found" << numFound[1] << "entities, the octree found" << numFound[0];
+            return false;
+        }
+    }
+
+    // move every entity and re-bin them all in one traversal
+    QVector<EntityItemPointer> allEntities;
+    tree->withReadLock([&] {
+        tree->findEntities(AACube(glm::vec3((float)-HALF_TREE_SCALE), (float)TREE_SCALE), allEntities);
+    });
+    for (auto& entity : allEntities) {
+        entity->setPosition(glm::vec3(randFloat(), randFloat(), randFloat()) * WORLD_SIZE);
+        entity->checkAndMaybeUpdateQueryAACube();
+        tree->queueEntityMove(entity, entity->getQueryAACube());
+    }
+    tree->update(false);
+    qDebug() << "re-binned" << tree->getTotalEntitiesMoved() << "entities in" << tree->getAverageMoveTime() << "usecs,"
+        << tree->getMoveChecksSaved() << "element checks saved";
+    return true;
+}
+
 int main(int argc, char** argv) {
     QCoreApplication app(argc, argv);
     {
@@ -151,6 +218,9 @@ int main(int argc, char** argv) {
 
     }
     DependencyManager::set<NodeList>(NodeType::Unassigned);
+    if (!benchmarkBoundsIndex()) {
+        return -1;
+    }
 
     QFile file(getTestResourceDir() + "packet.bin");
     if (!file.open(QIODevice::ReadOnly)) return -1;
@@ -0,0 +1,90 @@
+//
+//  PacketReceiverTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketReceiverTests.h"
+
+#include <PacketReceiver.h>
+
+QTEST_MAIN(PacketReceiverTests)
+
+// DomainList is not sourced, so the receiver doesn't need a node list to look up its sender
+static const PacketType TEST_PACKET_TYPE = PacketType::DomainList;
+
+static std::unique_ptr<udt::Packet> makeReceivedPacket(const QByteArray& payload) {
+    auto packet = NLPacket::create(TEST_PACKET_TYPE);
+    packet->write(payload);
+
+    std::unique_ptr<char[]> data(new char[packet->getDataSize()]);
+    memcpy(data.get(), packet->getData(), packet->getDataSize());
+    return udt::Packet::fromReceivedPacket(std::move(data), packet->getDataSize(), HifiSockAddr());
+}
+
+void PacketReceiverTests::typedListenerTest() {
+    PacketReceiver receiver;
+    TestPacketListener listener;
+
+    PacketReceiver::DispatchOptions options;
+    options.onReceiveThread = true;
+    QVERIFY(receiver.registerListener(TEST_PACKET_TYPE, &listener, &TestPacketListener::handlePacket, options));
+
+    receiver.handleVerifiedPacket(makeReceivedPacket("typed"));
+    QCOMPARE(listener.messages.size(), 1);
+    QCOMPARE(listener.messages[0], QByteArray("typed"));
+
+    QJsonObject stats = receiver.getAndResetDispatchStats();
+    QCOMPARE(stats["DomainList"].toObject()["count"].toInt(), 1);
+    QVERIFY(receiver.getAndResetDispatchStats().isEmpty());
+}
+
+void PacketReceiverTests::slotListenerTest() {
+    PacketReceiver receiver;
+    TestPacketListener listener;
+
+    QVERIFY(receiver.registerListener(TEST_PACKET_TYPE, &listener, "processPacket"));
+
+    // the listener lives on this thread, so it is called right away
+    receiver.handleVerifiedPacket(makeReceivedPacket("slot"));
+    QCOMPARE(listener.messages.size(), 1);
+    QCOMPARE(listener.messages[0], QByteArray("slot"));
+}
+
+void PacketReceiverTests::listenerThreadTest() {
+    PacketReceiver receiver;
+    QThread listenerThread;
+    QObject listener;
+    listener.moveToThread(&listenerThread);
+    listenerThread.start();
+
+    std::atomic<QThread*> handlerThread { nullptr };
+    QVERIFY(receiver.registerHandler(TEST_PACKET_TYPE, &listener,
+                                     [&](QSharedPointer<ReceivedMessage>, SharedNodePointer) {
+        handlerThread = QThread::currentThread();
+    }));
+
+    receiver.handleVerifiedPacket(makeReceivedPacket("queued"));
+    QTRY_VERIFY(handlerThread.load() != nullptr);
+    QCOMPARE(handlerThread.load(), &listenerThread);
+
+    listenerThread.quit();
+    listenerThread.wait();
+}
+
+void PacketReceiverTests::unregisterTest() {
+    PacketReceiver receiver;
+    TestPacketListener listener;
+
+    PacketReceiver::DispatchOptions options;
+    options.onReceiveThread = true;
+    QVERIFY(receiver.registerListener(TEST_PACKET_TYPE, &listener, &TestPacketListener::handlePacket, options));
+    receiver.unregisterListener(&listener);
+
+    receiver.handleVerifiedPacket(makeReceivedPacket("dropped"));
+    QCOMPARE(listener.messages.size(), 0);
+}
@@ -0,0 +1,48 @@
+//
+//  PacketReceiverTests.h
+//  tests/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PacketReceiverTests_h
+#define hifi_PacketReceiverTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+#include <ReceivedMessage.h>
+
+class PacketReceiverTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test a typed listener run on the receive thread
+    void typedListenerTest();
+
+    // Test a listener registered by slot name
+    void slotListenerTest();
+
+    // Test a handler run on the thread its listener lives in
+    void listenerThreadTest();
+
+    // Test that unregistered listeners stop receiving
+    void unregisterTest();
+};
+
+class TestPacketListener : public QObject {
+    Q_OBJECT
+public:
+    void handlePacket(QSharedPointer<ReceivedMessage> message) { messages << message->readAll(); }
+
+public slots:
+    void processPacket(QSharedPointer<ReceivedMessage> message) { messages << message->readAll(); }
+
+public:
+    QList<QByteArray> messages;
+};
+
+#endif // hifi_PacketReceiverTests_h
@@ -0,0 +1,97 @@
+//
+//  ReceivedMessageTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ReceivedMessageTests.h"
+
+#include <ReceivedMessage.h>
+
+QTEST_MAIN(ReceivedMessageTests)
+
+static std::unique_ptr<NLPacket> makePacket(const QByteArray& payload, udt::Packet::PacketPosition position, int partNumber) {
+    auto packet = NLPacket::create(PacketType::EntityData, -1, true, position != udt::Packet::ONLY);
+    packet->write(payload);
+    if (position != udt::Packet::ONLY) {
+        packet->writeMessageNumber(1, position, partNumber);
+    }
+    packet->seek(0);
+    return packet;
+}
+
+static QByteArray makeMessageData(int size) {
+    QByteArray data(size, 0);
+    for (int i = 0; i < size; i++) {
+        data[i] = (char)(i * 7);
+    }
+    return data;
+}
+
+void ReceivedMessageTests::singlePacketTest() {
+    QUuid uuid = QUuid::createUuid();
+    QByteArray payload = uuid.toRfc4122();
+    payload.append(makeMessageData(100));
+
+    ReceivedMessage message(makePacket(payload, udt::Packet::ONLY, 0));
+    QVERIFY(message.isComplete());
+    QCOMPARE(message.getSize(), (qint64)payload.size());
+    QCOMPARE(message.readUuid(), uuid);
+    QCOMPARE(message.readWithoutCopy(10), payload.mid(16, 10));
+    QCOMPARE(message.readAll(), payload.mid(26));
+    QCOMPARE(message.getBytesLeftToRead(), (qint64)0);
+    QCOMPARE(message.getMessage(), payload);
+}
+
+void ReceivedMessageTests::multiPacketTest() {
+    QByteArray data = makeMessageData(300);
+
+    ReceivedMessage message(makePacket(data.mid(0, 100), udt::Packet::FIRST, 0));
+    QVERIFY(!message.isComplete());
+    message.appendPacket(makePacket(data.mid(100, 100), udt::Packet::MIDDLE, 1));
+    message.appendPacket(makePacket(data.mid(200, 100), udt::Packet::LAST, 2));
+    QVERIFY(message.isComplete());
+    QCOMPARE(message.getSize(), (qint64)data.size());
+
+    // the head is the first packet, and is readable while the rest arrives
+    QCOMPARE(message.readHead(8), data.mid(0, 8));
+
+    // reads within a packet, and across packets
+    message.seek(90);
+    QCOMPARE(message.read(20), data.mid(90, 20));
+    QCOMPARE(message.peek(200), data.mid(110, 190));
+
+    quint32 primitive;
+    message.seek(198);
+    message.readPrimitive(&primitive);
+    QCOMPARE(QByteArray(reinterpret_cast<const char*>(&primitive), sizeof(primitive)), data.mid(198, sizeof(primitive)));
+
+    QCOMPARE(message.readWithoutCopy(50), data.mid(202, 50));
+    QCOMPARE(message.readAll(), data.mid(252));
+}
+
+void ReceivedMessageTests::flattenTest() {
+    QString string = "a string that is split between packets";
+    QByteArray utf8 = string.toUtf8();
+    quint32 length = utf8.size();
+
+    QByteArray data = makeMessageData(90);
+    data.append(reinterpret_cast<const char*>(&length), sizeof(length));
+    data.append(utf8);
+
+    ReceivedMessage message(makePacket(data.mid(0, 100), udt::Packet::FIRST, 0));
+    message.appendPacket(makePacket(data.mid(100), udt::Packet::LAST, 1));
+
+    message.seek(90);
+    QCOMPARE(message.readString(), string);
+
+    QCOMPARE(message.getMessage(), data);
+    QCOMPARE(QByteArray(message.getRawMessage(), message.getSize()), data);
+
+    message.seek(0);
+    QCOMPARE(message.readAll(), data);
+}
@@ -0,0 +1,31 @@
+//
+//  ReceivedMessageTests.h
+//  tests/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ReceivedMessageTests_h
+#define hifi_ReceivedMessageTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class ReceivedMessageTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test reads from a single packet message
+    void singlePacketTest();
+
+    // Test reads that span the packets of a multi packet message
+    void multiPacketTest();
+
+    // Test getMessage and reads after it on a multi packet message
+    void flattenTest();
+};
+
+#endif // hifi_ReceivedMessageTests_h
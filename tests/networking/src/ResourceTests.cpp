@@ -82,3 +82,47 @@ void ResourceTests::downloadAgain() {
 
     QVERIFY(resource->isLoaded());
 }
+
+static QSharedPointer<Resource> createQueuedResource(const QString& url) {
+    auto queued = QSharedPointer<Resource>::create(QUrl(url));
+    queued->setSelf(queued);
+    return queued;
+}
+
+void ResourceTests::pendingRequestOrder() {
+    // nothing may start, so every request stays in the pending list
+    int requestLimit = ResourceCache::getRequestLimit();
+    ResourceCache::setRequestLimit(0);
+
+    QObject closeOwner;
+    QObject approachingOwner;
+    QObject* departedOwner = new QObject();
+
+    auto approaching = createQueuedResource("http://localhost/approaching.fbx");
+    approaching->setLoadPriority(&approachingOwner, 0.1f);
+    auto close = createQueuedResource("http://localhost/close.fbx");
+    close->setLoadPriority(&closeOwner, 1.0f);
+    auto stale = createQueuedResource("http://localhost/stale.fbx");
+    stale->setLoadPriority(departedOwner, 2.0f);
+    auto local = createQueuedResource("file:///local.fbx");
+    local->setLoadPriority(&closeOwner, -1.0f);
+
+    approaching->ensureLoading();
+    close->ensureLoading();
+    stale->ensureLoading();
+    local->ensureLoading();
+    QCOMPARE(ResourceCache::getPendingRequestCount(), 4);
+
+    // priorities are read when a request is picked, so changes after queueing still count
+    approaching->setLoadPriority(&approachingOwner, 1.5f);
+    delete departedOwner;
+
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    QCOMPARE(sharedItems->getHighestPendingRequest(), local);
+    QCOMPARE(sharedItems->getHighestPendingRequest(), approaching);
+    QCOMPARE(sharedItems->getHighestPendingRequest(), close);
+    QCOMPARE(sharedItems->getHighestPendingRequest(), stale);
+    QVERIFY(sharedItems->getHighestPendingRequest().isNull());
+
+    ResourceCache::setRequestLimit(requestLimit);
+}
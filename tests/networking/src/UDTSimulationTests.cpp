@@ -0,0 +1,248 @@
+//
+//  UDTSimulationTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "UDTSimulationTests.h"
+
+#include <algorithm>
+#include <random>
+#include <set>
+
+#include <udt/ControlPacket.h>
+#include <udt/LossList.h>
+#include <udt/PacketList.h>
+#include <udt/PacketQueue.h>
+
+QTEST_MAIN(UDTSimulationTests)
+
+using namespace udt;
+
+// start close to the wrap so every test crosses it
+static const SequenceNumber::Type FIRST_SEQUENCE_NUMBER = SequenceNumber::MAX - 1000;
+
+static SequenceNumber sequenceNumberAt(int offset) {
+    return SequenceNumber(FIRST_SEQUENCE_NUMBER) + offset;
+}
+
+void UDTSimulationTests::lossListTest() {
+    std::mt19937 generator(17);
+    LossList lossList;
+    std::set<int> lost;
+    int nextOffset = 0;
+
+    for (int i = 0; i < 20000; i++) {
+        int action = generator() % 5;
+        int start = generator() % (nextOffset + 1);
+        int length = generator() % 16 + 1;
+
+        if (action == 0) {
+            // new losses, always after the last one
+            start = nextOffset + generator() % 4;
+            lossList.append(sequenceNumberAt(start), sequenceNumberAt(start + length - 1));
+            nextOffset = start + length;
+            for (int offset = start; offset < nextOffset; offset++) {
+                lost.insert(offset);
+            }
+        } else if (action == 1) {
+            int end = std::min(start + length, nextOffset) - 1;
+            if (end >= start) {
+                lossList.insert(sequenceNumberAt(start), sequenceNumberAt(end));
+                for (int offset = start; offset <= end; offset++) {
+                    lost.insert(offset);
+                }
+            }
+        } else if (action == 2) {
+            QCOMPARE(lossList.remove(sequenceNumberAt(start)), lost.erase(start) > 0);
+        } else if (action == 3) {
+            lossList.remove(sequenceNumberAt(start), sequenceNumberAt(start + length - 1));
+            for (int offset = start; offset < start + length; offset++) {
+                lost.erase(offset);
+            }
+        } else if (!lost.empty()) {
+            QCOMPARE(lossList.popFirstSequenceNumber(), sequenceNumberAt(*lost.begin()));
+            lost.erase(lost.begin());
+        }
+
+        QCOMPARE(lossList.getLength(), (int)lost.size());
+        if (!lost.empty()) {
+            QCOMPARE(lossList.getFirstSequenceNumber(), sequenceNumberAt(*lost.begin()));
+        }
+    }
+}
+
+static std::unique_ptr<Packet> makeTestPacket(int index) {
+    auto packet = Packet::create(sizeof(int));
+    packet->writePrimitive(index);
+    return packet;
+}
+
+static int readTestPacket(Packet& packet) {
+    int index = -1;
+    packet.seek(0);
+    packet.readPrimitive(&index);
+    return index;
+}
+
+void UDTSimulationTests::packetQueueTest() {
+    PacketQueue queue;
+    QVERIFY(queue.isEmpty());
+
+    // enough packets to make the main channel grow a few times
+    const int NUM_PACKETS = 100;
+    for (int i = 0; i < NUM_PACKETS; i++) {
+        queue.queuePacket(makeTestPacket(i));
+    }
+
+    int numQueuedListPackets = 0;
+    for (int list = 0; list < 3; list++) {
+        auto packetList = PacketList::create(PacketType::EntityData, QByteArray(), true, true);
+        packetList->write(QByteArray(Packet::maxPayloadSize(true) * (list + 2), 'x'));
+        packetList->closeCurrentPacket();
+        numQueuedListPackets += (int)packetList->getNumPackets();
+        queue.queuePacketList(std::move(packetList));
+    }
+
+    int nextIndex = 0;
+    int numListPackets = 0;
+    while (!queue.isEmpty()) {
+        auto packet = queue.takePacket();
+        QVERIFY(packet);
+        if (packet->isPartOfMessage()) {
+            numListPackets++;
+        } else {
+            QCOMPARE(readTestPacket(*packet), nextIndex++);
+        }
+    }
+    QCOMPARE(nextIndex, NUM_PACKETS);
+    QCOMPARE(numListPackets, numQueuedListPackets);
+    QVERIFY(!queue.takePacket());
+
+    // emptied list channels are reused
+    auto packetList = PacketList::create(PacketType::EntityData, QByteArray(), true, true);
+    packetList->write(QByteArray(10, 'x'));
+    packetList->closeCurrentPacket();
+    queue.queuePacketList(std::move(packetList));
+    QVERIFY(queue.takePacket());
+    QVERIFY(queue.isEmpty());
+}
+
+namespace {
+
+// Stands in for the socket between a SendQueue and a Connection, dropping a share of what goes through it
+class LossyLink {
+public:
+    LossyLink(float lossRate, unsigned int seed) : _lossRate(lossRate), _generator(seed) {}
+
+    bool deliver() { return _distribution(_generator) >= _lossRate; }
+
+private:
+    float _lossRate;
+    std::mt19937 _generator;
+    std::uniform_real_distribution<float> _distribution { 0.0f, 1.0f };
+};
+
+}
+
+void UDTSimulationTests::lossyLinkTest() {
+    const int NUM_PACKETS = 100000;
+    const int PACKETS_PER_TICK = 64;
+    const int NAK_INTERVAL_TICKS = 4;
+    const float LOSS_RATE = 0.2f;
+
+    LossyLink link(LOSS_RATE, 42);
+
+    // sender side, like SendQueue
+    PacketQueue packets;
+    LossList naks;
+    std::vector<std::unique_ptr<Packet>> sentPackets;
+    for (int i = 0; i < NUM_PACKETS; i++) {
+        packets.queuePacket(makeTestPacket(i));
+    }
+
+    // receiver side, like Connection
+    LossList lossList;
+    int lastReceivedOffset = -1;
+    std::vector<bool> received(NUM_PACKETS, false);
+    int numReceived = 0;
+    int numDuplicates = 0;
+    int numSent = 0;
+    int numResent = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for (int tick = 0; numReceived < NUM_PACKETS; tick++) {
+        for (int i = 0; i < PACKETS_PER_TICK; i++) {
+            int offset;
+            if (!naks.isEmpty()) {
+                offset = seqoff(sequenceNumberAt(0), naks.popFirstSequenceNumber());
+                numResent++;
+            } else if (!packets.isEmpty()) {
+                offset = (int)sentPackets.size();
+                sentPackets.push_back(packets.takePacket());
+            } else {
+                break;
+            }
+            numSent++;
+
+            if (!link.deliver()) {
+                continue;
+            }
+
+            int index = readTestPacket(*sentPackets[offset]);
+            QCOMPARE(index, offset);
+
+            if (offset > lastReceivedOffset + 1) {
+                lossList.append(sequenceNumberAt(lastReceivedOffset + 1), sequenceNumberAt(offset - 1));
+            }
+
+            if (offset > lastReceivedOffset) {
+                lastReceivedOffset = offset;
+            } else if (!lossList.remove(sequenceNumberAt(offset))) {
+                numDuplicates++;
+                continue;
+            }
+
+            QVERIFY(!received[index]);
+            received[index] = true;
+            numReceived++;
+        }
+
+        // the receiver reports its losses now and then, like Connection::sendTimeoutNAK, and the sender replaces its
+        // NAKs with them, like SendQueue::overrideNAKListFromPacket. Those reports can be lost too.
+        if (tick % NAK_INTERVAL_TICKS == 0 && !lossList.isEmpty() && link.deliver()) {
+            auto lossListPacket = ControlPacket::create(ControlPacket::TimeoutNAK, ControlPacket::maxPayloadSize());
+            lossList.write(*lossListPacket, ControlPacket::maxPayloadSize() / (2 * sizeof(SequenceNumber)));
+            lossListPacket->seek(0);
+
+            naks.clear();
+            SequenceNumber first, second;
+            while (lossListPacket->bytesLeftToRead() >= (qint64)(2 * sizeof(SequenceNumber))) {
+                lossListPacket->readPrimitive(&first);
+                lossListPacket->readPrimitive(&second);
+                naks.append(first, second);
+            }
+        }
+
+        // and once everything was sent, the sender times out and resends what wasn't acknowledged
+        if (packets.isEmpty() && naks.isEmpty() && numReceived < NUM_PACKETS) {
+            if (lastReceivedOffset + 1 < (int)sentPackets.size()) {
+                naks.insert(sequenceNumberAt(lastReceivedOffset + 1), sequenceNumberAt((int)sentPackets.size() - 1));
+            }
+        }
+    }
+
+    QCOMPARE(numReceived, NUM_PACKETS);
+    QVERIFY(lossList.isEmpty());
+
+    qint64 elapsedMsecs = std::max(timer.elapsed(), (qint64)1);
+    qDebug() << "Sent" << numSent << "packets (" << numResent << "resent," << numDuplicates << "duplicates ) for"
+        << NUM_PACKETS << "at" << LOSS_RATE * 100.0f << "% loss in" << elapsedMsecs << "ms,"
+        << (numSent * 1000 / elapsedMsecs) << "packets/s";
+}
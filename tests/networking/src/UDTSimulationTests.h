@@ -0,0 +1,31 @@
+//
+//  UDTSimulationTests.h
+//  tests/networking/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_UDTSimulationTests_h
+#define hifi_UDTSimulationTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class UDTSimulationTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test LossList against a set of sequence numbers, across the sequence number wrap
+    void lossListTest();
+
+    // Test PacketQueue takes packets in order, round robin between packet lists
+    void packetQueueTest();
+
+    // Test a transfer over a lossy link recovers every packet, and report how fast it ran
+    void lossyLinkTest();
+};
+
+#endif // hifi_UDTSimulationTests_h
@@ -0,0 +1,102 @@
+//
+//  EntityEditPacketSenderTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityEditPacketSenderTests.h"
+
+#include <EntityEditPacketSender.h>
+#include <EntityItemProperties.h>
+#include <NodeList.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+QTEST_MAIN(EntityEditPacketSenderTests)
+
+// With no entity server known, the sender keeps the edits it queues, which lets the tests see what went out
+class TestEditPacketSender : public EntityEditPacketSender {
+public:
+    QList<QByteArray> getQueuedEdits() {
+        QMutexLocker locker(&_pendingPacketsLock);
+        QList<QByteArray> edits;
+        for (const auto& edit : _preServerEdits) {
+            edits << edit.second;
+        }
+        return edits;
+    }
+};
+
+static EntityItemProperties decodeEdit(const QByteArray& edit) {
+    int processedBytes = 0;
+    EntityItemID entityID;
+    EntityItemProperties properties;
+    EntityItemProperties::decodeEntityEditPacket(reinterpret_cast<const unsigned char*>(edit.constData()), edit.size(),
+                                                 processedBytes, entityID, properties);
+    return properties;
+}
+
+void EntityEditPacketSenderTests::initTestCase() {
+    DependencyManager::set<NodeList>(NodeType::Unassigned);
+}
+
+void EntityEditPacketSenderTests::heldEditSentWithoutTraffic() {
+    const quint64 COALESCE_INTERVAL = 100 * USECS_PER_MSEC;
+    TestEditPacketSender sender;
+    sender.setEditCoalesceInterval(COALESCE_INTERVAL);
+    sender.initialize(true);
+
+    EntityItemID entityID(QUuid::createUuid());
+    EntityItemProperties properties;
+    properties.setType(EntityTypes::Box);
+    properties.setPosition(glm::vec3(1.0f));
+    sender.queueEditEntityMessage(PacketType::EntityEdit, EntityTreePointer(), entityID, properties);
+    QCOMPARE(sender.getQueuedEdits().size(), 1);
+
+    // the second edit comes too soon after the first and is held back
+    properties.setPosition(glm::vec3(2.0f));
+    quint64 heldAt = usecTimestampNow();
+    sender.queueEditEntityMessage(PacketType::EntityEdit, EntityTreePointer(), entityID, properties);
+    QCOMPARE(sender.getQueuedEdits().size(), 1);
+
+    // and nothing else is queued, so only the sender's own timing can send it
+    QTRY_COMPARE_WITH_TIMEOUT(sender.getQueuedEdits().size(), 2, 1000);
+    quint64 elapsed = usecTimestampNow() - heldAt;
+    QVERIFY(elapsed < 3 * COALESCE_INTERVAL);
+    QVERIFY(decodeEdit(sender.getQueuedEdits().last()).getPosition() == glm::vec3(2.0f));
+
+    sender.terminate();
+}
+
+void EntityEditPacketSenderTests::finalDeltaSentWhole() {
+    TestEditPacketSender sender;
+    sender.setEditCoalesceInterval(0);
+    sender.initialize(true);
+
+    EntityItemID entityID(QUuid::createUuid());
+    QString userData(4 * EntityItemProperties::MIN_STRING_DELTA_SIZE, 'a');
+    EntityItemProperties properties;
+    properties.setType(EntityTypes::Box);
+    properties.setUserData(userData);
+    sender.queueEditEntityMessage(PacketType::EntityEdit, EntityTreePointer(), entityID, properties);
+
+    // a small change goes out as a delta, which a server that missed the first edit drops
+    userData[10] = 'b';
+    properties.setUserData(userData);
+    sender.queueEditEntityMessage(PacketType::EntityEdit, EntityTreePointer(), entityID, properties);
+    QList<QByteArray> edits = sender.getQueuedEdits();
+    QCOMPARE(edits.size(), 2);
+    QVERIFY(decodeEdit(edits[1]).getStringDeltas().contains(PROP_USER_DATA));
+
+    // with no further edits the latest value still reaches the server whole
+    QTRY_COMPARE_WITH_TIMEOUT(sender.getQueuedEdits().size(), 3, 2000);
+    EntityItemProperties closingProperties = decodeEdit(sender.getQueuedEdits().last());
+    QVERIFY(closingProperties.getStringDeltas().isEmpty());
+    QCOMPARE(closingProperties.getUserData(), userData);
+
+    sender.terminate();
+}
@@ -0,0 +1,28 @@
+//
+//  EntityEditPacketSenderTests.h
+//  tests/octree/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityEditPacketSenderTests_h
+#define hifi_EntityEditPacketSenderTests_h
+
+#include <QtTest/QtTest>
+
+class EntityEditPacketSenderTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+
+    // Test that a held back edit goes out once its interval has passed, with no other edit to wake the sender
+    void heldEditSentWithoutTraffic();
+
+    // Test that a run of deltas ending in one the server could have dropped is followed by the value sent whole
+    void finalDeltaSentWhole();
+};
+
+#endif // hifi_EntityEditPacketSenderTests_h
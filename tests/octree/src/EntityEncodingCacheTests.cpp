@@ -0,0 +1,120 @@
+//
+//  EntityEncodingCacheTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityEncodingCacheTests.h"
+
+#include <memory>
+#include <vector>
+
+#include <EntityTreeElement.h>
+#include <OctreePacketData.h>
+#include <ShapeEntityItem.h>
+#include <SharedUtil.h>
+
+QTEST_MAIN(EntityEncodingCacheTests)
+
+// A box whose requested properties can be narrowed, the way a subclass may ask for less than it did before
+class TestShapeEntityItem : public ShapeEntityItem {
+public:
+    TestShapeEntityItem() : ShapeEntityItem(EntityItemID(QUuid::createUuid())) { }
+
+    EntityPropertyFlags getEntityProperties(EncodeBitstreamParams& params) const override {
+        EntityPropertyFlags requestedProperties = ShapeEntityItem::getEntityProperties(params);
+        if (withoutColor) {
+            requestedProperties -= PROP_COLOR;
+        }
+        return requestedProperties;
+    }
+
+    bool withoutColor { false };
+};
+
+// Encodes the entity on its own into an empty packet, as the first entity of an element would be
+static QByteArray encode(const EntityItem& entity, EncodeBitstreamParams& params) {
+    OctreePacketData packetData;
+    auto extraEncodeData = std::make_shared<EntityTreeElementExtraEncodeData>();
+    OctreeElement::AppendState state = entity.appendEntityData(&packetData, params, extraEncodeData);
+    if (state != OctreeElement::COMPLETED) {
+        return QByteArray();
+    }
+    return QByteArray((const char*)packetData.getUncompressedData(), packetData.getUncompressedSize());
+}
+
+void EntityEncodingCacheTests::reusedWhileUnchanged() {
+    auto entity = std::make_shared<TestShapeEntityItem>();
+
+    EncodeBitstreamParams firstParams;
+    QByteArray first = encode(*entity, firstParams);
+    QVERIFY(!first.isEmpty());
+    QCOMPARE(firstParams.encodedDataMisses, 1);
+    QCOMPARE(firstParams.encodedDataHits, 0);
+
+    EncodeBitstreamParams secondParams;
+    QByteArray second = encode(*entity, secondParams);
+    QCOMPARE(secondParams.encodedDataHits, 1);
+    QCOMPARE(secondParams.encodedDataMisses, 0);
+    QCOMPARE(second, first);
+}
+
+void EntityEncodingCacheTests::invalidatedByChanges() {
+    auto entity = std::make_shared<TestShapeEntityItem>();
+    EncodeBitstreamParams params;
+    encode(*entity, params);
+
+    // after each change the next encode misses, and the one after it reuses what that encode kept
+    auto encodedAfresh = [&] {
+        EncodeBitstreamParams changedParams;
+        QByteArray changed = encode(*entity, changedParams);
+        EncodeBitstreamParams againParams;
+        QByteArray again = encode(*entity, againParams);
+        return changedParams.encodedDataMisses == 1 && changedParams.encodedDataHits == 0 &&
+            againParams.encodedDataHits == 1 && again == changed;
+    };
+
+    entity->setLastEdited(entity->getLastEdited() + 1);
+    QVERIFY2(encodedAfresh(), "lastEdited");
+
+    entity->markAsChangedOnServer();
+    QVERIFY2(encodedAfresh(), "lastChangedOnServer");
+
+    entity->update(entity->getLastUpdated() + 1);
+    QVERIFY2(encodedAfresh(), "lastUpdated");
+
+    entity->setLastSimulated(entity->getLastSimulated() + 1);
+    QVERIFY2(encodedAfresh(), "lastSimulated");
+
+    entity->withoutColor = true;
+    QVERIFY2(encodedAfresh(), "requested properties");
+}
+
+void EntityEncodingCacheTests::countedPerPass() {
+    const int NUM_ENTITIES = 4;
+    std::vector<std::shared_ptr<TestShapeEntityItem>> entities;
+    for (int i = 0; i < NUM_ENTITIES; i++) {
+        entities.push_back(std::make_shared<TestShapeEntityItem>());
+    }
+
+    // the first viewer's pass encodes everything
+    EncodeBitstreamParams firstPass;
+    for (const auto& entity : entities) {
+        encode(*entity, firstPass);
+    }
+    QCOMPARE(firstPass.encodedDataMisses, NUM_ENTITIES);
+    QCOMPARE(firstPass.encodedDataHits, 0);
+
+    // the next pass counts from zero, and only the entity that changed since is encoded again
+    entities[0]->setLastEdited(entities[0]->getLastEdited() + 1);
+    EncodeBitstreamParams secondPass;
+    for (const auto& entity : entities) {
+        encode(*entity, secondPass);
+    }
+    QCOMPARE(secondPass.encodedDataMisses, 1);
+    QCOMPARE(secondPass.encodedDataHits, NUM_ENTITIES - 1);
+}
@@ -0,0 +1,29 @@
+//
+//  EntityEncodingCacheTests.h
+//  tests/octree/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityEncodingCacheTests_h
+#define hifi_EntityEncodingCacheTests_h
+
+#include <QtTest/QtTest>
+
+class EntityEncodingCacheTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that an unchanged entity is copied from its kept encoding, byte for byte
+    void reusedWhileUnchanged();
+
+    // Test that each time stamp in the key, and the requested properties, force a fresh encode when they change
+    void invalidatedByChanges();
+
+    // Test that the hit and miss counts belong to the pass that made them
+    void countedPerPass();
+};
+
+#endif // hifi_EntityEncodingCacheTests_h
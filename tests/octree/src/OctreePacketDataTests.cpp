@@ -0,0 +1,140 @@
+//
+//  OctreePacketDataTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreePacketDataTests.h"
+
+#include <memory>
+
+#include <EntityItemProperties.h>
+#include <NumericalConstants.h>
+#include <OctreePacketData.h>
+#include <SharedUtil.h>
+
+QTEST_MAIN(OctreePacketDataTests)
+
+// Encodes a mix of entities the way a typical domain's content looks: mostly boxes and models with default physics,
+// some with user data, names and urls. Every property is included, as in the first packet a client gets for an entity.
+static QVector<QByteArray> makeEntityPayloads(int numEntities) {
+    QVector<QByteArray> payloads;
+    for (int i = 0; i < numEntities; i++) {
+        EntityItemProperties properties;
+        switch (i % 4) {
+            case 0:
+                properties.setType(EntityTypes::Box);
+                properties.setColor({ 255, (uint8_t)(i % 256), 0 });
+                break;
+            case 1:
+                properties.setType(EntityTypes::Model);
+                properties.setModelURL(QString("http://hifi-content.s3.amazonaws.com/models/furniture/chair%1.fbx").arg(i % 7));
+                properties.setShapeType(SHAPE_TYPE_SIMPLE_COMPOUND);
+                break;
+            case 2:
+                properties.setType(EntityTypes::Model);
+                properties.setModelURL(QString("atp:/%1.fbx").arg(QUuid::createUuid().toString().mid(1, 36)));
+                properties.setUserData("{\"grabbableKey\":{\"grabbable\":false}}");
+                break;
+            default:
+                properties.setType(EntityTypes::Light);
+                properties.setIntensity(2.0f);
+                break;
+        }
+        properties.setName(i % 3 == 0 ? QString("Item %1").arg(i) : QString());
+        properties.setPosition(glm::vec3(randFloatInRange(-100.0f, 100.0f), randFloatInRange(0.0f, 10.0f),
+            randFloatInRange(-100.0f, 100.0f)));
+        properties.setDimensions(glm::vec3(randFloatInRange(0.1f, 2.0f)));
+        properties.markAllChanged();
+
+        QByteArray buffer(MAX_OCTREE_PACKET_DATA_SIZE, 0);
+        if (EntityItemProperties::encodeEntityEditPacket(PacketType::EntityAdd, QUuid::createUuid(), properties, buffer)) {
+            payloads.push_back(buffer);
+        }
+    }
+    return payloads;
+}
+
+// Packs the payloads into as few sections as they fit into, returns the number of payloads in each section
+static QVector<int> packSections(const QVector<QByteArray>& payloads, bool useDictionary,
+        std::vector<std::unique_ptr<OctreePacketData>>& sections) {
+    QVector<int> payloadsPerSection;
+    for (const auto& payload : payloads) {
+        if (sections.empty() || !sections.back()->appendRawData(payload)) {
+            sections.emplace_back(new OctreePacketData(true, MAX_OCTREE_PACKET_DATA_SIZE, useDictionary));
+            payloadsPerSection.push_back(0);
+            if (!sections.back()->appendRawData(payload)) {
+                continue;
+            }
+        }
+        payloadsPerSection.back()++;
+    }
+    return payloadsPerSection;
+}
+
+void OctreePacketDataTests::dictionaryRoundTrip() {
+    const int NUM_ENTITIES = 40;
+    QVector<QByteArray> payloads = makeEntityPayloads(NUM_ENTITIES);
+
+    std::vector<std::unique_ptr<OctreePacketData>> sections;
+    packSections(payloads, true, sections);
+    QVERIFY(!sections.empty());
+
+    for (auto& section : sections) {
+        QVERIFY(section->usesDictionary());
+        int finalizedSize = section->getFinalizedSize();
+        QVERIFY(finalizedSize > 0);
+        QVERIFY(finalizedSize < section->getUncompressedSize());
+
+        OctreePacketData received(true, MAX_OCTREE_PACKET_DATA_SIZE, true);
+        received.loadFinalizedContent(section->getFinalizedData(), finalizedSize);
+        QCOMPARE(received.getUncompressedSize(), section->getUncompressedSize());
+        QVERIFY(memcmp(received.getUncompressedData(), section->getUncompressedData(), section->getUncompressedSize()) == 0);
+    }
+}
+
+void OctreePacketDataTests::dictionaryMismatch() {
+    QVector<QByteArray> payloads = makeEntityPayloads(4);
+    std::vector<std::unique_ptr<OctreePacketData>> sections;
+    packSections(payloads, true, sections);
+    QCOMPARE((int)sections.size(), 1);
+
+    QByteArray finalized((const char*)sections[0]->getFinalizedData(), sections[0]->getFinalizedSize());
+
+    // the zlib header is followed by the big endian checksum of the dictionary, a receiver with a different
+    // dictionary must drop the section instead of decoding garbage
+    const int DICTIONARY_ID_OFFSET = 2;
+    finalized[DICTIONARY_ID_OFFSET] = finalized[DICTIONARY_ID_OFFSET] ^ 0xFF;
+    OctreePacketData received(true, MAX_OCTREE_PACKET_DATA_SIZE, true);
+    received.loadFinalizedContent((const unsigned char*)finalized.constData(), finalized.size());
+    QCOMPARE(received.getUncompressedSize(), 0);
+}
+
+void OctreePacketDataTests::compressionBenchmark() {
+    const int NUM_ENTITIES = 2000;
+    QVector<QByteArray> payloads = makeEntityPayloads(NUM_ENTITIES);
+
+    int compressedBytes[2] = { 0, 0 };
+    for (int useDictionary = 0; useDictionary < 2; useDictionary++) {
+        std::vector<std::unique_ptr<OctreePacketData>> sections;
+        QVector<int> payloadsPerSection = packSections(payloads, useDictionary != 0, sections);
+
+        int numEntities = 0;
+        auto start = usecTimestampNow();
+        for (size_t i = 0; i < sections.size(); i++) {
+            compressedBytes[useDictionary] += sections[i]->getFinalizedSize();
+            numEntities += payloadsPerSection[(int)i];
+        }
+        auto duration = usecTimestampNow() - start;
+
+        qDebug() << (useDictionary ? "zlib with dictionary:" : "qCompress:") << sections.size() << "sections,"
+            << (float)compressedBytes[useDictionary] / numEntities << "bytes per entity,"
+            << (float)duration / sections.size() << "usecs per section";
+    }
+
+    QVERIFY(compressedBytes[1] < compressedBytes[0]);
+}
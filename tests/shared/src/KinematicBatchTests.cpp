@@ -0,0 +1,131 @@
+//
+//  KinematicBatchTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "KinematicBatchTests.h"
+
+#include <random>
+
+#include <KinematicBatch.h>
+#include <NumericalConstants.h>
+#include <PhysicsHelpers.h>
+#include <SharedUtil.h>
+
+#include <../GLMTestUtils.h>
+#include <../QTestExtensions.h>
+
+QTEST_MAIN(KinematicBatchTests)
+
+const float EPSILON = 1.0e-5f;
+const float TIME_STEP = 1.0f / 90.0f;
+
+static Transform makeTransform(const glm::vec3& position) {
+    Transform transform;
+    transform.setTranslation(position);
+    return transform;
+}
+
+void KinematicBatchTests::testSingleObject() {
+    KinematicBatch batch;
+    batch.add(makeTransform(glm::vec3(1.0f, 2.0f, 3.0f)), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f),
+        glm::vec3(0.0f, -10.0f, 0.0f), 1.0f, TIME_STEP); // falling
+    batch.add(makeTransform(glm::vec3(0.0f)), glm::vec3(0.5f * KINEMATIC_LINEAR_SPEED_THRESHOLD, 0.0f, 0.0f),
+        glm::vec3(0.0f), glm::vec3(0.0f), 1.0f, TIME_STEP); // too slow, stops
+    batch.add(makeTransform(glm::vec3(0.0f)), glm::vec3(0.0f), glm::vec3(0.0f),
+        glm::vec3(0.0f, -10.0f, 0.0f), 1.0f, TIME_STEP); // at rest, acceleration alone does not move it
+    QCOMPARE((int)batch.size(), 3);
+    batch.step();
+
+    // the position uses the velocity from the start of the step, like Bullet
+    QCOMPARE_WITH_ABS_ERROR(batch.getTransform(0).getTranslation(), glm::vec3(1.0f + TIME_STEP, 2.0f, 3.0f), EPSILON);
+    QCOMPARE_WITH_ABS_ERROR(batch.getVelocity(0), glm::vec3(1.0f, -10.0f * TIME_STEP, 0.0f), EPSILON);
+    QCOMPARE_WITH_ABS_ERROR(batch.getAngularVelocity(0), glm::vec3(0.0f, 1.0f, 0.0f), EPSILON);
+
+    QCOMPARE_WITH_ABS_ERROR(batch.getTransform(1).getTranslation(), glm::vec3(0.0f), EPSILON);
+    QCOMPARE_WITH_ABS_ERROR(batch.getVelocity(1), glm::vec3(0.0f), EPSILON);
+
+    QCOMPARE_WITH_ABS_ERROR(batch.getTransform(2).getTranslation(), glm::vec3(0.0f), EPSILON);
+    QCOMPARE_WITH_ABS_ERROR(batch.getVelocity(2), glm::vec3(0.0f), EPSILON);
+}
+
+void KinematicBatchTests::testAgreesWithStepLinearMotion() {
+    std::mt19937 generator(1234);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::uniform_int_distribution<int> choice(0, 4);
+
+    // a mix of fast, slow, stopped, accelerating and damped objects, so every branch is taken
+    const int NUM_OBJECTS = 1001;
+    const float SPEEDS[] = { 0.0f, 0.5f * KINEMATIC_LINEAR_SPEED_THRESHOLD, 2.0f * KINEMATIC_LINEAR_SPEED_THRESHOLD, 1.0f, 20.0f };
+    const float ACCELERATIONS[] = { 0.0f, 0.005f, 0.1f, 1.0f, 10.0f };
+    KinematicBatch batch;
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec3> velocities;
+    std::vector<glm::vec3> accelerations;
+    std::vector<float> dampingFactors;
+    for (int i = 0; i < NUM_OBJECTS; i++) {
+        glm::vec3 position = 10.0f * glm::vec3(unit(generator), unit(generator), unit(generator));
+        glm::vec3 velocity = SPEEDS[choice(generator)] * glm::vec3(unit(generator), unit(generator), unit(generator));
+        glm::vec3 acceleration = ACCELERATIONS[choice(generator)] * glm::vec3(unit(generator), unit(generator), unit(generator));
+        float dampingFactor = (i % 3 == 0) ? 1.0f : powf(1.0f - 0.39347f, TIME_STEP);
+        batch.add(makeTransform(position), velocity, glm::vec3(0.0f), acceleration, dampingFactor, TIME_STEP);
+        positions.push_back(position);
+        velocities.push_back(velocity);
+        accelerations.push_back(acceleration);
+        dampingFactors.push_back(dampingFactor);
+    }
+    batch.step();
+
+    for (int i = 0; i < NUM_OBJECTS; i++) {
+        KinematicBatch::stepLinearMotion(positions[i], velocities[i], accelerations[i], dampingFactors[i], TIME_STEP);
+        QCOMPARE_WITH_ABS_ERROR(batch.getTransform(i).getTranslation(), positions[i], EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(batch.getVelocity(i), velocities[i], EPSILON);
+    }
+}
+
+void KinematicBatchTests::stepBenchmark() {
+    std::mt19937 generator(1234);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+    const int NUM_OBJECTS = 10000;
+    const int NUM_STEPS = 100;
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec3> velocities;
+    for (int i = 0; i < NUM_OBJECTS; i++) {
+        positions.push_back(10.0f * glm::vec3(unit(generator), unit(generator), unit(generator)));
+        velocities.push_back(glm::vec3(unit(generator), unit(generator), unit(generator)));
+    }
+    const glm::vec3 GRAVITY(0.0f, -9.8f, 0.0f);
+    const float DAMPING_FACTOR = powf(1.0f - 0.39347f, TIME_STEP);
+
+    auto start = usecTimestampNow();
+    for (int j = 0; j < NUM_STEPS; j++) {
+        for (int i = 0; i < NUM_OBJECTS; i++) {
+            KinematicBatch::stepLinearMotion(positions[i], velocities[i], GRAVITY, DAMPING_FACTOR, TIME_STEP);
+        }
+    }
+    auto oneAtATime = usecTimestampNow() - start;
+
+    KinematicBatch batch;
+    batch.reserve(NUM_OBJECTS);
+    start = usecTimestampNow();
+    for (int j = 0; j < NUM_STEPS; j++) {
+        // refilled every step, as EntitySimulation does
+        batch.clear();
+        for (int i = 0; i < NUM_OBJECTS; i++) {
+            batch.add(makeTransform(positions[i]), velocities[i], glm::vec3(0.0f), GRAVITY, DAMPING_FACTOR, TIME_STEP);
+        }
+        batch.step();
+    }
+    auto batched = usecTimestampNow() - start;
+
+    qDebug() << "Stepped" << NUM_OBJECTS << "objects" << NUM_STEPS << "times:"
+        << (float)oneAtATime / USECS_PER_MSEC << "ms one at a time,"
+        << (float)batched / USECS_PER_MSEC << "ms batched including the refill";
+    QCOMPARE((int)batch.size(), NUM_OBJECTS);
+}
@@ -0,0 +1,159 @@
+//
+//  ParticleStoreTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ParticleStoreTests.h"
+
+#include <deque>
+#include <random>
+
+#include <NumericalConstants.h>
+#include <ParticleStore.h>
+#include <SharedUtil.h>
+
+#include <../GLMTestUtils.h>
+#include <../QTestExtensions.h>
+
+QTEST_MAIN(ParticleStoreTests)
+
+const float EPSILON = 1.0e-5f;
+const float TIME_STEP = 1.0f / 60.0f;
+
+void ParticleStoreTests::testExpire() {
+    ParticleStore store;
+    const int NUM_PARTICLES = 200;
+    size_t first = store.append(NUM_PARTICLES);
+    QCOMPARE((int)first, 0);
+    for (int i = 0; i < NUM_PARTICLES; i++) {
+        store.set(i, (float)i, (uint64_t)(i + 1), glm::vec3((float)i), glm::vec3(0.0f), glm::vec3(0.0f));
+    }
+
+    // the oldest particles go first
+    store.expire(100, NUM_PARTICLES);
+    QCOMPARE((int)store.size(), NUM_PARTICLES - 100);
+    QCOMPARE(store.getSeed(0), 100.0f);
+    QCOMPARE_WITH_ABS_ERROR(store.getPosition(0), glm::vec3(100.0f), EPSILON);
+
+    // then the ones over the maximum
+    store.expire(100, 50);
+    QCOMPARE((int)store.size(), 50);
+    QCOMPARE(store.getSeed(0), 150.0f);
+
+    // appended particles land after the ones left
+    first = store.append(1);
+    QCOMPARE((int)first, 50);
+    store.set(first, -1.0f, 1000, glm::vec3(0.0f), glm::vec3(0.0f), glm::vec3(0.0f));
+    QCOMPARE(store.getSeed(49), 199.0f);
+    QCOMPARE(store.getSeed(50), -1.0f);
+
+    store.expire(1000, NUM_PARTICLES);
+    QVERIFY(store.empty());
+}
+
+void ParticleStoreTests::testAgreesWithIntegrateParticle() {
+    std::mt19937 generator(1234);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+    // an odd count, and an expired front, so neither the SIMD path nor the remainder starts aligned
+    const int NUM_PARTICLES = 1003;
+    const int NUM_EXPIRED = 5;
+    ParticleStore store;
+    store.append(NUM_PARTICLES);
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec3> velocities;
+    std::vector<glm::vec3> accelerations;
+    for (int i = 0; i < NUM_PARTICLES; i++) {
+        glm::vec3 position = 10.0f * glm::vec3(unit(generator), unit(generator), unit(generator));
+        glm::vec3 velocity = glm::vec3(unit(generator), unit(generator), unit(generator));
+        glm::vec3 acceleration = glm::vec3(0.0f, -9.8f * unit(generator), 0.0f);
+        store.set(i, unit(generator), (uint64_t)i, position, velocity, acceleration);
+        if (i >= NUM_EXPIRED) {
+            positions.push_back(position);
+            velocities.push_back(velocity);
+            accelerations.push_back(acceleration);
+        }
+    }
+    store.expire(NUM_EXPIRED - 1, NUM_PARTICLES);
+    QCOMPARE((int)store.size(), NUM_PARTICLES - NUM_EXPIRED);
+
+    const int NUM_STEPS = 3;
+    for (int j = 0; j < NUM_STEPS; j++) {
+        store.integrate(TIME_STEP);
+    }
+
+    for (size_t i = 0; i < positions.size(); i++) {
+        float lifetime = 0.0f;
+        for (int j = 0; j < NUM_STEPS; j++) {
+            ParticleStore::integrateParticle(positions[i], velocities[i], accelerations[i], lifetime, TIME_STEP);
+        }
+        QCOMPARE_WITH_ABS_ERROR(store.getPosition(i), positions[i], EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(store.getVelocity(i), velocities[i], EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(store.getLifetime(i), lifetime, EPSILON);
+    }
+}
+
+void ParticleStoreTests::integrateBenchmark() {
+    std::mt19937 generator(1234);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+    // particles stored one struct at a time, the way they used to be
+    struct Particle {
+        float seed;
+        uint64_t expiration;
+        float lifetime;
+        glm::vec3 position;
+        glm::vec3 velocity;
+        glm::vec3 acceleration;
+    };
+
+    const int NUM_EMITTERS = 100;
+    const int NUM_PARTICLES = 5000;
+    const int NUM_STEPS = 10;
+    std::vector<std::deque<Particle>> emitters(NUM_EMITTERS);
+    std::vector<ParticleStore> stores(NUM_EMITTERS);
+    for (int e = 0; e < NUM_EMITTERS; e++) {
+        stores[e].append(NUM_PARTICLES);
+        for (int i = 0; i < NUM_PARTICLES; i++) {
+            Particle particle;
+            particle.seed = unit(generator);
+            particle.expiration = (uint64_t)(i + 1);
+            particle.lifetime = 0.0f;
+            particle.position = glm::vec3(unit(generator), unit(generator), unit(generator));
+            particle.velocity = glm::vec3(unit(generator), unit(generator), unit(generator));
+            particle.acceleration = glm::vec3(0.0f, -9.8f, 0.0f);
+            emitters[e].push_back(particle);
+            stores[e].set(i, particle.seed, particle.expiration, particle.position, particle.velocity,
+                particle.acceleration);
+        }
+    }
+
+    auto start = usecTimestampNow();
+    for (int j = 0; j < NUM_STEPS; j++) {
+        for (auto& particles : emitters) {
+            for (auto& particle : particles) {
+                ParticleStore::integrateParticle(particle.position, particle.velocity, particle.acceleration,
+                    particle.lifetime, TIME_STEP);
+            }
+        }
+    }
+    auto oneAtATime = usecTimestampNow() - start;
+
+    start = usecTimestampNow();
+    for (int j = 0; j < NUM_STEPS; j++) {
+        for (auto& store : stores) {
+            store.integrate(TIME_STEP);
+        }
+    }
+    auto batched = usecTimestampNow() - start;
+
+    qDebug() << "Integrated" << NUM_EMITTERS << "emitters of" << NUM_PARTICLES << "particles" << NUM_STEPS << "times:"
+        << (float)oneAtATime / USECS_PER_MSEC << "ms one at a time,"
+        << (float)batched / USECS_PER_MSEC << "ms from the stores";
+    QCOMPARE_WITH_ABS_ERROR(stores[0].getPosition(0), emitters[0][0].position, EPSILON);
+}
@@ -0,0 +1,24 @@
+//
+//  ParticleStoreTests.h
+//  tests/shared/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ParticleStoreTests_h
+#define hifi_ParticleStoreTests_h
+
+#include <QtTest/QtTest>
+
+class ParticleStoreTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testExpire();
+    void testAgreesWithIntegrateParticle();
+    void integrateBenchmark();
+};
+
+#endif // hifi_ParticleStoreTests_h
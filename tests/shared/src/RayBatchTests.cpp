@@ -0,0 +1,100 @@
+//
+//  RayBatchTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "RayBatchTests.h"
+
+#include <random>
+
+#include <AABox.h>
+#include <RayBatch.h>
+
+QTEST_MAIN(RayBatchTests)
+
+void RayBatchTests::testAxisAlignedRays() {
+    const glm::vec3 corner(-1.0f);
+    const glm::vec3 scale(2.0f);
+
+    RayBatch rays;
+    rays.addRay(glm::vec3(0.0f, 0.0f, -5.0f), glm::vec3(0.0f, 0.0f, 1.0f)); // toward the box
+    rays.addRay(glm::vec3(0.0f, 0.0f, -5.0f), glm::vec3(0.0f, 0.0f, -1.0f)); // away from the box
+    rays.addRay(glm::vec3(0.5f), glm::vec3(1.0f, 0.0f, 0.0f)); // from the inside
+    rays.addRay(glm::vec3(5.0f, 0.5f, 0.5f), glm::vec3(-1.0f, 0.0f, 0.0f)); // toward the box
+    rays.addRay(glm::vec3(5.0f, 2.0f, 0.5f), glm::vec3(-1.0f, 0.0f, 0.0f)); // parallel to the box, outside of it
+    QCOMPARE((int)rays.size(), 5);
+
+    std::vector<uint8_t> active(rays.size(), 1);
+    std::vector<uint8_t> hits(rays.size(), 0);
+    QCOMPARE(rays.intersectBox(corner, scale, active.data(), hits.data()), 3);
+    QCOMPARE((int)hits[0], 1);
+    QCOMPARE((int)hits[1], 0);
+    QCOMPARE((int)hits[2], 1);
+    QCOMPARE((int)hits[3], 1);
+    QCOMPARE((int)hits[4], 0);
+}
+
+void RayBatchTests::testInactiveRays() {
+    RayBatch rays;
+    for (int i = 0; i < 6; i++) {
+        rays.addRay(glm::vec3(0.0f, 0.0f, -5.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+    }
+
+    std::vector<uint8_t> active = { 1, 0, 1, 0, 0, 1 };
+    std::vector<uint8_t> hits(rays.size(), 1);
+    QCOMPARE(rays.intersectBox(glm::vec3(-1.0f), glm::vec3(2.0f), active.data(), hits.data()), 3);
+    for (size_t i = 0; i < hits.size(); i++) {
+        QCOMPARE(hits[i], active[i]);
+    }
+}
+
+void RayBatchTests::testAgreesWithAABox() {
+    // the batch test may report extra hits, but must never miss a ray that AABox says intersects
+    std::mt19937 generator(1234);
+    std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> size(0.1f, 5.0f);
+
+    const int NUM_RAYS = 1000;
+    const int NUM_BOXES = 100;
+    RayBatch rays;
+    std::vector<glm::vec3> origins;
+    std::vector<glm::vec3> directions;
+    for (int i = 0; i < NUM_RAYS; i++) {
+        glm::vec3 origin(position(generator), position(generator), position(generator));
+        glm::vec3 direction(position(generator), position(generator), position(generator));
+        if (i % 10 == 0) {
+            // exercise rays that are parallel to one of the slabs
+            direction[i % 3] = 0.0f;
+        }
+        direction = glm::normalize(direction);
+        origins.push_back(origin);
+        directions.push_back(direction);
+        rays.addRay(origin, direction);
+    }
+
+    std::vector<uint8_t> active(NUM_RAYS, 1);
+    std::vector<uint8_t> hits(NUM_RAYS, 0);
+    int numExactHits = 0;
+    int numBatchHits = 0;
+    for (int j = 0; j < NUM_BOXES; j++) {
+        AABox box(glm::vec3(position(generator), position(generator), position(generator)),
+            glm::vec3(size(generator), size(generator), size(generator)));
+        numBatchHits += rays.intersectBox(box.getCorner(), box.getScale(), active.data(), hits.data());
+        for (int i = 0; i < NUM_RAYS; i++) {
+            float distance;
+            BoxFace face;
+            glm::vec3 normal;
+            if (box.findRayIntersection(origins[i], directions[i], distance, face, normal)) {
+                numExactHits++;
+                QVERIFY(hits[i]);
+            }
+        }
+    }
+    QVERIFY(numExactHits > 0);
+    QVERIFY(numBatchHits >= numExactHits);
+}
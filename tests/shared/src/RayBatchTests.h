@@ -0,0 +1,24 @@
+//
+//  RayBatchTests.h
+//  tests/shared/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_RayBatchTests_h
+#define hifi_RayBatchTests_h
+
+#include <QtTest/QtTest>
+
+class RayBatchTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testAxisAlignedRays();
+    void testInactiveRays();
+    void testAgreesWithAABox();
+};
+
+#endif // hifi_RayBatchTests_h
@@ -0,0 +1,152 @@
+//
+//  SpatiallyNestableTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SpatiallyNestableTests.h"
+
+#include <QtTest/QtTest>
+
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+#include <SpatiallyNestable.h>
+
+#include "../GLMTestUtils.h"
+#include "../QTestExtensions.h"
+
+QTEST_MAIN(SpatiallyNestableTests)
+
+const float EPSILON = 0.0001f;
+
+class TestParentFinder : public SpatialParentFinder {
+public:
+    SpatiallyNestableWeakPointer find(QUuid parentID, bool& success, SpatialParentTree* entityTree = nullptr) const override {
+        success = true;
+        return parentID.isNull() ? SpatiallyNestableWeakPointer() : nestables.value(parentID);
+    }
+
+    QHash<QUuid, SpatiallyNestableWeakPointer> nestables;
+};
+
+static SpatiallyNestablePointer makeNestable(const QUuid& parentID = QUuid()) {
+    auto nestable = std::make_shared<SpatiallyNestable>(NestableType::Entity, QUuid::createUuid());
+    auto parentFinder = DependencyManager::get<SpatialParentFinder>();
+    static_cast<TestParentFinder*>(parentFinder.data())->nestables[nestable->getID()] = nestable;
+    nestable->setParentID(parentID);
+    return nestable;
+}
+
+void SpatiallyNestableTests::initTestCase() {
+    DependencyManager::registerInheritance<SpatialParentFinder, TestParentFinder>();
+    DependencyManager::set<TestParentFinder>();
+}
+
+void SpatiallyNestableTests::cachedWorldTransformTest() {
+    auto root = makeNestable();
+    auto middle = makeNestable(root->getID());
+    auto leaf = makeNestable(middle->getID());
+
+    const glm::quat QUARTER_TURN = glm::angleAxis(PI / 2.0f, Vectors::UNIT_Y);
+
+    root->setPosition(glm::vec3(10.0f, 0.0f, 0.0f));
+    root->setOrientation(QUARTER_TURN);
+    middle->setLocalPosition(glm::vec3(1.0f, 0.0f, 0.0f));
+    leaf->setLocalPosition(glm::vec3(0.0f, 0.0f, 2.0f));
+
+    // first read fills the caches, the second comes from them
+    for (int i = 0; i < 2; ++i) {
+        QCOMPARE_WITH_ABS_ERROR(leaf->getPosition(), glm::vec3(12.0f, 0.0f, -1.0f), EPSILON);
+        QCOMPARE_QUATS(leaf->getOrientation(), QUARTER_TURN, EPSILON);
+    }
+
+    // moving an ancestor reaches the leaf
+    root->setPosition(glm::vec3(0.0f, 5.0f, 0.0f));
+    QCOMPARE_WITH_ABS_ERROR(leaf->getPosition(), glm::vec3(2.0f, 5.0f, -1.0f), EPSILON);
+
+    middle->setLocalOrientation(QUARTER_TURN);
+    QCOMPARE_WITH_ABS_ERROR(leaf->getPosition(), glm::vec3(0.0f, 5.0f, -3.0f), EPSILON);
+    QCOMPARE_QUATS(leaf->getOrientation(), QUARTER_TURN * QUARTER_TURN, EPSILON);
+
+    // so does reparenting, for the object and everything under it
+    auto other = makeNestable();
+    other->setPosition(glm::vec3(-3.0f, 0.0f, 0.0f));
+    middle->setParentID(other->getID());
+    QCOMPARE_WITH_ABS_ERROR(middle->getPosition(), glm::vec3(-2.0f, 0.0f, 0.0f), EPSILON);
+    QCOMPARE_WITH_ABS_ERROR(leaf->getPosition(), glm::vec3(0.0f, 0.0f, 0.0f), EPSILON);
+
+    middle->setParentID(QUuid());
+    QCOMPARE_WITH_ABS_ERROR(leaf->getPosition(), glm::vec3(3.0f, 0.0f, 0.0f), EPSILON);
+
+    // and setting a world position on a child is relative to its cached parent
+    leaf->setPosition(glm::vec3(0.0f, 1.0f, 0.0f));
+    QCOMPARE_WITH_ABS_ERROR(leaf->getLocalPosition(), glm::vec3(0.0f, 1.0f, -1.0f), EPSILON);
+    QCOMPARE_WITH_ABS_ERROR(leaf->getPosition(), glm::vec3(0.0f, 1.0f, 0.0f), EPSILON);
+}
+
+void SpatiallyNestableTests::nestedTransformBenchmark() {
+    // 10k nestables in chains of 20, the deepest that stays well clear of the parenting loop check
+    static const int NUM_CHAINS = 500;
+    static const int CHAIN_DEPTH = 20;
+    static const int NUM_PASSES = 10;
+
+    std::vector<SpatiallyNestablePointer> roots;
+    std::vector<SpatiallyNestablePointer> nestables;
+    for (int i = 0; i < NUM_CHAINS; ++i) {
+        auto parent = makeNestable();
+        parent->setPosition(glm::vec3((float)i, 0.0f, 0.0f));
+        roots.push_back(parent);
+        nestables.push_back(parent);
+
+        for (int j = 1; j < CHAIN_DEPTH; ++j) {
+            auto child = makeNestable(parent->getID());
+            child->setLocalPosition(glm::vec3(0.0f, 1.0f, 0.0f));
+            nestables.push_back(child);
+            parent = child;
+        }
+    }
+
+    auto readAll = [&] {
+        glm::vec3 sum;
+        for (auto& nestable : nestables) {
+            sum += nestable->getPosition();
+        }
+        return sum;
+    };
+
+    auto start = usecTimestampNow();
+    readAll();
+    auto coldDuration = usecTimestampNow() - start;
+
+    start = usecTimestampNow();
+    glm::vec3 sum;
+    for (int i = 0; i < NUM_PASSES; ++i) {
+        sum = readAll();
+    }
+    auto cachedDuration = (usecTimestampNow() - start) / NUM_PASSES;
+
+    // every chain is a column from y = 0 to y = CHAIN_DEPTH - 1 above its root
+    glm::vec3 expected((float)(CHAIN_DEPTH * NUM_CHAINS * (NUM_CHAINS - 1) / 2),
+                       (float)(NUM_CHAINS * CHAIN_DEPTH * (CHAIN_DEPTH - 1) / 2), 0.0f);
+    QCOMPARE_WITH_ABS_ERROR(sum, expected, 1.0f);
+
+    // move every root, which dirties everything again
+    start = usecTimestampNow();
+    for (auto& root : roots) {
+        root->setPosition(root->getPosition() + glm::vec3(0.0f, 0.0f, 1.0f));
+    }
+    auto dirtyDuration = usecTimestampNow() - start;
+
+    start = usecTimestampNow();
+    sum = readAll();
+    auto recomputeDuration = usecTimestampNow() - start;
+    QCOMPARE_WITH_ABS_ERROR(sum.z, (float)(NUM_CHAINS * CHAIN_DEPTH), 1.0f);
+
+    qDebug() << "Reading" << nestables.size() << "nested world positions took" << coldDuration << "us cold and"
+        << cachedDuration << "us cached. Moving the roots took" << dirtyDuration << "us, reading after that took"
+        << recomputeDuration << "us";
+}
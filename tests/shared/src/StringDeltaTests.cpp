@@ -0,0 +1,168 @@
+//
+//  StringDeltaTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "StringDeltaTests.h"
+
+#include <algorithm>
+#include <random>
+
+#include <SharedUtil.h>
+#include <StringDelta.h>
+
+QTEST_MAIN(StringDeltaTests)
+
+static QByteArray makeUserData(int numKeys, int version) {
+    QByteArray userData = "{";
+    for (int i = 0; i < numKeys; i++) {
+        userData += QString("\"key%1\":{\"value\":%2,\"label\":\"setting number %1\"},").arg(i).arg(i * 7).toUtf8();
+    }
+    userData += QString("\"version\":%1}").arg(version).toUtf8();
+    return userData;
+}
+
+static void checkRoundTrip(const QByteArray& base, const QByteArray& target) {
+    QByteArray delta = StringDelta::diff(base, target);
+    QByteArray result;
+    QVERIFY(StringDelta::patch(base, delta, result));
+    QCOMPARE(result, target);
+}
+
+void StringDeltaTests::testRoundTrip() {
+    QByteArray base = makeUserData(20, 1);
+
+    checkRoundTrip(base, base);
+    checkRoundTrip(base, QByteArray());
+    checkRoundTrip(QByteArray(), base);
+    checkRoundTrip(base, makeUserData(20, 2));
+    checkRoundTrip(base, "short");
+
+    // an edit in the middle, text moved to the front, and text appended
+    QByteArray target = base;
+    target.replace(200, 10, "something else entirely");
+    checkRoundTrip(base, target);
+    checkRoundTrip(base, base.mid(300) + base.left(300));
+    checkRoundTrip(base, base + base.left(100));
+
+    // an unchanged value costs a few bytes however long it is
+    QVERIFY(StringDelta::diff(base, base).size() < 16);
+
+    std::mt19937 generator(7);
+    std::uniform_int_distribution<int> byteDistribution(0, 255);
+    for (int i = 0; i < 100; i++) {
+        QByteArray random(1 + (int)(generator() % 2000), 0);
+        for (int j = 0; j < random.size(); j++) {
+            random[j] = (char)byteDistribution(generator);
+        }
+        QByteArray changed = random;
+        int position = (int)(generator() % changed.size());
+        changed.insert(position, random.mid(0, (int)(generator() % 50)));
+        checkRoundTrip(random, changed);
+    }
+}
+
+void StringDeltaTests::testMismatchedBase() {
+    QByteArray base = makeUserData(20, 1);
+    QByteArray delta = StringDelta::diff(base, makeUserData(20, 2));
+
+    // a base of the same length with different contents is caught by the checksum
+    QByteArray otherBase = base;
+    otherBase[10] = 'x';
+    QByteArray result = "untouched";
+    QVERIFY(!StringDelta::patch(otherBase, delta, result));
+    QVERIFY(!StringDelta::patch(makeUserData(21, 1), delta, result));
+    QCOMPARE(result, QByteArray("untouched"));
+}
+
+void StringDeltaTests::testMalformedDelta() {
+    QByteArray base = makeUserData(20, 1);
+    QByteArray delta = StringDelta::diff(base, makeUserData(20, 2));
+
+    QByteArray result;
+    QVERIFY(!StringDelta::patch(base, QByteArray(), result));
+    for (int length = 0; length < delta.size(); length++) {
+        QVERIFY(!StringDelta::patch(base, delta.left(length), result));
+    }
+    QVERIFY(!StringDelta::patch(base, delta + "extra", result));
+}
+
+static void appendVarint(QByteArray& bytes, quint32 value) {
+    while (value >= 0x80) {
+        bytes.append((char)((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    bytes.append((char)value);
+}
+
+// a delta against base with a valid header claiming the given target size, followed by the given ops
+static QByteArray makeHeader(const QByteArray& base, quint32 targetSize) {
+    QByteArray delta;
+    appendVarint(delta, (quint32)base.size());
+    quint32 baseChecksum = StringDelta::checksum(base);
+    delta.append((const char*)&baseChecksum, sizeof(baseChecksum));
+    appendVarint(delta, targetSize);
+    return delta;
+}
+
+void StringDeltaTests::testOversizedDelta() {
+    QByteArray base = makeUserData(20, 1);
+    QByteArray result;
+
+    // a target size that passes the checksum but is bigger than any property is refused before anything is allocated
+    QVERIFY(!StringDelta::patch(base, makeHeader(base, 0x7fffffff), result));
+    QVERIFY(!StringDelta::patch(base, makeHeader(base, StringDelta::MAX_TARGET_SIZE + 1), result));
+
+    // copies that add up to more than the target size
+    QByteArray delta = makeHeader(base, StringDelta::MAX_TARGET_SIZE);
+    for (int i = 0; i < 2 * StringDelta::MAX_TARGET_SIZE / base.size(); i++) {
+        appendVarint(delta, ((quint32)base.size() << 1) | 1);
+        appendVarint(delta, 0);
+    }
+    QVERIFY(!StringDelta::patch(base, delta, result));
+
+    // a copy whose length would wrap around
+    delta = makeHeader(base, 100);
+    appendVarint(delta, 0xffffffff);
+    appendVarint(delta, 0);
+    QVERIFY(!StringDelta::patch(base, delta, result));
+
+    // the largest legal target still works
+    delta = makeHeader(base, StringDelta::MAX_TARGET_SIZE);
+    int remaining = StringDelta::MAX_TARGET_SIZE;
+    while (remaining > 0) {
+        int length = std::min(remaining, base.size());
+        appendVarint(delta, ((quint32)length << 1) | 1);
+        appendVarint(delta, 0);
+        remaining -= length;
+    }
+    QVERIFY(StringDelta::patch(base, delta, result));
+    QCOMPARE(result.size(), StringDelta::MAX_TARGET_SIZE);
+}
+
+void StringDeltaTests::userDataBenchmark() {
+    // a script that bumps a counter in a few kilobytes of userData on every edit
+    const int NUM_EDITS = 1000;
+    QByteArray base = makeUserData(60, 0);
+
+    int wholeBytes = 0;
+    int deltaBytes = 0;
+    auto start = usecTimestampNow();
+    for (int i = 1; i <= NUM_EDITS; i++) {
+        QByteArray target = makeUserData(60, i);
+        QByteArray delta = StringDelta::diff(base, target);
+        wholeBytes += target.size();
+        deltaBytes += delta.size();
+    }
+    auto elapsed = usecTimestampNow() - start;
+
+    qDebug() << "userData of" << base.size() << "bytes," << NUM_EDITS << "edits:"
+        << wholeBytes / NUM_EDITS << "bytes per edit whole," << deltaBytes / NUM_EDITS << "as deltas,"
+        << (float)elapsed / NUM_EDITS << "usecs per diff";
+    QVERIFY(deltaBytes * 10 < wholeBytes);
+}
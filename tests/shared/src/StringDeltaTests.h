@@ -0,0 +1,26 @@
+//
+//  StringDeltaTests.h
+//  tests/shared/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_StringDeltaTests_h
+#define hifi_StringDeltaTests_h
+
+#include <QtTest/QtTest>
+
+class StringDeltaTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testRoundTrip();
+    void testMismatchedBase();
+    void testMalformedDelta();
+    void testOversizedDelta();
+    void userDataBenchmark();
+};
+
+#endif // hifi_StringDeltaTests_h
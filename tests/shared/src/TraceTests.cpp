@@ -8,6 +8,10 @@
 
 #include "TraceTests.h"
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 #include <QtTest/QtTest>
 #include <QtGui/QDesktopServices>
 
@@ -45,3 +49,73 @@ void TraceTests::testTraceSerialization() {
     qDebug() << "Done";
 }
 
+
+void TraceTests::testThreadedBinaryTrace() {
+    static const int NUM_THREADS = 4;
+    static const int EVENTS_PER_THREAD = 5000;
+
+    auto tracer = DependencyManager::set<tracing::Tracer>();
+    tracer->startTracing();
+    {
+        // every thread stays alive until all have recorded, so that no two of them can be given the same thread ID
+        std::mutex finishedMutex;
+        std::condition_variable allFinished;
+        int numFinished = 0;
+
+        std::vector<std::thread> threads;
+        for (int i = 0; i < NUM_THREADS; ++i) {
+            threads.emplace_back([&] {
+                for (int j = 0; j < EVENTS_PER_THREAD / 2; ++j) {
+                    PROFILE_RANGE(test, "ThreadedEvent")
+                }
+                std::unique_lock<std::mutex> lock(finishedMutex);
+                if (++numFinished == NUM_THREADS) {
+                    allFinished.notify_all();
+                } else {
+                    allFinished.wait(lock, [&] { return numFinished == NUM_THREADS; });
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+    tracer->stopTracing();
+
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    QString path = directory.filePath("threadedTrace.htrace");
+    tracer->serialize(path);
+
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::ReadOnly));
+
+    QByteArray json;
+    QVERIFY(tracing::Tracer::binaryToJson(file.readAll(), json));
+
+    auto events = QJsonDocument::fromJson(json).array();
+    QCOMPARE(events.size(), NUM_THREADS * EVENTS_PER_THREAD);
+
+    // merged across threads by timestamp, and every begin is matched by an end on its own thread
+    qint64 lastTimestamp = 0;
+    QHash<qint64, int> openRanges;
+    for (const auto& value : events) {
+        auto event = value.toObject();
+        QCOMPARE(event["name"].toString(), QString("ThreadedEvent"));
+        QCOMPARE(event["cat"].toString(), QString("trace.test"));
+
+        qint64 timestamp = (qint64)event["ts"].toDouble();
+        QVERIFY(timestamp >= lastTimestamp);
+        lastTimestamp = timestamp;
+
+        qint64 threadID = (qint64)event["tid"].toDouble();
+        if (event["ph"].toString() == "B") {
+            ++openRanges[threadID];
+            QCOMPARE(event["args"].toObject()["nv_payload"].toInt(), 0);
+        } else {
+            QCOMPARE(event["ph"].toString(), QString("E"));
+            QVERIFY(openRanges[threadID]-- > 0);
+        }
+    }
+    QCOMPARE(openRanges.size(), NUM_THREADS);
+}
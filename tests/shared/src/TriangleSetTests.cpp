@@ -0,0 +1,156 @@
+//
+//  TriangleSetTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TriangleSetTests.h"
+
+#include <random>
+
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+#include <TriangleSet.h>
+
+#include <../GLMTestUtils.h>
+#include <../QTestExtensions.h>
+
+QTEST_MAIN(TriangleSetTests)
+
+static std::vector<Triangle> makeRandomTriangles(int numTriangles, std::mt19937& generator) {
+    std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> offset(-0.5f, 0.5f);
+    std::vector<Triangle> triangles;
+    triangles.reserve(numTriangles);
+    for (int i = 0; i < numTriangles; i++) {
+        glm::vec3 center(position(generator), position(generator), position(generator));
+        Triangle triangle = {
+            center + glm::vec3(offset(generator), offset(generator), offset(generator)),
+            center + glm::vec3(offset(generator), offset(generator), offset(generator)),
+            center + glm::vec3(offset(generator), offset(generator), offset(generator))
+        };
+        triangles.push_back(triangle);
+    }
+    return triangles;
+}
+
+static bool findBruteForceIntersection(const std::vector<Triangle>& triangles, const glm::vec3& origin,
+        const glm::vec3& direction, float& distance) {
+    bool intersects = false;
+    distance = std::numeric_limits<float>::max();
+    for (const auto& triangle : triangles) {
+        float triangleDistance;
+        if (findRayTriangleIntersection(origin, direction, triangle, triangleDistance) && triangleDistance < distance) {
+            distance = triangleDistance;
+            intersects = true;
+        }
+    }
+    return intersects;
+}
+
+void TriangleSetTests::testSingleTriangle() {
+    TriangleSet set;
+    Triangle triangle = { glm::vec3(-1.0f, -1.0f, 0.0f), glm::vec3(1.0f, -1.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f) };
+    set.insert(triangle);
+    set.balanceTree();
+
+    float distance;
+    BoxFace face;
+    glm::vec3 normal;
+
+    // front side
+    QVERIFY(set.findRayIntersection(glm::vec3(0.0f, 0.0f, 5.0f), glm::vec3(0.0f, 0.0f, -1.0f), distance, face, normal, true));
+    QCOMPARE_WITH_ABS_ERROR(distance, 5.0f, EPSILON);
+    QCOMPARE_WITH_ABS_ERROR(normal, glm::vec3(0.0f, 0.0f, 1.0f), EPSILON);
+
+    // back side is only hit when asked for
+    QVERIFY(!set.findRayIntersection(glm::vec3(0.0f, 0.0f, -5.0f), glm::vec3(0.0f, 0.0f, 1.0f), distance, face, normal, true));
+
+    // miss beside the triangle, even though the bounds are hit without precision
+    QVERIFY(!set.findRayIntersection(glm::vec3(0.9f, 0.9f, 5.0f), glm::vec3(0.0f, 0.0f, -1.0f), distance, face, normal, true));
+    QVERIFY(set.findRayIntersection(glm::vec3(0.9f, 0.9f, 5.0f), glm::vec3(0.0f, 0.0f, -1.0f), distance, face, normal, false));
+}
+
+void TriangleSetTests::testAgreesWithBruteForce() {
+    std::mt19937 generator(1234);
+    std::vector<Triangle> triangles = makeRandomTriangles(5000, generator);
+    TriangleSet set;
+    for (const auto& triangle : triangles) {
+        set.insert(triangle);
+    }
+    set.balanceTree();
+
+    std::uniform_real_distribution<float> position(-20.0f, 20.0f);
+    int numHits = 0;
+    for (int i = 0; i < 500; i++) {
+        glm::vec3 origin(position(generator), position(generator), position(generator));
+        glm::vec3 target(position(generator) * 0.5f, position(generator) * 0.5f, position(generator) * 0.5f);
+        glm::vec3 direction = glm::normalize(target - origin);
+
+        float expectedDistance;
+        bool expected = findBruteForceIntersection(triangles, origin, direction, expectedDistance);
+
+        float distance;
+        BoxFace face;
+        glm::vec3 normal;
+        bool intersects = set.findRayIntersection(origin, direction, distance, face, normal, true);
+        QCOMPARE(intersects, expected);
+        if (expected) {
+            numHits++;
+            QCOMPARE_WITH_ABS_ERROR(distance, expectedDistance, 1.0e-3f);
+        }
+    }
+    QVERIFY(numHits > 0);
+}
+
+void TriangleSetTests::buildAndQueryBenchmark() {
+    const int NUM_TRIANGLES = 100000;
+    const int NUM_RAYS = 1000;
+    std::mt19937 generator(4321);
+    std::vector<Triangle> triangles = makeRandomTriangles(NUM_TRIANGLES, generator);
+
+    TriangleSet set;
+    for (const auto& triangle : triangles) {
+        set.insert(triangle);
+    }
+    auto start = usecTimestampNow();
+    set.balanceTree();
+    auto buildDuration = usecTimestampNow() - start;
+
+    std::uniform_real_distribution<float> position(-20.0f, 20.0f);
+    std::vector<glm::vec3> origins;
+    std::vector<glm::vec3> directions;
+    for (int i = 0; i < NUM_RAYS; i++) {
+        glm::vec3 origin(position(generator), position(generator), position(generator));
+        origins.push_back(origin);
+        directions.push_back(glm::normalize(-origin));
+    }
+
+    int numHits = 0;
+    start = usecTimestampNow();
+    for (int i = 0; i < NUM_RAYS; i++) {
+        float distance;
+        BoxFace face;
+        glm::vec3 normal;
+        numHits += set.findRayIntersection(origins[i], directions[i], distance, face, normal, true) ? 1 : 0;
+    }
+    auto treeDuration = usecTimestampNow() - start;
+
+    // only a slice of the rays, testing every triangle is slow
+    const int NUM_BRUTE_FORCE_RAYS = NUM_RAYS / 10;
+    start = usecTimestampNow();
+    for (int i = 0; i < NUM_BRUTE_FORCE_RAYS; i++) {
+        float distance;
+        findBruteForceIntersection(triangles, origins[i], directions[i], distance);
+    }
+    auto bruteForceDuration = (usecTimestampNow() - start) * (NUM_RAYS / NUM_BRUTE_FORCE_RAYS);
+
+    qDebug() << "Built a tree over" << NUM_TRIANGLES << "triangles in" << buildDuration << "usecs";
+    qDebug() << NUM_RAYS << "rays took" << treeDuration << "usecs with the tree," << bruteForceDuration
+        << "usecs (extrapolated) testing every triangle," << numHits << "hits";
+    QVERIFY(numHits > 0);
+}
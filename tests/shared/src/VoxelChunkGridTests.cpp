@@ -0,0 +1,64 @@
+//
+//  VoxelChunkGridTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "VoxelChunkGridTests.h"
+
+#include <VoxelChunkGrid.h>
+
+QTEST_MAIN(VoxelChunkGridTests)
+
+const int CHUNK_SIZE = VoxelChunkGrid::CHUNK_SIZE;
+
+void VoxelChunkGridTests::testChunkCorners() {
+    VoxelChunkGrid grid;
+
+    // 40 voxels have 39 cells, which take three chunks; the last one is short
+    grid.resize(glm::ivec3(40, 1, 17));
+    QCOMPARE(grid.getNumChunks(), 3);
+    QCOMPARE(grid.getNumDirtyChunks(), 3);
+    QCOMPARE(grid.getChunkLow(0), glm::ivec3(0));
+    QCOMPARE(grid.getChunkHigh(0), glm::ivec3(CHUNK_SIZE, 0, CHUNK_SIZE));
+    QCOMPARE(grid.getChunkLow(1), glm::ivec3(CHUNK_SIZE, 0, 0));
+    QCOMPARE(grid.getChunkHigh(2), glm::ivec3(39, 0, CHUNK_SIZE));
+
+    // a volume that is a whole number of chunks doesn't get an extra one for its last face
+    grid.resize(glm::ivec3(2 * CHUNK_SIZE + 1));
+    QCOMPARE(grid.getNumChunks(), 8);
+    QCOMPARE(grid.getChunkHigh(7), glm::ivec3(2 * CHUNK_SIZE));
+}
+
+void VoxelChunkGridTests::testMarkVoxelDirty() {
+    VoxelChunkGrid grid;
+    grid.resize(glm::ivec3(4 * CHUNK_SIZE + 1));
+    QCOMPARE((int)grid.takeDirtyChunks().size(), 64);
+    QCOMPARE(grid.getNumDirtyChunks(), 0);
+
+    // inside a chunk
+    grid.markVoxelDirty(glm::ivec3(CHUNK_SIZE + 5));
+    std::vector<int> dirtyChunks = grid.takeDirtyChunks();
+    QCOMPARE((int)dirtyChunks.size(), 1);
+    QCOMPARE(grid.getChunkLow(dirtyChunks[0]), glm::ivec3(CHUNK_SIZE));
+
+    // next to a face, the chunk on the other side samples it for its normals
+    grid.markVoxelDirty(glm::ivec3(CHUNK_SIZE + 1, 5, 5));
+    QCOMPARE(grid.getNumDirtyChunks(), 2);
+    grid.takeDirtyChunks();
+
+    // on a corner shared by eight chunks
+    grid.markVoxelDirty(glm::ivec3(2 * CHUNK_SIZE));
+    QCOMPARE(grid.getNumDirtyChunks(), 8);
+    grid.takeDirtyChunks();
+
+    // at the edges of the volume
+    grid.markVoxelDirty(glm::ivec3(0));
+    QCOMPARE(grid.getNumDirtyChunks(), 1);
+    grid.markVoxelDirty(glm::ivec3(4 * CHUNK_SIZE));
+    QCOMPARE(grid.getNumDirtyChunks(), 2);
+}
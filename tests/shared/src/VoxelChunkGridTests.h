@@ -0,0 +1,23 @@
+//
+//  VoxelChunkGridTests.h
+//  tests/shared/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_VoxelChunkGridTests_h
+#define hifi_VoxelChunkGridTests_h
+
+#include <QtTest/QtTest>
+
+class VoxelChunkGridTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testChunkCorners();
+    void testMarkVoxelDirty();
+};
+
+#endif // hifi_VoxelChunkGridTests_h
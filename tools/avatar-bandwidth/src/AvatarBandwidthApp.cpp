@@ -0,0 +1,142 @@
+//
+//  AvatarBandwidthApp.cpp
+//  tools/avatar-bandwidth/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AvatarBandwidthApp.h"
+
+#include <QCommandLineParser>
+#include <QDebug>
+
+#include <AvatarData.h>
+#include <JointDeltaCoding.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+#include <recording/Clip.h>
+#include <recording/Frame.h>
+
+// same as the avatar mixer
+static const int AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND = 45;
+static const recording::Frame::Time BROADCAST_INTERVAL_MSECS = MSECS_PER_SECOND / AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND;
+static const int SEND_ALL_INTERVAL = (int)(1.0f / AVATAR_SEND_FULL_UPDATE_RATIO);
+static const recording::Frame::Time KEYFRAME_INTERVAL_MSECS = JointDeltaCoding::KEYFRAME_INTERVAL_USECS / USECS_PER_MSEC;
+
+AvatarBandwidthApp::AvatarBandwidthApp(int argc, char* argv[]) : QCoreApplication(argc, argv) {
+
+    // parse command-line
+    QCommandLineParser parser;
+    parser.setApplicationDescription("High Fidelity Avatar Joint Data Bandwidth Comparison");
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption inputFilenameOption("i", "input file", "filename.hfr");
+    parser.addOption(inputFilenameOption);
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << endl;
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    if (parser.isSet(helpOption)) {
+        parser.showHelp();
+        return;
+    }
+
+    QString inputFilename = parser.value(inputFilenameOption);
+    auto clip = recording::Clip::fromFile(inputFilename);
+    if (!clip) {
+        qCritical() << "Failed to open clip " << inputFilename;
+        _returnCode = 2;
+        return;
+    }
+
+    static const recording::FrameType AVATAR_FRAME_TYPE = recording::Frame::registerFrameType(AvatarData::FRAME_NAME);
+
+    auto avatar = std::make_shared<AvatarData>();
+    auto receiver = std::make_shared<AvatarData>();
+
+    QVector<JointData> lastSentJointData;
+    JointBaseline baseline;
+    quint64 lastSentTime = 0;
+    recording::Frame::Time nextBroadcastTime = 0;
+    recording::Frame::Time lastKeyframeTime = 0;
+
+    int numBroadcasts = 0;
+    int numKeyframes = 0;
+    qint64 fullBytes = 0;
+    qint64 deltaBytes = 0;
+    float maxRotationError = 0.0f;
+    float maxTranslationError = 0.0f;
+
+    clip->seekFrameTime(0);
+    for (auto frame = clip->nextFrame(); frame; frame = clip->nextFrame()) {
+        if (frame->type != AVATAR_FRAME_TYPE || frame->timeOffset < nextBroadcastTime) {
+            continue;
+        }
+        nextBroadcastTime = frame->timeOffset + BROADCAST_INTERVAL_MSECS;
+        AvatarData::fromFrame(frame->data, *avatar, false);
+
+        // the mixer sends everything to a receiver on a random AVATAR_SEND_FULL_UPDATE_RATIO of its frames
+        AvatarData::AvatarDataDetail detail = (numBroadcasts % SEND_ALL_INTERVAL == 0) ?
+            AvatarData::SendAllData : AvatarData::CullSmallData;
+
+        // time keyframes by the clip rather than the wall clock
+        if (frame->timeOffset - lastKeyframeTime >= KEYFRAME_INTERVAL_MSECS) {
+            baseline.invalidate();
+        }
+        uint8_t lastSequence = baseline.sequence;
+
+        lastSentJointData.resize(avatar->getJointCount());
+        AvatarDataPacket::HasFlags hasFlags;
+        QByteArray fullData = avatar->toByteArray(detail, lastSentTime, lastSentJointData, hasFlags,
+                                                  false, false, glm::vec3(0), &lastSentJointData);
+        QByteArray deltaData = avatar->toByteArray(detail, lastSentTime, lastSentJointData, hasFlags,
+                                                   false, false, glm::vec3(0), nullptr, nullptr, &baseline);
+        lastSentTime = usecTimestampNow();
+
+        if (baseline.sequence != lastSequence) {
+            lastKeyframeTime = frame->timeOffset;
+            numKeyframes++;
+        }
+
+        fullBytes += fullData.size();
+        deltaBytes += deltaData.size();
+        numBroadcasts++;
+
+        // check what a receiver of the delta coded data ends up with
+        receiver->parseDataFromBuffer(deltaData);
+        const QVector<JointData>& sent = avatar->getRawJointData();
+        const QVector<JointData>& received = receiver->getRawJointData();
+        for (int i = 0; i < std::min(sent.size(), received.size()); i++) {
+            if (sent[i].rotationSet && received[i].rotationSet) {
+                float dot = std::min(1.0f, fabsf(glm::dot(sent[i].rotation, received[i].rotation)));
+                maxRotationError = std::max(maxRotationError, 2.0f * acosf(dot));
+            }
+            if (sent[i].translationSet && received[i].translationSet) {
+                maxTranslationError = std::max(maxTranslationError, glm::distance(sent[i].translation, received[i].translation));
+            }
+        }
+    }
+
+    if (numBroadcasts == 0) {
+        qCritical() << "No avatar frames in clip " << inputFilename;
+        _returnCode = 3;
+        return;
+    }
+
+    float seconds = (float)numBroadcasts / AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND;
+    float fullKbps = fullBytes / seconds / BYTES_PER_KILOBIT;
+    float deltaKbps = deltaBytes / seconds / BYTES_PER_KILOBIT;
+    qDebug() << "Broadcasts:" << numBroadcasts << "joint keyframes:" << numKeyframes;
+    qDebug() << "Full joint data:" << fullBytes << "bytes," << fullKbps << "kbps per receiver";
+    qDebug() << "Delta joint data:" << deltaBytes << "bytes," << deltaKbps << "kbps per receiver,"
+        << (100.0f * deltaBytes / fullBytes) << "% of full";
+    qDebug() << "Delta max rotation error:" << maxRotationError * DEGREES_PER_RADIAN << "degrees,"
+        << "max translation error:" << maxTranslationError;
+}
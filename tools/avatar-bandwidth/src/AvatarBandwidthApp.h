@@ -0,0 +1,29 @@
+//
+//  AvatarBandwidthApp.h
+//  tools/avatar-bandwidth/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AvatarBandwidthApp_h
+#define hifi_AvatarBandwidthApp_h
+
+#include <QCoreApplication>
+
+// Plays back a recorded avatar clip at the avatar mixer broadcast rate and reports the bytes
+// one receiver would get, with the joints sent as full data and as delta coded data.
+class AvatarBandwidthApp : public QCoreApplication {
+    Q_OBJECT
+public:
+    AvatarBandwidthApp(int argc, char* argv[]);
+
+    int getReturnCode() const { return _returnCode; }
+
+private:
+    int _returnCode { 0 };
+};
+
+#endif // hifi_AvatarBandwidthApp_h
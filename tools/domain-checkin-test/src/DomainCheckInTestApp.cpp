@@ -0,0 +1,226 @@
+//
+//  DomainCheckInTestApp.cpp
+//  tools/domain-checkin-test/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "DomainCheckInTestApp.h"
+
+#include <QCommandLineParser>
+#include <QDataStream>
+#include <QDebug>
+
+#include <DomainHandler.h>
+#include <LimitedNodeList.h>
+#include <NodePermissions.h>
+#include <NodeType.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+#include <udt/PacketHeaders.h>
+
+// same as the NodeList
+const int DOMAIN_SERVER_CHECK_IN_MSECS = 1000;
+
+// what an interface client is interested in
+const QList<NodeType_t> AGENT_INTEREST_LIST = {
+    NodeType::AudioMixer, NodeType::AvatarMixer, NodeType::EntityServer,
+    NodeType::AssetServer, NodeType::MessagesMixer, NodeType::EntityScriptServer
+};
+
+DomainCheckInTestApp::DomainCheckInTestApp(int argc, char* argv[]) :
+    QCoreApplication(argc, argv)
+{
+    // parse command-line
+    QCommandLineParser parser;
+    parser.setApplicationDescription("High Fidelity domain-server check in test");
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption domainServerOption("d", "domain-server address", "IP:PORT");
+    parser.addOption(domainServerOption);
+
+    const QCommandLineOption numAgentsOption("a", "number of agents to simulate", "100");
+    parser.addOption(numAgentsOption);
+
+    const QCommandLineOption numRoundsOption("n", "number of check in rounds, 0 to run until stopped", "10");
+    parser.addOption(numRoundsOption);
+
+    const QCommandLineOption fullListsOption("f", "never acknowledge a domain list, so every reply is a full list");
+    parser.addOption(fullListsOption);
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << endl;
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+
+    if (parser.isSet(helpOption)) {
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+
+    _domainServerAddr = HifiSockAddr(QHostAddress::LocalHost, DEFAULT_DOMAIN_SERVER_PORT);
+    if (parser.isSet(domainServerOption)) {
+        QString hostnamePortString = parser.value(domainServerOption);
+        QHostAddress address { hostnamePortString.left(hostnamePortString.indexOf(':')) };
+        quint16 port { (quint16) hostnamePortString.mid(hostnamePortString.indexOf(':') + 1).toUInt() };
+        _domainServerAddr = HifiSockAddr(address, port ? port : DEFAULT_DOMAIN_SERVER_PORT);
+    }
+
+    int numAgents = parser.isSet(numAgentsOption) ? parser.value(numAgentsOption).toInt() : 100;
+    _numRounds = parser.isSet(numRoundsOption) ? parser.value(numRoundsOption).toInt() : 10;
+    _fullListsOnly = parser.isSet(fullListsOption);
+
+    qDebug() << "Connecting" << numAgents << "agents to" << _domainServerAddr;
+
+    for (int i = 0; i < numAgents; i++) {
+        _agents.emplace_back(new Agent());
+        Agent& agent = *_agents.back();
+
+        agent.socket = new udt::Socket(this);
+        agent.socket->bind(QHostAddress::AnyIPv4, 0);
+        agent.socket->setPacketHandler([this, &agent](std::unique_ptr<udt::Packet> packet) {
+            processPacket(agent, std::move(packet));
+        });
+        agent.sockAddr = HifiSockAddr(QHostAddress::LocalHost, agent.socket->localPort());
+
+        sendConnectRequest(agent);
+    }
+
+    connect(&_checkInTimer, &QTimer::timeout, this, &DomainCheckInTestApp::checkIn);
+    _checkInTimer.start(DOMAIN_SERVER_CHECK_IN_MSECS);
+}
+
+void DomainCheckInTestApp::sendConnectRequest(Agent& agent) {
+    // same as NodeList::sendDomainServerCheckIn, for an anonymous interface client
+    auto packet = NLPacket::create(PacketType::DomainConnectRequest);
+    QDataStream packetStream(packet.get());
+
+    packetStream << QUuid();
+
+    QByteArray protocolVersionSig = protocolVersionsSignature();
+    packetStream.writeBytes(protocolVersionSig.constData(), protocolVersionSig.size());
+
+    packetStream << QString() << QUuid::createUuid();
+    packetStream << NodeType::Agent << agent.sockAddr << agent.sockAddr << AGENT_INTEREST_LIST << QString();
+    packetStream << QString();
+
+    agent.socket->writePacket(*packet, _domainServerAddr);
+}
+
+void DomainCheckInTestApp::sendListRequest(Agent& agent) {
+    auto packet = NLPacket::create(PacketType::DomainListRequest);
+    QDataStream packetStream(packet.get());
+
+    packetStream << NodeType::Agent << agent.sockAddr << agent.sockAddr << AGENT_INTEREST_LIST << QString();
+    packetStream << (_fullListsOnly ? 0 : agent.domainListVersion);
+
+    packet->writeSourceID(agent.sessionUUID);
+    agent.socket->writePacket(*packet, _domainServerAddr);
+}
+
+void DomainCheckInTestApp::checkIn() {
+    if (_round > 0) {
+        reportRound();
+    }
+
+    if (_numRounds > 0 && _round >= _numRounds) {
+        _checkInTimer.stop();
+        quit();
+        return;
+    }
+
+    _numLists = 0;
+    _numFullLists = 0;
+    _numEntries = 0;
+    _numListBytes = 0;
+    _roundStart = usecTimestampNow();
+    _lastReplyTime = _roundStart;
+
+    for (auto& agent : _agents) {
+        if (agent->sessionUUID.isNull()) {
+            // still waiting to hear back about our connect request, ask again
+            sendConnectRequest(*agent);
+        } else {
+            sendListRequest(*agent);
+        }
+    }
+
+    _round++;
+}
+
+void DomainCheckInTestApp::reportRound() {
+    float replyMsecs = (float)(_lastReplyTime - _roundStart) / USECS_PER_MSEC;
+    qDebug() << "Round" << _round << "-" << _numConnected << "agents connected," << _numDenied << "denied,"
+        << _numLists << "domain list packets (" << _numFullLists << "full ) with" << _numEntries << "entries,"
+        << _numListBytes << "bytes," << (_numLists > 0 ? _numListBytes / _numLists : 0) << "bytes per packet,"
+        << "last reply after" << replyMsecs << "ms";
+}
+
+void DomainCheckInTestApp::processPacket(Agent& agent, std::unique_ptr<udt::Packet> packet) {
+    auto nlPacket = NLPacket::fromBase(std::move(packet));
+
+    if (nlPacket->getType() == PacketType::DomainList) {
+        processDomainList(agent, *nlPacket);
+    } else if (nlPacket->getType() == PacketType::DomainConnectionDenied) {
+        _numDenied++;
+    }
+}
+
+void DomainCheckInTestApp::processDomainList(Agent& agent, NLPacket& packet) {
+    _numLists++;
+    _numListBytes += packet.getDataSize();
+    _lastReplyTime = usecTimestampNow();
+
+    QDataStream packetStream(&packet);
+
+    QUuid domainUUID, sessionUUID;
+    NodePermissions permissions;
+    quint32 listVersion, baseListVersion, numEntries;
+    packetStream >> domainUUID >> sessionUUID >> permissions >> listVersion >> baseListVersion >> numEntries;
+
+    if (agent.sessionUUID.isNull()) {
+        agent.sessionUUID = sessionUUID;
+        _numConnected++;
+    }
+
+    if (baseListVersion == 0) {
+        _numFullLists++;
+    } else if (baseListVersion != agent.domainListVersion) {
+        return;
+    }
+
+    if (listVersion != agent.pendingDomainListVersion) {
+        agent.pendingDomainListVersion = listVersion;
+        agent.numPendingDomainListEntries = 0;
+    }
+
+    // same as NodeList::processDomainServerList, without keeping the nodes
+    while (packet.bytesLeftToRead() > 0) {
+        DomainListEntryType_t entryType;
+        packetStream >> entryType;
+
+        QUuid nodeUUID;
+        if (entryType == DomainListEntryType::Removed) {
+            packetStream >> nodeUUID;
+        } else {
+            qint8 nodeType;
+            HifiSockAddr publicSocket, localSocket;
+            NodePermissions nodePermissions;
+            bool isReplicated;
+            QUuid connectionSecret;
+            packetStream >> nodeType >> nodeUUID >> publicSocket >> localSocket >> nodePermissions
+                >> isReplicated >> connectionSecret;
+        }
+
+        _numEntries++;
+        agent.numPendingDomainListEntries++;
+    }
+
+    if (agent.numPendingDomainListEntries >= numEntries) {
+        agent.domainListVersion = listVersion;
+    }
+}
@@ -0,0 +1,69 @@
+//
+//  DomainCheckInTestApp.h
+//  tools/domain-checkin-test/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_DomainCheckInTestApp_h
+#define hifi_DomainCheckInTestApp_h
+
+#include <memory>
+#include <vector>
+
+#include <QCoreApplication>
+#include <QTimer>
+
+#include <HifiSockAddr.h>
+#include <NLPacket.h>
+#include <udt/Socket.h>
+
+// Connects many simulated agents to a domain-server, has them all check in once a second like a NodeList
+// does, and reports how long the domain-server takes to answer and how many bytes of domain list it sends.
+class DomainCheckInTestApp : public QCoreApplication {
+    Q_OBJECT
+public:
+    DomainCheckInTestApp(int argc, char* argv[]);
+
+private slots:
+    void checkIn();
+
+private:
+    struct Agent {
+        udt::Socket* socket;
+        HifiSockAddr sockAddr;
+        QUuid sessionUUID;
+
+        quint32 domainListVersion { 0 };
+        quint32 pendingDomainListVersion { 0 };
+        quint32 numPendingDomainListEntries { 0 };
+    };
+
+    void sendConnectRequest(Agent& agent);
+    void sendListRequest(Agent& agent);
+    void processPacket(Agent& agent, std::unique_ptr<udt::Packet> packet);
+    void processDomainList(Agent& agent, NLPacket& packet);
+    void reportRound();
+
+    HifiSockAddr _domainServerAddr;
+    bool _fullListsOnly { false };
+    int _numRounds { 0 };
+
+    std::vector<std::unique_ptr<Agent>> _agents;
+    QTimer _checkInTimer;
+
+    int _round { 0 };
+    quint64 _roundStart { 0 };
+    quint64 _lastReplyTime { 0 };
+    int _numConnected { 0 };
+    int _numDenied { 0 };
+    int _numLists { 0 };
+    int _numFullLists { 0 };
+    int _numEntries { 0 };
+    qint64 _numListBytes { 0 };
+};
+
+#endif // hifi_DomainCheckInTestApp_h
@@ -17,6 +17,7 @@
 #include <NetworkLogging.h>
 
 #include "ICEClientApp.h"
+#include "ICELoadTest.h"
 
 ICEClientApp::ICEClientApp(int argc, char* argv[]) :
     QCoreApplication(argc, argv)
@@ -43,6 +44,12 @@ ICEClientApp::ICEClientApp(int argc, char* argv[]) :
     const QCommandLineOption cacheSTUNOption("s", "cache stun-server response");
     parser.addOption(cacheSTUNOption);
 
+    const QCommandLineOption loadTestOption("l", "heartbeat the ice-server as this many domain-servers", "1000");
+    parser.addOption(loadTestOption);
+
+    const QCommandLineOption resignOption("r", "with -l, sign new heartbeats every round");
+    parser.addOption(resignOption);
+
     if (!parser.parse(QCoreApplication::arguments())) {
         qCritical() << parser.errorText() << endl;
         parser.showHelp();
@@ -103,6 +110,14 @@ ICEClientApp::ICEClientApp(int argc, char* argv[]) :
         qDebug() << "ICE-server address is" << _iceServerAddr;
     }
 
+    if (parser.isSet(loadTestOption)) {
+        int numDomains = parser.value(loadTestOption).toInt();
+        int numRounds = parser.isSet(howManyTimesOption) ? _actionMax : 0;
+        auto loadTest = new ICELoadTest(_iceServerAddr, numDomains, numRounds, parser.isSet(resignOption), this);
+        connect(loadTest, &ICELoadTest::finished, this, &QCoreApplication::quit);
+        return;
+    }
+
     setState(lookUpStunServer);
 
     QTimer* doTimer = new QTimer(this);
@@ -0,0 +1,198 @@
+//
+//  ICELoadTest.cpp
+//  tools/ice-client/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ICELoadTest.h"
+
+#include <openssl/x509.h>
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+
+#include <HTTPConnection.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+// the simulated domains share a few keys, generating one per domain would take longer than the test
+const int NUM_KEYS = 8;
+const int RSA_KEY_BITS = 2048;
+
+// spread the domains across a few sockets, as if they were heartbeating from different hosts
+const int NUM_SOCKETS = 16;
+
+// same as the domain-server
+const int HEARTBEAT_INTERVAL_MSECS = 1 * 1000;
+
+const quint16 PUBLIC_KEY_API_PORT = 40200;
+const QString PUBLIC_KEY_PATH_PREFIX = "/api/v1/domains/";
+const QString PUBLIC_KEY_PATH_SUFFIX = "/public_key";
+
+ICELoadTest::ICELoadTest(const HifiSockAddr& iceServerAddr, int numDomains, int numRounds, bool resign, QObject* parent) :
+    QObject(parent),
+    _iceServerAddr(iceServerAddr),
+    _numRounds(numRounds),
+    _resign(resign)
+{
+    qDebug() << "Generating" << NUM_KEYS << "domain keypairs";
+    for (int i = 0; i < NUM_KEYS; i++) {
+        RSA* keyPair = RSA_new();
+        BIGNUM* exponent = BN_new();
+        BN_set_word(exponent, RSA_F4);
+        RSA_generate_key_ex(keyPair, RSA_KEY_BITS, exponent, NULL);
+        BN_free(exponent);
+
+        // the ice-server expects the public key the way the metaverse API stores it
+        unsigned char* publicKeyDER = NULL;
+        int publicKeyLength = i2d_RSA_PUBKEY(keyPair, &publicKeyDER);
+        _publicKeys.push_back(QByteArray(reinterpret_cast<char*>(publicKeyDER), publicKeyLength).toBase64());
+        OPENSSL_free(publicKeyDER);
+
+        _keys.push_back(std::shared_ptr<RSA>(keyPair, RSA_free));
+    }
+
+    _apiServer = new HTTPManager(QHostAddress::LocalHost, PUBLIC_KEY_API_PORT, QString(), this, this);
+    qDebug() << "Serving domain public keys - start the ice-server with"
+        << QString("HIFI_ICE_SERVER_METAVERSE_URL=http://127.0.0.1:%1").arg(PUBLIC_KEY_API_PORT);
+
+    for (int i = 0; i < NUM_SOCKETS; i++) {
+        auto socket = new udt::Socket(this);
+        socket->bind(QHostAddress::AnyIPv4, 0);
+        socket->setPacketHandler([this](std::unique_ptr<udt::Packet> packet) { processPacket(std::move(packet)); });
+        _sockets.push_back(socket);
+    }
+
+    _domains.resize(numDomains);
+    for (int i = 0; i < numDomains; i++) {
+        Domain& domain = _domains[i];
+        domain.id = QUuid::createUuid();
+        domain.keyIndex = i % NUM_KEYS;
+        domain.socket = _sockets[i % NUM_SOCKETS];
+        domain.heartbeatPacket = NLPacket::create(PacketType::ICEServerHeartbeat);
+        _domainKeys.insert(domain.id, domain.keyIndex);
+
+        signHeartbeat(domain, domain.socket->localPort());
+    }
+
+    connect(&_roundTimer, &QTimer::timeout, this, &ICELoadTest::sendRound);
+    _roundTimer.start(HEARTBEAT_INTERVAL_MSECS);
+}
+
+ICELoadTest::~ICELoadTest() {
+    _roundTimer.stop();
+}
+
+void ICELoadTest::signHeartbeat(Domain& domain, quint16 localPort) {
+    // same as DomainServer::sendHeartbeatToIceServer
+    auto& packet = *domain.heartbeatPacket;
+    packet.reset();
+
+    QDataStream heartbeatDataStream(&packet);
+    HifiSockAddr publicSocket("127.0.0.1", domain.socket->localPort());
+    HifiSockAddr localSocket("127.0.0.1", localPort);
+    heartbeatDataStream << domain.id << publicSocket << localSocket;
+
+    auto plaintext = QByteArray::fromRawData(packet.getPayload(), packet.getPayloadSize());
+    QByteArray hashedPlaintext = QCryptographicHash::hash(plaintext, QCryptographicHash::Sha256);
+
+    RSA* privateKey = _keys[domain.keyIndex].get();
+    QByteArray signature(RSA_size(privateKey), 0);
+    unsigned int signatureBytes = 0;
+    RSA_sign(NID_sha256,
+             reinterpret_cast<const unsigned char*>(hashedPlaintext.constData()),
+             hashedPlaintext.size(),
+             reinterpret_cast<unsigned char*>(signature.data()),
+             &signatureBytes,
+             privateKey);
+
+    heartbeatDataStream << signature;
+}
+
+void ICELoadTest::sendRound() {
+    if (_round > 0) {
+        reportRound();
+    }
+
+    if (_numRounds > 0 && _round >= _numRounds) {
+        _roundTimer.stop();
+        emit finished();
+        return;
+    }
+
+    // re-signing with a different local port each round means every heartbeat has to be verified,
+    // otherwise the ice-server only verifies the first one from each domain
+    if (_resign && _round > 0) {
+        for (auto& domain : _domains) {
+            signHeartbeat(domain, domain.socket->localPort() + _round);
+        }
+    }
+
+    _numACKs = 0;
+    _numDenied = 0;
+    _roundStart = usecTimestampNow();
+    _lastReplyTime = _roundStart;
+
+    for (auto& domain : _domains) {
+        domain.socket->writePacket(*domain.heartbeatPacket, _iceServerAddr);
+    }
+
+    _round++;
+}
+
+void ICELoadTest::reportRound() {
+    float replySeconds = (float)(_lastReplyTime - _roundStart) / USECS_PER_SECOND;
+    int numReplies = _numACKs + _numDenied;
+    qDebug() << "Round" << _round << "- sent" << _domains.size() << "heartbeats,"
+        << _numACKs << "ACKed," << _numDenied << "denied,"
+        << _domains.size() - numReplies << "unanswered, last reply after" << replySeconds * MSECS_PER_SECOND << "ms,"
+        << (replySeconds > 0.0f ? numReplies / replySeconds : 0.0f) << "replies/s,"
+        << _numKeyRequests << "public key requests so far";
+}
+
+void ICELoadTest::processPacket(std::unique_ptr<udt::Packet> packet) {
+    auto nlPacket = NLPacket::fromBase(std::move(packet));
+
+    if (nlPacket->getType() == PacketType::ICEServerHeartbeatACK) {
+        _numACKs++;
+    } else if (nlPacket->getType() == PacketType::ICEServerHeartbeatDenied) {
+        _numDenied++;
+    } else {
+        return;
+    }
+
+    _lastReplyTime = usecTimestampNow();
+}
+
+bool ICELoadTest::handleHTTPRequest(HTTPConnection* connection, const QUrl& url, bool skipSubHandler) {
+    QString path = url.path();
+    if (path.startsWith(PUBLIC_KEY_PATH_PREFIX) && path.endsWith(PUBLIC_KEY_PATH_SUFFIX)) {
+        QUuid domainID(path.mid(PUBLIC_KEY_PATH_PREFIX.size(),
+                                path.size() - PUBLIC_KEY_PATH_PREFIX.size() - PUBLIC_KEY_PATH_SUFFIX.size()));
+
+        auto it = _domainKeys.find(domainID);
+        if (it != _domainKeys.end()) {
+            _numKeyRequests++;
+
+            QJsonObject dataObject;
+            dataObject["public_key"] = QString::fromUtf8(_publicKeys[it.value()]);
+
+            QJsonObject responseObject;
+            responseObject["status"] = "success";
+            responseObject["data"] = dataObject;
+
+            connection->respond(HTTPConnection::StatusCode200, QJsonDocument(responseObject).toJson(),
+                                "application/json");
+            return true;
+        }
+    }
+
+    connection->respond(HTTPConnection::StatusCode404);
+    return true;
+}
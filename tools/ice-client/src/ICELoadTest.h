@@ -0,0 +1,77 @@
+//
+//  ICELoadTest.h
+//  tools/ice-client/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ICELoadTest_h
+#define hifi_ICELoadTest_h
+
+#include <memory>
+#include <vector>
+
+#include <QtCore/QObject>
+#include <QtCore/QTimer>
+
+#include <openssl/rsa.h>
+
+#include <HTTPManager.h>
+#include <NLPacket.h>
+#include <udt/Socket.h>
+
+// Heartbeats an ice-server on behalf of many simulated domain-servers and reports how many it ACKs.
+//
+// The test answers public key requests itself, so the ice-server has to be started with
+// HIFI_ICE_SERVER_METAVERSE_URL pointing at it.
+class ICELoadTest : public QObject, public HTTPRequestHandler {
+    Q_OBJECT
+public:
+    ICELoadTest(const HifiSockAddr& iceServerAddr, int numDomains, int numRounds, bool resign, QObject* parent = nullptr);
+    ~ICELoadTest();
+
+    bool handleHTTPRequest(HTTPConnection* connection, const QUrl& url, bool skipSubHandler = false) override;
+
+signals:
+    void finished();
+
+private slots:
+    void sendRound();
+
+private:
+    struct Domain {
+        QUuid id;
+        int keyIndex;
+        udt::Socket* socket;
+        std::unique_ptr<NLPacket> heartbeatPacket;
+    };
+
+    void signHeartbeat(Domain& domain, quint16 localPort);
+    void processPacket(std::unique_ptr<udt::Packet> packet);
+    void reportRound();
+
+    HifiSockAddr _iceServerAddr;
+    int _numRounds;
+    bool _resign;
+
+    std::vector<std::shared_ptr<RSA>> _keys;
+    std::vector<QByteArray> _publicKeys;
+    std::vector<udt::Socket*> _sockets;
+    std::vector<Domain> _domains;
+    QHash<QUuid, int> _domainKeys;
+
+    HTTPManager* _apiServer { nullptr };
+    QTimer _roundTimer;
+
+    int _round { 0 };
+    quint64 _roundStart { 0 };
+    quint64 _lastReplyTime { 0 };
+    int _numACKs { 0 };
+    int _numDenied { 0 };
+    int _numKeyRequests { 0 };
+};
+
+#endif // hifi_ICELoadTest_h
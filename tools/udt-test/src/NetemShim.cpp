@@ -0,0 +1,149 @@
+//
+//  NetemShim.cpp
+//  tools/udt-test/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "NetemShim.h"
+
+#include <QtCore/QDebug>
+
+static const int STATS_INTERVAL_MSECS = 1000;
+
+NetemShim::NetemShim(quint16 port, const HifiSockAddr& target, const LinkParameters& parameters, QObject* parent) :
+    QObject(parent),
+    _parameters(parameters),
+    _target(target),
+    _generator(parameters.seed)
+{
+    _toTarget.destination = _target;
+
+    if (!_socket.bind(QHostAddress::AnyIPv4, port)) {
+        qCritical() << "NetemShim could not bind to port" << port << "-" << _socket.errorString();
+        return;
+    }
+
+    qDebug() << "NetemShim is listening on" << _socket.localPort() << "and relaying to" << _target;
+    qDebug() << "NetemShim link is" << _parameters.delay.count() / 1000.0 << "ms one way,"
+        << _parameters.lossRate * 100.0 << "% loss," << _parameters.bandwidth / 1000000.0 << "Mb/s with a"
+        << _parameters.queueLimit << "datagram queue (seed" << _parameters.seed << ")";
+
+    connect(&_socket, &QUdpSocket::readyRead, this, &NetemShim::readPendingDatagrams);
+
+    // coarse timers are only good to a few ms, which is the same order as the delays we want to model
+    _deliveryTimer.setTimerType(Qt::PreciseTimer);
+    _deliveryTimer.setSingleShot(true);
+    connect(&_deliveryTimer, &QTimer::timeout, this, &NetemShim::deliverDueDatagrams);
+
+    connect(&_statsTimer, &QTimer::timeout, this, &NetemShim::printStats);
+    _statsTimer.start(STATS_INTERVAL_MSECS);
+}
+
+void NetemShim::readPendingDatagrams() {
+    auto now = Clock::now();
+
+    while (_socket.hasPendingDatagrams()) {
+        QByteArray datagram;
+        datagram.resize(_socket.pendingDatagramSize());
+
+        QHostAddress senderAddress;
+        quint16 senderPort;
+        _socket.readDatagram(datagram.data(), datagram.size(), &senderAddress, &senderPort);
+
+        HifiSockAddr sender(senderAddress, senderPort);
+
+        if (sender == _target) {
+            if (!_client.isNull()) {
+                enqueue(_toClient, std::move(datagram), now);
+            }
+        } else {
+            if (_client.isNull()) {
+                _client = sender;
+                _toClient.destination = _client;
+                qDebug() << "NetemShim is relaying for" << _client;
+            }
+
+            if (sender == _client) {
+                enqueue(_toTarget, std::move(datagram), now);
+            }
+        }
+    }
+
+    scheduleDelivery();
+}
+
+void NetemShim::enqueue(Link& link, QByteArray datagram, Clock::time_point now) {
+    if (_parameters.lossRate > 0.0 && _lossDistribution(_generator) < _parameters.lossRate) {
+        ++link.lost;
+        return;
+    }
+
+    Clock::duration serializationTime { 0 };
+
+    if (_parameters.bandwidth > 0.0) {
+        static const double BITS_PER_BYTE = 8.0;
+        std::chrono::duration<double> seconds { (datagram.size() * BITS_PER_BYTE) / _parameters.bandwidth };
+        serializationTime = std::chrono::duration_cast<Clock::duration>(seconds);
+
+        // everything at the back of the queue that has not finished serializing is still waiting for the bottleneck
+        int waiting = 0;
+        for (auto it = link.queue.rbegin(); it != link.queue.rend() && it->deliveryTime - _parameters.delay > now; ++it) {
+            ++waiting;
+        }
+
+        if (waiting >= _parameters.queueLimit) {
+            ++link.dropped;
+            return;
+        }
+    }
+
+    link.busyUntil = std::max(link.busyUntil, now) + serializationTime;
+    link.queue.push_back({ std::move(datagram), link.busyUntil + _parameters.delay });
+}
+
+void NetemShim::deliverDueDatagrams() {
+    auto now = Clock::now();
+
+    for (Link* link : { &_toTarget, &_toClient }) {
+        while (!link->queue.empty() && link->queue.front().deliveryTime <= now) {
+            auto& datagram = link->queue.front().data;
+            _socket.writeDatagram(datagram, link->destination.getAddress(), link->destination.getPort());
+            ++link->forwarded;
+            link->queue.pop_front();
+        }
+    }
+
+    scheduleDelivery();
+}
+
+void NetemShim::scheduleDelivery() {
+    auto next = Clock::time_point::max();
+
+    for (Link* link : { &_toTarget, &_toClient }) {
+        if (!link->queue.empty()) {
+            next = std::min(next, link->queue.front().deliveryTime);
+        }
+    }
+
+    if (next == Clock::time_point::max()) {
+        return;
+    }
+
+    // round up so the timer does not fire before the head of the queue is actually due
+    static const int USECS_PER_MSEC = 1000;
+    auto wait = std::chrono::duration_cast<std::chrono::microseconds>(next - Clock::now());
+    _deliveryTimer.start(std::max(0, (int)((wait.count() + USECS_PER_MSEC - 1) / USECS_PER_MSEC)));
+}
+
+void NetemShim::printStats() {
+    qDebug() << "NetemShim to target: forwarded" << _toTarget.forwarded << "lost" << _toTarget.lost
+        << "tail dropped" << _toTarget.dropped << "| to client: forwarded" << _toClient.forwarded
+        << "lost" << _toClient.lost << "tail dropped" << _toClient.dropped;
+
+    _toTarget.forwarded = _toTarget.lost = _toTarget.dropped = 0;
+    _toClient.forwarded = _toClient.lost = _toClient.dropped = 0;
+}
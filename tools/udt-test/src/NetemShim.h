@@ -0,0 +1,84 @@
+//
+//  NetemShim.h
+//  tools/udt-test/src
+//
+//  Copyright 2017 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_NetemShim_h
+#define hifi_NetemShim_h
+
+#include <chrono>
+#include <deque>
+#include <random>
+
+#include <QtCore/QObject>
+#include <QtCore/QTimer>
+#include <QtNetwork/QUdpSocket>
+
+#include <HifiSockAddr.h>
+
+// A small userspace stand-in for netem - it relays datagrams between the first peer that talks to it and a target,
+// pushing each direction through a bottleneck link with a fixed propagation delay, a tail drop queue and seeded random
+// loss. That gives reproducible congestion control comparisons on a single machine without root.
+class NetemShim : public QObject {
+    Q_OBJECT
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct LinkParameters {
+        std::chrono::microseconds delay { 0 }; // one way propagation delay
+        double lossRate { 0.0 }; // probability that a datagram is dropped before it is queued
+        double bandwidth { 0.0 }; // bottleneck rate in bits per second, zero for no serialization delay
+        int queueLimit { 100 }; // datagrams that can wait for the bottleneck before tail drop
+        int seed { 742272 }; // seeds the loss generator so runs can be repeated
+    };
+
+    NetemShim(quint16 port, const HifiSockAddr& target, const LinkParameters& parameters, QObject* parent = nullptr);
+
+private slots:
+    void readPendingDatagrams();
+    void deliverDueDatagrams();
+    void printStats();
+
+private:
+    struct QueuedDatagram {
+        QByteArray data;
+        Clock::time_point deliveryTime;
+    };
+
+    struct Link {
+        HifiSockAddr destination;
+        std::deque<QueuedDatagram> queue;
+        Clock::time_point busyUntil; // when the bottleneck finishes serializing what has already been accepted
+
+        int forwarded { 0 };
+        int dropped { 0 };
+        int lost { 0 };
+    };
+
+    void enqueue(Link& link, QByteArray datagram, Clock::time_point now);
+    void scheduleDelivery();
+
+    QUdpSocket _socket;
+    QTimer _deliveryTimer;
+    QTimer _statsTimer;
+
+    LinkParameters _parameters;
+
+    HifiSockAddr _target;
+    HifiSockAddr _client; // the first peer that is not the target
+
+    Link _toTarget;
+    Link _toClient;
+
+    std::mt19937 _generator;
+    std::uniform_real_distribution<double> _lossDistribution { 0.0, 1.0 };
+};
+
+#endif // hifi_NetemShim_h
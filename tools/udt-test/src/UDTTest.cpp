@@ -13,6 +13,7 @@
 
 #include <QtCore/QDebug>
 
+#include <udt/BBRCC.h>
 #include <udt/Constants.h>
 #include <udt/Packet.h>
 #include <udt/PacketList.h>
@@ -56,6 +57,28 @@ const QCommandLineOption STATS_INTERVAL {
     "stats-interval", "stats output interval (default is 100ms)", "milliseconds"
 };
 
+const QCommandLineOption CONGESTION_CONTROL {
+    "cc", "congestion control for sent packets - vegas, bbr or udt (default is vegas)", "algorithm"
+};
+const QCommandLineOption SHIM {
+    "shim", "relay between the first peer and --target through a simulated link instead of running the test"
+};
+const QCommandLineOption SHIM_DELAY {
+    "shim-delay", "one way propagation delay added by the shim (default is 0ms)", "milliseconds"
+};
+const QCommandLineOption SHIM_LOSS {
+    "shim-loss", "percentage of datagrams the shim drops at random (default is 0)", "percent"
+};
+const QCommandLineOption SHIM_BANDWIDTH {
+    "shim-bandwidth", "bottleneck bandwidth of the shim link (default is unlimited)", "Mb/s"
+};
+const QCommandLineOption SHIM_QUEUE {
+    "shim-queue", "datagrams that can wait for the shim bottleneck before tail drop (default is 100)", "datagrams"
+};
+const QCommandLineOption SHIM_SEED {
+    "shim-seed", "seed for the shim random loss (default is 742272)", "integer"
+};
+
 const QStringList CLIENT_STATS_TABLE_HEADERS {
     "Send (Mb/s)", "Est. Max (Mb/s)", "RTT (ms)", "CW (P)", "Period (us)",
     "Recv ACK", "Procd ACK", "Recv LACK", "Recv NAK", "Recv TNAK",
@@ -74,10 +97,17 @@ UDTTest::UDTTest(int& argc, char** argv) :
     qInstallMessageHandler(LogHandler::verboseMessageHandler);
     
     parseArguments();
+
+    if (_argumentParser.isSet(SHIM)) {
+        setupShim();
+        return;
+    }
     
     // randomize the seed for packet size randomization
     srand(time(NULL));
 
+    setupCongestionControl();
+
     _socket.bind(QHostAddress::AnyIPv4, _argumentParser.value(PORT_OPTION).toUInt());
     qDebug() << "Test socket is listening on" << _socket.localPort();
     
@@ -228,7 +258,8 @@ void UDTTest::parseArguments() {
     _argumentParser.addOptions({
         PORT_OPTION, TARGET_OPTION, PACKET_SIZE, MIN_PACKET_SIZE, MAX_PACKET_SIZE,
         MAX_SEND_BYTES, MAX_SEND_PACKETS, UNRELIABLE_PACKETS, ORDERED_PACKETS,
-        MESSAGE_SIZE, MESSAGE_SEED, STATS_INTERVAL
+        MESSAGE_SIZE, MESSAGE_SEED, STATS_INTERVAL, CONGESTION_CONTROL,
+        SHIM, SHIM_DELAY, SHIM_LOSS, SHIM_BANDWIDTH, SHIM_QUEUE, SHIM_SEED
     });
     
     if (!_argumentParser.parse(arguments())) {
@@ -243,6 +274,67 @@ void UDTTest::parseArguments() {
     }
 }
 
+void UDTTest::setupCongestionControl() {
+    if (!_argumentParser.isSet(CONGESTION_CONTROL)) {
+        return;
+    }
+
+    QString congestionControl = _argumentParser.value(CONGESTION_CONTROL);
+
+    if (congestionControl == "bbr") {
+        _socket.setCongestionControlFactory(std::unique_ptr<udt::CongestionControlVirtualFactory>(
+            new udt::CongestionControlFactory<udt::BBRCC>()));
+    } else if (congestionControl == "udt") {
+        _socket.setCongestionControlFactory(std::unique_ptr<udt::CongestionControlVirtualFactory>(
+            new udt::CongestionControlFactory<udt::DefaultCC>()));
+    } else if (congestionControl != "vegas") {
+        qCritical() << "Unknown congestion control" << congestionControl << "- expected vegas, bbr or udt.";
+        QMetaObject::invokeMethod(this, "quit", Qt::QueuedConnection);
+        return;
+    }
+
+    qDebug() << "Using" << congestionControl << "congestion control";
+}
+
+void UDTTest::setupShim() {
+    QString hostnamePortString = _argumentParser.value(TARGET_OPTION);
+
+    QHostAddress address { hostnamePortString.left(hostnamePortString.indexOf(':')) };
+    quint16 port { (quint16) hostnamePortString.mid(hostnamePortString.indexOf(':') + 1).toUInt() };
+
+    if (address.isNull() || port == 0) {
+        qCritical() << "The shim needs a --target to relay to, could not parse one from" << hostnamePortString;
+        QMetaObject::invokeMethod(this, "quit", Qt::QueuedConnection);
+        return;
+    }
+
+    NetemShim::LinkParameters parameters;
+
+    if (_argumentParser.isSet(SHIM_DELAY)) {
+        static const double USECS_PER_MSEC = 1000.0;
+        parameters.delay = std::chrono::microseconds((qint64)(_argumentParser.value(SHIM_DELAY).toDouble() * USECS_PER_MSEC));
+    }
+
+    if (_argumentParser.isSet(SHIM_LOSS)) {
+        parameters.lossRate = _argumentParser.value(SHIM_LOSS).toDouble() / 100.0;
+    }
+
+    if (_argumentParser.isSet(SHIM_BANDWIDTH)) {
+        static const double BITS_PER_MEGABIT = 1000000.0;
+        parameters.bandwidth = _argumentParser.value(SHIM_BANDWIDTH).toDouble() * BITS_PER_MEGABIT;
+    }
+
+    if (_argumentParser.isSet(SHIM_QUEUE)) {
+        parameters.queueLimit = _argumentParser.value(SHIM_QUEUE).toInt();
+    }
+
+    if (_argumentParser.isSet(SHIM_SEED)) {
+        parameters.seed = _argumentParser.value(SHIM_SEED).toInt();
+    }
+
+    _shim.reset(new NetemShim(_argumentParser.value(PORT_OPTION).toUInt(), HifiSockAddr(address, port), parameters));
+}
+
 void UDTTest::sendInitialPackets() {
     static const int NUM_INITIAL_PACKETS = 500;
     
@@ -25,6 +25,8 @@
 
 #include <ReceivedMessage.h>
 
+#include "NetemShim.h"
+
 struct Message {
     udt::MessageNumber messageNumber;
     QByteArray data;
@@ -46,8 +48,13 @@ private:
     void sendInitialPackets(); // fills the queue with packets to start
     void sendPacket(); // constructs and sends a packet according to the test parameters
     
+    void setupCongestionControl();
+    void setupShim();
+
     QCommandLineParser _argumentParser;
     udt::Socket _socket;
+
+    std::unique_ptr<NetemShim> _shim; // set when we are only relaying between a sender and a receiver
     
     HifiSockAddr _target; // the target for sent packets
     